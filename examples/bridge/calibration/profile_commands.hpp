@@ -0,0 +1,56 @@
+#pragma once
+#include "util/line_fields.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// シリアルから補正プロファイルの指示を受け取る
+// 1行1指示のテキスト（改行は\nか\r\n）
+//   L       プロファイルの一覧をログへ出す
+//   S,n     プロファイルnへ切り替える（0=組み込み、1..=フラッシュのスロット）
+//   U,n     スロットnへプロファイルを書き込む（続きはバイナリ。calibration/profile_upload.hpp）
+namespace gcinput::calibration {
+
+class ProfileCommandReceiver {
+  public:
+    enum class Command : uint8_t {
+        None,
+        List,
+        Select,
+        Upload,
+        Rejected, // 読めない行
+    };
+
+    struct Result {
+        Command command{Command::None};
+        uint32_t profile{0}; // Select/Uploadのとき
+    };
+
+    // 1文字ずつ渡す。行が終わったときだけNone以外を返すことがある
+    Result feed(char c) {
+        std::string_view line{};
+        if (!line_.feed(c, line) || line_.overflowed() || line.empty()) {
+            return {};
+        }
+        if (line == "L") {
+            return {.command = Command::List};
+        }
+        const bool select = line.starts_with("S,");
+        if (!select && !line.starts_with("U,")) {
+            return {.command = Command::Rejected};
+        }
+        std::array<uint32_t, 1> v{};
+        if (!parse_fields(line.substr(2), v)) {
+            return {.command = Command::Rejected};
+        }
+        return {.command = select ? Command::Select : Command::Upload, .profile = v[0]};
+    }
+
+  private:
+    static constexpr std::size_t kMaxLine = 16;
+
+    LineBuffer<kMaxLine> line_{};
+};
+
+} // namespace gcinput::calibration
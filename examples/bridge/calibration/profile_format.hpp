@@ -0,0 +1,83 @@
+#pragma once
+#include "util/crc32.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// フラッシュに置く補正プロファイルの形式（tools/generate_inverse_lut.py --format profile/forward）
+//
+//   +0     ProfileHeader（64バイト、残りはセクタの終わりまで0xFF）
+//   +4096  データ（kindで決まる）
+//
+// ProfileKind::InverseTable（--format profile）
+//   +4096  X表 256×256（[mx][my] の順。inverse_lut_data.hpp の kInverseLutX と同じ並び）
+//   +69632 Y表 256×256
+// ProfileKind::ForwardMap（--format forward）。逆変換テーブルは選んだときにRAMへ組み立てる
+//   +4096  計測したビット 8192バイト（s = sx*256+sy を計測したらバイトs/8のビットs%8）
+//   +12288 計測した s の順に (mx, my) を2バイトずつ
+//
+// 数値はすべてリトルエンディアン。表はXIPからそのまま引くので、データはセクタ境界に置く
+namespace gcinput::calibration {
+
+inline constexpr uint32_t kProfileMagic = 0x4650'4347u; // "GCPF"
+inline constexpr uint16_t kProfileFormatVersion = 2;
+inline constexpr uint32_t kProfileTableSize = 256 * 256;
+// 先頭からデータまで（ヘッダに1セクタ使う）
+inline constexpr uint32_t kProfileDataOffset = 4096;
+
+enum class ProfileKind : uint16_t {
+    InverseTable = 0,
+    ForwardMap = 1,
+};
+
+// InverseTableのデータ（X表とY表）
+inline constexpr uint32_t kInverseTableDataSize = 2 * kProfileTableSize;
+// ForwardMapの計測したビット。データの大きさはこれに点の数×2を足したもの
+inline constexpr uint32_t kMeasuredMaskSize = kProfileTableSize / 8;
+inline constexpr uint32_t kForwardMapMaxDataSize = kMeasuredMaskSize + 2 * kProfileTableSize;
+// スロットに置けるデータの大きさ
+inline constexpr uint32_t kProfileDataCapacity = kForwardMapMaxDataSize;
+
+struct ProfileHeader {
+    uint32_t magic{0};
+    uint16_t version{0};
+    uint16_t header_size{0}; // sizeof(ProfileHeader)
+    ProfileKind kind{ProfileKind::InverseTable};
+    uint16_t reserved{0};
+    uint32_t data_size{0};   // データのバイト数
+    uint32_t data_crc{0};    // データのCRC-32
+    uint32_t source_hash{0}; // 生成元の readings.csv のCRC-32（どの計測から作ったか）
+    uint32_t created{0};     // 生成した時刻（UNIX秒）
+    char name[32]{};         // 表示用の名前（NUL終端）
+    uint32_t header_crc{0};  // magic から name までのCRC-32
+};
+static_assert(sizeof(ProfileHeader) == 64);
+static_assert(offsetof(ProfileHeader, header_crc) == 60);
+
+inline uint32_t header_checksum(const ProfileHeader &header) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&header);
+    return crc32(std::span<const uint8_t>(bytes, offsetof(ProfileHeader, header_crc)));
+}
+
+inline bool data_size_valid(ProfileKind kind, uint32_t data_size) {
+    switch (kind) {
+    case ProfileKind::InverseTable:
+        return data_size == kInverseTableDataSize;
+    case ProfileKind::ForwardMap:
+        return data_size >= kMeasuredMaskSize && data_size <= kForwardMapMaxDataSize &&
+               (data_size - kMeasuredMaskSize) % 2 == 0;
+    }
+    return false;
+}
+
+// ヘッダだけで分かる検査（データのCRCは呼び出し側で確かめる）
+// 名前はそのまま%sで出すので、NULで終わっていないヘッダは使わない
+inline bool header_valid(const ProfileHeader &header) {
+    return header.magic == kProfileMagic && header.version == kProfileFormatVersion &&
+           header.header_size == sizeof(ProfileHeader) &&
+           data_size_valid(header.kind, header.data_size) &&
+           header.name[sizeof(header.name) - 1] == '\0' &&
+           header.header_crc == header_checksum(header);
+}
+
+} // namespace gcinput::calibration
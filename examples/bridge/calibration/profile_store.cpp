@@ -0,0 +1,153 @@
+#include "calibration/profile_store.hpp"
+#include "hardware/flash.h"
+#include "util/flash_region.hpp"
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+namespace gcinput::calibration {
+namespace {
+
+using domain::transform::correction::ForwardMap;
+using domain::transform::correction::InverseLutTable;
+
+// 保存領域（フラッシュ先頭からのオフセット）
+constexpr uint32_t kRegionSize = ProfileStore::kSlotCount * ProfileStore::kSlotSize;
+constexpr uint32_t kRegionOffset = PICO_FLASH_SIZE_BYTES - kRegionSize;
+static_assert(kProfileDataOffset == FLASH_SECTOR_SIZE);
+static_assert(ProfileStore::kSlotSize % FLASH_SECTOR_SIZE == 0);
+
+} // namespace
+
+uint32_t ProfileStore::flash_offset(std::size_t profile) {
+    return kRegionOffset + static_cast<uint32_t>(profile - 1) * kSlotSize;
+}
+
+void ProfileStore::init(Builtin builtin) {
+    namespace correction = domain::transform::correction;
+    builtin_ = builtin;
+    if (builtin == Builtin::Spline) {
+        std::ranges::copy(
+            std::span(&correction::kSplineWeights[0][0], builtin_spline_weights_.size()),
+            builtin_spline_weights_.begin());
+        std::ranges::copy(std::span(&correction::kSplineX[0][0][0], builtin_spline_x_.size()),
+                          builtin_spline_x_.begin());
+        std::ranges::copy(std::span(&correction::kSplineY[0][0][0], builtin_spline_y_.size()),
+                          builtin_spline_y_.begin());
+        builtin_spline_ = correction::InverseSpline{
+            .shift = correction::kSplineShift,
+            .control_points = correction::kSplineControlPoints,
+            .weights = builtin_spline_weights_.data(),
+            .x = builtin_spline_x_.data(),
+            .y = builtin_spline_y_.data(),
+        };
+        builtin_table_ = InverseLutTable{nullptr, nullptr, nullptr, &builtin_spline_};
+    } else {
+        std::ranges::copy(correction::kFoldedLutX, builtin_x_.begin());
+        std::ranges::copy(correction::kFoldedLutY, builtin_y_.begin());
+        std::ranges::copy(correction::kFoldedExceptionCells, builtin_exception_cells_.begin());
+        std::ranges::copy(correction::kFoldedExceptionX, builtin_exception_x_.begin());
+        std::ranges::copy(correction::kFoldedExceptionY, builtin_exception_y_.begin());
+        builtin_folded_ = correction::FoldedInverseLut{
+            .octant = correction::kFoldedLutOctant,
+            .x = builtin_x_.data(),
+            .y = builtin_y_.data(),
+            .exception_cells = builtin_exception_cells_.data(),
+            .exception_x = builtin_exception_x_.data(),
+            .exception_y = builtin_exception_y_.data(),
+            .exception_count = correction::kFoldedExceptionCount,
+        };
+        builtin_table_ = InverseLutTable{nullptr, nullptr, &builtin_folded_};
+    }
+
+    available_ = flash::region_available(kRegionOffset);
+    if (!available_) {
+        return;
+    }
+    for (std::size_t profile = 1; profile <= kSlotCount; ++profile) {
+        reload(profile);
+    }
+}
+
+bool ProfileStore::reload(std::size_t profile, bool data_verified) {
+    if (!available_ || profile == kBuiltinProfile || profile > kSlotCount) {
+        return false;
+    }
+    const std::size_t slot = profile - 1;
+    valid_[slot] = false;
+
+    const uint8_t *base = flash::read(flash_offset(profile));
+    ProfileHeader header{};
+    std::memcpy(&header, base, sizeof(header));
+    if (!header_valid(header)) {
+        return false;
+    }
+    const uint8_t *data = base + kProfileDataOffset;
+    if (!data_verified &&
+        crc32(std::span<const uint8_t>(data, header.data_size)) != header.data_crc) {
+        return false;
+    }
+    headers_[slot] = header;
+    if (header.kind == ProfileKind::InverseTable) {
+        tables_[slot] = InverseLutTable{
+            reinterpret_cast<const uint8_t (*)[256]>(data),
+            reinterpret_cast<const uint8_t (*)[256]>(data + kProfileTableSize),
+        };
+    } else {
+        forward_maps_[slot] = ForwardMap{
+            .measured = data,
+            .points = data + kMeasuredMaskSize,
+            .count = (header.data_size - kMeasuredMaskSize) / 2,
+        };
+    }
+    valid_[slot] = true;
+    return true;
+}
+
+void ProfileStore::invalidate(std::size_t profile) {
+    if (profile != kBuiltinProfile && profile <= kSlotCount) {
+        valid_[profile - 1] = false;
+    }
+}
+
+bool ProfileStore::selectable(std::size_t profile) const {
+    return profile == kBuiltinProfile || (profile <= kSlotCount && valid_[profile - 1]);
+}
+
+const InverseLutTable *ProfileStore::table(std::size_t profile) const {
+    if (profile == kBuiltinProfile) {
+        return &builtin_table_;
+    }
+    const ProfileHeader *h = header(profile);
+    if (h == nullptr || h->kind != ProfileKind::InverseTable) {
+        return nullptr;
+    }
+    return &tables_[profile - 1];
+}
+
+const ForwardMap *ProfileStore::forward_map(std::size_t profile) const {
+    const ProfileHeader *h = header(profile);
+    if (h == nullptr || h->kind != ProfileKind::ForwardMap) {
+        return nullptr;
+    }
+    return &forward_maps_[profile - 1];
+}
+
+const ProfileHeader *ProfileStore::header(std::size_t profile) const {
+    if (profile == kBuiltinProfile || profile > kSlotCount || !valid_[profile - 1]) {
+        return nullptr;
+    }
+    return &headers_[profile - 1];
+}
+
+std::size_t ProfileStore::next(std::size_t current) const {
+    for (std::size_t i = 1; i < kProfileCount; ++i) {
+        const std::size_t profile = (current + i) % kProfileCount;
+        if (selectable(profile)) {
+            return profile;
+        }
+    }
+    return kBuiltinProfile;
+}
+
+} // namespace gcinput::calibration
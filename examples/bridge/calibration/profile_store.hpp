@@ -0,0 +1,98 @@
+#pragma once
+#include "calibration/profile_format.hpp"
+#include "domain/transform/correction.hpp"
+#include "domain/transform/inverse_builder.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// フラッシュの末尾に置いた補正プロファイルのスロット
+//
+// 番号0は組み込みの表、1..kSlotCountがフラッシュのスロット
+// 組み込みの表は折り畳んだもの（inverse_lut_folded_data.hpp、19KBほど）をinit()でSRAMへ写して引く
+// Builtin::Splineなら表の代わりにスプライン（inverse_spline_data.hpp、2KBほど）を写して引く
+// 1スロットはヘッダ1セクタ＋データ34セクタ。起動時にヘッダとデータのCRCを確かめ、
+// 壊れている・空のスロットは選べない
+// 逆変換テーブルのスロットは表をXIPからそのまま引くので、切り替えは InverseLutContext の
+// ポインタを差し替えるだけで済む。順方向の写像のスロットは InverseBuilder で表を組み立ててから
+// 差し替える（mainが行う）
+namespace gcinput::calibration {
+
+class ProfileStore {
+  public:
+    static constexpr std::size_t kSlotCount = 4;
+    static constexpr std::size_t kProfileCount = kSlotCount + 1;
+    static constexpr std::size_t kBuiltinProfile = 0;
+    // 1スロットの大きさ（ヘッダのセクタ＋データ）
+    static constexpr uint32_t kSlotSize = kProfileDataOffset + kProfileDataCapacity;
+
+    // 組み込みのプロファイルの補正のしかた
+    enum class Builtin : uint8_t {
+        FoldedTable, // 折り畳んだ逆変換テーブル（計測した原像をそのまま返す）
+        Spline,      // 逆変換のスプライン（出力がなめらか。原像から数カウントずれることがある）
+    };
+
+    // スロット（1..kSlotCount）の先頭のフラッシュ上のオフセット
+    static uint32_t flash_offset(std::size_t profile);
+
+    // 起動時に1回。組み込みの表（builtin）をSRAMへ写し、スロットを確かめる
+    // 保存領域がファームウェアと重なっていればスロットは使わない
+    // データのCRCを確かめるので、スロット1つにつき数十ms掛かる
+    void init(Builtin builtin = Builtin::FoldedTable);
+
+    bool available() const { return available_; }
+    Builtin builtin() const { return builtin_; }
+
+    // 選べるプロファイルか
+    bool selectable(std::size_t profile) const;
+    // 逆変換テーブルのプロファイルの表。それ以外ならnullptr
+    const domain::transform::correction::InverseLutTable *table(std::size_t profile) const;
+    // 順方向の写像のプロファイルの写像。それ以外ならnullptr
+    const domain::transform::correction::ForwardMap *forward_map(std::size_t profile) const;
+    // フラッシュのスロットのヘッダ。組み込みや選べないスロットならnullptr
+    const ProfileHeader *header(std::size_t profile) const;
+    // currentの次に選べるプロファイル（最後の次は組み込みに戻る）
+    std::size_t next(std::size_t current) const;
+
+    // スロットを書き換える前に選べなくする（選んでいるスロットには使わない）
+    void invalidate(std::size_t profile);
+    // 書き換えたスロットを確かめ直す。選べるようになればtrue
+    // data_verifiedなら表のCRCは書いたときに確かめた値を信じ、ヘッダだけを見る
+    bool reload(std::size_t profile, bool data_verified = false);
+
+  private:
+    bool available_{false};
+    std::array<bool, kSlotCount> valid_{};
+    std::array<ProfileHeader, kSlotCount> headers_{};
+    std::array<domain::transform::correction::InverseLutTable, kSlotCount> tables_{};
+    std::array<domain::transform::correction::ForwardMap, kSlotCount> forward_maps_{};
+
+    // 折り畳んだ組み込みの表のSRAMの写し。init()までは256×256の表を引く
+    std::array<uint8_t, std::size(domain::transform::correction::kFoldedLutX)> builtin_x_{};
+    std::array<uint8_t, std::size(domain::transform::correction::kFoldedLutY)> builtin_y_{};
+    std::array<uint16_t, std::size(domain::transform::correction::kFoldedExceptionCells)>
+        builtin_exception_cells_{};
+    std::array<uint8_t, std::size(domain::transform::correction::kFoldedExceptionX)>
+        builtin_exception_x_{};
+    std::array<uint8_t, std::size(domain::transform::correction::kFoldedExceptionY)>
+        builtin_exception_y_{};
+    domain::transform::correction::FoldedInverseLut builtin_folded_{};
+    // スプラインのSRAMの写し（Builtin::Splineのときだけ写す）
+    std::array<int16_t, sizeof(domain::transform::correction::kSplineWeights) / sizeof(int16_t)>
+        builtin_spline_weights_{};
+    std::array<int16_t, sizeof(domain::transform::correction::kSplineX) / sizeof(int16_t)>
+        builtin_spline_x_{};
+    std::array<int16_t, sizeof(domain::transform::correction::kSplineY) / sizeof(int16_t)>
+        builtin_spline_y_{};
+    domain::transform::correction::InverseSpline builtin_spline_{};
+    Builtin builtin_{Builtin::FoldedTable};
+    domain::transform::correction::InverseLutTable builtin_table_{
+        domain::transform::correction::kBuiltinInverseLut};
+};
+
+// 組み込みのプロファイルの補正のしかた（Splineにすると表の代わりにスプラインを引く）
+// measure の補正の検証も同じものを引く
+inline constexpr ProfileStore::Builtin kBuiltinCorrection = ProfileStore::Builtin::FoldedTable;
+
+} // namespace gcinput::calibration
@@ -0,0 +1,191 @@
+#include "calibration/profile_upload.hpp"
+#include "telemetry/crc8.hpp"
+#include <cstring>
+#include <span>
+
+namespace gcinput::calibration {
+namespace {
+
+constexpr uint32_t kSectorsPerSlot = ProfileStore::kSlotSize / FLASH_SECTOR_SIZE;
+static_assert(ProfileUpload::kChunkSize == FLASH_PAGE_SIZE);
+
+uint32_t read_u32_le(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+bool ProfileUpload::begin(std::size_t profile, std::size_t active_profile, uint32_t now_us) {
+    if (busy() || !store_.available() || profile == ProfileStore::kBuiltinProfile ||
+        profile > ProfileStore::kSlotCount || profile == active_profile) {
+        return false;
+    }
+    // 書き換える間は選べなくする（ISRは選んでいないスロットを読まない）
+    store_.invalidate(profile);
+    profile_ = profile;
+    state_ = State::Erasing;
+    sector_ = 0;
+    waiting_ = false;
+    next_offset_ = kProfileDataOffset;
+    data_closed_ = false;
+    header_received_ = false;
+    written_offset_ = kProfileDataOffset;
+    crc_ = 0;
+    last_chunk_us_ = now_us;
+    chunk_head_ = 0;
+    chunk_count_ = 0;
+    frame_length_ = 0;
+    frame_overflow_ = false;
+    return true;
+}
+
+void ProfileUpload::feed(uint8_t byte, uint32_t now_us) {
+    if (state_ != State::Receiving) {
+        return;
+    }
+    if (byte != 0x00) {
+        if (frame_length_ < frame_.size()) {
+            frame_[frame_length_++] = byte;
+        } else {
+            frame_overflow_ = true;
+        }
+        return;
+    }
+    if (!frame_overflow_ && frame_length_ > 0) {
+        accept_frame(now_us);
+    }
+    frame_length_ = 0;
+    frame_overflow_ = false;
+}
+
+void ProfileUpload::accept_frame(uint32_t now_us) {
+    std::array<uint8_t, kMaxRawChunk> raw{};
+    std::size_t length = 0;
+    if (!telemetry::cobs::decode(std::span<const uint8_t>(frame_.data(), frame_length_), raw,
+                                 length) ||
+        length < 4 + 1 + 1 ||
+        telemetry::crc8(std::span<const uint8_t>(raw.data(), length - 1)) != raw[length - 1]) {
+        return;
+    }
+    const uint32_t offset = read_u32_le(raw.data());
+    const std::size_t data_length = length - 4 - 1;
+
+    const bool data_chunk = offset == next_offset_ && !data_closed_ && !header_received_ &&
+                            data_length <= kChunkSize && offset + data_length <= kDataLimit;
+    const bool header_chunk = offset == 0 && next_offset_ > kProfileDataOffset &&
+                              !header_received_ && data_length == sizeof(ProfileHeader);
+    if ((!data_chunk && !header_chunk) || chunk_count_ == chunks_.size()) {
+        // 重なった送り直しや抜けの後のチャンク。ホストは応答が止まれば送り直す
+        return;
+    }
+    Chunk &chunk = chunks_[(chunk_head_ + chunk_count_) % chunks_.size()];
+    chunk.offset = offset;
+    chunk.length = static_cast<uint16_t>(data_length);
+    std::memcpy(chunk.data.data(), raw.data() + 4, data_length);
+    ++chunk_count_;
+    if (header_chunk) {
+        header_received_ = true;
+    } else {
+        next_offset_ = offset + static_cast<uint32_t>(data_length);
+        data_closed_ = data_length < kChunkSize;
+    }
+    last_chunk_us_ = now_us;
+}
+
+ProfileUpload::Result ProfileUpload::service(uint32_t now_us, const ConsoleFrameClock &clock) {
+    switch (state_) {
+    case State::Idle:
+        return {};
+    case State::Erasing:
+        return erase_step(now_us, clock);
+    case State::Receiving:
+        return write_step(now_us, clock);
+    }
+    return {};
+}
+
+ProfileUpload::Result ProfileUpload::erase_step(uint32_t now_us, const ConsoleFrameClock &clock) {
+    const uint32_t base = ProfileStore::flash_offset(profile_);
+    // 消したままのセクタは飛ばす（1回に1セクタだけ確かめる）
+    if (sector_ < kSectorsPerSlot &&
+        !flash::is_blank(base + sector_ * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE)) {
+        // 消去の間は要求に応答できないので、コンソールが止まっているときだけ消す
+        bool console_idle = false;
+        window_.open(now_us, clock.last_poll_us, clock.frames != 0, console_idle);
+        if (!console_idle) {
+            if (now_us - last_chunk_us_ >= kEraseTimeoutUs) {
+                // まだ消していなければ元のプロファイルを選べるように戻す
+                store_.reload(profile_);
+                return fail(0);
+            }
+            if (!waiting_) {
+                waiting_ = true;
+                return {.event = Event::Waiting, .profile = profile_};
+            }
+            return {};
+        }
+        window_.use(clock.last_poll_us);
+        flash::erase_sector(base + sector_ * FLASH_SECTOR_SIZE);
+    }
+    if (sector_ < kSectorsPerSlot) {
+        ++sector_;
+        return {};
+    }
+    state_ = State::Receiving;
+    last_chunk_us_ = now_us;
+    return {.event = Event::Ready, .profile = profile_, .offset = next_offset_};
+}
+
+ProfileUpload::Result ProfileUpload::write_step(uint32_t now_us, const ConsoleFrameClock &clock) {
+    if (chunk_count_ == 0) {
+        if (now_us - last_chunk_us_ >= kReceiveTimeoutUs) {
+            return fail(written_offset_);
+        }
+        return {};
+    }
+    bool console_idle = false;
+    if (!window_.open(now_us, clock.last_poll_us, clock.frames != 0, console_idle)) {
+        return {};
+    }
+    window_.use(clock.last_poll_us);
+    const Chunk &chunk = chunks_[chunk_head_];
+    const auto data = std::span<const uint8_t>(chunk.data.data(), chunk.length);
+    const uint32_t flash_offset = ProfileStore::flash_offset(profile_) + chunk.offset;
+    chunk_head_ = (chunk_head_ + 1) % chunks_.size();
+    --chunk_count_;
+
+    if (chunk.offset != 0) {
+        flash::program_page(flash_offset, data);
+        // 読み戻して確かめ、データのCRCも読み戻した値で数える
+        const auto written = std::span<const uint8_t>(flash::read(flash_offset), data.size());
+        if (std::memcmp(written.data(), data.data(), data.size()) != 0) {
+            return fail(chunk.offset);
+        }
+        crc_ = crc32_update(crc_, written);
+        written_offset_ = chunk.offset + chunk.length;
+        return {.event = Event::Written, .profile = profile_, .offset = written_offset_};
+    }
+
+    // ヘッダ: 書いたデータの大きさとCRCが合うときだけ書く
+    ProfileHeader header{};
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (!header_valid(header) || header.data_size != written_offset_ - kProfileDataOffset ||
+        header.data_crc != crc_) {
+        return fail(written_offset_);
+    }
+    flash::program_page(flash_offset, data);
+    if (!store_.reload(profile_, true)) {
+        return fail(0);
+    }
+    state_ = State::Idle;
+    return {.event = Event::Completed, .profile = profile_, .offset = written_offset_, .crc = crc_};
+}
+
+ProfileUpload::Result ProfileUpload::fail(uint32_t offset) {
+    state_ = State::Idle;
+    chunk_count_ = 0;
+    return {.event = Event::Failed, .profile = profile_, .offset = offset, .crc = crc_};
+}
+
+} // namespace gcinput::calibration
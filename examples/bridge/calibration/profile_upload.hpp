@@ -0,0 +1,109 @@
+#pragma once
+#include "calibration/profile_store.hpp"
+#include "link/shared/shared_console.hpp"
+#include "telemetry/cobs.hpp"
+#include "util/flash_region.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// シリアルから補正プロファイルを受け取り、選んでいないスロットへ書く（tools/upload_profile.py）
+//
+//   1. ホストが U,n の行を送る（ProfileCommandReceiver）。選んでいるスロットには書かない
+//   2. スロットの空でないセクタを消してReadyを返し、ここからバイナリの受信に切り替わる
+//      消去はコンソールが止まっている間だけ行う（要求が来ている間はWaitingを返して待つ）
+//   3. ホストはデータを先頭から256バイトずつ COBS( offset:u32 | data | crc8 ) 0x00 で送る
+//      最後のチャンクだけは短くてよい（その後のデータは受け取らない）
+//      Writtenが返る前に送ってよいのはkWindow個まで。順番の合わない・壊れたチャンクは黙って捨てる
+//      ので、応答が止まったらホストは最後にWrittenが返った位置から送り直す
+//   4. 最後にヘッダ64バイトをoffset 0で送る。書いたデータの大きさと読み戻したCRCがヘッダと
+//      合えばヘッダを書き、スロットを選べるようにする（切り替えはmainが行う）
+//
+// ヘッダを最後に書くので、途中で止まったスロットは空のまま（起動し直しても選べない）
+// ページの書き込み（1ms弱）はStatus要求の直後に1回ずつ行い、要求の合間に収まる
+// セクタの消去（数十ms）の間は要求に応答できないので、遊んでいる間は消さない。空のスロットなら
+// 消去は要らず、遊びながら書ける。空でなければコンソールを止める（電源を切る、パッドを抜く）まで待つ
+namespace gcinput::calibration {
+
+class ProfileUpload {
+  public:
+    // 1チャンクのデータのバイト数（フラッシュの1ページ）
+    static constexpr std::size_t kChunkSize = 256;
+    // Writtenを待たずに送ってよいチャンクの数
+    static constexpr std::size_t kWindow = 4;
+    // これだけチャンクが届かなければ止める
+    static constexpr uint32_t kReceiveTimeoutUs = 3'000'000;
+    // これだけ経っても消し終えなければ止める（コンソールが止まらない）
+    static constexpr uint32_t kEraseTimeoutUs = 60'000'000;
+
+    enum class Event : uint8_t {
+        None,
+        Waiting, // 空でないスロットの消去を、コンソールが止まるまで待っている（1回だけ）
+        Ready,
+        Written,
+        Completed, // スロットを選べるようになった
+        Failed,
+    };
+
+    struct Result {
+        Event event{Event::None};
+        std::size_t profile{0};
+        uint32_t offset{0}; // Ready: 次に送る位置、Written: 書き終えた位置、Failed: 止めた位置
+        uint32_t crc{0};    // Completed/Failed: 書いたデータのCRC-32
+    };
+
+    explicit ProfileUpload(ProfileStore &store) : store_{store} {}
+
+    // スロットprofileへの書き込みを始める。始められなければfalse
+    bool begin(std::size_t profile, std::size_t active_profile, uint32_t now_us);
+    // 書き込み中。シリアルの文字は行ではなくfeed()へ渡す
+    bool busy() const { return state_ != State::Idle; }
+    void feed(uint8_t byte, uint32_t now_us);
+
+    // mainループから毎回呼ぶ。書き込める時間帯なら、書き込みか消去を1回行う
+    Result service(uint32_t now_us, const ConsoleFrameClock &clock);
+
+  private:
+    enum class State : uint8_t { Idle, Erasing, Receiving };
+
+    // offset(4) + data + crc8(1)
+    static constexpr std::size_t kMaxRawChunk = 4 + kChunkSize + 1;
+    static constexpr std::size_t kMaxEncodedChunk = telemetry::cobs::max_encoded_size(kMaxRawChunk);
+    static constexpr uint32_t kDataLimit = kProfileDataOffset + kProfileDataCapacity;
+
+    struct Chunk {
+        uint32_t offset{0};
+        uint16_t length{0};
+        std::array<uint8_t, kChunkSize> data{};
+    };
+
+    void accept_frame(uint32_t now_us);
+    Result erase_step(uint32_t now_us, const ConsoleFrameClock &clock);
+    Result write_step(uint32_t now_us, const ConsoleFrameClock &clock);
+    Result fail(uint32_t offset);
+
+    ProfileStore &store_;
+    State state_{State::Idle};
+    std::size_t profile_{0};
+    uint32_t sector_{0};         // Erasing: 次に確かめるセクタ（スロット内の番号）
+    bool waiting_{false};        // Erasing: Waitingを返した
+    uint32_t next_offset_{0};    // 次に受け取るチャンクの位置
+    bool data_closed_{false};    // 短いチャンクを受け取った（データの終わり）
+    bool header_received_{false};
+    uint32_t written_offset_{0}; // 書き終えた位置
+    uint32_t crc_{0};            // 読み戻したデータのCRC-32（書き終えた位置まで）
+    uint32_t last_chunk_us_{0};  // Erasing中は始めた時刻
+    // Status要求からこの間だけフラッシュを触る（応答を送り終え、次の要求はまだ来ない）
+    flash::ConsoleWindow window_{{.start_us = 600, .end_us = 2'500}};
+
+    // 受け取ったがまだ書いていないチャンク（先頭から順に書く）
+    std::array<Chunk, kWindow> chunks_{};
+    std::size_t chunk_head_{0};
+    std::size_t chunk_count_{0};
+
+    std::array<uint8_t, kMaxEncodedChunk> frame_{};
+    std::size_t frame_length_{0};
+    bool frame_overflow_{false};
+};
+
+} // namespace gcinput::calibration
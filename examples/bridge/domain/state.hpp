@@ -1,5 +1,6 @@
 #pragma once
 #include "domain/pad_status_flags.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -29,23 +30,38 @@ enum class PadButton : uint16_t {
 
 constexpr inline uint16_t to_mask(PadButton button) { return static_cast<uint16_t>(button); }
 
+// Status wordのうちボタン以外のビット。PadStatusFlagsの各フラグに対応する
+enum class PadStatusBit : uint16_t {
+    OriginNotSent = (1u << 5),
+    ErrorLatched = (1u << 6),
+    // 受信時は直近エラー（error_last）として読む。送信時は常に1
+    Always1 = (1u << 7),
+    UseControllerOrigin = (1u << 15),
+};
+
+constexpr inline uint16_t to_mask(PadStatusBit bit) { return static_cast<uint16_t>(bit); }
+
+// Status wordのうちボタンに割り当てられたビット全体
+inline constexpr uint16_t kPadButtonMask =
+    to_mask(PadButton::A) | to_mask(PadButton::B) | to_mask(PadButton::X) |
+    to_mask(PadButton::Y) | to_mask(PadButton::Start) | to_mask(PadButton::DpadLeft) |
+    to_mask(PadButton::DpadRight) | to_mask(PadButton::DpadDown) | to_mask(PadButton::DpadUp) |
+    to_mask(PadButton::Z) | to_mask(PadButton::R) | to_mask(PadButton::L);
+
+// ボタンのON/OFFはStatus wordそのもので持つ。デコード/エンコードはワードのコピーで済む
+// ボタン以外のビット（PadStatusBit）も同じワードに同居する
 struct ButtonInput {
-    bool a{false};
-    bool b{false};
-    bool x{false};
-    bool y{false};
-    bool start{false};
-
-    bool dpad_left{false};
-    bool dpad_right{false};
-    bool dpad_down{false};
-    bool dpad_up{false};
-
-    bool z{false};
-    bool r{false};
-    bool l{false};
+    // PadStatusFlags{}と同じ状態（Origin送信済み、エラーなし、error_last=1）
+    static constexpr uint16_t kDefaultStatusWord{to_mask(PadStatusBit::Always1)};
+
+    uint16_t status_word{kDefaultStatusWord};
+
+    // 押されているボタンのビット集合
+    constexpr uint16_t pressed_mask() const { return status_word & kPadButtonMask; }
 };
 
+// フィールドの並びはMode3/Originレスポンスの3バイト目以降と同じ
+// state_wireはこの並びを前提にバイト列をそのままコピーする
 struct AnalogInput {
     // スティックの中心
     static constexpr uint8_t kAxisCenter{0x80};
@@ -71,6 +87,7 @@ struct AnalogInput {
 };
 
 // プロジェクト内共通のコントローラ入力表現
+// Originレスポンスと同じ並び（Status word + アナログ8バイト）の10バイト
 struct PadInput {
     // ボタンのON/OFF
     ButtonInput buttons{};
@@ -78,92 +95,79 @@ struct PadInput {
     AnalogInput analog{};
 
     constexpr bool pressed(PadButton button) const {
-        switch (button) {
-        case PadButton::A:
-            return buttons.a;
-        case PadButton::B:
-            return buttons.b;
-        case PadButton::X:
-            return buttons.x;
-        case PadButton::Y:
-            return buttons.y;
-        case PadButton::Start:
-            return buttons.start;
-        case PadButton::DpadLeft:
-            return buttons.dpad_left;
-        case PadButton::DpadRight:
-            return buttons.dpad_right;
-        case PadButton::DpadDown:
-            return buttons.dpad_down;
-        case PadButton::DpadUp:
-            return buttons.dpad_up;
-        case PadButton::Z:
-            return buttons.z;
-        case PadButton::R:
-            return buttons.r;
-        case PadButton::L:
-            return buttons.l;
-        default:
-            return false;
-        }
-        return false;
+        return (buttons.status_word & to_mask(button)) != 0;
     }
 
     constexpr void set(PadButton button, bool on = true) {
-        switch (button) {
-        case PadButton::A:
-            buttons.a = on;
-            break;
-        case PadButton::B:
-            buttons.b = on;
-            break;
-        case PadButton::X:
-            buttons.x = on;
-            break;
-        case PadButton::Y:
-            buttons.y = on;
-            break;
-        case PadButton::Start:
-            buttons.start = on;
-            break;
-        case PadButton::DpadLeft:
-            buttons.dpad_left = on;
-            break;
-        case PadButton::DpadRight:
-            buttons.dpad_right = on;
-            break;
-        case PadButton::DpadDown:
-            buttons.dpad_down = on;
-            break;
-        case PadButton::DpadUp:
-            buttons.dpad_up = on;
-            break;
-        case PadButton::Z:
-            buttons.z = on;
-            break;
-        case PadButton::R:
-            buttons.r = on;
-            break;
-        case PadButton::L:
-            buttons.l = on;
-            break;
-        default:
-            break;
+        if (on) {
+            buttons.status_word |= to_mask(button);
+        } else {
+            buttons.status_word &= static_cast<uint16_t>(~to_mask(button));
         }
     }
 
     constexpr void clear(PadButton button) { set(button, false); }
 
-    constexpr void clear_buttons() { buttons = ButtonInput{}; }
+    // ボタンのビットだけを落とす。レポートフラグは残す
+    constexpr void clear_buttons() {
+        buttons.status_word &= static_cast<uint16_t>(~kPadButtonMask);
+    }
 };
 
+// PadInputの各バイト（先頭から0..9）を表すビット
+// 変換ステージが書き換えるフィールドの申告や、応答バイト列の差分更新に使う
+namespace input_field {
+inline constexpr uint16_t kStatusWordLow = 1u << 0;
+inline constexpr uint16_t kStatusWordHigh = 1u << 1;
+inline constexpr uint16_t kStickX = 1u << 2;
+inline constexpr uint16_t kStickY = 1u << 3;
+inline constexpr uint16_t kCStickX = 1u << 4;
+inline constexpr uint16_t kCStickY = 1u << 5;
+inline constexpr uint16_t kLAnalog = 1u << 6;
+inline constexpr uint16_t kRAnalog = 1u << 7;
+inline constexpr uint16_t kAAnalog = 1u << 8;
+inline constexpr uint16_t kBAnalog = 1u << 9;
+
+// ボタンとレポートフラグはStatus wordの両バイトにまたがる
+inline constexpr uint16_t kStatusWord = kStatusWordLow | kStatusWordHigh;
+inline constexpr uint16_t kStick = kStickX | kStickY;
+inline constexpr uint16_t kCStick = kCStickX | kCStickY;
+inline constexpr uint16_t kTriggers = kLAnalog | kRAnalog;
+inline constexpr uint16_t kAnalogButtons = kAAnalog | kBAnalog;
+inline constexpr uint16_t kAll = (1u << 10) - 1u;
+} // namespace input_field
+
 // Status, Origin, Recalibrateレスポンスの共通形式。PollModeに依存しない。
+// レポートフラグはinput.buttons.status_wordに同居しているので、report()/set_report()で読み書きする
 struct PadState {
-    PadStatusFlags report{};
     PadInput input{};
+
+    constexpr PadStatusFlags report() const {
+        const uint16_t word = input.buttons.status_word;
+        PadStatusFlags out{};
+        out.origin_sent = (word & to_mask(PadStatusBit::OriginNotSent)) == 0;
+        out.error_latched = (word & to_mask(PadStatusBit::ErrorLatched)) != 0;
+        out.error_last = (word & to_mask(PadStatusBit::Always1)) != 0;
+        out.use_controller_origin = (word & to_mask(PadStatusBit::UseControllerOrigin)) != 0;
+        return out;
+    }
+
+    constexpr void set_report(const PadStatusFlags &report) {
+        uint16_t word = input.buttons.pressed_mask();
+        word |= report.origin_sent ? 0 : to_mask(PadStatusBit::OriginNotSent);
+        word |= report.error_latched ? to_mask(PadStatusBit::ErrorLatched) : 0;
+        word |= report.error_last ? to_mask(PadStatusBit::Always1) : 0;
+        word |= report.use_controller_origin ? to_mask(PadStatusBit::UseControllerOrigin) : 0;
+        input.buttons.status_word = word;
+    }
 };
 
 // ISRやダブルバッファでコピーしても安全
 static_assert(std::is_trivially_copyable_v<PadInput>);
 static_assert(std::is_standard_layout_v<PadInput>);
+// ワイヤ形式のバイト列と直接コピーできる配置になっていること
+static_assert(sizeof(AnalogInput) == 8);
+static_assert(offsetof(AnalogInput, b_analog) == 7);
+static_assert(sizeof(PadInput) == 10);
+static_assert(sizeof(PadState) == sizeof(PadInput));
 } // namespace gcinput::domain
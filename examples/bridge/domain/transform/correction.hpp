@@ -1,8 +1,11 @@
 #pragma once
 #include "domain/state.hpp"
 #include "domain/transform/inverse_lut_data.hpp"
+#include "domain/transform/inverse_lut_folded_data.hpp"
+#include "domain/transform/inverse_spline_data.hpp"
 #include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
@@ -101,16 +104,173 @@ inline void linear_scale(void *, domain::PadState &state) {
         static_cast<uint8_t>(std::clamp(ry + kCenter, int32_t{0}, int32_t{255}));
 }
 
+// ── 折り畳んだ逆変換テーブル ──
+// S⁻¹⁺ は (127.5, 127.5) を中心にほぼ対称なので、補正パイプラインが引く入力 φ(C(s)) については
+// 八分円（a ≥ b の三角形）か象限の表と、対称にならないセルの例外で元の表を再現できる
+// （tools/generate_inverse_lut.py --format folded）。それ以外の入力には近くの値を返すだけ
+struct FoldedInverseLut {
+    bool octant;
+    const uint8_t *x; // 折り畳んだセルの順（八分円: a*(a+1)/2+b、象限: a*128+b）
+    const uint8_t *y;
+    const uint16_t *exception_cells; // mx<<8|my の昇順
+    const uint8_t *exception_x;
+    const uint8_t *exception_y;
+    uint16_t exception_count;
+};
+
+inline constexpr FoldedInverseLut kBuiltinFoldedLut{
+    .octant = kFoldedLutOctant,
+    .x = kFoldedLutX,
+    .y = kFoldedLutY,
+    .exception_cells = kFoldedExceptionCells,
+    .exception_x = kFoldedExceptionX,
+    .exception_y = kFoldedExceptionY,
+    .exception_count = kFoldedExceptionCount,
+};
+
+// 折り畳んだ表を引く。m と 255 − m が対になり、値も 255 − v で戻す
+inline std::pair<uint8_t, uint8_t> folded_lookup(const FoldedInverseLut &lut, uint8_t mx,
+                                                 uint8_t my) {
+    const uint16_t cell = static_cast<uint16_t>((mx << 8) | my);
+    uint32_t lo = 0;
+    uint32_t hi = lut.exception_count;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) / 2;
+        if (lut.exception_cells[mid] < cell) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < lut.exception_count && lut.exception_cells[lo] == cell) {
+        return {lut.exception_x[lo], lut.exception_y[lo]};
+    }
+
+    const bool mirror_x = mx < 128;
+    const bool mirror_y = my < 128;
+    uint32_t a = mirror_x ? 127u - mx : mx - 128u;
+    uint32_t b = mirror_y ? 127u - my : my - 128u;
+    const bool swap = lut.octant && b > a;
+    if (swap) {
+        std::swap(a, b);
+    }
+    const uint32_t index = lut.octant ? a * (a + 1) / 2 + b : a * 128 + b;
+    uint8_t u = lut.x[index];
+    uint8_t v = lut.y[index];
+    if (swap) {
+        std::swap(u, v);
+    }
+    return {static_cast<uint8_t>(mirror_x ? 255 - u : u),
+            static_cast<uint8_t>(mirror_y ? 255 - v : v)};
+}
+
+// ── 逆変換のスプライン ──
+// S⁻¹⁺ を (mx, my) の象限ごとに一様な双3次Bスプラインで近似したもの
+// （tools/fit_inverse_spline.py）。象限に分けるのは、デッドゾーンで 127 と 128 の間が跳ぶため。
+// 表のような1カウントの段が出ず2KBほどで済むが、1回に40回乗算する（除算は使わない）
+struct InverseSpline {
+    uint8_t shift;               // 節点の間隔は 1 << shift
+    uint8_t control_points;      // 象限の片軸の制御点の数 (128 >> shift) + 3
+    const int16_t *weights;      // 区間内の位置 t ごとに4つの基底の重み（Q12、和は4096）
+    const int16_t *x; // 象限 (mx >= 128) * 2 + (my >= 128) ごとの制御点（Q4、行優先）
+    const int16_t *y;
+};
+
+inline constexpr InverseSpline kBuiltinSpline{
+    .shift = kSplineShift,
+    .control_points = kSplineControlPoints,
+    .weights = &kSplineWeights[0][0],
+    .x = &kSplineX[0][0][0],
+    .y = &kSplineY[0][0][0],
+};
+
+// 制御点が -64..319 カウントなら、途中の和は int32_t に収まる
+template <std::size_t N>
+consteval bool spline_control_in_range(const int16_t (&control)[4][N][N]) {
+    for (const auto &quadrant : control) {
+        for (const auto &row : quadrant) {
+            for (const int16_t c : row) {
+                if (c < -64 * 16 || c > 319 * 16) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+static_assert(spline_control_in_range(kSplineX) && spline_control_in_range(kSplineY));
+
+// 制御点 4×4 を重みで足す。行ごとの和（Q16）を Q8 に丸めてから列の重みを掛ける（Q20）
+inline uint8_t spline_axis(const int16_t *control, uint32_t stride, const int16_t *wx,
+                           const int16_t *wy) {
+    int32_t acc = 0;
+    for (uint32_t p = 0; p < 4; ++p) {
+        const int16_t *c = control + p * stride;
+        const int32_t row = wy[0] * c[0] + wy[1] * c[1] + wy[2] * c[2] + wy[3] * c[3];
+        acc += wx[p] * ((row + (1 << 7)) >> 8);
+    }
+    return static_cast<uint8_t>(std::clamp<int32_t>((acc + (1 << 19)) >> 20, 0, 255));
+}
+
+inline std::pair<uint8_t, uint8_t> spline_lookup(const InverseSpline &spline, uint8_t mx,
+                                                 uint8_t my) {
+    const uint32_t mask = (1u << spline.shift) - 1;
+    const uint32_t n = spline.control_points;
+    const uint32_t lx = mx & 127u;
+    const uint32_t ly = my & 127u;
+    const uint32_t quadrant = (mx >> 7) * 2u + (my >> 7);
+    const uint32_t base = (quadrant * n + (lx >> spline.shift)) * n + (ly >> spline.shift);
+    const int16_t *wx = spline.weights + 4 * (lx & mask);
+    const int16_t *wy = spline.weights + 4 * (ly & mask);
+    return {spline_axis(spline.x + base, n, wx, wy), spline_axis(spline.y + base, n, wx, wy)};
+}
+
+// ── 逆変換テーブル ──
+// [mx][my] で引く 256×256 の表を軸ごとに持つ。組み込み（inverse_lut_data.hpp）か、
+// フラッシュのプロファイル（calibration/profile_store.hpp）を指す。
+// foldedがあれば x/y の代わりに折り畳んだ表を、splineがあればスプラインを引く
+struct InverseLutTable {
+    const uint8_t (*x)[256];
+    const uint8_t (*y)[256];
+    const FoldedInverseLut *folded{nullptr};
+    const InverseSpline *spline{nullptr};
+};
+
+inline constexpr InverseLutTable kBuiltinInverseLut{kInverseLutX, kInverseLutY};
+inline constexpr InverseLutTable kBuiltinFoldedInverseLut{nullptr, nullptr, &kBuiltinFoldedLut};
+inline constexpr InverseLutTable kBuiltinSplineInverseLut{nullptr, nullptr, nullptr,
+                                                        &kBuiltinSpline};
+
+// ── 逆変換テーブルの切り替えコンテキスト ──
+// main ループがプロファイルを切り替えるときに store、ISR から load される。
+// 1回の Status 応答の中では同じ表を使う（x と y を別の表から引くことはない）。
+struct InverseLutContext {
+    std::atomic<const InverseLutTable *> table{&kBuiltinInverseLut};
+};
+
 // ── inverse_lut: S⁻¹⁺ LUT ルックアップ ──
 // 現在のスティック値をインデックスとして逆変換テーブルを参照する。
-inline void inverse_lut(void *, domain::PadState &state) {
+inline void inverse_lut(InverseLutContext &ctx, domain::PadState &state) {
+    const InverseLutTable *table = ctx.table.load(std::memory_order_acquire);
     auto &analog = state.input.analog;
 
     const uint8_t mx = analog.stick_x;
     const uint8_t my = analog.stick_y;
 
-    analog.stick_x = kInverseLutX[mx][my];
-    analog.stick_y = kInverseLutY[mx][my];
+    if (table->folded != nullptr) {
+        const auto [x, y] = folded_lookup(*table->folded, mx, my);
+        analog.stick_x = x;
+        analog.stick_y = y;
+        return;
+    }
+    if (table->spline != nullptr) {
+        const auto [x, y] = spline_lookup(*table->spline, mx, my);
+        analog.stick_x = x;
+        analog.stick_y = y;
+        return;
+    }
+    analog.stick_x = table->x[mx][my];
+    analog.stick_y = table->y[mx][my];
 }
 
 // ── forward_lut: S 順方向 LUT ルックアップ（デバッグ用） ──
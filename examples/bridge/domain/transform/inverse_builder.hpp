@@ -0,0 +1,285 @@
+#pragma once
+#include "domain/transform/correction.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// 計測した順方向の写像 S から S⁻¹⁺ をRAMに組み立てる
+// tools/generate_inverse_lut.py の build_inverse と bfs_fill と同じ表になる（host/bench で確かめる）
+//
+//   1. 計測した s を sx, sy の順に見て inv[S(s)] = s とする（後勝ち）。値が入ったセルがシード
+//   2. シードを (mx, my) の順に展開し、空の4近傍に値を写してキューへ積む
+//   3. キューの先頭から同じく展開する。近傍は (-1,0) (1,0) (0,-1) (0,1) の順
+//   4. 値を写した元（親）をたどり、シード以外のセルへ値を書く
+//
+// Python はシードを全部キューへ積んでから始めるが、シードはキューの先頭に並ぶので、2 で先に
+// 展開しても取り出す順番は変わらない
+// 2 と 3 の間はシード以外のセルに親の向き（2ビット）だけを覚え、値は 4 でまとめて書く。
+// キューに積むのはシード以外のセルで、どれも1回しか積まないので、キューはシード以外のセルの
+// 表の2バイトに（セルの順に）置ける。キューのための別のRAMは要らず、溢れることもない
+// step()は決まった数のセルだけ処理して戻るので、mainループを止めずに少しずつ進められる
+namespace gcinput::domain::transform::correction {
+
+// 計測した順方向の写像（形式は calibration/profile_format.hpp）
+struct ForwardMap {
+    const uint8_t *measured{nullptr}; // s = sx*256+sy を計測したか。バイトs/8のビットs%8
+    const uint8_t *points{nullptr};   // 計測した s の順に (mx, my) を2バイトずつ
+    uint32_t count{0};                // pointsの組の数（measuredの1の数と同じはず）
+};
+
+class InverseBuilder {
+  public:
+    // 持っているRAM（表 128KB、ビットマップ 16KB、親の向き 16KB）。組み立てていない間も使う
+    static constexpr std::size_t kRamBytes = 2 * 256 * 256 + 2 * (256 * 256 / 8) + 256 * 256 / 4;
+
+    enum class State : uint8_t {
+        Idle,
+        Inverting, // 1. 順方向の写像を逆に引く
+        Seeding,   // 2. シードを展開する
+        Filling,   // 3. キューを空にする
+        Resolving, // 4. 親から値を写す
+        Done,      // table()を使える
+        Failed,    // 写像が壊れている・シードがない
+    };
+
+    // mapを読み終えるまで（Done/Failedになるまで）mapの中身を変えないこと
+    // 組み立て中の表をISRに使わせていないこと
+    void begin(const ForwardMap &map) {
+        map_ = map;
+        state_ = State::Inverting;
+        cursor_ = 0;
+        point_ = 0;
+        exact_count_ = 0;
+        queue_head_ = 0;
+        queue_tail_ = 0;
+        queue_count_ = 0;
+        peak_queue_ = 0;
+        seed_.fill(0);
+        filled_.fill(0);
+        parent_.fill(0);
+        filled_count_ = 0;
+    }
+
+    // 多くてbudget個のセルを処理して今の状態を返す
+    State step(uint32_t budget) {
+        while (budget-- > 0) {
+            switch (state_) {
+            case State::Inverting:
+                invert_next();
+                break;
+            case State::Seeding:
+                seed_next();
+                break;
+            case State::Filling:
+                fill_next();
+                break;
+            case State::Resolving:
+                resolve_next();
+                break;
+            case State::Idle:
+            case State::Done:
+            case State::Failed:
+                return state_;
+            }
+        }
+        return state_;
+    }
+
+    State state() const { return state_; }
+    // Doneのときだけ使える
+    const InverseLutTable &table() const { return table_; }
+    // 原像が計測にあったセルの数
+    uint32_t exact_count() const { return exact_count_; }
+    // キューに同時に積んだセルの数の最大
+    uint32_t peak_queue() const { return peak_queue_; }
+
+    // 進み具合。1.〜4. をそれぞれkCellsとして数える（3.は値が入ったセルの数）
+    static constexpr uint32_t kProgressTotal = 4 * 256 * 256;
+    uint32_t progress() const {
+        switch (state_) {
+        case State::Inverting:
+            return cursor_;
+        case State::Seeding:
+            return kCells + cursor_;
+        case State::Filling:
+            return 2 * kCells + filled_count_;
+        case State::Resolving:
+            return 3 * kCells + cursor_;
+        case State::Done:
+            return kProgressTotal;
+        case State::Idle:
+        case State::Failed:
+            break;
+        }
+        return 0;
+    }
+
+  private:
+    static constexpr uint32_t kCells = 256 * 256;
+
+    static bool test(const std::array<uint32_t, kCells / 32> &bits, uint32_t cell) {
+        return (bits[cell >> 5] >> (cell & 31)) & 1u;
+    }
+    static void set(std::array<uint32_t, kCells / 32> &bits, uint32_t cell) {
+        bits[cell >> 5] |= 1u << (cell & 31);
+    }
+
+    // 親（値を写した元）の向き。expand() で近傍を見る順と同じ
+    static constexpr int32_t kParentOffset[4] = {-256, 256, -1, 1};
+    uint32_t parent(uint32_t cell) const {
+        return cell + kParentOffset[(parent_[cell >> 4] >> ((cell & 15) * 2)) & 3u];
+    }
+
+    // cellから後ろで最初のシード以外のセル（キューを置く場所）
+    uint32_t next_slot(uint32_t cell) const {
+        while (cell < kCells) {
+            const uint32_t free = ~seed_[cell >> 5] >> (cell & 31);
+            if (free != 0) {
+                return cell + static_cast<uint32_t>(std::countr_zero(free));
+            }
+            cell = (cell | 31) + 1;
+        }
+        return kCells;
+    }
+    void invert_next() {
+        if (cursor_ == kCells) {
+            // 点の数がビットの数と合わない写像は使わない
+            state_ = point_ == map_.count ? State::Seeding : State::Failed;
+            cursor_ = 0;
+            queue_head_ = next_slot(0);
+            queue_tail_ = queue_head_;
+            return;
+        }
+        const uint32_t s = cursor_++;
+        if (((map_.measured[s >> 3] >> (s & 7)) & 1u) == 0) {
+            return;
+        }
+        if (point_ == map_.count) {
+            state_ = State::Failed;
+            return;
+        }
+        const uint8_t mx = map_.points[2 * point_];
+        const uint8_t my = map_.points[2 * point_ + 1];
+        ++point_;
+        x_[mx][my] = static_cast<uint8_t>(s >> 8);
+        y_[mx][my] = static_cast<uint8_t>(s);
+        const uint32_t cell = (static_cast<uint32_t>(mx) << 8) | my;
+        set(seed_, cell);
+        if (!test(filled_, cell)) {
+            set(filled_, cell);
+            ++filled_count_;
+        }
+    }
+
+    void seed_next() {
+        if (cursor_ == kCells) {
+            state_ = exact_count_ == 0 ? State::Failed : State::Filling;
+            return;
+        }
+        const uint32_t cell = cursor_++;
+        if (test(seed_, cell)) {
+            ++exact_count_;
+            expand(cell);
+        }
+    }
+
+    void fill_next() {
+        if (queue_count_ == 0) {
+            // 4.では filled_ を値を書いたセルのビットに使う
+            filled_ = seed_;
+            state_ = State::Resolving;
+            cursor_ = 0;
+            return;
+        }
+        const uint32_t slot = queue_head_;
+        const uint32_t cell = (static_cast<uint32_t>(x_[slot >> 8][slot & 0xFFu]) << 8) |
+                              y_[slot >> 8][slot & 0xFFu];
+        queue_head_ = next_slot(slot + 1);
+        --queue_count_;
+        expand(cell);
+    }
+
+    // 親をたどって値を書いたセルまで行き、その値を途中のセルへ書く
+    // たどる長さはシードからの距離まで。どのセルにも書くのは1回だけ
+    void resolve_next() {
+        if (cursor_ == kCells) {
+            state_ = State::Done;
+            return;
+        }
+        const uint32_t cell = cursor_++;
+        uint32_t source = cell;
+        while (!test(filled_, source)) {
+            source = parent(source);
+        }
+        const uint8_t x = x_[source >> 8][source & 0xFFu];
+        const uint8_t y = y_[source >> 8][source & 0xFFu];
+        for (uint32_t c = cell; !test(filled_, c); c = parent(c)) {
+            x_[c >> 8][c & 0xFFu] = x;
+            y_[c >> 8][c & 0xFFu] = y;
+            set(filled_, c);
+        }
+    }
+
+    // 空の4近傍にcellを親として覚え、キューへ積む
+    void expand(uint32_t cell) {
+        const uint32_t mx = cell >> 8;
+        const uint32_t my = cell & 0xFFu;
+        if (mx > 0) {
+            visit(cell - 256, 1);
+        }
+        if (mx < 255) {
+            visit(cell + 256, 0);
+        }
+        if (my > 0) {
+            visit(cell - 1, 3);
+        }
+        if (my < 255) {
+            visit(cell + 1, 2);
+        }
+    }
+
+    // direction は to から見た親の向き（kParentOffset の添字）
+    void visit(uint32_t to, uint32_t direction) {
+        if (test(filled_, to)) {
+            return;
+        }
+        set(filled_, to);
+        ++filled_count_;
+        parent_[to >> 4] |= direction << ((to & 15) * 2);
+        // 積むのはシード以外のセルで、空いた場所は積んだ数より先にある
+        const uint32_t slot = queue_tail_;
+        x_[slot >> 8][slot & 0xFFu] = static_cast<uint8_t>(to >> 8);
+        y_[slot >> 8][slot & 0xFFu] = static_cast<uint8_t>(to);
+        queue_tail_ = next_slot(slot + 1);
+        ++queue_count_;
+        if (queue_count_ > peak_queue_) {
+            peak_queue_ = queue_count_;
+        }
+    }
+
+    ForwardMap map_{};
+    State state_{State::Idle};
+    uint32_t cursor_{0}; // Inverting: 次の s、Seeding と Resolving: 次のセル
+    uint32_t point_{0};  // 読んだpointsの組の数
+    uint32_t exact_count_{0};
+
+    uint8_t x_[256][256]{};
+    uint8_t y_[256][256]{};
+    const InverseLutTable table_{x_, y_};
+
+    std::array<uint32_t, kCells / 32> seed_{};   // 原像が計測にあったセル
+    std::array<uint32_t, kCells / 32> filled_{}; // 値が入ったセル（4.では値を書いたセル）
+    std::array<uint32_t, kCells / 16> parent_{}; // シード以外のセルの親の向き（2ビットずつ）
+    uint32_t filled_count_{0};
+
+    // キューはシード以外のセルの表の2バイト（x_ に上位、y_ に下位）に置く。どちらもセルの番号
+    uint32_t queue_head_{0};
+    uint32_t queue_tail_{0};
+    uint32_t queue_count_{0};
+    uint32_t peak_queue_{0};
+};
+static_assert(sizeof(InverseBuilder) - InverseBuilder::kRamBytes < 256,
+              "kRamBytesに入っていない大きなメンバがある");
+
+} // namespace gcinput::domain::transform::correction
@@ -0,0 +1,351 @@
+// Auto-generated by tools/generate_inverse_lut.py --format folded
+// Source: resources/switch2/20260205/readings.csv
+// Generated: 2026-10-18T09:31:34Z
+// Symmetry: octant, tolerance 0 (max error 0), cells 8256, exceptions 591
+#pragma once
+#include <cstdint>
+
+namespace gcinput::domain::transform::correction {
+
+inline constexpr bool kFoldedLutOctant = true;
+inline constexpr uint16_t kFoldedExceptionCount = 591;
+
+// clang-format off
+inline constexpr uint8_t kFoldedLutX[8256] = {
+  143,
+  144,144,
+  144,144,144,
+  145,145,145,145,
+  145,145,145,145,145,
+  146,146,146,146,146,146,
+  146,146,146,146,146,146,146,
+  147,147,147,147,147,147,147,147,
+  148,148,148,148,148,148,148,148,148,
+  148,148,148,148,148,148,148,148,148,148,
+  149,149,149,149,149,149,149,149,149,149,149,
+  149,149,149,149,149,149,149,149,149,149,149,149,
+  150,150,150,150,150,150,150,150,150,150,150,150,150,
+  150,150,150,150,150,150,150,150,150,150,150,150,150,150,
+  151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,
+  151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,
+  152,152,152,152,152,152,152,152,152,152,152,152,152,152,152,152,152,
+  153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,
+  153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,153,
+  154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,
+  154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,154,
+  155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,
+  155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,155,
+  156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,156,
+  157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,
+  157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,157,
+  158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,
+  158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,158,
+  159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,
+  159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,159,
+  160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,
+  160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,160,
+  161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,161,
+  162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,
+  162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,162,
+  163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,
+  163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,163,
+  164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,
+  164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,164,
+  165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,
+  165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,165,
+  166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,166,
+  167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,
+  167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,167,
+  168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,
+  168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,168,
+  169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,
+  169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,169,
+  170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,170,
+  171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,
+  171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,171,
+  172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,
+  172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,172,
+  173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,
+  173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,173,
+  174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,
+  174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,174,
+  175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,175,
+  176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,
+  176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,176,
+  177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,
+  177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,177,
+  178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,
+  178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,178,
+  179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,
+  179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,179,
+  180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,180,
+  181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,
+  181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,181,
+  182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,
+  182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,182,255,
+  183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,255,255,193,193,
+  183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,183,255,255,183,193,193,193,193,
+  184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,184,218,255,255,252,183,183,193,193,193,193,193,
+  185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,255,219,219,184,183,252,183,183,193,193,193,193,193,193,
+  185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,185,255,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,
+  186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,255,255,254,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,
+  186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,186,255,187,187,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,
+  187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,255,255,255,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,
+  187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,187,188,188,254,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,
+  188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,255,229,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,
+  188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,188,255,255,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,189,255,255,189,189,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,255,254,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,190,191,191,255,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,255,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,191,192,255,255,255,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,193,255,255,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,192,255,253,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,196,196,255,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,255,255,255,255,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  194,194,194,194,194,194,194,194,194,194,194,194,194,194,194,194,194,194,194,255,255,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  195,195,195,195,195,195,195,195,195,195,195,195,195,195,195,195,195,251,251,255,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  195,195,195,195,195,195,195,195,195,195,195,195,195,195,195,255,255,255,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  196,196,196,196,196,196,196,196,196,196,196,196,255,255,255,255,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  196,196,196,196,196,196,196,196,198,198,255,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  197,197,197,197,197,197,197,255,255,255,255,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  197,197,197,197,255,255,255,255,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,255,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  255,255,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  255,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+  198,209,255,255,199,255,255,196,255,255,196,255,196,255,255,195,255,251,194,194,193,255,193,255,255,192,255,194,193,255,192,255,192,255,190,255,255,190,255,190,189,189,189,188,188,191,255,187,255,187,255,255,186,255,187,186,186,186,185,186,185,185,218,218,184,183,252,183,183,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,
+};
+// clang-format on
+
+// clang-format off
+inline constexpr uint8_t kFoldedLutY[8256] = {
+  143,
+  143,144,
+  143,144,144,
+  143,144,144,145,
+  143,144,144,145,145,
+  143,144,144,145,145,146,
+  143,144,144,145,145,146,146,
+  143,144,144,145,145,146,146,147,
+  143,144,144,145,145,146,146,147,148,
+  143,144,144,145,145,146,146,147,148,148,
+  143,144,144,145,145,146,146,147,148,148,149,
+  143,144,144,145,145,146,146,147,148,148,149,149,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,181,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,181,181,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,181,181,182,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,181,181,182,255,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,180,181,250,252,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,178,179,179,246,247,181,192,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,177,178,208,241,244,242,181,181,192,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,176,177,236,207,208,179,179,242,181,181,192,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,174,175,176,231,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,173,174,226,229,229,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,172,173,222,174,175,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,169,170,171,171,172,218,220,220,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,169,170,171,212,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,168,168,209,194,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,166,167,167,204,206,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,165,165,200,201,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,163,164,164,197,197,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,160,161,162,162,163,164,193,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,161,161,162,189,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,159,160,161,186,187,187,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,158,159,182,183,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,156,157,157,158,179,179,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,155,157,158,175,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,154,154,155,171,173,174,174,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,153,153,168,169,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,151,152,164,165,167,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,150,150,151,162,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,148,149,149,158,159,161,161,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,147,148,149,156,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,145,146,146,153,154,155,155,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,144,145,149,150,151,151,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,147,148,149,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  144,145,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+  143,144,146,148,146,150,151,147,154,155,149,157,150,159,161,152,163,164,153,154,154,170,156,173,174,157,176,159,159,180,160,184,162,187,162,190,191,164,194,165,165,166,167,167,168,170,207,169,212,171,215,216,172,220,174,174,174,175,176,177,177,177,207,208,179,179,242,181,181,192,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,193,192,
+};
+// clang-format on
+
+// clang-format off
+inline constexpr uint16_t kFoldedExceptionCells[591] = {
+  7296,7552,7553,7554,7802,7803,7804,7806,7810,7812,7813,7814,8059,8062,8066,8068,8069,8070,8071,8310,8314,8316,8324,8326,8328,8330,8566,8570,8572,8580,8582,8585,
+  8586,8587,8817,8819,8821,8823,8841,8843,8845,8847,9071,9072,9075,9077,9079,9097,9099,9101,9103,9104,9105,9326,9329,9359,9362,9363,9580,9582,9618,9620,9831,9833,
+  9836,9838,9874,9876,9878,9879,9881,10087,10090,10134,10137,10340,10343,10346,10390,10393,10395,10396,10397,10595,10597,10651,10653,10846,10847,10851,10853,10907,10909,10912,10913,10914,
+  11102,11105,11167,11170,11171,11355,11358,11361,11423,11426,11428,11429,11430,11608,11610,11612,11684,11686,11688,11861,11864,11944,11947,11948,12114,12116,12117,12120,12200,12203,12204,12205,
+  12206,12368,12369,12371,12461,12464,12623,12624,12625,12627,12717,12719,12720,12721,12722,12874,12876,12878,12978,12980,12982,13129,13132,13134,13234,13236,13238,13239,13240,13384,13386,13494,
+  13496,13640,13642,13750,13752,13755,13889,13891,13893,14011,14013,14143,14145,14147,14269,14271,14273,14274,14397,14398,14399,14401,14403,14525,14527,14529,14530,14531,14652,14788,14908,15044,
+  15046,15162,15302,15303,15417,15418,15558,15559,15672,15816,15928,16072,16073,16183,16184,16328,16329,16585,16694,16695,16696,16840,16841,17098,17206,17354,17867,17973,18123,18124,18380,18484,
+  18485,18635,18636,18739,18893,19149,19150,19251,19405,19406,19506,19507,19661,19662,20175,20273,20431,20528,20529,20688,20784,20785,20943,20944,21039,21201,21457,21551,21713,21806,21807,21969,
+  21970,22226,22573,22739,23252,23340,23508,23765,23852,24020,24021,24107,24108,24276,24277,24278,24362,24534,24789,24790,25046,25130,25224,25225,25302,25303,25385,25386,25480,25481,25558,25560,
+  25640,25816,26072,26152,26328,26329,26406,26407,26408,26584,26585,26586,26841,26842,26918,27098,27354,27430,27610,27611,27685,27686,27866,27867,28124,28196,28380,28451,28637,28707,28893,29149,
+  29150,29219,29405,29406,29474,29475,29661,29662,30175,30240,30241,30431,30432,30688,30753,30943,30944,31007,31201,31262,31457,31458,31518,31519,31713,31714,31969,31970,32031,32225,32226,32286,
+  32287,32481,32483,32739,32796,32797,33053,33250,33309,33310,33311,33505,33566,33567,33822,33823,34018,34078,34079,34334,34335,34591,34592,34593,34848,34849,35039,35104,35105,35360,35361,35617,
+  35874,35875,36130,36131,36317,36386,36387,36642,36643,36899,37156,37340,37412,37668,37669,37670,37925,37926,38106,38181,38182,38438,38694,38873,38950,38951,38952,39206,39207,39208,39384,39463,
+  39464,39720,39976,40151,40232,40233,40234,40406,40489,40490,40917,41002,41258,41514,41515,41516,41684,41771,41772,41940,42027,42028,42284,42540,42797,43053,43310,43311,43566,43567,43822,43823,
+  43985,43986,44078,44079,44335,44591,44592,44593,44848,44849,45007,45104,45105,45361,45617,46130,46131,46285,46386,46387,46642,46643,46899,47053,47155,47156,47157,47307,47412,47413,47668,47669,
+  47925,48438,48694,48842,48951,48952,49096,49097,49207,49208,49463,49464,49608,49719,49720,49976,50233,50234,50374,50489,50490,50746,50748,50884,51004,51262,51263,51265,51391,51393,51518,51520,
+  51521,51647,51779,51902,52037,52040,52152,52294,52296,52554,52556,52660,52663,52812,52918,53070,53071,53073,53167,53328,53329,53330,53331,53588,53589,53675,53847,53848,53931,54104,54105,54106,
+  54363,54366,54434,54435,54622,54624,54687,54880,54881,54883,54941,54946,55139,55196,55395,55396,55397,55399,55449,55655,55703,55914,55916,55956,55961,56173,56174,56429,56431,56465,56689,56691,
+  56717,56948,56949,56975,57206,57224,57465,57466,57482,57724,57726,57730,57735,57982,57985,
+};
+// clang-format on
+
+// clang-format off
+inline constexpr uint8_t kFoldedExceptionX[591] = {
+  57,13,57,46,58,56,58,57,57,58,56,58,56,57,57,58,56,58,58,57,58,58,58,58,59,57,55,58,58,58,58,59,
+  55,59,60,59,59,59,59,59,59,60,56,60,59,59,59,59,59,59,60,60,56,60,60,60,60,61,61,60,60,61,59,62,
+  61,60,60,61,62,62,59,62,62,62,62,61,62,62,62,62,63,61,62,63,63,63,63,63,63,63,63,63,63,64,63,63,
+  64,64,64,64,65,64,64,64,64,64,65,64,65,65,65,65,65,65,65,66,65,65,66,67,64,65,66,65,65,66,65,67,
+  64,68,67,67,67,68,67,68,67,67,67,67,68,67,68,69,68,68,68,68,69,68,68,68,68,68,69,68,69,67,69,69,
+  67,67,69,69,67,70,37,69,70,70,69,71,71,69,69,71,71,72,71,72,71,71,69,69,71,71,72,71,70,70,70,70,
+  73,73,73,74,72,72,72,72,74,74,75,75,76,76,75,75,76,77,48,77,77,77,77,78,77,77,79,79,79,80,81,79,
+  79,79,79,81,81,82,82,82,82,83,83,83,83,83,84,84,84,86,85,86,86,85,85,86,85,85,87,87,87,88,87,87,
+  88,89,90,90,91,91,91,92,92,92,93,93,93,93,93,93,93,93,95,94,95,95,96,96,95,96,96,96,97,96,96,96,
+  96,96,97,97,97,98,98,98,98,98,98,98,99,98,99,99,100,100,100,101,101,101,101,101,102,102,102,102,102,103,103,104,
+  104,104,104,105,105,105,105,105,106,106,106,106,106,107,107,107,108,109,109,109,109,109,109,109,109,109,110,110,110,110,111,111,
+  111,111,111,112,143,144,145,144,146,147,147,147,148,148,148,149,148,150,150,152,152,152,153,153,154,154,148,155,149,155,156,157,
+  158,158,160,160,159,161,161,161,162,163,165,165,166,167,168,168,169,169,169,170,170,172,173,156,174,158,158,174,175,175,175,177,
+  177,179,180,159,181,182,182,182,183,183,160,186,188,188,189,189,189,190,190,163,192,164,193,195,197,198,200,200,201,201,203,203,
+  203,203,168,204,207,208,209,209,210,210,194,213,171,212,215,219,219,218,221,221,221,223,225,224,175,227,227,226,229,229,230,230,
+  232,237,239,238,179,179,179,179,242,242,244,244,244,245,247,248,251,251,250,253,253,255,255,255,255,255,255,185,185,255,252,255,
+  185,185,255,255,255,255,255,254,255,255,255,255,255,255,255,255,254,188,188,255,229,255,255,255,255,255,255,255,255,254,255,255,
+  255,255,255,190,255,191,191,255,192,255,255,255,255,192,255,253,255,255,255,255,193,255,255,255,255,255,255,255,255,255,255,255,
+  255,255,255,255,255,196,255,255,255,255,255,255,255,255,198,
+};
+// clang-format on
+
+// clang-format off
+inline constexpr uint8_t kFoldedExceptionY[591] = {
+  143,144,144,145,109,109,111,111,145,145,147,147,109,111,145,146,147,147,147,107,109,110,146,147,148,149,106,109,110,146,147,149,
+  150,150,105,105,106,107,149,150,151,151,102,103,105,106,107,149,150,151,152,153,154,102,104,152,154,154,101,102,154,155,98,99,
+  101,102,154,155,156,157,158,98,100,156,158,96,98,100,156,158,159,160,160,96,97,159,160,93,93,96,97,159,160,162,163,163,
+  93,95,161,163,163,91,93,95,161,163,164,165,165,90,91,92,164,165,166,88,90,166,168,168,85,87,88,90,166,168,169,169,
+  171,86,86,87,169,170,84,85,86,87,169,170,171,172,172,83,83,84,172,173,173,81,83,84,172,173,174,176,175,79,82,174,
+  177,79,82,174,177,177,48,77,79,177,179,76,77,77,179,179,180,180,74,75,76,77,77,179,179,180,181,182,72,184,72,184,
+  183,73,183,183,70,70,186,186,71,185,72,184,184,71,72,184,185,184,37,71,71,185,185,185,69,187,186,70,186,186,186,67,
+  67,189,189,68,188,187,187,69,187,187,68,68,188,188,188,67,190,68,68,188,67,68,188,189,64,192,190,65,191,66,65,191,
+  190,189,65,191,191,64,193,192,65,191,191,64,64,192,192,192,63,194,191,193,192,64,147,149,192,192,63,63,148,149,193,194,
+  61,196,195,63,195,193,62,62,62,195,195,195,193,198,62,196,196,62,196,194,61,61,197,197,195,60,197,56,203,60,200,198,
+  198,60,198,196,59,59,199,199,200,55,55,206,206,202,59,198,197,59,197,58,199,199,56,56,209,209,202,202,58,202,198,57,
+  57,209,242,242,57,13,13,198,13,13,13,255,13,13,13,13,255,13,13,0,0,0,2,2,3,3,196,4,59,4,5,6,
+  6,6,0,0,255,1,1,1,2,3,4,255,0,1,2,2,2,2,255,3,3,0,1,193,2,60,60,2,3,3,255,0,
+  0,2,0,192,0,1,1,255,2,2,191,1,0,0,1,1,255,2,2,190,0,65,1,0,1,0,1,1,1,1,1,1,
+  255,255,67,1,0,0,1,1,0,0,229,0,68,2,1,0,0,255,0,0,0,0,0,255,69,0,0,255,1,1,0,0,
+  0,0,0,255,71,71,185,185,0,0,1,1,255,0,0,0,0,0,255,0,0,1,6,250,6,11,11,77,179,246,14,17,
+  77,179,22,238,26,31,226,27,31,35,39,218,224,39,222,43,44,85,171,46,62,48,48,52,52,204,56,56,203,59,61,61,
+  64,68,189,163,68,95,160,71,95,75,182,189,75,159,76,77,79,81,175,81,156,85,87,169,175,88,88,90,91,165,94,97,
+  159,98,98,162,100,148,104,104,156,107,109,147,153,109,144,
+};
+// clang-format on
+
+} // namespace gcinput::domain::transform::correction
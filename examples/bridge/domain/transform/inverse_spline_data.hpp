@@ -0,0 +1,149 @@
+// Auto-generated by tools/fit_inverse_spline.py
+// Source: resources/switch2/20260205/readings.csv
+// Generated: 2026-10-18T09:40:52Z
+// Knot spacing 16, smoothing 0.001, seeds 9508, 2064 bytes
+// round trip max=  5.00 mean= 0.84 p95= 1.41 p99= 2.24 (table: max=  2.00 mean= 0.74 p95= 1.41 p99= 1.41)
+#pragma once
+#include <cstdint>
+
+namespace gcinput::domain::transform::correction {
+
+inline constexpr uint8_t kSplineShift = 4;
+inline constexpr uint8_t kSplineControlPoints = 11;
+
+// clang-format off
+inline constexpr int16_t kSplineWeights[16][4] = {
+  {683,2730,683,0},
+  {562,2716,818,0},
+  {457,2671,967,1},
+  {366,2601,1125,4},
+  {288,2506,1291,11},
+  {222,2393,1460,21},
+  {167,2262,1631,36},
+  {122,2118,1799,57},
+  {85,1963,1963,85},
+  {57,1799,2118,122},
+  {36,1631,2262,167},
+  {21,1460,2393,222},
+  {11,1291,2506,288},
+  {4,1125,2601,366},
+  {1,967,2671,457},
+  {0,818,2716,562},
+};
+// clang-format on
+
+// clang-format off
+inline constexpr int16_t kSplineX[4][11][11] = {
+  {
+    {-1024,-1024,-1024,-1024,-1024,-1024,-1024,-1024,-795,-333,73},
+    {-1024,-1024,-1024,-1024,-1024,-1024,-1024,-499,-110,100,284},
+    {-1024,-1024,-1024,-1024,-1024,-954,-132,312,537,527,552},
+    {-1024,-1024,-1024,-1024,-822,-32,823,942,964,997,944},
+    {-1024,-1024,-1024,-574,551,1095,1138,1073,1090,1057,1122},
+    {-1024,-1024,-341,375,1256,1276,1193,1243,1224,1247,1210},
+    {-785,-101,610,1300,1412,1336,1396,1364,1377,1364,1379},
+    {171,693,1179,1517,1506,1532,1507,1520,1516,1520,1523},
+    {1044,1311,1543,1675,1661,1651,1664,1658,1658,1657,1656},
+    {1834,1816,1788,1801,1801,1816,1801,1806,1807,1809,1803},
+    {2576,2297,2065,1950,1928,1895,1931,1928,1911,1914,1930},
+  },
+  {
+    {-1024,-1024,-1024,-1024,-1024,-1024,-1024,-1024,-1024,-1024,-1024},
+    {-1024,-1024,-383,-200,-554,-1024,-1024,-1024,-1024,-1024,-1024},
+    {-1024,-37,786,597,111,-646,-1024,-1024,-1024,-1024,-1024},
+    {624,1195,878,982,785,16,-669,-1024,-1024,-1024,-1024},
+    {1254,988,1116,1063,1145,1086,559,-479,-1024,-1024,-1024},
+    {1186,1272,1216,1246,1192,1279,1252,391,-258,-898,-1024},
+    {1378,1354,1380,1363,1396,1336,1413,1297,630,-42,-678},
+    {1525,1525,1515,1520,1507,1532,1506,1517,1167,684,180},
+    {1655,1653,1659,1658,1664,1651,1661,1679,1503,1267,999},
+    {1805,1814,1807,1806,1801,1817,1800,1801,1769,1776,1768},
+    {1910,1897,1911,1931,1930,1894,1924,1972,2093,2282,2504},
+  },
+  {
+    {1573,1796,1988,2079,2106,2166,2118,2114,2140,2148,2150},
+    {2381,2334,2310,2315,2301,2284,2300,2299,2293,2290,2294},
+    {3221,2908,2603,2390,2438,2441,2432,2431,2437,2438,2440},
+    {4101,3575,3089,2649,2573,2574,2585,2586,2577,2578,2566},
+    {5019,4321,3592,2844,2681,2756,2702,2719,2722,2732,2713},
+    {5104,5104,4384,3618,2847,2828,2899,2878,2866,2849,2899},
+    {5104,5104,5104,4497,3451,3004,2957,2967,3020,3042,2917},
+    {5104,5104,5104,5104,4760,3996,3351,3381,3044,3153,3082},
+    {5104,5104,5104,5104,5104,5104,4722,4461,3735,3477,3335},
+    {5104,5104,5104,5104,5104,5104,5104,5104,4622,4020,3518},
+    {5104,5104,5104,5104,5104,5104,5104,5104,5104,4594,3712},
+  },
+  {
+    {2161,2159,2139,2112,2119,2166,2106,2080,1995,1828,1639},
+    {2291,2286,2293,2299,2300,2284,2301,2314,2310,2350,2417},
+    {2442,2441,2436,2431,2432,2441,2438,2390,2604,2907,3218},
+    {2566,2574,2579,2586,2585,2574,2573,2648,3083,3546,4039},
+    {2712,2741,2719,2720,2702,2757,2679,2862,3568,4236,4866},
+    {2927,2825,2875,2875,2900,2825,2852,3593,4293,4983,5104},
+    {2789,3107,2994,2977,2950,3014,3443,4398,5104,5104,5104},
+    {3427,2962,3128,3348,3382,3948,4611,5104,5104,5104,5104},
+    {5104,3981,3502,4205,4500,4932,5104,5104,5104,5104,5104},
+    {5104,5104,4869,5062,5104,5104,5104,5104,5104,5104,5104},
+    {5104,5104,5104,5104,5104,5104,5104,5104,5104,5104,5104},
+  },
+};
+// clang-format on
+
+// clang-format off
+inline constexpr int16_t kSplineY[4][11][11] = {
+  {
+    {-1024,-1024,-1024,-1024,-1024,-1024,-785,171,1044,1834,2576},
+    {-1024,-1024,-1024,-1024,-1024,-1024,-101,693,1311,1816,2297},
+    {-1024,-1024,-1024,-1024,-1024,-341,610,1179,1543,1788,2065},
+    {-1024,-1024,-1024,-1024,-574,375,1300,1517,1675,1801,1950},
+    {-1024,-1024,-1024,-822,551,1256,1412,1506,1661,1801,1928},
+    {-1024,-1024,-954,-32,1095,1276,1336,1532,1651,1816,1895},
+    {-1024,-1024,-132,823,1138,1193,1396,1507,1664,1801,1931},
+    {-1024,-499,312,942,1073,1243,1364,1520,1658,1806,1928},
+    {-795,-110,537,964,1090,1224,1377,1516,1658,1807,1911},
+    {-333,100,527,997,1057,1247,1364,1520,1657,1809,1914},
+    {73,284,552,944,1122,1210,1379,1523,1656,1803,1930},
+  },
+  {
+    {1574,2295,3066,3917,4845,5104,5104,5104,5104,5104,5104},
+    {1824,2301,2792,3397,4174,5104,5104,5104,5104,5104,5104},
+    {2026,2324,2553,2913,3475,4414,5104,5104,5104,5104,5104},
+    {2113,2297,2420,2578,2795,3718,4652,5104,5104,5104,5104},
+    {2126,2299,2434,2591,2684,2841,3544,4907,5104,5104,5104},
+    {2161,2284,2443,2565,2759,2820,3000,4131,5060,5104,5104},
+    {2124,2299,2431,2589,2700,2903,2959,3267,4271,5104,5104},
+    {2132,2293,2436,2577,2731,2853,3021,3162,3897,4899,5104},
+    {2146,2292,2437,2579,2721,2869,3014,3101,3847,4701,5104},
+    {2149,2289,2439,2575,2736,2841,3054,3067,3954,4601,5104},
+    {2149,2292,2441,2573,2716,2892,2981,3029,3682,4375,5018},
+  },
+  {
+    {-1024,-1024,-1024,670,1304,1170,1384,1529,1656,1804,1907},
+    {-1024,-1024,124,1133,990,1270,1354,1523,1654,1814,1894},
+    {-1024,-757,595,967,1102,1222,1377,1518,1658,1807,1915},
+    {-1024,-949,-93,754,1117,1222,1375,1511,1663,1801,1951},
+    {-1024,-1024,-385,737,1143,1196,1394,1512,1663,1801,1937},
+    {-1024,-1024,-835,139,1083,1272,1338,1523,1654,1816,1890},
+    {-1024,-1024,-1024,-522,653,1243,1419,1523,1657,1799,1953},
+    {-1024,-1024,-1024,-1024,-302,507,1228,1449,1704,1783,1989},
+    {-1024,-1024,-1024,-1024,-1012,-199,524,1013,1491,1804,2106},
+    {-1024,-1024,-1024,-1024,-1024,-893,-143,553,1199,1771,2301},
+    {-1024,-1024,-1024,-1024,-1024,-1024,-773,64,898,1716,2515},
+  },
+  {
+    {2161,2291,2441,2566,2712,2926,2791,3432,5104,5104,5104},
+    {2159,2286,2441,2574,2741,2826,3107,2960,3981,5104,5104},
+    {2139,2293,2436,2578,2719,2874,2994,3130,3500,4868,5104},
+    {2112,2299,2431,2586,2720,2875,2977,3345,4206,5064,5104},
+    {2120,2299,2432,2585,2702,2900,2952,3376,4498,5104,5104},
+    {2166,2284,2441,2574,2757,2825,3013,3952,4936,5104,5104},
+    {2105,2302,2438,2573,2678,2852,3444,4616,5104,5104,5104},
+    {2077,2315,2390,2650,2864,3592,4398,5104,5104,5104,5104},
+    {1994,2310,2604,3083,3569,4294,5104,5104,5104,5104,5104},
+    {1828,2350,2907,3545,4236,4984,5104,5104,5104,5104,5104},
+    {1639,2417,3218,4038,4866,5104,5104,5104,5104,5104,5104},
+  },
+};
+// clang-format on
+
+} // namespace gcinput::domain::transform::correction
@@ -1,5 +1,6 @@
 #pragma once
 #include "domain/state.hpp"
+#include "domain/transform/pipeline_profiler.hpp"
 #include <array>
 #include <atomic>
 #include <cstddef>
@@ -14,6 +15,9 @@ using TransformFunction = void (*)(void *user, domain::PadState &state);
 struct Stage {
     TransformFunction func{nullptr};
     void *user{nullptr};
+    // このステージが書き換えうるフィールド（domain::input_fieldのビット）
+    // 申告より広く書き換えると応答に反映されないことがあるので、迷ったらkAllのままにする
+    uint16_t writes{domain::input_field::kAll};
 };
 
 template <class Context, void (*Func)(Context &, domain::PadState &)>
@@ -23,17 +27,19 @@ inline void thunk(void *user, domain::PadState &state) {
 }
 
 template <class Context, void (*Func)(Context &, domain::PadState &)>
-inline Stage make_stage(Context &context) {
+inline Stage make_stage(Context &context, uint16_t writes = domain::input_field::kAll) {
     return Stage{
         .func{&thunk<Context, Func>},
         .user{&context},
+        .writes{writes},
     };
 }
 
-inline Stage make_stage(TransformFunction func) {
+inline Stage make_stage(TransformFunction func, uint16_t writes = domain::input_field::kAll) {
     return Stage{
         .func{func},
         .user{nullptr},
+        .writes{writes},
     };
 }
 
@@ -82,8 +88,20 @@ class Pipeline {
         return (enabled & (1u << index)) != 0;
     }
 
-    void apply_from_isr(domain::PadState &state) const {
+    // ステージごとの時間と中間値を取る（nullptrで外す）。profilerはパイプラインより長く生かす
+    void set_profiler(PipelineProfiler *profiler) {
+        profiler_.store(profiler, std::memory_order_release);
+    }
+
+    // 実行したステージが書き換えうるフィールドの和集合を返す
+    // 0なら入力をそのまま素通しした（有効なステージがない）
+    uint16_t apply_from_isr(domain::PadState &state) const {
         const uint32_t enabled = enable_mask_.load(std::memory_order_acquire);
+        if (PipelineProfiler *profiler = profiler_.load(std::memory_order_acquire);
+            profiler != nullptr) {
+            return apply_profiled(state, enabled, *profiler);
+        }
+        uint16_t written = 0;
         for (std::size_t i = 0; i < stage_count_; ++i) {
             // is_stage_enabledでもいいけどISR内で何度もenabledをload()しなくて済むよう直接確認
             if ((enabled & (1u << i)) == 0) {
@@ -94,13 +112,59 @@ class Pipeline {
                 continue;
             }
             stage.func(stage.user, state);
+            written |= stage.writes;
         }
+        return written;
     }
 
   private:
+    static_assert(kMaxStages <= PipelineProfiler::kMaxStages);
+
+    // apply_from_isrと同じ順にステージを実行し、ステージの間でカウンタを読む
+    // 無効なステージを飛ばす時間は次に実行したステージに入る
+    uint16_t apply_profiled(domain::PadState &state, uint32_t enabled,
+                            PipelineProfiler &profiler) const {
+        const bool capture = profiler.begin_call();
+        const bool timing = profiler.timing();
+        auto &analog = state.input.analog;
+        PipelineProfiler::Capture captured{};
+        if (capture) {
+            captured.input = {analog.stick_x, analog.stick_y};
+        }
+        const uint32_t call_start = timing ? profiler.now() : 0;
+        uint32_t start = call_start;
+        uint16_t written = 0;
+        for (std::size_t i = 0; i < stage_count_; ++i) {
+            if ((enabled & (1u << i)) == 0) {
+                continue;
+            }
+            const Stage &stage = stages_[i];
+            if (!stage.func) {
+                continue;
+            }
+            stage.func(stage.user, state);
+            written |= stage.writes;
+            if (timing) {
+                const uint32_t end = profiler.now();
+                profiler.record_stage(i, start, end);
+                start = end;
+            }
+            if (capture) {
+                captured.executed |= 1u << i;
+                captured.stages[i] = {analog.stick_x, analog.stick_y};
+            }
+        }
+        profiler.end_call(call_start, start);
+        if (capture) {
+            profiler.push_capture(captured);
+        }
+        return written;
+    }
+
     std::array<Stage, kMaxStages> stages_{};
     std::size_t stage_count_ = 0;
     std::atomic<uint32_t> enable_mask_{0};
+    std::atomic<PipelineProfiler *> profiler_{nullptr};
 };
 
 // 何もしない空のパイプラインを返す
@@ -0,0 +1,129 @@
+#pragma once
+#include "util/spsc_ring.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Pipeline::apply_from_isr のステージごとの時間と中間値
+// Pipeline::set_profiler() で付けたときだけ使い、付けなければISRの経路は変わらない
+//
+// 時間は counter（bridge は SysTick、ホストは偽のカウンタ）の差を counter_mask で折り返したもの。
+// 各ステージの値にはカウンタを1回読む時間も入る
+// 集計はISRだけが書き、mainは snapshot() で読む（途中でISRが書いたら読み直す）
+// 中間値は request_capture() の次の呼び出しで、入力と各ステージの後のスティックをリングへ積む
+namespace gcinput::domain::transform {
+
+class PipelineProfiler {
+  public:
+    static constexpr std::size_t kMaxStages = 16;
+    static constexpr std::size_t kCaptureDepth = 4;
+    // snapshot() に渡すと呼び出し全体の集計
+    static constexpr std::size_t kTotal = kMaxStages;
+
+    using CycleCounter = uint32_t (*)();
+
+    struct Stats {
+        uint32_t count{0};
+        uint32_t min{0};
+        uint32_t max{0};
+        uint64_t sum{0};
+
+        uint32_t mean() const { return count == 0 ? 0 : static_cast<uint32_t>(sum / count); }
+        void add(uint32_t cycles) {
+            if (count == 0 || cycles < min) {
+                min = cycles;
+            }
+            if (cycles > max) {
+                max = cycles;
+            }
+            sum += cycles;
+            ++count;
+        }
+    };
+
+    struct Stick {
+        uint8_t x{0};
+        uint8_t y{0};
+    };
+
+    struct Capture {
+        uint32_t executed{0};                   // 実行したステージのビット
+        Stick input{};                          // 最初のステージの前
+        std::array<Stick, kMaxStages> stages{}; // ステージの後（executedのビットだけ有効）
+    };
+
+    // counterがnullptrなら時間は測らず、中間値だけ取る
+    explicit PipelineProfiler(CycleCounter counter = nullptr, uint32_t counter_mask = 0xFFFF'FFFFu)
+        : counter_(counter), mask_(counter_mask) {}
+
+    // ── Pipeline から（ISR） ──
+    bool timing() const { return counter_ != nullptr; }
+    uint32_t now() const { return counter_(); }
+
+    // 呼び出しの始め。中間値を取る回ならtrue
+    // フラグはmainがtrueにしてISRがfalseに戻すだけなので、同じコアでは読んで書くだけで済む
+    bool begin_call() {
+        if (reset_requested_.load(std::memory_order_acquire)) {
+            reset_requested_.store(false, std::memory_order_relaxed);
+            stages_.fill(Stats{});
+            total_ = Stats{};
+        }
+        seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        const bool capture = capture_requested_.load(std::memory_order_acquire);
+        if (capture) {
+            capture_requested_.store(false, std::memory_order_relaxed);
+        }
+        return capture;
+    }
+
+    void record_stage(std::size_t stage, uint32_t start, uint32_t end) {
+        stages_[stage].add((end - start) & mask_);
+    }
+
+    // 呼び出しの終わり。startとendは最初と最後に読んだカウンタ（timing()のときだけ数える）
+    void end_call(uint32_t start, uint32_t end) {
+        if (timing()) {
+            total_.add((end - start) & mask_);
+        }
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void push_capture(const Capture &capture) { captures_.push(capture); }
+
+    // ── main から ──
+    // ステージの集計（kTotalなら呼び出し全体）
+    Stats snapshot(std::size_t stage) const {
+        while (true) {
+            const uint32_t before = seq_.load(std::memory_order_acquire);
+            const Stats stats = (stage == kTotal) ? total_ : stages_[stage];
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            if ((before & 1u) == 0 && seq_.load(std::memory_order_acquire) == before) {
+                return stats;
+            }
+        }
+    }
+
+    // 次の呼び出しで集計を消す
+    void reset() { reset_requested_.store(true, std::memory_order_release); }
+    // 次の呼び出しの中間値を取る
+    void request_capture() { capture_requested_.store(true, std::memory_order_release); }
+    bool pop_capture(Capture &out) { return captures_.pop(out); }
+    // リングが一杯で捨てた中間値の数
+    uint32_t dropped_captures() const { return captures_.dropped(); }
+
+  private:
+    CycleCounter counter_;
+    uint32_t mask_;
+
+    std::array<Stats, kMaxStages> stages_{};
+    Stats total_{};
+    std::atomic<uint32_t> seq_{0}; // ISRが書いている間は奇数
+    std::atomic<bool> reset_requested_{false};
+    std::atomic<bool> capture_requested_{false};
+    SpscRing<Capture, kCaptureDepth> captures_{};
+};
+
+} // namespace gcinput::domain::transform
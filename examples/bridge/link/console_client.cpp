@@ -2,6 +2,7 @@
 #include "domain/transform/pipeline.hpp"
 #include "joybus/codec/identity_wire.hpp"
 #include "joybus/codec/state_wire.hpp"
+#include "pico/stdlib.h"
 
 namespace gcinput {
 
@@ -22,7 +23,8 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
     }
 
     auto *self = static_cast<ConsoleClient *>(user);
-    self->link_.shared_console().on_request_isr(std::span<const uint8_t>(rx, rx_len));
+    self->link_.shared_console().on_request_isr(std::span<const uint8_t>(rx, rx_len),
+                                                time_us_32());
 
     if (!self->link_.is_pad_ready()) {
         return 0;
@@ -45,11 +47,32 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
     switch (cmd) {
     case joybus::Command::Status: {
         const domain::PadState original_state = original_snapshot.status;
-        original_reply = joybus::state_wire::encode_status(original_state, host_poll_mode);
-
         domain::PadState modified_state = original_state;
-        pipelines.status.apply_from_isr(modified_state);
-        modified_reply = joybus::state_wire::encode_status(modified_state, host_poll_mode);
+        const uint16_t written = pipelines.status.apply_from_isr(modified_state);
+
+        if (original_snapshot.has_status_raw &&
+            original_snapshot.status_raw_poll_mode == host_poll_mode) {
+            // パッドへの問い合わせとコンソールの指定が同じPollModeなら受信したバイト列をそのまま使い、
+            // ステージが書き換えたフィールドのバイトだけを作り直す（何も書き換えなければ素通し）
+            auto bytes = original_snapshot.status_raw;
+            joybus::state_wire::fix_up_raw_status(bytes);
+            original_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+            if (written != 0) {
+                host_console.status_patcher(modified_state.input, written, bytes);
+            }
+            modified_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+            break;
+        }
+
+        // コンソールの指定したPollModeで作り直す。加工後の応答はステージが書き換えたフィールドの
+        // バイトだけを書き換える
+        std::array<uint8_t, joybus::kStatusResponseSize> bytes{};
+        host_console.status_patcher(original_state.input, domain::input_field::kAll, bytes);
+        original_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+        if (written != 0) {
+            host_console.status_patcher(modified_state.input, written, bytes);
+        }
+        modified_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
         break;
     }
     case joybus::Command::Origin: {
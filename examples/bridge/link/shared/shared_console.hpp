@@ -1,12 +1,27 @@
 #pragma once
+#include "joybus/codec/state_wire.hpp"
 #include "joybus/protocol/protocol.hpp"
+#include "util/frame_cadence.hpp"
 #include "util/latest_slot.hpp"
 #include <span>
 
 namespace gcinput {
 
+// コンソールのStatus要求から数えたフレーム
+// 1フレームに何回か要求するゲームもあるので、間がsame_frame_usより短い要求は同じフレームとみなす
+// same_frame_usは要求の間隔から見積もる（util/frame_cadence.hpp）
+struct ConsoleFrameClock {
+    uint32_t frames = 0;        // 数えたフレーム数（最初の要求で1）
+    uint32_t polls = 0;         // 受けたStatus要求の数（framesと比べて1フレームあたりの回数を出す）
+    uint32_t last_poll_us = 0;  // 最後のStatus要求を受けた時刻
+    uint32_t same_frame_us = 0; // 今の見積もりで同じフレームとみなす間隔
+};
+
 struct ConsoleState {
     domain::PollMode poll_mode = domain::PollMode::Mode3;
+    // poll_modeに対応するStatusレスポンスのエンコーダ。PollModeが変わったときだけ引き直す
+    joybus::state_wire::StatusPatcher status_patcher =
+        joybus::state_wire::status_patcher_for(domain::PollMode::Mode3);
     domain::RumbleMode rumble_mode = domain::RumbleMode::Off;
     uint16_t reset_count = 0;
 };
@@ -14,11 +29,15 @@ struct ConsoleState {
 class SharedConsole {
   public:
     ConsoleState load() const { return latch_.load(); }
+    ConsoleFrameClock load_frame_clock() const { return frame_clock_.load(); }
 
-    void on_request_isr(std::span<const uint8_t> rx) {
+    void on_request_isr(std::span<const uint8_t> rx, uint32_t now_us) {
         if (rx.empty()) {
             return;
         }
+        if (static_cast<joybus::Command>(rx[0]) == joybus::Command::Status) {
+            count_frame_isr(now_us);
+        }
 
         bool updated = false;
         joybus::Command command = static_cast<joybus::Command>(rx[0]);
@@ -28,6 +47,9 @@ class SharedConsole {
                 const auto poll = joybus::sanitize_poll_mode(rx[1]);
                 const auto rumble = joybus::sanitize_rumble_mode(rx[2]);
                 if (poll != shadow_.poll_mode || rumble != shadow_.rumble_mode) {
+                    if (poll != shadow_.poll_mode) {
+                        shadow_.status_patcher = joybus::state_wire::status_patcher_for(poll);
+                    }
                     shadow_.poll_mode = poll;
                     shadow_.rumble_mode = rumble;
                     updated = true;
@@ -51,8 +73,21 @@ class SharedConsole {
     }
 
   private:
+    void count_frame_isr(uint32_t now_us) {
+        if (cadence_.on_poll(now_us)) {
+            frame_shadow_.frames++;
+        }
+        frame_shadow_.polls++;
+        frame_shadow_.last_poll_us = now_us;
+        frame_shadow_.same_frame_us = cadence_.same_frame_us();
+        frame_clock_.publish(frame_shadow_);
+    }
+
     ConsoleState shadow_{};
     LatestSlot<ConsoleState> latch_{};
+    FrameCadence cadence_{};
+    ConsoleFrameClock frame_shadow_{};
+    LatestSlot<ConsoleFrameClock> frame_clock_{};
 };
 
 } // namespace gcinput
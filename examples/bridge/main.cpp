@@ -1,7 +1,12 @@
+#include "calibration/profile_commands.hpp"
+#include "calibration/profile_store.hpp"
+#include "calibration/profile_upload.hpp"
 #include "domain/state.hpp"
 #include "domain/transform/builtins.hpp"
 #include "domain/transform/correction.hpp"
+#include "domain/transform/inverse_builder.hpp"
 #include "domain/transform/pipeline.hpp"
+#include "domain/transform/pipeline_profiler.hpp"
 #include "hardware/pio.h"
 #include "joybus/driver/joybus_pio_port.hpp"
 #include "joybus_console.pio.h"
@@ -9,9 +14,16 @@
 #include "link/console_client.hpp"
 #include "link/pad_client.hpp"
 #include "link/shared/shared_pad_hub.hpp"
+#include "logging/log.hpp"
 #include "pico/bootrom.h"
 #include "pico/stdlib.h"
+#include "telemetry/emit.hpp"
+#include "util/job_scheduler.hpp"
+#include "util/systick_counter.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <cstdio>
+#include <iterator>
 
 namespace {
 // 通電確認用のオンボードLED
@@ -40,7 +52,9 @@ void handle_boot_btn_if_requested() {
     // デバウンス: 依然として押下中かを確認
     busy_wait_ms(100);
     if (gpio_get(BOOT_BTN_PIN) == 0) {
-        printf("BOOTSEL button pressed. Entering USB boot mode...\n");
+        gcinput::logging::info("BOOTSEL button pressed. Entering USB boot mode...\n");
+        // キューに残っているログを送り切ってからリセットする
+        gcinput::logging::flush_blocking(100'000);
         reset_usb_boot(0, 0);
     }
 }
@@ -61,6 +75,289 @@ void init_led() {
 // 原点正規化コンテキスト（main から更新、ISR から参照）
 gcinput::domain::transform::correction::OriginOffsetContext origin_ctx{};
 
+// 逆変換テーブルの切り替えコンテキスト（main から更新、ISR から参照）
+gcinput::domain::transform::correction::InverseLutContext inverse_ctx{};
+// Status パイプラインのプロファイル。Offならプロファイラを付けず、ISRの経路は変わらない
+// Capture: デバッグログへ出すステージごとの中間値だけ取る
+// Cycles: さらに SysTick でステージごとのサイクル数を数え、kProfileLogIntervalUs ごとにログへ出す
+enum class PipelineProfile : uint8_t { Off, Capture, Cycles };
+constexpr PipelineProfile kPipelineProfile = PipelineProfile::Off;
+constexpr uint32_t kProfileLogIntervalUs = 5'000'000;
+gcinput::domain::transform::PipelineProfiler status_profiler{
+    kPipelineProfile == PipelineProfile::Cycles ? &gcinput::util::systick_cycles : nullptr,
+    gcinput::util::kSysTickMask};
+// Status パイプラインのステージ名（ログ用、add_stage の順）
+constexpr const char *kStatusStageNames[] = {"fix", "norm", "clamp", "scale", "lut"};
+
+// フラッシュの補正プロファイル
+gcinput::calibration::ProfileStore profile_store{};
+// 順方向の写像のプロファイルから組み立てた逆変換テーブル（RAM）
+// 表 128KB と組み立てに使うビットマップ 32KB を常に持つ。残りは起動時のログ（RAM:）で見る
+gcinput::domain::transform::correction::InverseBuilder inverse_builder{};
+
+// リンカスクリプトが置く、静的な変数の終わり（ヒープの始まり）と、ヒープが伸びてよい終わり
+extern "C" char __end__;
+extern "C" char __StackLimit;
+// 静的な変数のあとに残したいRAM（ヒープ。printf等が使う）。足りなければ起動時に警告する
+constexpr uint32_t kRamHeadroomMin = 16 * 1024;
+
+void log_ram_usage() {
+    const auto static_end = reinterpret_cast<uintptr_t>(&__end__);
+    const auto stack_limit = reinterpret_cast<uintptr_t>(&__StackLimit);
+    const auto free_bytes = static_cast<uint32_t>(stack_limit - static_end);
+    gcinput::logging::info("RAM: %lu KB static (inverse builder %lu KB), %lu KB free\n",
+                           static_cast<uint32_t>((static_end - SRAM_BASE) / 1024),
+                           static_cast<uint32_t>(sizeof(inverse_builder) / 1024),
+                           free_bytes / 1024);
+    if (free_bytes < kRamHeadroomMin) {
+        gcinput::logging::warn("RAM: less than %lu KB left for the heap.\n",
+                               kRamHeadroomMin / 1024);
+    }
+}
+
+// mainループで少しずつ進める重い処理
+using JobScheduler = gcinput::JobScheduler<4>;
+JobScheduler jobs{};
+JobScheduler::Id inverse_build_job{JobScheduler::kInvalid};
+// 逆変換テーブルの組み立てにmainループ1周で使う時間と、1単位で組み立てるセルの数（50µsほど）
+constexpr uint32_t kInverseBuildBudgetUs = 500;
+constexpr uint32_t kInverseBuildStepCells = 128;
+
+bool step_inverse_builder(void *) {
+    using State = gcinput::domain::transform::correction::InverseBuilder::State;
+    const State state = inverse_builder.step(kInverseBuildStepCells);
+    return state != State::Done && state != State::Failed;
+}
+
+JobScheduler::Progress inverse_builder_progress(const void *) {
+    return {.done = inverse_builder.progress(),
+            .total = gcinput::domain::transform::correction::InverseBuilder::kProgressTotal};
+}
+
+// ジョブの時間の使い方をログへ出す
+void log_job(JobScheduler::Id id) {
+    const auto &stats = jobs.stats(id);
+    gcinput::logging::info(
+        "Job %s: %lu slices, %lu us busy, max slice %lu us, %lu overruns (max +%lu us)\n",
+        jobs.name(id), stats.slices, stats.busy_us, stats.max_slice_us, stats.overruns,
+        stats.max_overrun_us);
+}
+
+// ISRが取ったステージごとの中間値をログへ出す。S(out) はコンソールが実際に受け取る期待値
+// ステージの数で長さが変わるので、行をここで整形して中身ごと積む
+void log_capture(const gcinput::domain::transform::PipelineProfiler::Capture &capture,
+                 bool correction) {
+    char line[160];
+    std::size_t length = 0;
+    const auto append = [&](const char *fmt, auto... args) {
+        const int n = std::snprintf(line + length, sizeof(line) - length, fmt, args...);
+        length = std::min(length + static_cast<std::size_t>(n > 0 ? n : 0), sizeof(line) - 1);
+    };
+    append("DBG [%s] origin=(%3u,%3u) raw=(%3u,%3u)", correction ? "COR" : "FIX",
+           origin_ctx.origin_x.load(std::memory_order_acquire),
+           origin_ctx.origin_y.load(std::memory_order_acquire), capture.input.x, capture.input.y);
+    auto out = capture.input;
+    for (std::size_t i = 0; i < std::size(kStatusStageNames); ++i) {
+        if ((capture.executed & (1u << i)) == 0) {
+            continue;
+        }
+        out = capture.stages[i];
+        append(" %s=(%3u,%3u)", kStatusStageNames[i], out.x, out.y);
+    }
+    const auto [sx, sy] = gcinput::domain::transform::correction::forward_lut(out.x, out.y);
+    append(" S(out)=(%3u,%3u)\n", sx, sy);
+    gcinput::logging::text(gcinput::logging::Level::Debug, line, length);
+}
+
+// ステージごとのサイクル数（カウンタを読む時間を含む）をログへ出し、数え直す
+void log_pipeline_profile() {
+    using Profiler = gcinput::domain::transform::PipelineProfiler;
+    for (std::size_t i = 0; i <= std::size(kStatusStageNames); ++i) {
+        const bool total = i == std::size(kStatusStageNames);
+        const auto stats = status_profiler.snapshot(total ? Profiler::kTotal : i);
+        if (stats.count == 0) {
+            continue;
+        }
+        gcinput::logging::info("PROF %-5s n=%lu min=%lu mean=%lu max=%lu cycles\n",
+                               total ? "total" : kStatusStageNames[i], stats.count, stats.min,
+                               stats.mean(), stats.max);
+    }
+    status_profiler.reset();
+}
+
+// 逆変換テーブルを組み立てているプロファイル
+struct PendingProfile {
+    std::size_t profile{gcinput::calibration::ProfileStore::kProfileCount}; // なければkProfileCount
+    bool uploaded{false}; // 書き込んだプロファイル。組み立て終えたらActivatedを返す
+    uint32_t offset{0};
+    uint32_t crc{0};
+};
+PendingProfile pending_profile{};
+
+void log_profile(std::size_t profile, std::size_t active) {
+    const char *mark = profile == active ? "*" : " ";
+    if (profile == gcinput::calibration::ProfileStore::kBuiltinProfile) {
+        const bool spline =
+            profile_store.builtin() == gcinput::calibration::ProfileStore::Builtin::Spline;
+        gcinput::logging::info("Profile %u%s builtin%s\n", static_cast<unsigned>(profile), mark,
+                               spline ? " (spline)" : "");
+        return;
+    }
+    const auto *header = profile_store.header(profile);
+    if (header == nullptr) {
+        gcinput::logging::info("Profile %u%s (empty)\n", static_cast<unsigned>(profile), mark);
+        return;
+    }
+    // 名前はスロットを書き換えると変わるので、ログのキューへは整形した行の中身ごと積む
+    const bool forward = header->kind == gcinput::calibration::ProfileKind::ForwardMap;
+    char line[96];
+    const int n = std::snprintf(line, sizeof(line), "Profile %u%s %s%s source=%08lx created=%lu\n",
+                                static_cast<unsigned>(profile), mark, header->name,
+                                forward ? " (forward)" : "",
+                                static_cast<unsigned long>(header->source_hash),
+                                static_cast<unsigned long>(header->created));
+    const std::size_t length =
+        std::min(static_cast<std::size_t>(n > 0 ? n : 0), sizeof(line) - 1);
+    gcinput::logging::text(gcinput::logging::Level::Info, line, length);
+}
+
+void log_profiles(std::size_t active) {
+    if (!profile_store.available()) {
+        gcinput::logging::warn("Profile: flash region overlaps firmware, builtin only.\n");
+    }
+    for (std::size_t i = 0; i < gcinput::calibration::ProfileStore::kProfileCount; ++i) {
+        log_profile(i, active);
+    }
+    if (jobs.running(inverse_build_job)) {
+        const auto progress = jobs.progress(inverse_build_job);
+        gcinput::logging::info("Profile %u: building inverse table, %lu%%\n",
+                               static_cast<unsigned>(pending_profile.profile),
+                               progress.done * 100 / progress.total);
+    }
+}
+
+void emit_profile_ack(gcinput::telemetry::ProfileAckStatus status, std::size_t profile,
+                      uint32_t offset = 0, uint32_t crc = 0) {
+    gcinput::telemetry::emit(gcinput::telemetry::ProfileAckRecord{
+        .status = status,
+        .slot = static_cast<uint8_t>(profile),
+        .offset = offset,
+        .crc = crc,
+    });
+}
+
+// 逆変換テーブルの組み立てをやめる（書き込んだプロファイルならFailedを返す）
+void cancel_pending_profile() {
+    if (pending_profile.uploaded) {
+        emit_profile_ack(gcinput::telemetry::ProfileAckStatus::Failed, pending_profile.profile,
+                         pending_profile.offset, pending_profile.crc);
+    }
+    jobs.stop(inverse_build_job);
+    pending_profile = {};
+}
+
+// 逆変換テーブルを差し替える。次の Status 応答から新しい表を使う
+// 順方向の写像のプロファイルは表を組み立て始めるだけで、差し替えは service_inverse_builder が行う
+bool select_profile(std::size_t profile, std::size_t &active) {
+    using gcinput::calibration::ProfileStore;
+    if (!profile_store.selectable(profile)) {
+        gcinput::logging::warn("Profile %u is not available.\n", static_cast<unsigned>(profile));
+        return false;
+    }
+    cancel_pending_profile();
+    if (const auto *table = profile_store.table(profile); table != nullptr) {
+        inverse_ctx.table.store(table, std::memory_order_release);
+        active = profile;
+        log_profile(profile, active);
+        return true;
+    }
+    // 組み立て直す表をISRが引いていれば、組み立てる間は組み込みの表に戻す
+    // （ISRは同じコアで動くので、ここへ来たときに前の表を読んでいる途中ではない）
+    if (inverse_ctx.table.load(std::memory_order_relaxed) == &inverse_builder.table()) {
+        inverse_ctx.table.store(profile_store.table(ProfileStore::kBuiltinProfile),
+                                std::memory_order_release);
+        active = ProfileStore::kBuiltinProfile;
+    }
+    inverse_builder.begin(*profile_store.forward_map(profile));
+    jobs.start(inverse_build_job);
+    pending_profile = {.profile = profile};
+    gcinput::logging::info("Profile %u: building inverse table.\n",
+                           static_cast<unsigned>(profile));
+    return true;
+}
+
+// 逆変換テーブルを組み立て終えていたら差し替える（組み立てはjobsが進める）
+void service_inverse_builder(std::size_t &active) {
+    using State = gcinput::domain::transform::correction::InverseBuilder::State;
+    using Status = gcinput::telemetry::ProfileAckStatus;
+    if (pending_profile.profile == gcinput::calibration::ProfileStore::kProfileCount) {
+        return;
+    }
+    const State state = inverse_builder.state();
+    if (state != State::Done && state != State::Failed) {
+        return;
+    }
+    const PendingProfile pending = pending_profile;
+    pending_profile = {};
+    log_job(inverse_build_job);
+    if (state == State::Failed) {
+        gcinput::logging::warn("Profile %u: cannot build inverse table (no seeds or broken map).\n",
+                               static_cast<unsigned>(pending.profile));
+        if (pending.uploaded) {
+            emit_profile_ack(Status::Failed, pending.profile, pending.offset, pending.crc);
+        }
+        return;
+    }
+    inverse_ctx.table.store(&inverse_builder.table(), std::memory_order_release);
+    active = pending.profile;
+    log_profile(active, active);
+    gcinput::logging::info("Profile %u: %lu exact preimages, queue peak %lu.\n",
+                           static_cast<unsigned>(active), inverse_builder.exact_count(),
+                           inverse_builder.peak_queue());
+    if (pending.uploaded) {
+        emit_profile_ack(Status::Activated, pending.profile, pending.offset, pending.crc);
+    }
+}
+
+// プロファイルの書き込みの進み具合を返す。書き終えたらそのプロファイルへ切り替える
+void handle_profile_upload(const gcinput::calibration::ProfileUpload::Result &result,
+                           std::size_t &active) {
+    using Event = gcinput::calibration::ProfileUpload::Event;
+    using Status = gcinput::telemetry::ProfileAckStatus;
+    switch (result.event) {
+    case Event::None:
+        return;
+    case Event::Waiting:
+        gcinput::logging::info("Profile %u: slot not empty, erasing once the console stops.\n",
+                               static_cast<unsigned>(result.profile));
+        return;
+    case Event::Ready:
+        emit_profile_ack(Status::Ready, result.profile, result.offset);
+        gcinput::logging::info("Profile %u: receiving.\n", static_cast<unsigned>(result.profile));
+        return;
+    case Event::Written:
+        emit_profile_ack(Status::Written, result.profile, result.offset);
+        return;
+    case Event::Completed:
+        if (!select_profile(result.profile, active)) {
+            emit_profile_ack(Status::Failed, result.profile, result.offset, result.crc);
+        } else if (pending_profile.profile == result.profile) {
+            // 表を組み立て終えてからActivatedを返す
+            pending_profile.uploaded = true;
+            pending_profile.offset = result.offset;
+            pending_profile.crc = result.crc;
+        } else {
+            emit_profile_ack(Status::Activated, result.profile, result.offset, result.crc);
+        }
+        return;
+    case Event::Failed:
+        emit_profile_ack(Status::Failed, result.profile, result.offset, result.crc);
+        gcinput::logging::warn("Profile %u: upload failed at %lu.\n",
+                               static_cast<unsigned>(result.profile), result.offset);
+        return;
+    }
+}
+
 // 振動パターン再生（モード切替通知用）
 struct RumbleOverride {
     uint8_t remaining_pulses{0};
@@ -103,6 +400,7 @@ struct RumbleOverride {
 
 int main() {
     stdio_init_all();
+    gcinput::logging::init();
 
     // ボタンを押すだけでBOOTSELに入るようにする
     bootsel_button_init();
@@ -158,30 +456,66 @@ int main() {
     constexpr std::size_t kStageCorrectionFirst = 1;
     constexpr std::size_t kStageCorrectionLast = 4;
 
+    // 各ステージが書き換えるフィールド。Status応答はこれ以外のバイトをパッドの応答から素通しする
+    namespace input_field = gcinput::domain::input_field;
+    constexpr uint16_t kNeutralFields =
+        input_field::kStick | input_field::kCStick | input_field::kTriggers;
+
     // Stage 0: 原点確定用ニュートラル固定（起動時有効）
-    pipelines.status.add_stage(gcinput::domain::transform::make_stage(&fix_origin_to_neutral));
+    pipelines.status.add_stage(
+        gcinput::domain::transform::make_stage(&fix_origin_to_neutral, kNeutralFields));
 
     // Stage 1-4: 補正パイプライン P(s) = S⁻¹⁺(φ(C(s)))（起動時無効）
+    // いずれも主スティックだけを書き換える
+    pipelines.status.add_stage(
+        gcinput::domain::transform::make_stage<OriginOffsetContext, origin_normalize>(
+            origin_ctx, input_field::kStick));
     pipelines.status.add_stage(
-        gcinput::domain::transform::make_stage<OriginOffsetContext, origin_normalize>(origin_ctx));
-    pipelines.status.add_stage(gcinput::domain::transform::make_stage(&octagon_clamp));
-    pipelines.status.add_stage(gcinput::domain::transform::make_stage(&linear_scale));
-    pipelines.status.add_stage(gcinput::domain::transform::make_stage(&inverse_lut));
+        gcinput::domain::transform::make_stage(&octagon_clamp, input_field::kStick));
+    pipelines.status.add_stage(
+        gcinput::domain::transform::make_stage(&linear_scale, input_field::kStick));
+    pipelines.status.add_stage(
+        gcinput::domain::transform::make_stage<InverseLutContext, inverse_lut>(
+            inverse_ctx, input_field::kStick));
 
     // 補正ステージを初期状態では無効にする
     for (std::size_t i = kStageCorrectionFirst; i <= kStageCorrectionLast; ++i) {
         pipelines.status.set_stage_enabled(i, false);
     }
+    static_assert(std::size(kStatusStageNames) == kStageCorrectionLast + 1);
+    if constexpr (kPipelineProfile == PipelineProfile::Cycles) {
+        gcinput::util::start_systick_counter();
+    }
+    if constexpr (kPipelineProfile != PipelineProfile::Off) {
+        pipelines.status.set_profiler(&status_profiler);
+    }
+
+    // 補正プロファイル: 起動時は組み込みの表を使う（選んだプロファイルは覚えない）
+    profile_store.init(gcinput::calibration::kBuiltinCorrection);
+    std::size_t active_profile = gcinput::calibration::ProfileStore::kBuiltinProfile;
+    inverse_ctx.table.store(profile_store.table(active_profile), std::memory_order_release);
+    gcinput::calibration::ProfileUpload profile_upload{profile_store};
+    inverse_build_job = jobs.add({
+        .name = "inverse_build",
+        .step = &step_inverse_builder,
+        .progress = &inverse_builder_progress,
+        .budget_us = kInverseBuildBudgetUs,
+    });
 
     gcinput::PadClient pad_client(host_to_pad_config, client_link);
     gcinput::ConsoleClient console_client(device_to_console_config, client_link);
 
-    printf("Bridge firmware ready.\n");
-    printf("Mode: origin_fix (L+R+DUp+Start+Y to activate correction)\n");
-    printf("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
-           host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
-    printf("device_to_console: PIO%d SM%u pin GP%u\n", pio_get_index(device_to_console_config.pio),
-           device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    namespace logging = gcinput::logging;
+    logging::info("Bridge firmware ready.\n");
+    log_ram_usage();
+    logging::info("Mode: origin_fix (L+R+DUp+Start+Y to activate correction)\n");
+    logging::info("Profiles: L+R+DUp+Start+X or serial S,<n> to switch, L to list\n");
+    log_profiles(active_profile);
+    logging::info("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
+                  host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
+    logging::info("device_to_console: PIO%d SM%u pin GP%u\n",
+                  pio_get_index(device_to_console_config.pio),
+                  device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
 
     // モード管理
     // origin_fix: 接続直後。Status に (128,128) を返してコンソールに原点を確定させる
@@ -191,10 +525,13 @@ int main() {
 
     bool is_pad_connected = false;
     bool prev_combo = false;
+    bool prev_profile_combo = false;
+    gcinput::calibration::ProfileCommandReceiver profile_commands{};
     RumbleOverride rumble_override{};
     uint32_t last_origin_publish_count = 0;
     uint32_t last_tx_publish_count = 0;
     uint32_t last_debug_log_us = 0;
+    uint32_t last_profile_log_us = 0;
     constexpr uint32_t kDebugLogIntervalUs = 500'000; // 500ms間隔
 
     while (true) {
@@ -218,7 +555,7 @@ int main() {
                 const auto oy = snapshot.origin.input.analog.stick_y;
                 origin_ctx.origin_x.store(ox, std::memory_order_release);
                 origin_ctx.origin_y.store(oy, std::memory_order_release);
-                printf("Origin updated: (%u, %u)\n", ox, oy);
+                logging::info("Origin updated: (%u, %u)\n", ox, oy);
             }
         }
 
@@ -239,7 +576,7 @@ int main() {
                         pipelines.status.set_stage_enabled(i, true);
                     }
                     rumble_override.start(1, now_us);
-                    printf("Mode: correction (pipeline active)\n");
+                    logging::info("Mode: correction (pipeline active)\n");
                 } else {
                     mode = BridgeMode::OriginFix;
                     pipelines.status.set_stage_enabled(kStageFixOrigin, true);
@@ -247,75 +584,109 @@ int main() {
                         pipelines.status.set_stage_enabled(i, false);
                     }
                     rumble_override.start(2, now_us);
-                    printf("Mode: origin_fix (L+R+DUp+Start+Y to activate correction)\n");
+                    logging::info("Mode: origin_fix (L+R+DUp+Start+Y to activate correction)\n");
                 }
             }
             prev_combo = combo_held;
+
+            // プロファイル切替: L+R+DpadUp+Start+X 同時押しで次のプロファイルへ
+            // 振動の回数で番号を知らせる（組み込みは1回、スロットnはn+1回）
+            const bool profile_combo_held = input.pressed(gcinput::domain::PadButton::L) &&
+                                            input.pressed(gcinput::domain::PadButton::R) &&
+                                            input.pressed(gcinput::domain::PadButton::DpadUp) &&
+                                            input.pressed(gcinput::domain::PadButton::Start) &&
+                                            input.pressed(gcinput::domain::PadButton::X);
+            if (profile_combo_held && !prev_profile_combo &&
+                select_profile(profile_store.next(active_profile), active_profile)) {
+                rumble_override.start(static_cast<uint8_t>(active_profile + 1), now_us);
+            }
+            prev_profile_combo = profile_combo_held;
         }
 
-        // デバッグログ: 各ステージの中間値を出力
+        // シリアルからのプロファイルの指示。書き込み中はチャンクを受け取る
+        // 1周で読む文字数は抑える（チャンク1つ分を読み切れる程度）
+        for (int i = 0; i < 64; ++i) {
+            const int c = getchar_timeout_us(0);
+            if (c == PICO_ERROR_TIMEOUT) {
+                break;
+            }
+            if (profile_upload.busy()) {
+                profile_upload.feed(static_cast<uint8_t>(c), now_us);
+                continue;
+            }
+            using ProfileCommand = gcinput::calibration::ProfileCommandReceiver::Command;
+            const auto command = profile_commands.feed(static_cast<char>(c));
+            if (command.command == ProfileCommand::List) {
+                log_profiles(active_profile);
+            } else if (command.command == ProfileCommand::Select) {
+                select_profile(command.profile, active_profile);
+            } else if (command.command == ProfileCommand::Upload) {
+                // 表を組み立てている間はそのスロットも読むので書かない
+                if (command.profile == pending_profile.profile ||
+                    !profile_upload.begin(command.profile, active_profile, now_us)) {
+                    emit_profile_ack(gcinput::telemetry::ProfileAckStatus::Rejected,
+                                     command.profile);
+                    logging::warn("Profile %u: cannot upload (active or unavailable).\n",
+                                  static_cast<unsigned>(command.profile));
+                }
+            } else if (command.command == ProfileCommand::Rejected) {
+                logging::warn("Profile: unknown command.\n");
+            }
+        }
+        handle_profile_upload(
+            profile_upload.service(now_us, client_link.shared_console().load_frame_clock()),
+            active_profile);
+        jobs.run(time_us_32);
+        service_inverse_builder(active_profile);
+
+        // デバッグログ: プロファイラがあれば次の Status 応答の各ステージの中間値を取ってもらう
         gcinput::TxRecord last_tx{};
         if (client_link.real_pad_hub().consume_tx_if_new(last_tx_publish_count, last_tx)) {
             if (last_tx.raw.command() == gcinput::joybus::Command::Status &&
                 (int32_t)(now_us - last_debug_log_us) >= (int32_t)kDebugLogIntervalUs) {
                 last_debug_log_us = now_us;
-
-                // ISR が送った最終値（ワイヤフォーマットから読み取り）
-                const auto modified_view = last_tx.modified.view();
-                const uint8_t tx_sx = (modified_view.size() >= 3) ? modified_view[2] : 0;
-                const uint8_t tx_sy = (modified_view.size() >= 4) ? modified_view[3] : 0;
-
-                // 生の入力をスナップショットから取得
-                const auto raw_state = snapshot.status;
-                const uint8_t raw_x = raw_state.input.analog.stick_x;
-                const uint8_t raw_y = raw_state.input.analog.stick_y;
-
-                // 現在の Origin
-                const uint8_t ox = origin_ctx.origin_x.load(std::memory_order_acquire);
-                const uint8_t oy = origin_ctx.origin_y.load(std::memory_order_acquire);
-
-                // 各ステージを再計算
-                gcinput::domain::PadState s = raw_state;
-
-                // Stage 1: origin_normalize
-                origin_normalize(origin_ctx, s);
-                const uint8_t norm_x = s.input.analog.stick_x;
-                const uint8_t norm_y = s.input.analog.stick_y;
-
-                // Stage 2: octagon_clamp
-                octagon_clamp(nullptr, s);
-                const uint8_t clamp_x = s.input.analog.stick_x;
-                const uint8_t clamp_y = s.input.analog.stick_y;
-
-                // Stage 3: linear_scale
-                linear_scale(nullptr, s);
-                const uint8_t scale_x = s.input.analog.stick_x;
-                const uint8_t scale_y = s.input.analog.stick_y;
-
-                // Stage 4: inverse_lut
-                inverse_lut(nullptr, s);
-                const uint8_t lut_x = s.input.analog.stick_x;
-                const uint8_t lut_y = s.input.analog.stick_y;
-
-                // S(tx): コンソールが実際に受け取る期待値
-                const auto [stx_x, stx_y] = forward_lut(tx_sx, tx_sy);
-
-                printf("DBG [%s] origin=(%3u,%3u) raw=(%3u,%3u) norm=(%3u,%3u) clamp=(%3u,%3u) "
-                       "scale=(%3u,%3u) lut=(%3u,%3u) tx=(%3u,%3u) S(tx)=(%3u,%3u)\n",
-                       mode == BridgeMode::Correction ? "COR" : "FIX", ox, oy, raw_x, raw_y,
-                       norm_x, norm_y, clamp_x, clamp_y, scale_x, scale_y, lut_x, lut_y, tx_sx,
-                       tx_sy, stx_x, stx_y);
+                if constexpr (kPipelineProfile != PipelineProfile::Off) {
+                    status_profiler.request_capture();
+                } else {
+                    // ISR が送った最終値（ワイヤフォーマットから読み取り）
+                    const auto modified_view = last_tx.modified.view();
+                    const uint8_t tx_sx = (modified_view.size() >= 3) ? modified_view[2] : 0;
+                    const uint8_t tx_sy = (modified_view.size() >= 4) ? modified_view[3] : 0;
+                    const auto &raw = snapshot.status.input.analog;
+                    const auto [stx_x, stx_y] = forward_lut(tx_sx, tx_sy);
+                    logging::debug("DBG [%s] origin=(%3u,%3u) raw=(%3u,%3u) tx=(%3u,%3u) "
+                                   "S(tx)=(%3u,%3u)\n",
+                                   mode == BridgeMode::Correction ? "COR" : "FIX",
+                                   origin_ctx.origin_x.load(std::memory_order_acquire),
+                                   origin_ctx.origin_y.load(std::memory_order_acquire),
+                                   raw.stick_x, raw.stick_y, tx_sx, tx_sy, stx_x, stx_y);
+                }
+            }
+        }
+        if constexpr (kPipelineProfile != PipelineProfile::Off) {
+            gcinput::domain::transform::PipelineProfiler::Capture capture{};
+            while (status_profiler.pop_capture(capture)) {
+                log_capture(capture, mode == BridgeMode::Correction);
+            }
+        }
+        if constexpr (kPipelineProfile == PipelineProfile::Cycles) {
+            if ((int32_t)(now_us - last_profile_log_us) >= (int32_t)kProfileLogIntervalUs) {
+                last_profile_log_us = now_us;
+                log_pipeline_profile();
             }
         }
 
         const bool ready = client_link.is_pad_ready();
         if (!is_pad_connected && ready) {
-            printf("PadClient: console responses enabled.\n");
+            logging::info("PadClient: console responses enabled.\n");
             is_pad_connected = true;
         } else if (is_pad_connected && !ready) {
-            printf("PadClient: console responses disabled.\n");
+            logging::info("PadClient: console responses disabled.\n");
             is_pad_connected = false;
         }
+
+        // 溜まったログを送信バッファへ整形してDMAに渡す
+        logging::poll();
         tight_loop_contents();
     }
 }
@@ -0,0 +1,20 @@
+#pragma once
+#include "hardware/structs/systick.h"
+#include <cstdint>
+
+namespace gcinput::util {
+
+// SysTick をCPUクロックで数える24ビットのカウンタとして使う（割り込みは使わない）
+// SysTick は減っていくので、反転して増えるカウンタとして読む
+inline constexpr uint32_t kSysTickMask = 0x00FF'FFFFu;
+
+inline void start_systick_counter() {
+    systick_hw->csr = 0;
+    systick_hw->rvr = kSysTickMask;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+inline uint32_t systick_cycles() { return ~systick_hw->cvr & kSysTickMask; }
+
+} // namespace gcinput::util
@@ -0,0 +1,357 @@
+#include "logging/log.hpp"
+#include "hardware/dma.h"
+#include "logging/record_ring.hpp"
+#include "pico/stdlib.h"
+#include "telemetry/frame.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace gcinput::logging {
+namespace {
+
+// リング容量（4KiB）。115200bpsで約0.35秒分
+constexpr std::size_t kRingWords = 1024;
+// DMA送信バッファ1つのサイズ。送信中にもう一方へ次の分を整形する
+constexpr std::size_t kTxBufferSize = 256;
+
+// レコード先頭ワードと書式ポインタ
+constexpr std::size_t kFormatHeaderWords = 2;
+
+struct Bucket {
+    // 貯まっている時間（us）。1件ごとに1e6/per_second usを消費する
+    uint32_t credit_us{0};
+    uint32_t last_us{0};
+};
+
+struct Logger {
+    Config config{};
+    RecordRing<kRingWords> ring{};
+    std::array<Bucket, kLevelCount> buckets{};
+    Stats stats{};
+    // 直近に通知した時点のドロップ件数（全レベルの合計）
+    uint32_t reported_full{0};
+    uint32_t reported_rate{0};
+
+    int dma_channel{-1};
+    std::array<std::array<uint8_t, kTxBufferSize>, 2> tx{};
+    std::array<std::size_t, 2> tx_length{0, 0};
+    // 整形先のバッファ。もう一方がDMA送信中になりうる
+    uint8_t fill_index{0};
+    bool sending{false};
+    // 設定中はUARTの代わりにここへ出す
+    const Sink *sink{nullptr};
+};
+
+Logger g_logger{};
+
+constexpr std::size_t level_index(Level level) { return static_cast<std::size_t>(level); }
+
+bool admit(Level level) {
+    const RateLimit &limit = g_logger.config.rate_limits[level_index(level)];
+    if (limit.per_second == 0) {
+        return true;
+    }
+    Bucket &bucket = g_logger.buckets[level_index(level)];
+    const uint32_t now_us = time_us_32();
+    const uint32_t period_us = 1'000'000u / limit.per_second;
+    const uint32_t capacity_us = period_us * std::max<uint32_t>(limit.burst, 1);
+    const uint32_t elapsed_us = now_us - bucket.last_us;
+    bucket.last_us = now_us;
+    bucket.credit_us = std::min(capacity_us, bucket.credit_us + std::min(elapsed_us, capacity_us));
+    if (bucket.credit_us < period_us) {
+        g_logger.stats.dropped_rate[level_index(level)]++;
+        return false;
+    }
+    bucket.credit_us -= period_us;
+    return true;
+}
+
+uint32_t sum(const std::array<uint32_t, kLevelCount> &counts) {
+    uint32_t total = 0;
+    for (const uint32_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+// 整形結果の末尾の改行をCRLFにする（pico stdioの既定と同じ出力にそろえる）
+std::size_t translate_crlf(char *out, std::size_t length, std::size_t capacity) {
+    if (length == 0 || out[length - 1] != '\n' || length + 1 > capacity) {
+        return length;
+    }
+    if (length >= 2 && out[length - 2] == '\r') {
+        return length;
+    }
+    out[length - 1] = '\r';
+    out[length] = '\n';
+    return length + 1;
+}
+
+// Format/Textレコードを1行の文字列としてoutへ整形する
+// 収まらなければ0を返す（空のバッファでも収まらない長さなら切り詰める）
+std::size_t format_line(const uint32_t *record, char *out, std::size_t capacity, bool empty) {
+    const RecordHeader header = RecordHeader::unpack(record[0]);
+    std::size_t length = 0;
+
+    if (header.kind == RecordKind::Format) {
+        const char *fmt = reinterpret_cast<const char *>(static_cast<uintptr_t>(record[1]));
+        std::array<uint32_t, detail::kMaxArgs> a{};
+        std::copy_n(record + kFormatHeaderWords, header.count, a.begin());
+        // 引数は32ビットワードとして渡す。RP2040ではint/long/ポインタのどれも同じ渡し方になる
+        const int n = snprintf(out, capacity, fmt, a[0], a[1], a[2], a[3], a[4], a[5], a[6],
+                               a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15],
+                               a[16], a[17], a[18], a[19]);
+        if (n < 0) {
+            return 0;
+        }
+        length = static_cast<std::size_t>(n);
+    } else {
+        length = header.count;
+        std::memcpy(out, record + 1, std::min<std::size_t>(length, capacity));
+    }
+
+    if (length >= capacity) {
+        if (!empty) {
+            return 0;
+        }
+        length = capacity - 1;
+        out[length - 1] = '\n';
+    }
+    return translate_crlf(out, length, capacity);
+}
+
+// 1レコードをoutへ書き出す。収まらなければ0を返す
+std::size_t write_record(const uint32_t *record, uint8_t *out, std::size_t capacity, bool empty) {
+    const RecordHeader header = RecordHeader::unpack(record[0]);
+    if (header.kind == RecordKind::Frame) {
+        if (header.count > capacity) {
+            return 0;
+        }
+        std::memcpy(out, record + 1, header.count);
+        return header.count;
+    }
+    if (g_logger.config.framing == Framing::Text) {
+        return format_line(record, reinterpret_cast<char *>(out), capacity, empty);
+    }
+
+    // Telemetry: 整形した行をTextRecordのフレームに包む。行末の改行はフレームには含めない
+    std::array<char, kTxBufferSize> line{};
+    std::size_t length = format_line(record, line.data(), line.size(), true);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        --length;
+    }
+    const telemetry::TextRecord text{
+        .level = header.level,
+        .text = std::string_view(line.data(), std::min(length, telemetry::kMaxPayload - 1)),
+    };
+    return telemetry::encode_frame(text, time_us_32(), std::span<uint8_t>(out, capacity));
+}
+
+// 前回の通知以降に増えたドロップ件数を書き出す。収まらなければ0を返す
+std::size_t write_drop_notice(uint8_t *out, std::size_t capacity) {
+    const uint32_t full = sum(g_logger.stats.dropped_full) - g_logger.reported_full;
+    const uint32_t rate = sum(g_logger.stats.dropped_rate) - g_logger.reported_rate;
+    if (full == 0 && rate == 0) {
+        return 0;
+    }
+    std::size_t length = 0;
+    if (g_logger.config.framing == Framing::Text) {
+        const int n = snprintf(reinterpret_cast<char *>(out), capacity,
+                               "# log: dropped full=%lu rate=%lu\r\n",
+                               static_cast<unsigned long>(full), static_cast<unsigned long>(rate));
+        length = (n > 0 && static_cast<std::size_t>(n) < capacity) ? static_cast<std::size_t>(n)
+                                                                     : 0;
+    } else {
+        const telemetry::DroppedRecord dropped{.full = full, .rate = rate};
+        length = telemetry::encode_frame(dropped, time_us_32(), std::span<uint8_t>(out, capacity));
+    }
+    if (length != 0) {
+        g_logger.reported_full += full;
+        g_logger.reported_rate += rate;
+    }
+    return length;
+}
+
+// 整形先のバッファを、リングのレコードで埋められるだけ埋める
+void fill_tx_buffer() {
+    auto &buffer = g_logger.tx[g_logger.fill_index];
+    std::size_t &length = g_logger.tx_length[g_logger.fill_index];
+
+    length += write_drop_notice(buffer.data() + length, kTxBufferSize - length);
+
+    while (const uint32_t *record = g_logger.ring.front()) {
+        const std::size_t written = write_record(record, buffer.data() + length,
+                                                 kTxBufferSize - length, length == 0);
+        if (written == 0) {
+            break;
+        }
+        length += written;
+        g_logger.ring.pop();
+    }
+}
+
+// 出力先が差し替えられていれば、整形済みのバッファを丸ごと渡せるときだけ渡す
+void write_to_sink() {
+    const Sink &sink = *g_logger.sink;
+    std::size_t &length = g_logger.tx_length[g_logger.fill_index];
+    if (length == 0 || sink.writable(sink.user) < length) {
+        return;
+    }
+    sink.write(sink.user, g_logger.tx[g_logger.fill_index].data(), length);
+    length = 0;
+}
+
+void start_dma_if_idle() {
+    if (g_logger.sending && !dma_channel_is_busy(static_cast<uint>(g_logger.dma_channel))) {
+        g_logger.sending = false;
+    }
+    if (g_logger.sink) {
+        write_to_sink();
+        return;
+    }
+    if (g_logger.sending) {
+        return;
+    }
+    const uint8_t index = g_logger.fill_index;
+    const std::size_t length = g_logger.tx_length[index];
+    if (length == 0) {
+        return;
+    }
+    dma_channel_transfer_from_buffer_now(static_cast<uint>(g_logger.dma_channel),
+                                         g_logger.tx[index].data(),
+                                         static_cast<uint32_t>(length));
+    g_logger.stats.sent_bytes += static_cast<uint32_t>(length);
+    g_logger.sending = true;
+    g_logger.fill_index = index ^ 1u;
+    g_logger.tx_length[g_logger.fill_index] = 0;
+}
+
+} // namespace
+
+void init(const Config &config) {
+    g_logger.config = config;
+    uart_set_baudrate(config.uart, config.baudrate);
+
+    g_logger.dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(static_cast<uint>(g_logger.dma_channel));
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(config.uart, true));
+    dma_channel_configure(static_cast<uint>(g_logger.dma_channel), &c,
+                          &uart_get_hw(config.uart)->dr, nullptr, 0, false);
+
+    const uint32_t now_us = time_us_32();
+    for (std::size_t i = 0; i < kLevelCount; ++i) {
+        const RateLimit &limit = config.rate_limits[i];
+        g_logger.buckets[i].last_us = now_us;
+        g_logger.buckets[i].credit_us =
+            (limit.per_second == 0) ? 0 : (1'000'000u / limit.per_second) * limit.burst;
+    }
+}
+
+void poll() {
+    if (g_logger.dma_channel < 0) {
+        return;
+    }
+    start_dma_if_idle();
+    fill_tx_buffer();
+    start_dma_if_idle();
+}
+
+bool idle() {
+    return g_logger.ring.empty() && !g_logger.sending &&
+           g_logger.tx_length[g_logger.fill_index] == 0;
+}
+
+void flush_blocking(uint32_t timeout_us) {
+    if (g_logger.dma_channel < 0) {
+        return;
+    }
+    const uint32_t start_us = time_us_32();
+    while (!idle()) {
+        if (time_us_32() - start_us >= timeout_us) {
+            return;
+        }
+        poll();
+    }
+    uart_tx_wait_blocking(g_logger.config.uart);
+}
+
+void write_blocking(const char *text) {
+    if (g_logger.dma_channel >= 0) {
+        dma_channel_wait_for_finish_blocking(static_cast<uint>(g_logger.dma_channel));
+    }
+    uart_puts(g_logger.config.uart, text);
+    uart_tx_wait_blocking(g_logger.config.uart);
+}
+
+Stats stats() { return g_logger.stats; }
+
+void set_sink(const Sink *sink) { g_logger.sink = sink; }
+
+bool has_room_for_frame(std::size_t length) {
+    // 末尾で折り返すとSkipの分も要るので、2件分空いていれば必ず積める
+    const std::size_t words = 1 + (length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    return g_logger.ring.free_words() >= 2 * words;
+}
+
+namespace detail {
+
+bool push_format(Level level, const char *fmt, const uint32_t *args, std::size_t count) {
+    if (!admit(level)) {
+        return false;
+    }
+    const std::size_t words = kFormatHeaderWords + count;
+    uint32_t *slot = g_logger.ring.reserve(words);
+    if (!slot) {
+        g_logger.stats.dropped_full[level_index(level)]++;
+        return false;
+    }
+    slot[0] = RecordHeader::pack(static_cast<uint8_t>(words), RecordKind::Format,
+                                 static_cast<uint8_t>(level), static_cast<uint8_t>(count));
+    slot[1] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fmt));
+    std::copy_n(args, count, slot + kFormatHeaderWords);
+    g_logger.ring.commit(words);
+    return true;
+}
+
+bool push_text(Level level, const char *text, std::size_t length) {
+    if (!admit(level)) {
+        return false;
+    }
+    length = std::min(length, kMaxTextBytes);
+    const std::size_t words = 1 + (length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    uint32_t *slot = g_logger.ring.reserve(words);
+    if (!slot) {
+        g_logger.stats.dropped_full[level_index(level)]++;
+        return false;
+    }
+    slot[0] = RecordHeader::pack(static_cast<uint8_t>(words), RecordKind::Text,
+                                 static_cast<uint8_t>(level), static_cast<uint8_t>(length));
+    std::memcpy(slot + 1, text, length);
+    g_logger.ring.commit(words);
+    return true;
+}
+
+bool push_frame(Level level, const uint8_t *frame, std::size_t length) {
+    // フレームは途中で切ると受信側で壊れるので、長すぎるものは積まない
+    if (length > telemetry::kMaxEncodedFrame || !admit(level)) {
+        return false;
+    }
+    const std::size_t words = 1 + (length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    uint32_t *slot = g_logger.ring.reserve(words);
+    if (!slot) {
+        g_logger.stats.dropped_full[level_index(level)]++;
+        return false;
+    }
+    slot[0] = RecordHeader::pack(static_cast<uint8_t>(words), RecordKind::Frame,
+                                 static_cast<uint8_t>(level), static_cast<uint8_t>(length));
+    std::memcpy(slot + 1, frame, length);
+    g_logger.ring.commit(words);
+    return true;
+}
+
+} // namespace detail
+} // namespace gcinput::logging
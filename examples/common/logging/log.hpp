@@ -0,0 +1,153 @@
+#pragma once
+#include "hardware/uart.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// mainループ向けの非同期ログ
+// 呼び出し側は書式文字列へのポインタと引数をリングに積むだけで、整形とUART送信はpoll()で行う
+// UARTへの送出はDMAなので、ログ出力でPadClient::tickが止まることはない
+//
+// 制約:
+// - 書き込み（log/text）と読み出し（poll）はどちらもmainループから呼ぶ。割り込みから呼ばない
+// - 書式文字列と%sに渡す文字列は静的な寿命を持つこと（整形時まで参照する）
+// - 引数は32ビット以下の整数かポインタのみ。%lu等のlongはRP2040では32ビット
+namespace gcinput::logging {
+
+enum class Level : uint8_t {
+    Error = 0,
+    Warn = 1,
+    Info = 2,
+    Debug = 3,
+    // ホストで解析する計測データ行（D,/I,/T,など）。既定ではレート制限しない
+    Data = 4,
+};
+
+inline constexpr std::size_t kLevelCount = 5;
+
+// レベルごとのレート制限（トークンバケット）。per_secondが0なら制限しない
+struct RateLimit {
+    uint16_t per_second{0};
+    uint16_t burst{0};
+};
+
+// UARTへ出すときの形式
+enum class Framing : uint8_t {
+    // printfと同じテキスト行。テレメトリフレームはそのまま混ざる
+    Text,
+    // すべてテレメトリフレームにする。ログ行はTextRecord、ドロップ通知はDroppedRecordになる
+    // 受信側はhost/telemetryのデコーダでCSVへ戻す
+    Telemetry,
+};
+
+struct Config {
+    uart_inst_t *uart{uart0};
+    Framing framing{Framing::Text};
+    uint32_t baudrate{115200};
+    std::array<RateLimit, kLevelCount> rate_limits{{
+        {.per_second = 0, .burst = 0},   // Error
+        {.per_second = 20, .burst = 20}, // Warn
+        {.per_second = 20, .burst = 40}, // Info
+        {.per_second = 10, .burst = 10}, // Debug
+        {.per_second = 0, .burst = 0},   // Data
+    }};
+};
+
+struct Stats {
+    // リングが満杯で捨てた件数
+    std::array<uint32_t, kLevelCount> dropped_full{};
+    // レート制限で捨てた件数
+    std::array<uint32_t, kLevelCount> dropped_rate{};
+    // UARTへ送出したバイト数
+    uint32_t sent_bytes{0};
+};
+
+// stdio_init_all()の後に一度だけ呼ぶ。UARTはstdioと共用し、DMAチャネルを1つ確保する
+void init(const Config &config = Config{});
+
+// mainループから毎周呼ぶ。レコードを整形して送信バッファへ詰め、空いていればDMA送信を開始する
+// 1回の呼び出しで整形するのは送信バッファ1つ分まで
+void poll();
+
+// キューが空で、送信中のバッファもないか
+bool idle();
+
+// キューが空になり送信が終わるまで待つ（リセット直前など）
+void flush_blocking(uint32_t timeout_us);
+
+// キューを経由せず直接UARTへ書く。割り込みからのリセット直前メッセージ用
+void write_blocking(const char *text);
+
+Stats stats();
+
+// UARTの代わりに出力を受け取る先（debug_probeのフラッシュ記録など）
+// 設定中はUARTへ送らず、整形したバイト列をwriteへ渡す。writableが足りないあいだはキューに溜める
+struct Sink {
+    std::size_t (*writable)(void *user) = nullptr;
+    void (*write)(void *user, const uint8_t *data, std::size_t length) = nullptr;
+    void *user = nullptr;
+};
+
+// nullptrでUARTへ戻す。sinkは戻すまで生きていること
+void set_sink(const Sink *sink);
+
+// lengthバイトのテレメトリフレームを今キューへ積めるか
+// まとまった量を数周に分けて送るとき、キューを溢れさせないように確かめる
+bool has_room_for_frame(std::size_t length);
+
+namespace detail {
+inline constexpr std::size_t kMaxArgs = 20;
+// Textレコード1件の最大バイト数
+inline constexpr std::size_t kMaxTextBytes = 200;
+
+bool push_format(Level level, const char *fmt, const uint32_t *args, std::size_t count);
+bool push_text(Level level, const char *text, std::size_t length);
+bool push_frame(Level level, const uint8_t *frame, std::size_t length);
+
+template <class T> inline uint32_t to_word(T value) {
+    if constexpr (std::is_pointer_v<T>) {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+    } else {
+        return static_cast<uint32_t>(value);
+    }
+}
+
+// ポインタはRP2040では32ビットなので常に可
+template <class T>
+inline constexpr bool kIsLoggableArg =
+    ((std::is_integral_v<T> || std::is_enum_v<T>) && sizeof(T) <= sizeof(uint32_t)) ||
+    std::is_pointer_v<T>;
+} // namespace detail
+
+// printf互換の書式で1件積む。整形はpoll()まで遅延する
+template <class... Args> inline void log(Level level, const char *fmt, Args... args) {
+    static_assert(sizeof...(Args) <= detail::kMaxArgs, "引数が多すぎる");
+    static_assert((detail::kIsLoggableArg<Args> && ...),
+                  "引数は32ビット以下の整数かポインタのみ（浮動小数点は不可）");
+    const std::array<uint32_t, sizeof...(Args)> words{detail::to_word(args)...};
+    detail::push_format(level, fmt, words.data(), words.size());
+}
+
+// 整形済みの文字列を1件積む（中身はコピーする）。長さが可変の行や一時バッファの文字列用
+inline void text(Level level, const char *text, std::size_t length) {
+    detail::push_text(level, text, length);
+}
+
+template <class... Args> inline void error(const char *fmt, Args... args) {
+    log(Level::Error, fmt, args...);
+}
+template <class... Args> inline void warn(const char *fmt, Args... args) {
+    log(Level::Warn, fmt, args...);
+}
+template <class... Args> inline void info(const char *fmt, Args... args) {
+    log(Level::Info, fmt, args...);
+}
+template <class... Args> inline void debug(const char *fmt, Args... args) {
+    log(Level::Debug, fmt, args...);
+}
+template <class... Args> inline void data(const char *fmt, Args... args) {
+    log(Level::Data, fmt, args...);
+}
+
+} // namespace gcinput::logging
@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gcinput::logging {
+
+// ログレコードの種類
+enum class RecordKind : uint8_t {
+    Skip = 0,   // リング末尾の余りを埋めるだけのレコード。読み飛ばす
+    Format = 1, // 書式文字列へのポインタ + 32ビット引数列。整形は読み出し側で行う
+    Text = 2,   // 整形済みの文字列をそのまま持つ
+    Frame = 3,  // エンコード済みのテレメトリフレーム。そのまま送る
+};
+
+// レコード先頭ワードの配置
+// bit 0-7: レコード全体のワード数（先頭ワードを含む）
+// bit 8-15: RecordKind
+// bit 16-23: Level
+// bit 24-31: Formatなら引数の数、Text/Frameならバイト数
+struct RecordHeader {
+    uint8_t words;
+    RecordKind kind;
+    uint8_t level;
+    uint8_t count;
+
+    static constexpr uint32_t pack(uint8_t words, RecordKind kind, uint8_t level, uint8_t count) {
+        return static_cast<uint32_t>(words) | (static_cast<uint32_t>(kind) << 8) |
+               (static_cast<uint32_t>(level) << 16) | (static_cast<uint32_t>(count) << 24);
+    }
+
+    static constexpr RecordHeader unpack(uint32_t word) {
+        return RecordHeader{
+            .words = static_cast<uint8_t>(word & 0xFFu),
+            .kind = static_cast<RecordKind>((word >> 8) & 0xFFu),
+            .level = static_cast<uint8_t>((word >> 16) & 0xFFu),
+            .count = static_cast<uint8_t>(word >> 24),
+        };
+    }
+};
+
+// 32ビットワード単位の可変長レコードを積む単一ライタ・単一リーダのリングバッファ
+// 1つのレコードは必ず連続領域に置く。末尾に収まらないときは残りをSkipで埋めて先頭から書く
+// head_/tail_は折り返さずに増え続ける値で、添字はCapacityWordsで割った余り
+template <std::size_t CapacityWords> class RecordRing {
+    static_assert((CapacityWords & (CapacityWords - 1)) == 0, "容量は2の冪にする");
+    static_assert(CapacityWords >= 256, "1レコードは最大255ワード");
+
+  public:
+    // 書き込み側: wordsワードの連続領域を確保する。空きが足りなければnullptr
+    // 確保した領域に書き込んだらcommit()で公開する
+    uint32_t *reserve(std::size_t words) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const uint32_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t free_words = CapacityWords - static_cast<std::size_t>(head - tail);
+        const std::size_t offset = head & kMask;
+        const std::size_t to_end = CapacityWords - offset;
+
+        if (words <= to_end) {
+            return (words <= free_words) ? &buffer_[offset] : nullptr;
+        }
+        // 折り返し: 末尾の余りをSkipで埋めてから先頭に置く
+        if (to_end + words > free_words) {
+            return nullptr;
+        }
+        buffer_[offset] =
+            RecordHeader::pack(static_cast<uint8_t>(to_end), RecordKind::Skip, 0, 0);
+        head_.store(head + static_cast<uint32_t>(to_end), std::memory_order_release);
+        return &buffer_[0];
+    }
+
+    // 書き込み側: 空いているワード数（連続しているとは限らない）
+    std::size_t free_words() const {
+        return CapacityWords - static_cast<std::size_t>(head_.load(std::memory_order_relaxed) -
+                                                        tail_.load(std::memory_order_acquire));
+    }
+
+    void commit(std::size_t words) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        head_.store(head + static_cast<uint32_t>(words), std::memory_order_release);
+    }
+
+    // 読み出し側: 先頭のレコードを返す。空ならnullptr
+    const uint32_t *front() {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        while (tail != head) {
+            const uint32_t *record = &buffer_[tail & kMask];
+            const RecordHeader header = RecordHeader::unpack(record[0]);
+            if (header.kind != RecordKind::Skip) {
+                return record;
+            }
+            tail += header.words;
+            tail_.store(tail, std::memory_order_release);
+        }
+        return nullptr;
+    }
+
+    // front()で得たレコードを捨てる
+    void pop() {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const RecordHeader header = RecordHeader::unpack(buffer_[tail & kMask]);
+        tail_.store(tail + header.words, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr std::size_t kMask = CapacityWords - 1;
+
+    std::array<uint32_t, CapacityWords> buffer_{};
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+};
+
+} // namespace gcinput::logging
@@ -0,0 +1,204 @@
+#pragma once
+#include "telemetry/records.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// JoyBusのエッジ時刻からフレームを組み立てる（ファームウェアとホストの共通）
+// エッジはdebug_probeのスニファ（joybus_sniffer.pio）が記録したもの
+// 時間はすべてスニファのサイクル数（clk_sys）で持ち、記録するときにnsへ直す
+namespace gcinput::sniffer {
+
+// 1つのエッジ。cyclesは単調に増える（2^32で一周する）
+struct Edge {
+    uint32_t cycles;
+    bool level; // エッジの後のレベル（falseなら立ち下がり）
+};
+
+// スニファがpushした語をエッジの時刻へ戻す
+class EdgeClock {
+  public:
+    // 語の上位31ビットはxの下位31ビット。xは2サイクルごとに1減り、エッジの処理で3サイクル使う
+    static constexpr uint32_t kCountMask = 0x7FFF'FFFFu;
+    static constexpr uint32_t kCyclesPerCount = 2;
+    static constexpr uint32_t kCyclesPerEdge = 3;
+
+    Edge unpack(uint32_t word) {
+        const uint32_t count = word >> 1;
+        if (has_last_) {
+            cycles_ += kCyclesPerCount * ((last_count_ - count) & kCountMask) + kCyclesPerEdge;
+        }
+        has_last_ = true;
+        last_count_ = count;
+        return Edge{cycles_, (word & 1u) != 0};
+    }
+
+    // 語を取りこぼしたとき。次の語からは前とつながらない
+    void reset() { has_last_ = false; }
+
+  private:
+    bool has_last_{false};
+    uint32_t last_count_{0};
+    uint32_t cycles_{0};
+};
+
+// フレームの終わりとみなすHighの長さ
+// JoyBusのビット内のHighは長くても3.75µs（5µs周期の'1'）
+inline constexpr uint32_t kDefaultEndHighNs = 4'500;
+
+// 組み立てた1フレーム（時間はサイクル数）
+struct BusFrame {
+    static constexpr std::size_t kMaxBytes = 16;
+
+    uint32_t start_cycles{0}; // 最初の立ち下がり
+    uint32_t end_cycles{0};   // ストップビットの立ち上がり
+    uint32_t bit_count{0};    // ストップビットを除くビット数
+    std::size_t length{0};    // 組み上がったバイト数（kMaxBytesまで）
+    std::array<uint8_t, kMaxBytes> bytes{};
+
+    uint32_t bit_period{0};   // データビットの平均周期（立ち下がりから次の立ち下がり）
+    uint32_t one_low_max{0};  // '1'のLow幅の最大（'1'がなければ0）
+    uint32_t zero_low_min{0}; // '0'のLow幅の最小（'0'がなければ0）
+    uint32_t stop_low{0};     // ストップビットのLow幅
+    bool has_gap{false};
+    uint32_t gap{0}; // 直前のフレームのストップビットの立ち上がりから、このフレームの始まりまで
+};
+
+// エッジを順に受け取り、フレームが閉じるたびにon_frameを呼ぶ
+// ビットの値はLow幅とHigh幅の比べで決める（Lowが短ければ'1'）
+// 閾値を持たないので、4µsと5µsのどちらの周期でも読める
+// Highがend_high_cyclesより長く続いたらフレームの終わりとみなし、最後のビットをストップビットとする
+class EdgeDecoder {
+  public:
+    explicit EdgeDecoder(uint32_t end_high_cycles) : end_high_cycles_{end_high_cycles} {}
+
+    template <class OnFrame> void feed(const Edge &edge, OnFrame &&on_frame) {
+        if (edge.level == level_) {
+            // 同じ向きが続いた（取りこぼし）。組み立て中のフレームは捨てる
+            in_frame_ = false;
+            has_end_ = false;
+            level_ = edge.level;
+            if (!edge.level) {
+                begin(edge.cycles, false);
+            } else {
+                last_rise_ = edge.cycles;
+            }
+            return;
+        }
+        level_ = edge.level;
+        if (edge.level) {
+            last_rise_ = edge.cycles;
+            return;
+        }
+        if (in_frame_ && edge.cycles - last_rise_ > end_high_cycles_) {
+            close(on_frame);
+        }
+        if (!in_frame_) {
+            begin(edge.cycles, has_end_);
+            return;
+        }
+        // 直前のビットが確定した
+        const uint32_t low = last_rise_ - bit_fall_;
+        const uint32_t high = edge.cycles - last_rise_;
+        push_bit(low < high, low, edge.cycles - bit_fall_);
+        bit_fall_ = edge.cycles;
+    }
+
+    // 線が止まったと分かったとき（しばらくエッジが来ない）に、組み立て中のフレームを閉じる
+    template <class OnFrame> void finish(OnFrame &&on_frame) {
+        if (in_frame_ && level_) {
+            close(on_frame);
+        }
+    }
+
+    // 取りこぼしの後。前のフレームとの間隔も分からなくなる
+    void reset() {
+        in_frame_ = false;
+        has_end_ = false;
+        level_ = true;
+    }
+
+  private:
+    void begin(uint32_t cycles, bool has_gap) {
+        frame_ = BusFrame{};
+        frame_.start_cycles = cycles;
+        frame_.has_gap = has_gap;
+        frame_.gap = has_gap ? cycles - last_end_ : 0;
+        frame_.zero_low_min = std::numeric_limits<uint32_t>::max();
+        period_sum_ = 0;
+        bit_fall_ = cycles;
+        in_frame_ = true;
+    }
+
+    void push_bit(bool one, uint32_t low, uint32_t period) {
+        const uint32_t index = frame_.bit_count++;
+        if (index / 8 < BusFrame::kMaxBytes) {
+            uint8_t &byte = frame_.bytes[index / 8];
+            byte = static_cast<uint8_t>((byte << 1) | (one ? 1u : 0u));
+        }
+        if (one) {
+            frame_.one_low_max = std::max(frame_.one_low_max, low);
+        } else {
+            frame_.zero_low_min = std::min(frame_.zero_low_min, low);
+        }
+        period_sum_ += period;
+    }
+
+    template <class OnFrame> void close(OnFrame &&on_frame) {
+        in_frame_ = false;
+        frame_.end_cycles = last_rise_;
+        frame_.stop_low = last_rise_ - bit_fall_;
+        has_end_ = true;
+        last_end_ = last_rise_;
+        if (frame_.bit_count == 0) {
+            // ストップビットだけ（ノイズ）
+            return;
+        }
+        frame_.length = std::min<std::size_t>(frame_.bit_count / 8, BusFrame::kMaxBytes);
+        frame_.bit_period = static_cast<uint32_t>(period_sum_ / frame_.bit_count);
+        if (frame_.zero_low_min == std::numeric_limits<uint32_t>::max()) {
+            frame_.zero_low_min = 0;
+        }
+        on_frame(static_cast<const BusFrame &>(frame_));
+    }
+
+    uint32_t end_high_cycles_;
+    bool level_{true};
+    bool in_frame_{false};
+    bool has_end_{false};
+    uint32_t last_end_{0};
+    uint32_t last_rise_{0};
+    uint32_t bit_fall_{0};
+    uint64_t period_sum_{0};
+    BusFrame frame_{};
+};
+
+// サイクル数をnsへ（clock_hzはスニファのクロック）
+constexpr uint32_t cycles_to_ns(uint32_t cycles, uint32_t clock_hz) {
+    const uint64_t ns = static_cast<uint64_t>(cycles) * 1'000'000'000u / clock_hz;
+    return static_cast<uint32_t>(std::min<uint64_t>(ns, std::numeric_limits<uint32_t>::max()));
+}
+
+constexpr uint32_t ns_to_cycles(uint32_t ns, uint32_t clock_hz) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(ns) * clock_hz / 1'000'000'000u);
+}
+
+// フレームを記録用のレコードへ。dataはframeを指すので、frameより先に使い終える
+inline telemetry::ProbeBusFrameRecord to_record(const BusFrame &frame, telemetry::ProbePort port,
+                                                uint32_t clock_hz) {
+    return telemetry::ProbeBusFrameRecord{
+        .port = port,
+        .bits = frame.bit_count,
+        .data = std::span<const uint8_t>(frame.bytes.data(), frame.length),
+        .bit_period_ns = cycles_to_ns(frame.bit_period, clock_hz),
+        .one_low_max_ns = cycles_to_ns(frame.one_low_max, clock_hz),
+        .zero_low_min_ns = cycles_to_ns(frame.zero_low_min, clock_hz),
+        .stop_low_ns = cycles_to_ns(frame.stop_low, clock_hz),
+        .has_gap = frame.has_gap,
+        .gap_ns = cycles_to_ns(frame.gap, clock_hz),
+    };
+}
+
+} // namespace gcinput::sniffer
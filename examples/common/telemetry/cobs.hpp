@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// COBS (Consistent Overhead Byte Stuffing)
+// 0x00を含まない列に変換するので、フレーム区切りに0x00を使える。オーバーヘッドは254バイトごとに1バイト
+namespace gcinput::telemetry::cobs {
+
+constexpr std::size_t max_encoded_size(std::size_t length) { return length + length / 254 + 1; }
+
+// inをエンコードしてoutへ書き、書いたバイト数を返す。outが足りなければ0
+// 区切りの0x00は付けない
+inline std::size_t encode(std::span<const uint8_t> in, std::span<uint8_t> out) {
+    if (out.size() < max_encoded_size(in.size())) {
+        return 0;
+    }
+    std::size_t code_index = 0;
+    std::size_t write = 1;
+    uint8_t code = 1;
+    for (const uint8_t byte : in) {
+        if (byte != 0) {
+            out[write++] = byte;
+            ++code;
+        }
+        if (byte == 0 || code == 0xFF) {
+            out[code_index] = code;
+            code_index = write++;
+            code = 1;
+        }
+    }
+    out[code_index] = code;
+    return write;
+}
+
+// 区切りを除いた1フレーム分をデコードしてoutへ書き、書いたバイト数を返す
+// 途中に0x00がある、長さが符号と合わない、outが足りないときはfalse
+inline bool decode(std::span<const uint8_t> in, std::span<uint8_t> out, std::size_t &length) {
+    std::size_t read = 0;
+    std::size_t write = 0;
+    while (read < in.size()) {
+        const uint8_t code = in[read++];
+        if (code == 0 || read + code - 1 > in.size()) {
+            return false;
+        }
+        for (uint8_t i = 1; i < code; ++i) {
+            if (in[read] == 0 || write >= out.size()) {
+                return false;
+            }
+            out[write++] = in[read++];
+        }
+        // 0xFFのブロックは暗黙の0x00を持たない。最後のブロックの後ろにも付けない
+        if (code != 0xFF && read < in.size()) {
+            if (write >= out.size()) {
+                return false;
+            }
+            out[write++] = 0;
+        }
+    }
+    length = write;
+    return true;
+}
+
+} // namespace gcinput::telemetry::cobs
@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gcinput::telemetry {
+
+// CRC-8 ATM (poly=0x07, init=0x00)
+// 以前の各ファームウェアのビットループ版と同じ値を、256エントリの表引きで求める
+namespace detail {
+constexpr std::array<uint8_t, 256> make_crc8_table() {
+    std::array<uint8_t, 256> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        uint8_t crc = static_cast<uint8_t>(i);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80u) ? static_cast<uint8_t>((crc << 1) ^ 0x07u)
+                                : static_cast<uint8_t>(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+} // namespace detail
+
+inline constexpr std::array<uint8_t, 256> kCrc8Table = detail::make_crc8_table();
+
+constexpr uint8_t crc8_update(uint8_t crc, uint8_t byte) { return kCrc8Table[crc ^ byte]; }
+
+constexpr uint8_t crc8(std::span<const uint8_t> data, uint8_t crc = 0x00) {
+    for (const uint8_t byte : data) {
+        crc = crc8_update(crc, byte);
+    }
+    return crc;
+}
+
+} // namespace gcinput::telemetry
@@ -0,0 +1,36 @@
+#pragma once
+#include "logging/log.hpp"
+#include "pico/stdlib.h"
+#include "telemetry/frame.hpp"
+#include <array>
+
+// ファームウェアからテレメトリレコードを送る
+// その場でフレームにエンコードしてloggingのキューへ積む。UARTへの送出はlogging::poll()が行う
+// mainループからだけ呼ぶ（loggingと同じ制約）
+namespace gcinput::telemetry {
+
+// timestamp_usはレコードが表す出来事の時刻（ISRで記録した時刻など）
+template <class Record>
+inline bool emit_at(const Record &record, uint32_t timestamp_us,
+                    logging::Level level = logging::Level::Data) {
+    std::array<uint8_t, kMaxEncodedFrame> frame{};
+    const std::size_t length = encode_frame(record, timestamp_us, frame);
+    if (length == 0) {
+        return false;
+    }
+    return logging::detail::push_frame(level, frame.data(), length);
+}
+
+// エンコード済みのフレーム（区切りの0x00まで）をそのまま積む。フラッシュに記録したフレームの再送用
+inline bool emit_encoded(std::span<const uint8_t> frame,
+                         logging::Level level = logging::Level::Data) {
+    return logging::detail::push_frame(level, frame.data(), frame.size());
+}
+
+// 呼び出した時刻をタイムスタンプにする
+template <class Record>
+inline bool emit(const Record &record, logging::Level level = logging::Level::Data) {
+    return emit_at(record, time_us_32(), level);
+}
+
+} // namespace gcinput::telemetry
@@ -0,0 +1,136 @@
+#pragma once
+#include "telemetry/cobs.hpp"
+#include "telemetry/crc8.hpp"
+#include "telemetry/records.hpp"
+#include "telemetry/varint.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// フレームの配置
+//
+//   COBS( type:u8 | timestamp_us:varint | payload | crc8 ) 0x00
+//
+// crc8はtypeからpayloadの末尾までに対するCRC-8 ATM
+// 受信側は0x00で区切り、COBSを戻してCRCを確かめてからtypeで振り分ける
+// 途中から受信を始めても次の0x00から同期できる
+namespace gcinput::telemetry {
+
+inline constexpr std::size_t kMaxPayload = 224;
+inline constexpr std::size_t kMaxRawFrame = 1 + varint::kMaxBytesU32 + kMaxPayload + 1;
+// COBSと区切りを含む1フレームの最大長
+inline constexpr std::size_t kMaxEncodedFrame = cobs::max_encoded_size(kMaxRawFrame) + 1;
+
+// recordを1フレームにしてoutへ書き、区切りを含むバイト数を返す
+// ペイロードがkMaxPayloadを超える、またはoutが足りなければ0
+template <class Record>
+std::size_t encode_frame(const Record &record, uint32_t timestamp_us, std::span<uint8_t> out) {
+    std::array<uint8_t, kMaxRawFrame> raw{};
+    raw[0] = static_cast<uint8_t>(Record::kType);
+    std::size_t length = 1 + varint::encode_u32(timestamp_us, &raw[1]);
+
+    Writer writer(std::span<uint8_t>(raw).subspan(length, kMaxPayload));
+    record.write(writer);
+    if (writer.overflow()) {
+        return 0;
+    }
+    length += writer.size();
+    raw[length] = crc8(std::span<const uint8_t>(raw.data(), length));
+    ++length;
+
+    if (out.empty()) {
+        return 0;
+    }
+    const std::size_t encoded =
+        cobs::encode(std::span<const uint8_t>(raw.data(), length), out.first(out.size() - 1));
+    if (encoded == 0) {
+        return 0;
+    }
+    out[encoded] = 0x00;
+    return encoded + 1;
+}
+
+// 検証済みの1フレーム。payloadは受信側のバッファを指すので、次のフレームを受け取るまでに使う
+struct RawFrame {
+    RecordType type{};
+    uint32_t timestamp_us{0};
+    std::span<const uint8_t> payload{};
+
+    // typeが一致すればpayloadを読み取る
+    template <class Record> bool decode(Record &out) const {
+        if (type != Record::kType) {
+            return false;
+        }
+        Reader reader(payload);
+        return Record::read(reader, out);
+    }
+};
+
+// バイト列からフレームを切り出す。ホスト側のデコーダが使う
+class FrameDecoder {
+  public:
+    struct Stats {
+        uint32_t frames{0};
+        // 長すぎて捨てたフレーム（区切りを取りこぼした等）
+        uint32_t overruns{0};
+        // COBSとして不正、または短すぎるフレーム
+        uint32_t framing_errors{0};
+        uint32_t crc_errors{0};
+    };
+
+    // dataを順に読み、完全なフレームが揃うたびにon_frame(const RawFrame&)を呼ぶ
+    template <class OnFrame> void feed(std::span<const uint8_t> data, OnFrame &&on_frame) {
+        for (const uint8_t byte : data) {
+            if (byte != 0x00) {
+                if (length_ < encoded_.size()) {
+                    encoded_[length_] = byte;
+                }
+                ++length_;
+                continue;
+            }
+            if (length_ > encoded_.size()) {
+                stats_.overruns++;
+            } else if (length_ > 0) {
+                RawFrame frame{};
+                if (parse(frame)) {
+                    stats_.frames++;
+                    on_frame(frame);
+                }
+            }
+            length_ = 0;
+        }
+    }
+
+    const Stats &stats() const { return stats_; }
+
+  private:
+    bool parse(RawFrame &frame) {
+        std::size_t length = 0;
+        if (!cobs::decode(std::span<const uint8_t>(encoded_.data(), length_), decoded_, length) ||
+            length < 3) {
+            stats_.framing_errors++;
+            return false;
+        }
+        const auto body = std::span<const uint8_t>(decoded_.data(), length - 1);
+        if (crc8(body) != decoded_[length - 1]) {
+            stats_.crc_errors++;
+            return false;
+        }
+        const std::size_t ts_length = varint::decode_u32(body.subspan(1), frame.timestamp_us);
+        if (ts_length == 0) {
+            stats_.framing_errors++;
+            return false;
+        }
+        frame.type = static_cast<RecordType>(body[0]);
+        frame.payload = body.subspan(1 + ts_length);
+        return true;
+    }
+
+    std::array<uint8_t, kMaxEncodedFrame> encoded_{};
+    std::array<uint8_t, kMaxRawFrame> decoded_{};
+    std::size_t length_{0};
+    Stats stats_{};
+};
+
+} // namespace gcinput::telemetry
@@ -0,0 +1,693 @@
+#pragma once
+#include "telemetry/varint.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// テレメトリのレコード定義（ファームウェアとホストの共通）
+// 各レコードはkTypeとペイロードの書き出し(write)/読み取り(read)を持つ
+// フレームの組み立てはframe.hpp
+namespace gcinput::telemetry {
+
+// プロトコルのバージョン。レコードの配置を変えたら上げる
+inline constexpr uint8_t kProtocolVersion = 1;
+
+enum class RecordType : uint8_t {
+    // 共通
+    Hello = 0x01,   // 起動時に1回。ファームウェア名とプロトコルバージョン
+    Text = 0x02,    // ログ行（logging経由のメッセージ）
+    Dropped = 0x03, // 送信側で捨てたレコード数
+
+    // measure / input_viewer
+    MeasureSample = 0x10,     // D行相当: フレーム番号と計測中の軸の値
+    InputSample = 0x11,       // I行相当: コンソールへ返したStatusレスポンス8バイト
+    ReplyKeyframe = 0x12,     // 全件ストリーム: 応答の全バイト（reply_stream.hpp）
+    ReplyDelta = 0x13,        // 全件ストリーム: 直前の応答から変わったバイトだけ
+    ReplyGap = 0x14,          // 全件ストリーム: 送れずに飛ばした応答の範囲
+    MeasureRun = 0x15,        // K行: 計測の通し番号と走査位置（途中から再開した記録をつなぐ）
+    MeasureAck = 0x16,        // A行: ホストの値の指示への応答
+    MeasureCorrection = 0x17, // Q行: 補正の検証で、注入した生の値と補正後の値
+
+    // bridge
+    ProfileAck = 0x18, // F行: 補正プロファイルの書き込みへの応答
+
+    // debug_probe
+    ProbeFrame = 0x20,    // T行相当: JoyBusの送受信データ
+    ProbeState = 0x21,    // S行相当: 状態遷移（"from -> to"）
+    ProbeTimeout = 0x22,  // M行のタイムアウト通知
+    ProbeSummary = 0x23,  // U行相当: Ready中のStatusポーリング集計
+    ProbeCapture = 0x24,  // X行: トリガで凍結した区間の見出し（中身は続くProbeレコード）
+    ProbeTiming = 0x25,   // L行: 通信タイミングの統計（一定期間ごと）
+    ProbeEdges = 0x26,    // スニファの生のエッジ列（ホストがProbeBusFrameへ組み立てる）
+    ProbeBusFrame = 0x27, // B行: スニファがエッジから組み立てたフレームとビットの時間
+};
+
+// ペイロードの書き出し。容量を超えたらoverflowを立ててそれ以降は書かない
+class Writer {
+  public:
+    explicit Writer(std::span<uint8_t> out) : out_{out} {}
+
+    void u8(uint8_t value) {
+        if (size_ >= out_.size()) {
+            overflow_ = true;
+            return;
+        }
+        out_[size_++] = value;
+    }
+
+    void u16(uint16_t value) {
+        u8(static_cast<uint8_t>(value));
+        u8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void var_u32(uint32_t value) {
+        std::array<uint8_t, varint::kMaxBytesU32> encoded{};
+        bytes(std::span<const uint8_t>(encoded.data(), varint::encode_u32(value, encoded.data())));
+    }
+
+    void bytes(std::span<const uint8_t> data) {
+        for (const uint8_t byte : data) {
+            u8(byte);
+        }
+    }
+
+    // 長さを前置しない。ペイロードの残り全部を文字列として扱うレコード用
+    void tail_text(std::string_view text) {
+        for (const char c : text) {
+            u8(static_cast<uint8_t>(c));
+        }
+    }
+
+    std::size_t size() const { return size_; }
+    bool overflow() const { return overflow_; }
+
+  private:
+    std::span<uint8_t> out_;
+    std::size_t size_{0};
+    bool overflow_{false};
+};
+
+// ペイロードの読み取り。足りなければerrorを立てて0を返す
+class Reader {
+  public:
+    explicit Reader(std::span<const uint8_t> in) : in_{in} {}
+
+    uint8_t u8() {
+        if (pos_ >= in_.size()) {
+            error_ = true;
+            return 0;
+        }
+        return in_[pos_++];
+    }
+
+    uint16_t u16() {
+        const uint8_t lo = u8();
+        const uint8_t hi = u8();
+        return static_cast<uint16_t>(lo | (hi << 8));
+    }
+
+    uint32_t var_u32() {
+        uint32_t value = 0;
+        const std::size_t n = varint::decode_u32(in_.subspan(pos_), value);
+        if (n == 0) {
+            error_ = true;
+            return 0;
+        }
+        pos_ += n;
+        return value;
+    }
+
+    std::span<const uint8_t> bytes(std::size_t length) {
+        if (in_.size() - pos_ < length) {
+            error_ = true;
+            return {};
+        }
+        const auto out = in_.subspan(pos_, length);
+        pos_ += length;
+        return out;
+    }
+
+    // 長さを前置しないバイト列（ペイロードの残り全部）
+    std::span<const uint8_t> tail_bytes() {
+        const auto rest = in_.subspan(pos_);
+        pos_ = in_.size();
+        return rest;
+    }
+
+    std::string_view tail_text() {
+        const auto rest = in_.subspan(pos_);
+        pos_ = in_.size();
+        return {reinterpret_cast<const char *>(rest.data()), rest.size()};
+    }
+
+    // 読み終えたときに余りがなく、途中で不足もなかったか
+    bool ok() const { return !error_ && pos_ == in_.size(); }
+
+  private:
+    std::span<const uint8_t> in_;
+    std::size_t pos_{0};
+    bool error_{false};
+};
+
+// ─── 共通 ───
+
+struct HelloRecord {
+    static constexpr RecordType kType = RecordType::Hello;
+    uint8_t version{kProtocolVersion};
+    std::string_view firmware{};
+
+    void write(Writer &w) const {
+        w.u8(version);
+        w.tail_text(firmware);
+    }
+    static bool read(Reader &r, HelloRecord &out) {
+        out.version = r.u8();
+        out.firmware = r.tail_text();
+        return r.ok();
+    }
+};
+
+struct TextRecord {
+    static constexpr RecordType kType = RecordType::Text;
+    uint8_t level{0}; // logging::Level
+    std::string_view text{};
+
+    void write(Writer &w) const {
+        w.u8(level);
+        w.tail_text(text);
+    }
+    static bool read(Reader &r, TextRecord &out) {
+        out.level = r.u8();
+        out.text = r.tail_text();
+        return r.ok();
+    }
+};
+
+struct DroppedRecord {
+    static constexpr RecordType kType = RecordType::Dropped;
+    uint32_t full{0}; // 前回の通知以降にキュー満杯で捨てた件数
+    uint32_t rate{0}; // 前回の通知以降にレート制限で捨てた件数
+
+    void write(Writer &w) const {
+        w.var_u32(full);
+        w.var_u32(rate);
+    }
+    static bool read(Reader &r, DroppedRecord &out) {
+        out.full = r.var_u32();
+        out.rate = r.var_u32();
+        return r.ok();
+    }
+};
+
+// ─── measure / input_viewer ───
+
+struct MeasureSampleRecord {
+    static constexpr RecordType kType = RecordType::MeasureSample;
+    uint16_t frame{0};
+    uint8_t first{0};
+    uint8_t second{0};
+
+    void write(Writer &w) const {
+        w.u16(frame);
+        w.u8(first);
+        w.u8(second);
+    }
+    static bool read(Reader &r, MeasureSampleRecord &out) {
+        out.frame = r.u16();
+        out.first = r.u8();
+        out.second = r.u8();
+        return r.ok();
+    }
+};
+
+// MeasureRunRecordの契機
+enum class MeasureRunEvent : uint8_t {
+    Start = 0,      // 新しい計測を始めた（run_idが変わる）
+    Resume = 1,     // 中断した計測を続きから再開した
+    Checkpoint = 2, // 走査位置をフラッシュへ保存した（書き込みはこの直後の空き時間）
+};
+
+// 計測の通し番号と走査位置。frameは続くD行のフレーム番号（16bitへ丸める前の値）
+// 再開するとframeは中断前の値から続くので、ホストは(run_id, frame)で記録をつなげられる
+struct MeasureRunRecord {
+    static constexpr RecordType kType = RecordType::MeasureRun;
+    MeasureRunEvent event{MeasureRunEvent::Start};
+    uint32_t run_id{0};
+    uint32_t position{0}; // パターン上の位置（パターンごとの値）
+    uint32_t frame{0};
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(event));
+        w.var_u32(run_id);
+        w.var_u32(position);
+        w.var_u32(frame);
+    }
+    static bool read(Reader &r, MeasureRunRecord &out) {
+        out.event = static_cast<MeasureRunEvent>(r.u8());
+        out.run_id = r.var_u32();
+        out.position = r.var_u32();
+        out.frame = r.var_u32();
+        return r.ok();
+    }
+};
+
+// ホストの値の指示（measure/host_command_receiver.hpp）への応答の種類
+enum class MeasureAckStatus : uint8_t {
+    Queued = 0,   // 待ち行列に積んだ
+    Live = 1,     // その値をコンソールへ送り始めた（console_frameのフレームから）
+    Full = 2,     // 待ち行列が満杯で捨てた
+    Rejected = 3, // 行が読めない、値が範囲外（seqは0）
+    Released = 4, // 待ち行列を捨ててパターンへ戻った（queuedは捨てた数）
+};
+
+struct MeasureAckRecord {
+    static constexpr RecordType kType = RecordType::MeasureAck;
+    MeasureAckStatus status{MeasureAckStatus::Queued};
+    uint32_t seq{0};
+    uint32_t console_frame{0}; // コンソールのStatus要求から数えたフレーム（起動から）
+    uint8_t queued{0};         // 待ち行列に残っている数
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(status));
+        w.var_u32(seq);
+        w.var_u32(console_frame);
+        w.u8(queued);
+    }
+    static bool read(Reader &r, MeasureAckRecord &out) {
+        out.status = static_cast<MeasureAckStatus>(r.u8());
+        out.seq = r.var_u32();
+        out.console_frame = r.var_u32();
+        out.queued = r.u8();
+        return r.ok();
+    }
+};
+
+// 補正の検証（measureのkVerifyCorrection）で、D行の点ごとに出す
+// rawはパターンが注入した生の値s、outは補正パイプラインを通した値P(s)（D行の値と同じ）
+struct MeasureCorrectionRecord {
+    static constexpr RecordType kType = RecordType::MeasureCorrection;
+    uint16_t frame{0}; // 同じ点のD行のフレーム番号
+    uint8_t raw_x{0};
+    uint8_t raw_y{0};
+    uint8_t out_x{0};
+    uint8_t out_y{0};
+
+    void write(Writer &w) const {
+        w.u16(frame);
+        w.u8(raw_x);
+        w.u8(raw_y);
+        w.u8(out_x);
+        w.u8(out_y);
+    }
+    static bool read(Reader &r, MeasureCorrectionRecord &out) {
+        out.frame = r.u16();
+        out.raw_x = r.u8();
+        out.raw_y = r.u8();
+        out.out_x = r.u8();
+        out.out_y = r.u8();
+        return r.ok();
+    }
+};
+
+// 補正プロファイルの書き込み（bridgeのcalibration/profile_upload.hpp）への応答の種類
+enum class ProfileAckStatus : uint8_t {
+    Ready = 0,     // スロットを消し終えた（offsetから送ってよい）
+    Written = 1,   // offsetの手前まで書いて読み戻した
+    Activated = 2, // ヘッダと表のCRCが合い、そのプロファイルへ切り替えた
+    Rejected = 3,  // 書き込みを始められない（番号が範囲外、選んでいるスロット、書き込み中）
+    Failed = 4,    // 止めた（スロットは空のまま）。offsetは止めた位置、crcはそこまでの表のCRC
+};
+
+struct ProfileAckRecord {
+    static constexpr RecordType kType = RecordType::ProfileAck;
+    ProfileAckStatus status{ProfileAckStatus::Ready};
+    uint8_t slot{0};    // プロファイルの番号（1..）
+    uint32_t offset{0}; // スロットの先頭からのバイト数
+    uint32_t crc{0};    // Activated/Failedのとき、書いた表のCRC-32
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(status));
+        w.u8(slot);
+        w.var_u32(offset);
+        w.var_u32(crc);
+    }
+    static bool read(Reader &r, ProfileAckRecord &out) {
+        out.status = static_cast<ProfileAckStatus>(r.u8());
+        out.slot = r.u8();
+        out.offset = r.var_u32();
+        out.crc = r.var_u32();
+        return r.ok();
+    }
+};
+
+struct InputSampleRecord {
+    static constexpr RecordType kType = RecordType::InputSample;
+    // wireバイト: [0]=BH, [1]=BL, [2]=SX, [3]=SY, [4]=CX, [5]=CY, [6]=LT, [7]=RT
+    std::array<uint8_t, 8> status{};
+
+    void write(Writer &w) const { w.bytes(status); }
+    static bool read(Reader &r, InputSampleRecord &out) {
+        const auto bytes = r.bytes(out.status.size());
+        std::copy(bytes.begin(), bytes.end(), out.status.begin());
+        return r.ok();
+    }
+};
+
+// コンソールへ返した応答の全件ストリーム（input_viewerのUSB CDC出力）
+// 応答の最大長（joybus::kMaxResponseSize）
+inline constexpr std::size_t kMaxReplyBytes = 10;
+
+struct ReplyKeyframeRecord {
+    static constexpr RecordType kType = RecordType::ReplyKeyframe;
+    uint32_t publish_count{0};
+    uint8_t command{0};
+    std::span<const uint8_t> bytes{};
+
+    void write(Writer &w) const {
+        const std::size_t length = std::min(bytes.size(), kMaxReplyBytes);
+        w.var_u32(publish_count);
+        w.u8(command);
+        w.u8(static_cast<uint8_t>(length));
+        w.bytes(bytes.first(length));
+    }
+    static bool read(Reader &r, ReplyKeyframeRecord &out) {
+        out.publish_count = r.var_u32();
+        out.command = r.u8();
+        out.bytes = r.bytes(r.u8());
+        return r.ok() && out.bytes.size() <= kMaxReplyBytes;
+    }
+};
+
+// publish_countは直前の応答+1、コマンドと長さは直前と同じ
+// seqはpublish_countの下位8ビット。受信側で取りこぼしに気づけるようにする
+struct ReplyDeltaRecord {
+    static constexpr RecordType kType = RecordType::ReplyDelta;
+    uint8_t seq{0};
+    // bit i: i番目のバイトが変わった。変わったバイトだけをchangedに昇順で並べる
+    uint16_t mask{0};
+    std::span<const uint8_t> changed{};
+
+    void write(Writer &w) const {
+        w.u8(seq);
+        w.u16(mask);
+        w.bytes(changed);
+    }
+    static bool read(Reader &r, ReplyDeltaRecord &out) {
+        out.seq = r.u8();
+        out.mask = r.u16();
+        out.changed = r.bytes(static_cast<std::size_t>(std::popcount(out.mask)));
+        return r.ok();
+    }
+};
+
+struct ReplyGapRecord {
+    static constexpr RecordType kType = RecordType::ReplyGap;
+    uint32_t first_missing{0}; // 飛ばした最初の応答のpublish_count
+    uint32_t count{0};         // 飛ばした件数
+
+    void write(Writer &w) const {
+        w.var_u32(first_missing);
+        w.var_u32(count);
+    }
+    static bool read(Reader &r, ReplyGapRecord &out) {
+        out.first_missing = r.var_u32();
+        out.count = r.var_u32();
+        return r.ok();
+    }
+};
+
+// ─── debug_probe ───
+
+enum class ProbePort : uint8_t { Pad = 0, Console = 1 };
+enum class ProbeDir : uint8_t { TX = 0, RX = 1 };
+
+struct ProbeFrameRecord {
+    static constexpr RecordType kType = RecordType::ProbeFrame;
+    static constexpr std::size_t kMaxData = 16;
+
+    // flags: bit0=port, bit1=dir, bit2=PollMode情報あり
+    static constexpr uint8_t kFlagConsole = 1u << 0;
+    static constexpr uint8_t kFlagRx = 1u << 1;
+    static constexpr uint8_t kFlagPollMode = 1u << 2;
+
+    ProbePort port{ProbePort::Pad};
+    ProbeDir dir{ProbeDir::TX};
+    uint8_t command{0};
+    std::span<const uint8_t> data{};
+    bool has_poll_mode{false};
+    uint8_t poll_mode_pad{0};
+    uint8_t poll_mode_console{0};
+    uint8_t poll_mode_reply{0};
+
+    void write(Writer &w) const {
+        uint8_t flags = 0;
+        flags |= (port == ProbePort::Console) ? kFlagConsole : 0;
+        flags |= (dir == ProbeDir::RX) ? kFlagRx : 0;
+        flags |= has_poll_mode ? kFlagPollMode : 0;
+        const std::size_t length = std::min(data.size(), kMaxData);
+        w.u8(flags);
+        w.u8(command);
+        w.u8(static_cast<uint8_t>(length));
+        w.bytes(data.first(length));
+        if (has_poll_mode) {
+            w.u8(poll_mode_pad);
+            w.u8(poll_mode_console);
+            w.u8(poll_mode_reply);
+        }
+    }
+    static bool read(Reader &r, ProbeFrameRecord &out) {
+        const uint8_t flags = r.u8();
+        out.port = (flags & kFlagConsole) ? ProbePort::Console : ProbePort::Pad;
+        out.dir = (flags & kFlagRx) ? ProbeDir::RX : ProbeDir::TX;
+        out.has_poll_mode = (flags & kFlagPollMode) != 0;
+        out.command = r.u8();
+        out.data = r.bytes(r.u8());
+        if (out.has_poll_mode) {
+            out.poll_mode_pad = r.u8();
+            out.poll_mode_console = r.u8();
+            out.poll_mode_reply = r.u8();
+        }
+        return r.ok();
+    }
+};
+
+// ProbeStateとProbeTimeoutは同じ配置（ポート + 文字列）
+template <RecordType Type> struct ProbeTextRecord {
+    static constexpr RecordType kType = Type;
+    ProbePort port{ProbePort::Pad};
+    std::string_view text{};
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(port));
+        w.tail_text(text);
+    }
+    static bool read(Reader &r, ProbeTextRecord &out) {
+        out.port = static_cast<ProbePort>(r.u8() & 1u);
+        out.text = r.tail_text();
+        return r.ok();
+    }
+};
+
+using ProbeStateRecord = ProbeTextRecord<RecordType::ProbeState>;
+using ProbeTimeoutRecord = ProbeTextRecord<RecordType::ProbeTimeout>;
+
+struct ProbeSummaryRecord {
+    static constexpr RecordType kType = RecordType::ProbeSummary;
+    ProbePort port{ProbePort::Pad};
+    uint32_t polls{0};
+    uint32_t ok{0};
+    uint32_t timeout{0};
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(port));
+        w.var_u32(polls);
+        w.var_u32(ok);
+        w.var_u32(timeout);
+    }
+    static bool read(Reader &r, ProbeSummaryRecord &out) {
+        out.port = static_cast<ProbePort>(r.u8() & 1u);
+        out.polls = r.var_u32();
+        out.ok = r.var_u32();
+        out.timeout = r.var_u32();
+        return r.ok();
+    }
+};
+
+// トリガの種類（debug_probeのdebug_log::TriggerTypeと同じ値）
+enum class ProbeTrigger : uint8_t { Command = 1, Timeout = 2, State = 3, Pattern = 4 };
+
+// トリガ前後の凍結区間。フレームの時刻はトリガになった1件の時刻
+// 直後にpre + 1 + post件のProbeFrame/ProbeState/ProbeTimeoutが古い順に続く
+struct ProbeCaptureRecord {
+    static constexpr RecordType kType = RecordType::ProbeCapture;
+    ProbeTrigger trigger{ProbeTrigger::Command};
+    uint32_t pre{0};
+    uint32_t post{0};
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(trigger));
+        w.var_u32(pre);
+        w.var_u32(post);
+    }
+    static bool read(Reader &r, ProbeCaptureRecord &out) {
+        out.trigger = static_cast<ProbeTrigger>(r.u8());
+        out.pre = r.var_u32();
+        out.post = r.var_u32();
+        return r.ok();
+    }
+};
+
+// 統計を取るタイミング（debug_probeのdebug_timing::Metricと同じ値）
+enum class ProbeTimingMetric : uint8_t {
+    ConsolePollInterval = 0, // コンソールのStatus要求の間隔
+    PadRoundTrip = 1,        // パッドへの要求の送信開始から応答の受信完了まで
+    ReplyGap = 2,            // コンソールの要求の受信完了から応答の送信開始まで
+    SampleAge = 3,           // 応答に使ったパッドのStatusを受信してから応答を組み立てるまで
+};
+
+// 1つのタイミングの一定期間の統計（µs）。フレームの時刻は期間の終わり
+struct ProbeTimingRecord {
+    static constexpr RecordType kType = RecordType::ProbeTiming;
+    ProbeTimingMetric metric{ProbeTimingMetric::ConsolePollInterval};
+    uint32_t count{0};
+    uint32_t min{0};
+    uint32_t mean{0};
+    uint32_t max{0};
+    uint32_t p50{0};
+    uint32_t p99{0};
+    uint32_t jitter{0};
+
+    void write(Writer &w) const {
+        w.u8(static_cast<uint8_t>(metric));
+        w.var_u32(count);
+        w.var_u32(min);
+        w.var_u32(mean);
+        w.var_u32(max);
+        w.var_u32(p50);
+        w.var_u32(p99);
+        w.var_u32(jitter);
+    }
+    static bool read(Reader &r, ProbeTimingRecord &out) {
+        out.metric = static_cast<ProbeTimingMetric>(r.u8());
+        out.count = r.var_u32();
+        out.min = r.var_u32();
+        out.mean = r.var_u32();
+        out.max = r.var_u32();
+        out.p50 = r.var_u32();
+        out.p99 = r.var_u32();
+        out.jitter = r.var_u32();
+        return r.ok();
+    }
+};
+
+// スニファが記録したエッジの並び（sniffer/edge_decoder.hpp）
+// 立ち下がりと立ち上がりは交互なので、最初のエッジの向きだけを持つ
+// deltasは直前のエッジからのサイクル数をvarintでcount - 1個並べたもの
+struct ProbeEdgesRecord {
+    static constexpr RecordType kType = RecordType::ProbeEdges;
+    static constexpr uint8_t kFlagConsole = 1u << 0;
+    static constexpr uint8_t kFlagFirstHigh = 1u << 1;
+    // 直前のレコードとつながっていない（送れずに捨てたレコードがある）
+    static constexpr uint8_t kFlagRestart = 1u << 2;
+    // 最後のエッジのあと線が止まった（組み立て中のフレームを閉じてよい）
+    static constexpr uint8_t kFlagIdle = 1u << 3;
+
+    ProbePort port{ProbePort::Pad};
+    bool first_high{false};
+    bool restart{false};
+    bool idle{false};
+    uint32_t clock_hz{0};
+    uint32_t first_cycles{0};
+    uint32_t count{0};
+    std::span<const uint8_t> deltas{};
+
+    void write(Writer &w) const {
+        uint8_t flags = 0;
+        flags |= (port == ProbePort::Console) ? kFlagConsole : 0;
+        flags |= first_high ? kFlagFirstHigh : 0;
+        flags |= restart ? kFlagRestart : 0;
+        flags |= idle ? kFlagIdle : 0;
+        w.u8(flags);
+        w.var_u32(clock_hz);
+        w.var_u32(first_cycles);
+        w.var_u32(count);
+        w.bytes(deltas);
+    }
+    static bool read(Reader &r, ProbeEdgesRecord &out) {
+        const uint8_t flags = r.u8();
+        out.port = (flags & kFlagConsole) ? ProbePort::Console : ProbePort::Pad;
+        out.first_high = (flags & kFlagFirstHigh) != 0;
+        out.restart = (flags & kFlagRestart) != 0;
+        out.idle = (flags & kFlagIdle) != 0;
+        out.clock_hz = r.var_u32();
+        out.first_cycles = r.var_u32();
+        out.count = r.var_u32();
+        out.deltas = r.tail_bytes();
+        // 差分の数がcountと合うこと
+        std::size_t pos = 0;
+        for (uint32_t i = 1; i < out.count; ++i) {
+            uint32_t delta = 0;
+            const std::size_t n = varint::decode_u32(out.deltas.subspan(pos), delta);
+            if (n == 0) {
+                return false;
+            }
+            pos += n;
+        }
+        return r.ok() && out.clock_hz != 0 && out.count != 0 && pos == out.deltas.size();
+    }
+};
+
+// スニファが組み立てた1フレーム（時間はns）。フレームの時刻は組み立てた時刻
+struct ProbeBusFrameRecord {
+    static constexpr RecordType kType = RecordType::ProbeBusFrame;
+    static constexpr std::size_t kMaxData = 16;
+    static constexpr uint8_t kFlagConsole = 1u << 0;
+    static constexpr uint8_t kFlagGap = 1u << 1;
+
+    ProbePort port{ProbePort::Pad};
+    uint32_t bits{0}; // ストップビットを除くビット数
+    std::span<const uint8_t> data{};
+    uint32_t bit_period_ns{0};
+    uint32_t one_low_max_ns{0};
+    uint32_t zero_low_min_ns{0};
+    uint32_t stop_low_ns{0};
+    bool has_gap{false};
+    uint32_t gap_ns{0}; // 直前のフレームの終わりからの間隔
+
+    void write(Writer &w) const {
+        uint8_t flags = 0;
+        flags |= (port == ProbePort::Console) ? kFlagConsole : 0;
+        flags |= has_gap ? kFlagGap : 0;
+        const std::size_t length = std::min(data.size(), kMaxData);
+        w.u8(flags);
+        w.var_u32(bits);
+        w.u8(static_cast<uint8_t>(length));
+        w.bytes(data.first(length));
+        w.var_u32(bit_period_ns);
+        w.var_u32(one_low_max_ns);
+        w.var_u32(zero_low_min_ns);
+        w.var_u32(stop_low_ns);
+        if (has_gap) {
+            w.var_u32(gap_ns);
+        }
+    }
+    static bool read(Reader &r, ProbeBusFrameRecord &out) {
+        const uint8_t flags = r.u8();
+        out.port = (flags & kFlagConsole) ? ProbePort::Console : ProbePort::Pad;
+        out.has_gap = (flags & kFlagGap) != 0;
+        out.bits = r.var_u32();
+        out.data = r.bytes(r.u8());
+        out.bit_period_ns = r.var_u32();
+        out.one_low_max_ns = r.var_u32();
+        out.zero_low_min_ns = r.var_u32();
+        out.stop_low_ns = r.var_u32();
+        out.gap_ns = out.has_gap ? r.var_u32() : 0;
+        return r.ok();
+    }
+};
+
+} // namespace gcinput::telemetry
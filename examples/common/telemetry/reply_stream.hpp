@@ -0,0 +1,117 @@
+#pragma once
+#include "telemetry/frame.hpp"
+#include "telemetry/records.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// コンソールへ返した応答の全件ストリーム
+//
+//   ReplyGap      送れなかった応答の範囲（publish_countが飛んだとき）
+//   ReplyKeyframe 応答の全バイト
+//   ReplyDelta    直前の応答から変わったバイトだけ
+//
+// キーフレームは最初の1件、飛びの直後、コマンドか長さが変わったとき、
+// 前のキーフレームからkKeyframeIntervalUs経ったときに入れる。途中から受信しても次のキーフレームで復元できる
+namespace gcinput::telemetry {
+
+// ストリームへ流す応答1件
+struct ReplySample {
+    uint32_t publish_count{0};
+    uint32_t timestamp_us{0};
+    uint8_t command{0};
+    std::span<const uint8_t> bytes{};
+};
+
+// 1件あたりの最大出力（ギャップ+キーフレーム）
+inline constexpr std::size_t kMaxReplyStreamOutput = 64;
+
+class ReplyStreamEncoder {
+  public:
+    // 件数ではなく応答の時刻で決める。コンソールはStatusを1フレーム（約16.7ms）に1回ほど要求するので
+    // 0.25秒ならキーフレーム1件に差分が15件ほど続く（要求の間隔が短いゲームでも0.25秒で戻る）
+    static constexpr uint32_t kKeyframeIntervalUs = 250'000;
+
+    // sampleをフレーム列にしてoutへ書き、書いたバイト数を返す
+    // outが足りなければ0を返し、状態は変えない（同じsampleで呼び直せる）
+    std::size_t encode(const ReplySample &sample, std::span<uint8_t> out) {
+        const std::size_t length = std::min(sample.bytes.size(), kMaxReplyBytes);
+        const auto bytes = sample.bytes.first(length);
+        // 飛ばした件数。publish_countが戻ったとき（送り元のハブが替わった等）は負になる
+        const auto skipped =
+            static_cast<int32_t>(sample.publish_count - last_publish_count_ - 1);
+        const bool gap = has_base_ && skipped > 0;
+        const bool keyframe = !has_base_ || skipped != 0 || sample.command != command_ ||
+                              length != length_ || force_keyframe_ ||
+                              sample.timestamp_us - keyframe_us_ >= kKeyframeIntervalUs;
+
+        std::size_t written = 0;
+        if (gap) {
+            const ReplyGapRecord record{
+                .first_missing = last_publish_count_ + 1,
+                .count = static_cast<uint32_t>(skipped),
+            };
+            written = encode_frame(record, sample.timestamp_us, out);
+            if (written == 0) {
+                return 0;
+            }
+        }
+
+        std::size_t frame = 0;
+        if (keyframe) {
+            const ReplyKeyframeRecord record{
+                .publish_count = sample.publish_count,
+                .command = sample.command,
+                .bytes = bytes,
+            };
+            frame = encode_frame(record, sample.timestamp_us, out.subspan(written));
+        } else {
+            std::array<uint8_t, kMaxReplyBytes> changed{};
+            std::size_t count = 0;
+            uint16_t mask = 0;
+            for (std::size_t i = 0; i < length; ++i) {
+                if (bytes[i] != bytes_[i]) {
+                    mask |= static_cast<uint16_t>(1u << i);
+                    changed[count++] = bytes[i];
+                }
+            }
+            const ReplyDeltaRecord record{
+                .seq = static_cast<uint8_t>(sample.publish_count),
+                .mask = mask,
+                .changed = std::span<const uint8_t>(changed.data(), count),
+            };
+            frame = encode_frame(record, sample.timestamp_us, out.subspan(written));
+        }
+        if (frame == 0) {
+            return 0;
+        }
+
+        has_base_ = true;
+        last_publish_count_ = sample.publish_count;
+        command_ = sample.command;
+        length_ = length;
+        std::copy(bytes.begin(), bytes.end(), bytes_.begin());
+        if (keyframe) {
+            keyframe_us_ = sample.timestamp_us;
+            force_keyframe_ = false;
+        }
+        return written + frame;
+    }
+
+    // 次の1件を必ずキーフレームにする（受信側がつながり直したとき等）
+    // publish_countの連続性は保つので、飛びがあればギャップも出る
+    void force_keyframe() { force_keyframe_ = true; }
+
+  private:
+    bool has_base_{false};
+    uint32_t last_publish_count_{0};
+    uint8_t command_{0};
+    std::size_t length_{0};
+    std::array<uint8_t, kMaxReplyBytes> bytes_{};
+    uint32_t keyframe_us_{0}; // 最後のキーフレームの時刻
+    bool force_keyframe_{false};
+};
+
+} // namespace gcinput::telemetry
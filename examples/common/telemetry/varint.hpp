@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// 符号なしLEB128。下位7ビットずつ、続きがあれば最上位ビットを立てる
+// タイムスタンプ(us)や件数は小さい値が多いので、固定長より短くなる
+namespace gcinput::telemetry::varint {
+
+inline constexpr std::size_t kMaxBytesU32 = 5;
+
+// outへ書いたバイト数を返す（outはkMaxBytesU32以上）
+constexpr std::size_t encode_u32(uint32_t value, uint8_t *out) {
+    std::size_t n = 0;
+    while (value >= 0x80u) {
+        out[n++] = static_cast<uint8_t>(value | 0x80u);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// 読んだバイト数を返す。途中で切れている、または32ビットに収まらないときは0
+constexpr std::size_t decode_u32(std::span<const uint8_t> in, uint32_t &value) {
+    uint32_t result = 0;
+    for (std::size_t i = 0; i < in.size() && i < kMaxBytesU32; ++i) {
+        const uint8_t byte = in[i];
+        if (i == kMaxBytesU32 - 1 && byte > 0x0Fu) {
+            return 0;
+        }
+        result |= static_cast<uint32_t>(byte & 0x7Fu) << (7 * i);
+        if ((byte & 0x80u) == 0) {
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace gcinput::telemetry::varint
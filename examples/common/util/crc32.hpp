@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gcinput {
+
+// CRC-32（IEEE 802.3、zlib.crc32と同じ値）
+// 数百KBを起動時に確かめるのに使う。表は16エントリ（4ビットずつ）でフラッシュを食わない
+namespace detail {
+constexpr std::array<uint32_t, 16> make_crc32_nibble_table() {
+    std::array<uint32_t, 16> table{};
+    for (uint32_t i = 0; i < table.size(); ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 4; ++bit) {
+            crc = (crc & 1u) ? (crc >> 1) ^ 0xEDB8'8320u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+} // namespace detail
+
+inline constexpr std::array<uint32_t, 16> kCrc32NibbleTable = detail::make_crc32_nibble_table();
+
+// 途中から続けて計算できる。最初はcrc=0
+constexpr uint32_t crc32_update(uint32_t crc, std::span<const uint8_t> data) {
+    crc = ~crc;
+    for (const uint8_t byte : data) {
+        crc ^= byte;
+        crc = (crc >> 4) ^ kCrc32NibbleTable[crc & 0x0Fu];
+        crc = (crc >> 4) ^ kCrc32NibbleTable[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+constexpr uint32_t crc32(std::span<const uint8_t> data) { return crc32_update(0, data); }
+
+} // namespace gcinput
@@ -0,0 +1,94 @@
+#pragma once
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// リンカスクリプトが置く、フラッシュ上のファームウェアの終わり
+extern "C" char __flash_binary_end;
+
+// フラッシュの末尾に置く保存領域の共通の処理
+// （bridge の補正プロファイル、measure の走査位置、debug_probe の記録）
+//
+// 書き込みと消去の間はXIPが止まるため割り込みも止める。ページ（256B）の書き込みは1ms弱で
+// コンソールの要求の合間に収まるが、セクタ（4KB）の消去は数十msかかり、その間の要求には応えられない
+// どちらも ConsoleWindow で要求の直後かコンソールが止まっている間に1回ずつ行う
+namespace gcinput::flash {
+
+// フラッシュ先頭からregion_offsetより後ろがファームウェアと重ならないか
+inline bool region_available(uint32_t region_offset) {
+    const uint32_t binary_end =
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&__flash_binary_end) - XIP_BASE);
+    return binary_end <= region_offset;
+}
+
+// XIPから読む（フラッシュ先頭からのオフセット）
+inline const uint8_t *read(uint32_t flash_offset) {
+    return reinterpret_cast<const uint8_t *>(XIP_BASE + flash_offset);
+}
+
+// 消去したまま（全部0xFF）か
+inline bool is_blank(uint32_t flash_offset, uint32_t length) {
+    const uint8_t *data = read(flash_offset);
+    for (uint32_t i = 0; i < length; ++i) {
+        if (data[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void erase_sector(uint32_t flash_offset) {
+    const uint32_t irq = save_and_disable_interrupts();
+    flash_range_erase(flash_offset, FLASH_SECTOR_SIZE);
+    restore_interrupts(irq);
+}
+
+// 1ページに満たない分は0xFF（書いても変わらない）で埋める
+inline void program_page(uint32_t flash_offset, std::span<const uint8_t> data) {
+    std::array<uint8_t, FLASH_PAGE_SIZE> page{};
+    page.fill(0xFF);
+    std::memcpy(page.data(), data.data(), std::min<std::size_t>(data.size(), page.size()));
+
+    const uint32_t irq = save_and_disable_interrupts();
+    flash_range_program(flash_offset, page.data(), FLASH_PAGE_SIZE);
+    restore_interrupts(irq);
+}
+
+// コンソールの要求（か応答）からの時間で、フラッシュを触ってよいかを決める
+// 要求1回につき1操作まで。コンソールが止まっていればいつでもよい
+class ConsoleWindow {
+  public:
+    // これだけ要求がなければコンソールは止まっている（消去してよい）
+    static constexpr uint32_t kConsoleIdleUs = 100'000;
+
+    struct Timing {
+        uint32_t start_us; // 要求からこれだけ経ったら触ってよい（応答を送り終えた）
+        uint32_t end_us;   // これを過ぎたら次の要求が近い
+    };
+
+    constexpr explicit ConsoleWindow(Timing timing) : timing_(timing) {}
+
+    // last_us は最後の要求（か応答）の時刻。seen が false ならまだ一度も来ていない
+    // 触ってよければ true。console_idle はコンソールが止まっているか
+    bool open(uint32_t now_us, uint32_t last_us, bool seen, bool &console_idle) const {
+        const uint32_t since_us = now_us - last_us;
+        console_idle = !seen || since_us >= kConsoleIdleUs;
+        const bool after_request =
+            last_us != used_us_ && since_us >= timing_.start_us && since_us < timing_.end_us;
+        return after_request || console_idle;
+    }
+
+    // 操作したら、open() に渡した last_us で呼ぶ
+    void use(uint32_t last_us) { used_us_ = last_us; }
+
+  private:
+    Timing timing_;
+    uint32_t used_us_{0};
+};
+
+} // namespace gcinput::flash
@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+namespace gcinput {
+
+// コンソールのStatus要求の間隔からフレームの境目を見つける
+// 1フレームに何回か要求するゲームでは、同じフレームの要求は詰まって届き、フレームの間だけ大きく空く
+// 直近の要求の間隔の最大をフレームの長さとみなし、その半分以上空いたら新しいフレームとする
+// 決まった閾値と違い、60Hzでも120Hzでも、数msおきに要求するゲームでも同じ規則で数えられる
+// （1フレームの中で要求が等間隔に並ぶと、その1回ずつを別のフレームとして数える）
+//
+// 最大は8回ずつの2区間で取るので、間隔が詰まっても16回の要求のうちに追いつく
+// 読み込み中などで要求が長く止まっても、最大は今の見積もりの1.5倍までしか伸ばさない
+class FrameCadence {
+  public:
+    // 最初の見積もり（60Hz）
+    static constexpr uint32_t kInitialPeriodUs = 16'683;
+    static constexpr uint32_t kBlockPolls = 8;
+
+    // 要求を受けるたびに呼ぶ。新しいフレームの最初の要求ならtrue
+    bool on_poll(uint32_t now_us) {
+        if (!started_) {
+            started_ = true;
+            last_poll_us_ = now_us;
+            return true;
+        }
+        const uint32_t gap = now_us - last_poll_us_;
+        last_poll_us_ = now_us;
+        const bool new_frame = gap >= same_frame_us();
+
+        const uint32_t period = period_us();
+        block_max_ = std::max(block_max_, std::min(gap, period + period / 2));
+        if (++block_polls_ == kBlockPolls) {
+            previous_max_ = block_max_;
+            block_max_ = 0;
+            block_polls_ = 0;
+        }
+        return new_frame;
+    }
+
+    // 見積もったフレームの長さ
+    uint32_t period_us() const { return std::max(previous_max_, block_max_); }
+    // これより短い間隔の要求は同じフレーム
+    uint32_t same_frame_us() const { return period_us() / 2; }
+
+  private:
+    bool started_{false};
+    uint32_t last_poll_us_{0};
+    uint32_t previous_max_{kInitialPeriodUs};
+    uint32_t block_max_{0};
+    uint32_t block_polls_{0};
+};
+
+} // namespace gcinput
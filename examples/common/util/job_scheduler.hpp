@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gcinput {
+
+// mainループで重い処理（逆変換テーブルの組み立てなど）を少しずつ進める協調スケジューラ
+// ジョブは1回の呼び出しで小さな単位だけ進めて戻る関数で、run()はジョブごとに決めた時間
+// （budget_us）に収まるだけそれを繰り返し、次のジョブへ移る。mainループの他の処理は
+// run()1回ぶんしか待たされない
+// 次の1単位は直前の1単位と同じだけ掛かるとみて、予算に収まらなければそこで止める
+// （1回に1単位は必ず進める）。それでも予算を超えた回は超過として数える。超過が多ければ
+// 1単位を小さくする
+// 時刻はrun()に渡す関数から読む（ファームウェアは time_us_32、ホストは偽の時計）
+template <std::size_t MaxJobs>
+class JobScheduler {
+  public:
+    // 1単位進める。まだ続くならtrue、終わったらfalse
+    using StepFunction = bool (*)(void *user);
+
+    struct Progress {
+        uint32_t done{0};
+        uint32_t total{0};
+    };
+    using ProgressFunction = Progress (*)(const void *user);
+
+    struct Job {
+        const char *name{""};
+        StepFunction step{nullptr};
+        ProgressFunction progress{nullptr}; // なければ進み具合は0/0
+        void *user{nullptr};
+        uint32_t budget_us{0}; // run()1回で使ってよい時間
+    };
+
+    // start()からの集計
+    struct Stats {
+        uint32_t slices{0};       // run()で順番が回ってきた回数
+        uint32_t steps{0};        // stepを呼んだ回数
+        uint32_t busy_us{0};      // 使った時間の合計
+        uint32_t max_slice_us{0}; // 1回に使った時間の最大
+        uint32_t overruns{0};     // 予算を超えた回数
+        uint32_t max_overrun_us{0};
+    };
+
+    using Id = std::size_t;
+    static constexpr Id kInvalid = MaxJobs;
+
+    // 登録するだけで、start()するまで走らない。いっぱいならkInvalid
+    Id add(const Job &job) {
+        if (count_ == MaxJobs) {
+            return kInvalid;
+        }
+        jobs_[count_] = Entry{.job = job};
+        return count_++;
+    }
+
+    // 集計を消して走らせる（走っていれば最初から数え直す）
+    void start(Id id) {
+        jobs_[id].running = true;
+        jobs_[id].stats = Stats{};
+    }
+    void stop(Id id) { jobs_[id].running = false; }
+
+    bool running(Id id) const { return jobs_[id].running; }
+    const char *name(Id id) const { return jobs_[id].job.name; }
+    const Stats &stats(Id id) const { return jobs_[id].stats; }
+    Progress progress(Id id) const {
+        const Job &job = jobs_[id].job;
+        return job.progress == nullptr ? Progress{} : job.progress(job.user);
+    }
+
+    // 走っているジョブを登録順に1回ずつ進める。この呼び出しで終わったジョブのビットを返す
+    template <class Clock>
+    uint32_t run(Clock &&now_us) {
+        static_assert(MaxJobs <= 32);
+        uint32_t finished = 0;
+        for (Id id = 0; id < count_; ++id) {
+            Entry &entry = jobs_[id];
+            if (!entry.running) {
+                continue;
+            }
+            const uint32_t start_us = now_us();
+            uint32_t elapsed_us = 0;
+            bool more = true;
+            do {
+                more = entry.job.step(entry.job.user);
+                ++entry.stats.steps;
+                const uint32_t now = now_us() - start_us;
+                entry.step_us = now - elapsed_us;
+                elapsed_us = now;
+            } while (more && elapsed_us + entry.step_us <= entry.job.budget_us);
+            record(entry, elapsed_us);
+            if (!more) {
+                entry.running = false;
+                finished |= 1u << id;
+            }
+        }
+        return finished;
+    }
+
+  private:
+    struct Entry {
+        Job job{};
+        bool running{false};
+        Stats stats{};
+        uint32_t step_us{0}; // 直前の1単位に掛かった時間
+    };
+
+    static void record(Entry &entry, uint32_t elapsed_us) {
+        Stats &s = entry.stats;
+        ++s.slices;
+        s.busy_us += elapsed_us;
+        if (elapsed_us > s.max_slice_us) {
+            s.max_slice_us = elapsed_us;
+        }
+        if (elapsed_us > entry.job.budget_us) {
+            ++s.overruns;
+            const uint32_t over = elapsed_us - entry.job.budget_us;
+            if (over > s.max_overrun_us) {
+                s.max_overrun_us = over;
+            }
+        }
+    }
+
+    std::array<Entry, MaxJobs> jobs_{};
+    std::size_t count_{0};
+};
+
+} // namespace gcinput
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace gcinput {
+
+// カンマ区切りの10進数をN個読む（余りや足りない項目があればfalse）
+template <std::size_t N>
+bool parse_fields(std::string_view text, std::array<uint32_t, N> &out) {
+    const char *p = text.data();
+    const char *end = text.data() + text.size();
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto [next, ec] = std::from_chars(p, end, out[i]);
+        if (ec != std::errc{}) {
+            return false;
+        }
+        p = next;
+        if (i + 1 < N) {
+            if (p == end || *p != ',') {
+                return false;
+            }
+            ++p;
+        }
+    }
+    return p == end;
+}
+
+// シリアルから1文字ずつ受け取り、1行（改行は\nか\r\n）ごとに返す
+template <std::size_t MaxLine> class LineBuffer {
+  public:
+    // 行が終わったらtrue。長すぎた行は空の行として返し、overflowed()がtrueになる
+    bool feed(char c, std::string_view &line) {
+        if (c == '\r') {
+            return false;
+        }
+        if (c != '\n') {
+            if (length_ < line_.size()) {
+                line_[length_] = c;
+            }
+            length_++;
+            return false;
+        }
+        overflowed_ = length_ > line_.size();
+        line = std::string_view(line_.data(), overflowed_ ? 0 : length_);
+        length_ = 0;
+        return true;
+    }
+
+    bool overflowed() const { return overflowed_; }
+
+  private:
+    std::array<char, MaxLine> line_{};
+    std::size_t length_{0};
+    bool overflowed_{false};
+};
+
+} // namespace gcinput
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gcinput {
+
+// 単一ライタ・単一リーダの固定長リングバッファ
+// ライタはISR、リーダはmainループを想定。満杯のときは新しい要素を捨てて数える
+// head_/tail_は折り返さずに増え続ける値で、添字はCapacityで割った余り
+template <class T, std::size_t Capacity> class SpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "容量は2の冪にする");
+
+  public:
+    // 書き込み側: 満杯ならfalse（dropped()が増える）
+    bool push(const T &value) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer_[head & kMask] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 読み出し側: 空ならfalse
+    bool pop(T &out) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        if (tail == head) {
+            return false;
+        }
+        out = buffer_[tail & kMask];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    // 書き込み側: あと何個積めるか（複数個をまとめて積む前に確かめる）
+    std::size_t room() const {
+        return Capacity - (head_.load(std::memory_order_relaxed) -
+                           tail_.load(std::memory_order_acquire));
+    }
+
+    // 満杯で捨てた要素の累計
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    static constexpr uint32_t kMask = Capacity - 1;
+
+    std::array<T, Capacity> buffer_{};
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> dropped_{0};
+};
+
+} // namespace gcinput
@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace gcinput {
+
+// µs単位の時間を固定メモリで逐次集計する（最小・平均・最大・分位点・ジッタ）
+// 分位点は対数ヒストグラムから求める。32µs未満は1µs刻み、それ以上は2の冪ごとの区間を
+// 16分割するので、誤差はビン幅の半分（値の約3%）以内
+// ジッタは連続する2つの値の差の絶対値の平均
+class TimingStats {
+  public:
+    static constexpr uint32_t kExactLimit = 32;
+    static constexpr uint32_t kSubBuckets = 16;
+    // 2^24µs（約16.8秒）以上は最後のビンにまとめる
+    static constexpr uint32_t kMaxExponent = 24;
+    static constexpr std::size_t kBucketCount = kExactLimit + (kMaxExponent - 5) * kSubBuckets;
+
+    void add(uint32_t value_us) {
+        if (count_ == 0) {
+            min_ = value_us;
+            max_ = value_us;
+        } else {
+            min_ = std::min(min_, value_us);
+            max_ = std::max(max_, value_us);
+            jitter_sum_ += (value_us > last_) ? value_us - last_ : last_ - value_us;
+        }
+        last_ = value_us;
+        sum_ += value_us;
+        ++count_;
+        ++buckets_[bucket_of(value_us)];
+    }
+
+    // 一時オブジェクトを作らずに消す（mainのスタックは小さい）
+    void reset() {
+        buckets_.fill(0);
+        sum_ = 0;
+        jitter_sum_ = 0;
+        count_ = 0;
+        min_ = 0;
+        max_ = 0;
+        last_ = 0;
+    }
+
+    uint32_t count() const { return count_; }
+    uint32_t min() const { return min_; }
+    uint32_t max() const { return max_; }
+    uint32_t mean() const { return (count_ == 0) ? 0 : static_cast<uint32_t>(sum_ / count_); }
+    uint32_t jitter() const {
+        return (count_ < 2) ? 0 : static_cast<uint32_t>(jitter_sum_ / (count_ - 1));
+    }
+
+    // 分位点。per_milleは千分率（500で中央値、990でp99）
+    // 該当するビンの中央の値を、実際の最小・最大の範囲に収めて返す
+    uint32_t percentile(uint32_t per_mille) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        const uint64_t rank =
+            std::max<uint64_t>(1, (static_cast<uint64_t>(count_) * per_mille + 999) / 1000);
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                return std::clamp(bucket_mid(i), min_, max_);
+            }
+        }
+        return max_;
+    }
+
+    static constexpr std::size_t bucket_of(uint32_t value) {
+        if (value < kExactLimit) {
+            return value;
+        }
+        const uint32_t exponent = static_cast<uint32_t>(std::bit_width(value)) - 1;
+        if (exponent >= kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        const uint32_t sub = (value >> (exponent - 4)) & (kSubBuckets - 1);
+        return kExactLimit + (exponent - 5) * kSubBuckets + sub;
+    }
+
+    static constexpr uint32_t bucket_mid(std::size_t index) {
+        if (index < kExactLimit) {
+            return static_cast<uint32_t>(index);
+        }
+        const uint32_t exponent = 5 + static_cast<uint32_t>(index - kExactLimit) / kSubBuckets;
+        const uint32_t sub = static_cast<uint32_t>(index - kExactLimit) % kSubBuckets;
+        const uint32_t width = 1u << (exponent - 4);
+        return (kSubBuckets + sub) * width + width / 2;
+    }
+
+  private:
+    std::array<uint32_t, kBucketCount> buckets_{};
+    uint64_t sum_{0};
+    uint64_t jitter_sum_{0};
+    uint32_t count_{0};
+    uint32_t min_{0};
+    uint32_t max_{0};
+    uint32_t last_{0};
+};
+
+} // namespace gcinput
@@ -1,106 +1,522 @@
 #pragma once
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include "util/spsc_ring.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include "pico/stdlib.h"
 
+// JoyBusの送受信と状態遷移を記録するトレース
+// ISRとmainループの両方から積み、mainループで取り出してテレメトリへ流す
+// 文字列は積まず、状態やタイムアウトの理由はIDで持つ（名前は取り出す側で引く）
 namespace debug_log {
 
 enum class Port : uint8_t { Pad, Console };
 enum class Dir : uint8_t { TX, RX };
 
+enum class Kind : uint8_t {
+    Frame,         // データフレーム
+    FramePollMode, // PollMode付きデータフレーム（データは8バイトまで）
+    State,         // 状態遷移（PadClient::StateのID）
+    Timeout,       // 応答待ちのタイムアウト（TimeoutId）
+};
+
+// タイムアウトの理由
+enum class TimeoutId : uint8_t {
+    ConnectionLost,
+    Id,
+    Reset,
+    BootId,
+    Origin,
+    Recalibrate,
+    WarmStatus,
+    Status,
+    RelayOrigin,
+    RelayRecalibrate,
+};
+
+inline const char *timeout_name(TimeoutId id) {
+    switch (id) {
+    case TimeoutId::ConnectionLost:   return "pad connection lost";
+    case TimeoutId::Id:               return "waiting for Id";
+    case TimeoutId::Reset:            return "waiting for Reset";
+    case TimeoutId::BootId:           return "waiting for Id (boot)";
+    case TimeoutId::Origin:           return "waiting for Origin";
+    case TimeoutId::Recalibrate:      return "waiting for Recalibrate";
+    case TimeoutId::WarmStatus:       return "waiting for Status (warm)";
+    case TimeoutId::Status:           return "waiting for Status";
+    case TimeoutId::RelayOrigin:      return "waiting for Origin (relay)";
+    case TimeoutId::RelayRecalibrate: return "waiting for Recalibrate (relay)";
+    }
+    return "?";
+}
+
+// トレース1件。積むときはPackedEntryに分け、取り出すときに組み立て直す
+//
+//   Frame         data[0..len)    送受信したバイト列（10バイトまで）
+//   FramePollMode data[0..len)    送受信したバイト列（8バイトまで）
+//                 data[8]         パッド側PollMode(bit0-3) | 応答のPollMode(bit4-7)
+//                 data[9]         コンソールが要求したPollMode
+//   State         data[0], [1]    遷移元と遷移先
+//   Timeout       data[0]         TimeoutId
 struct LogEntry {
+    static constexpr std::size_t kMaxData = 10;
+    static constexpr std::size_t kMaxPollModeData = 8;
+
     uint32_t timestamp_us;
-    Port port;
-    Dir dir;
+    // bit0-1: Kind, bit2: Port, bit3: Dir, bit4-7: データ長
+    uint8_t header;
     uint8_t command_byte;
-    uint8_t data[16];
-    uint8_t data_len;
-    uint8_t poll_mode_pad;      // PAD側ポーリングで使用したPollMode
-    uint8_t poll_mode_console;  // コンソールからリクエストされたPollMode
-    uint8_t poll_mode_reply;    // Picoが応答に使用したPollMode
-    bool    has_poll_mode;      // PollMode情報の有無
-    bool is_state;
-    bool is_timeout;
-    char state_str[48];
+    uint8_t data[kMaxData];
+
+    static constexpr uint8_t pack(Kind kind, Port port, Dir dir, std::size_t length) {
+        return static_cast<uint8_t>(static_cast<uint8_t>(kind) |
+                                    (static_cast<uint8_t>(port) << 2) |
+                                    (static_cast<uint8_t>(dir) << 3) | (length << 4));
+    }
+
+    Kind kind() const { return static_cast<Kind>(header & 0x03); }
+    Port port() const { return static_cast<Port>((header >> 2) & 0x01); }
+    Dir dir() const { return static_cast<Dir>((header >> 3) & 0x01); }
+    uint8_t data_len() const { return header >> 4; }
+    bool is_frame() const { return kind() == Kind::Frame || kind() == Kind::FramePollMode; }
+
+    bool has_poll_mode() const { return kind() == Kind::FramePollMode; }
+    uint8_t poll_mode_pad() const { return data[8] & 0x0F; }
+    uint8_t poll_mode_reply() const { return data[8] >> 4; }
+    uint8_t poll_mode_console() const { return data[9]; }
+
+    uint8_t state_from() const { return data[0]; }
+    uint8_t state_to() const { return data[1]; }
+    TimeoutId timeout_id() const { return static_cast<TimeoutId>(data[0]); }
+};
+
+// ─── 詰めた形 ───
+// リングとキャプチャに積む8バイトの単位。LogEntry 1件を1〜3個に分ける
+//
+//   先頭  bytes[0..1]  同じ列の前の件からの経過時間（µs、リトルエンディアン）
+//         bytes[2]     コマンドバイト
+//         bytes[3..7)  中身の先頭4バイトまで
+//   More  bytes[0..7)  中身の続き（先頭のバイト数がkContinuedのとき直後に置く）
+//   Gap   bytes[0..4)  次の先頭までの経過時間。65ms以上空いたとき先頭の前に置き、先頭は0にする
+//
+// 中身はdata[0..len)で、FramePollModeはその後にdata[8], data[9]を続ける（11バイトまで）
+// 時刻は差分だけなので、読む側は前から足していく。落とした件は差分に含めないので、
+// 途中が抜けても後の時刻はずれない
+struct PackedEntry {
+    static constexpr uint8_t kMore = 4; // Kindの後ろに続く種類
+    static constexpr uint8_t kGap = 5;
+    static constexpr std::size_t kHeadBytes = 4;
+    static constexpr std::size_t kMoreBytes = 7;
+    // 先頭のバイト数欄の特別な値: 4バイトあり、Moreが続く
+    static constexpr uint8_t kContinued = 7;
+    // LogEntry 1件あたりの最大（Gap + 先頭 + More）
+    static constexpr std::size_t kMaxParts = 3;
+
+    // bit0-2: Kind（またはkMore, kGap）, bit3: Port, bit4: Dir, bit5-7: この個のバイト数
+    uint8_t header;
+    uint8_t bytes[7];
+
+    uint8_t type() const { return header & 0x07; }
+    bool is_head() const { return type() < kMore; }
+    std::size_t count() const { return header >> 5; }
+
+    // この個で進む時刻（Moreは0）
+    uint32_t advance_us() const {
+        if (type() == kGap) {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                   (static_cast<uint32_t>(bytes[2]) << 16) |
+                   (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+        if (type() == kMore) {
+            return 0;
+        }
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8);
+    }
 };
+static_assert(sizeof(PackedEntry) == 8);
+
+// eをoutへ分けて書き、個数を返す。last_usは同じ列に直前に積んだ件の時刻
+inline std::size_t pack_entry(const LogEntry &e, uint32_t last_us,
+                              PackedEntry (&out)[PackedEntry::kMaxParts]) {
+    uint8_t payload[LogEntry::kMaxData + 2];
+    std::size_t length = e.data_len();
+    memcpy(payload, e.data, length);
+    if (e.has_poll_mode()) {
+        payload[length++] = e.data[8];
+        payload[length++] = e.data[9];
+    }
+
+    std::size_t n = 0;
+    uint32_t delta = e.timestamp_us - last_us;
+    if (delta > 0xFFFF) {
+        PackedEntry &gap = out[n++];
+        gap = PackedEntry{};
+        gap.header = PackedEntry::kGap;
+        for (std::size_t i = 0; i < 4; ++i) {
+            gap.bytes[i] = static_cast<uint8_t>(delta >> (8 * i));
+        }
+        delta = 0;
+    }
 
-inline constexpr std::size_t kRingSize = 256;
-inline LogEntry g_ring[kRingSize];
-inline volatile uint32_t g_ring_head = 0;
-inline uint32_t g_ring_tail = 0;
-inline uint32_t g_drop_count = 0;
+    const std::size_t head_bytes = std::min(length, PackedEntry::kHeadBytes);
+    const bool continued = length > head_bytes;
+    PackedEntry &head = out[n++];
+    head = PackedEntry{};
+    head.header = static_cast<uint8_t>(
+        static_cast<uint8_t>(e.kind()) | (static_cast<uint8_t>(e.port()) << 3) |
+        (static_cast<uint8_t>(e.dir()) << 4) |
+        ((continued ? PackedEntry::kContinued : head_bytes) << 5));
+    head.bytes[0] = static_cast<uint8_t>(delta);
+    head.bytes[1] = static_cast<uint8_t>(delta >> 8);
+    head.bytes[2] = e.command_byte;
+    memcpy(&head.bytes[3], payload, head_bytes);
 
-inline void ring_push(LogEntry entry) {
-    uint32_t next = (g_ring_head + 1) % kRingSize;
-    if (next == g_ring_tail) {
-        g_drop_count++;
-        return;
+    if (continued) {
+        PackedEntry &more = out[n++];
+        more = PackedEntry{};
+        more.header = static_cast<uint8_t>(PackedEntry::kMore | ((length - head_bytes) << 5));
+        memcpy(more.bytes, &payload[head_bytes], length - head_bytes);
     }
-    g_ring[g_ring_head] = entry;
-    g_ring_head = next;
+    return n;
 }
 
-// ISR安全: データログをリングバッファに積む
-inline void ring_push_data(Port port, Dir dir, uint8_t cmd, const uint8_t *data, std::size_t len) {
+// PackedEntryを前から1個ずつ受け取り、LogEntryに組み立て直す
+// 先頭を欠いたMore（キャプチャの区間の端など）は読み飛ばす
+class EntryUnpacker {
+  public:
+    // time_usは最初に渡す個より前の時刻
+    explicit EntryUnpacker(uint32_t time_us = 0) : time_us_{time_us} {}
+
+    // 1件揃ったらtrueを返してoutに入れる
+    bool feed(const PackedEntry &p, LogEntry &out) {
+        time_us_ += p.advance_us();
+        if (p.type() == PackedEntry::kGap) {
+            continued_ = false;
+            return false;
+        }
+        if (p.type() == PackedEntry::kMore) {
+            if (!continued_) {
+                return false;
+            }
+            continued_ = false;
+            const std::size_t n = std::min(p.count(), sizeof(payload_) - length_);
+            memcpy(&payload_[length_], p.bytes, n);
+            length_ += n;
+            finish(out);
+            return true;
+        }
+
+        header_ = p.header;
+        command_byte_ = p.bytes[2];
+        timestamp_us_ = time_us_;
+        continued_ = p.count() == PackedEntry::kContinued;
+        length_ = continued_ ? PackedEntry::kHeadBytes
+                             : std::min(p.count(), PackedEntry::kHeadBytes);
+        memcpy(payload_, &p.bytes[3], length_);
+        if (continued_) {
+            return false;
+        }
+        finish(out);
+        return true;
+    }
+
+  private:
+    void finish(LogEntry &out) const {
+        const auto kind = static_cast<Kind>(header_ & 0x03);
+        const auto port = static_cast<Port>((header_ >> 3) & 0x01);
+        const auto dir = static_cast<Dir>((header_ >> 4) & 0x01);
+        std::size_t length = length_;
+        out = LogEntry{};
+        if (kind == Kind::FramePollMode && length >= 2) {
+            length -= 2;
+            out.data[8] = payload_[length];
+            out.data[9] = payload_[length + 1];
+        }
+        length = std::min(length, LogEntry::kMaxData);
+        out.timestamp_us = timestamp_us_;
+        out.header = LogEntry::pack(kind, port, dir, length);
+        out.command_byte = command_byte_;
+        memcpy(out.data, payload_, length);
+    }
+
+    uint32_t time_us_;
+    uint32_t timestamp_us_{0};
+    uint8_t header_{0};
+    uint8_t command_byte_{0};
+    bool continued_{false};
+    std::size_t length_{0};
+    uint8_t payload_[LogEntry::kMaxData + 2]{};
+};
+
+
+// ─── トリガ ───
+// ロジックアナライザのように、条件に合った1件の前後を凍結して残す
+// 取り出しが追いつかずリングから落ちる状況でも、トリガ前後は欠けずに残る
+
+enum class TriggerType : uint8_t {
+    None,
+    Command, // コマンドバイトが一致するフレーム
+    Timeout, // TimeoutIdが一致（idがkAnyなら全部）
+    State,   // 遷移先が一致（idがkAnyなら全部）
+    Pattern, // data[offset..offset+3]をビッグエンディアンで並べ、maskを取ってvalueと一致
+};
+
+struct Trigger {
+    static constexpr uint8_t kAny = 0xFF;
+
+    TriggerType type{TriggerType::None};
+    // Command/Pattern: 比べるコマンドバイト（PatternはkAnyで全コマンド）
+    uint8_t command{kAny};
+    // Timeout: TimeoutId、State: 遷移先
+    uint8_t id{kAny};
+    // Command/Pattern: ポートと方向も比べるか
+    bool match_port_dir{false};
+    Port port{Port::Pad};
+    Dir dir{Dir::RX};
+    // Pattern
+    uint8_t offset{0};
+    uint32_t mask{0};
+    uint32_t value{0};
+    // トリガの前と後に残すPackedEntryの個数（トリガの1件の分は含まない）
+    uint16_t pre{0};
+    uint16_t post{0};
+
+    bool matches(const LogEntry &e) const {
+        const bool port_ok = !match_port_dir || (e.port() == port && e.dir() == dir);
+        const bool frame_ok = e.is_frame() && port_ok;
+        switch (type) {
+        case TriggerType::None:
+            return false;
+        case TriggerType::Command:
+            return frame_ok && e.command_byte == command;
+        case TriggerType::Timeout:
+            return e.kind() == Kind::Timeout &&
+                   (id == kAny || static_cast<uint8_t>(e.timeout_id()) == id);
+        case TriggerType::State:
+            return e.kind() == Kind::State && (id == kAny || e.state_to() == id);
+        case TriggerType::Pattern: {
+            if (!frame_ok || (command != kAny && e.command_byte != command)) {
+                return false;
+            }
+            uint32_t window = 0;
+            for (std::size_t i = 0; i < 4; ++i) {
+                const std::size_t at = offset + i;
+                window = (window << 8) | ((at < e.data_len()) ? e.data[at] : 0u);
+            }
+            return (window & mask) == value;
+        }
+        }
+        return false;
+    }
+};
+
+class TriggerCapture {
+  public:
+    // 8バイト x 768個 = 6KB。既定のトリガ（前512個・後160個）が収まる
+    static constexpr std::size_t kCapacity = 768;
+
+    enum class Phase : uint8_t {
+        Idle,      // 記録しない
+        Armed,     // トリガ前の履歴を上書きしながら待つ
+        Triggered, // トリガ後の個数を記録中
+        Frozen,    // 確定。mainが取り出し終えるまで書き込まない
+    };
+
+    // main: 条件を設定して待ち受けを始める
+    // トリガの1件と最後の1件のはみ出し（それぞれkMaxParts個まで）を含めてkCapacityに収まるよう詰める
+    void arm(const Trigger &trigger) {
+        constexpr std::size_t kSlack = 2 * PackedEntry::kMaxParts;
+        const uint32_t irq = save_and_disable_interrupts();
+        trigger_ = trigger;
+        trigger_.post =
+            static_cast<uint16_t>(std::min<std::size_t>(trigger.post, kCapacity - kSlack));
+        trigger_.pre = static_cast<uint16_t>(
+            std::min<std::size_t>(trigger.pre, kCapacity - kSlack - trigger_.post));
+        written_ = 0;
+        phase_.store(trigger_.type == TriggerType::None ? Phase::Idle : Phase::Armed,
+                     std::memory_order_release);
+        restore_interrupts(irq);
+    }
+
+    // 積むたびに呼ぶ（割り込み禁止中）。1件の個はまとめて書くので、区間は件の境目で終わる
+    void record(const LogEntry &e) {
+        const Phase phase = phase_.load(std::memory_order_relaxed);
+        if (phase != Phase::Armed && phase != Phase::Triggered) {
+            return;
+        }
+        PackedEntry parts[PackedEntry::kMaxParts];
+        const std::size_t n = pack_entry(e, last_us_, parts);
+        const uint32_t first = written_;
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer_[written_ % kCapacity] = parts[i];
+            ++written_;
+        }
+        last_us_ = e.timestamp_us;
+        if (phase == Phase::Armed) {
+            if (!trigger_.matches(e)) {
+                return;
+            }
+            trigger_first_ = first;
+            trigger_head_ = first + (parts[0].type() == PackedEntry::kGap ? 1 : 0);
+            trigger_us_ = e.timestamp_us;
+            remaining_post_ = trigger_.post;
+            phase_.store(Phase::Triggered, std::memory_order_relaxed);
+        } else {
+            remaining_post_ -= std::min<uint32_t>(remaining_post_, n);
+        }
+        if (remaining_post_ == 0) {
+            phase_.store(Phase::Frozen, std::memory_order_release);
+        }
+    }
+
+    Phase phase() const { return phase_.load(std::memory_order_acquire); }
+
+    // 以下はFrozenのときだけ使う。添字は区間の中の個の番号
+    const Trigger &trigger() const { return trigger_; }
+    uint32_t trigger_us() const { return trigger_us_; }
+    std::size_t size() const { return written_ - begin(); }
+    const PackedEntry &at(std::size_t i) const { return buffer_[(begin() + i) % kCapacity]; }
+    // トリガの1件の先頭の添字
+    std::size_t trigger_index() const { return trigger_head_ - begin(); }
+
+    // 区間の最初から読むためのEntryUnpacker。トリガの時刻から差分を引いて起点を求める
+    EntryUnpacker unpacker() const {
+        uint32_t time_us = trigger_us_;
+        for (std::size_t i = 0; i <= trigger_index(); ++i) {
+            time_us -= at(i).advance_us();
+        }
+        return EntryUnpacker{time_us};
+    }
+
+    // [first, last)にある件の数（先頭を欠いたMoreは数えない）
+    std::size_t count_entries(std::size_t first, std::size_t last) const {
+        std::size_t count = 0;
+        for (std::size_t i = first; i < last; ++i) {
+            count += at(i).is_head() ? 1 : 0;
+        }
+        return count;
+    }
+
+  private:
+    // 実際に残ったトリガ前の個（待ち受け開始直後ならpreより少ない）の最初
+    uint32_t begin() const {
+        return trigger_first_ - std::min<uint32_t>(trigger_first_, trigger_.pre);
+    }
+
+    std::atomic<Phase> phase_{Phase::Idle};
+    Trigger trigger_{};
+    PackedEntry buffer_[kCapacity]{};
+    uint32_t written_{0};
+    uint32_t last_us_{0};
+    uint32_t trigger_first_{0};
+    uint32_t trigger_head_{0};
+    uint32_t trigger_us_{0};
+    uint32_t remaining_post_{0};
+};
+
+// ─── リング ───
+// 8バイト x 2048個 = 16KB。TriggerCaptureの6KBと合わせて22KBで、従来のリング
+// （約90バイト x 256件 = 約22.5KB）に収まる。Ready中のStatus 1往復（4件）は7個なので約290往復分
+inline constexpr std::size_t kRingSize = 2048;
+
+class TraceRing {
+  public:
+    // 書き込み側（割り込み禁止中）。1件の個が全部入らなければ1件まるごと捨てる
+    void push(const LogEntry &e) {
+        PackedEntry parts[PackedEntry::kMaxParts];
+        const std::size_t n = pack_entry(e, last_us_, parts);
+        if (ring_.room() < n) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            ring_.push(parts[i]);
+        }
+        last_us_ = e.timestamp_us;
+    }
+
+    // 読み出し側: 組み立て直した1件。空ならfalse
+    // 1件の個は割り込みを止めてまとめて積むので、途中までしか読めないことはない
+    bool pop(LogEntry &out) {
+        PackedEntry p{};
+        while (ring_.pop(p)) {
+            if (unpacker_.feed(p, out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 満杯で捨てた件の累計
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    gcinput::SpscRing<PackedEntry, kRingSize> ring_;
+    uint32_t last_us_{0};
+    EntryUnpacker unpacker_{};
+    std::atomic<uint32_t> dropped_{0};
+};
+
+inline TraceRing g_ring;
+inline TriggerCapture g_capture;
+
+// ISRとmainの両方から積むので、割り込みを止めて書き込み側を1つにする
+// （PIOの割り込みもmainも同じコアで動くので、これでSPSCとして扱える）
+inline void ring_push(const LogEntry &entry) {
+    const uint32_t irq = save_and_disable_interrupts();
+    g_capture.record(entry);
+    g_ring.push(entry);
+    restore_interrupts(irq);
+}
+
+inline LogEntry make_frame(Kind kind, Port port, Dir dir, uint8_t cmd, const uint8_t *data,
+                           std::size_t len, std::size_t max_len) {
+    const std::size_t length = std::min(len, max_len);
     LogEntry e{};
     e.timestamp_us = time_us_32();
-    e.port = port;
-    e.dir = dir;
+    e.header = LogEntry::pack(kind, port, dir, length);
     e.command_byte = cmd;
-    e.data_len = static_cast<uint8_t>(len > 16 ? 16 : len);
-    if (data && e.data_len > 0) {
-        memcpy(e.data, data, e.data_len);
+    if (data && length > 0) {
+        memcpy(e.data, data, length);
     }
-    e.is_state = false;
-    e.is_timeout = false;
-    e.has_poll_mode = false;
-    ring_push(e);
+    return e;
+}
+
+// ISR安全: データログをリングバッファに積む
+inline void ring_push_data(Port port, Dir dir, uint8_t cmd, const uint8_t *data, std::size_t len) {
+    ring_push(make_frame(Kind::Frame, port, dir, cmd, data, len, LogEntry::kMaxData));
 }
 
 // ISR安全: PollMode情報付きデータログをリングバッファに積む
 inline void ring_push_data_with_poll_mode(Port port, Dir dir, uint8_t cmd,
                                           const uint8_t *data, std::size_t len,
                                           uint8_t pm_pad, uint8_t pm_con, uint8_t pm_reply) {
-    LogEntry e{};
-    e.timestamp_us = time_us_32();
-    e.port = port;
-    e.dir = dir;
-    e.command_byte = cmd;
-    e.data_len = static_cast<uint8_t>(len > 16 ? 16 : len);
-    if (data && e.data_len > 0) {
-        memcpy(e.data, data, e.data_len);
-    }
-    e.is_state = false;
-    e.is_timeout = false;
-    e.has_poll_mode = true;
-    e.poll_mode_pad = pm_pad;
-    e.poll_mode_console = pm_con;
-    e.poll_mode_reply = pm_reply;
+    LogEntry e = make_frame(Kind::FramePollMode, port, dir, cmd, data, len,
+                            LogEntry::kMaxPollModeData);
+    e.data[8] = static_cast<uint8_t>((pm_pad & 0x0F) | (pm_reply << 4));
+    e.data[9] = pm_con;
     ring_push(e);
 }
 
 // main安全: 状態遷移ログをリングバッファに積む
-inline void ring_push_state(Port port, const char *msg) {
+inline void ring_push_state(Port port, uint8_t from, uint8_t to) {
     LogEntry e{};
     e.timestamp_us = time_us_32();
-    e.port = port;
-    e.is_state = true;
-    e.is_timeout = false;
-    strncpy(e.state_str, msg, sizeof(e.state_str) - 1);
-    e.state_str[sizeof(e.state_str) - 1] = '\0';
+    e.header = LogEntry::pack(Kind::State, port, Dir::TX, 2);
+    e.data[0] = from;
+    e.data[1] = to;
     ring_push(e);
 }
 
 // main安全: タイムアウトログをリングバッファに積む
-inline void ring_push_timeout(Port port, const char *msg) {
+inline void ring_push_timeout(Port port, TimeoutId id) {
     LogEntry e{};
     e.timestamp_us = time_us_32();
-    e.port = port;
-    e.is_state = false;
-    e.is_timeout = true;
-    strncpy(e.state_str, msg, sizeof(e.state_str) - 1);
-    e.state_str[sizeof(e.state_str) - 1] = '\0';
+    e.header = LogEntry::pack(Kind::Timeout, port, Dir::TX, 1);
+    e.data[0] = static_cast<uint8_t>(id);
     ring_push(e);
 }
 
@@ -0,0 +1,290 @@
+#include "debug_recorder.hpp"
+#include "pico/stdlib.h"
+#include <algorithm>
+#include <cstring>
+
+namespace debug_recorder {
+namespace {
+
+namespace logging = gcinput::logging;
+
+// stopでログのキューを書き切るまで待つ上限
+constexpr uint32_t kStopTimeoutUs = 2'000'000;
+
+const uint8_t *sector_data(uint32_t sector) {
+    return gcinput::flash::read(kRegionOffset + sector * FLASH_SECTOR_SIZE);
+}
+
+const SectorHeader &header_at(uint32_t sector) {
+    return *reinterpret_cast<const SectorHeader *>(sector_data(sector));
+}
+
+bool is_valid(const SectorHeader &header) { return header.magic == kSectorMagic; }
+
+void erase_sector(uint32_t sector) {
+    gcinput::flash::erase_sector(kRegionOffset + sector * FLASH_SECTOR_SIZE);
+}
+
+} // namespace
+
+// ─── FlashRecorder ───
+
+void FlashRecorder::init() {
+    if (!gcinput::flash::region_available(kRegionOffset)) {
+        state_ = State::Unavailable;
+        return;
+    }
+    state_ = State::Idle;
+
+    // 最新のセッションの最後のセクタの次から、次のセッションを始める（消去を領域全体に散らす）
+    uint32_t last_index = 0;
+    uint32_t last_sector = kSectorCount - 1;
+    for (uint32_t s = 0; s < kSectorCount; ++s) {
+        const SectorHeader &header = header_at(s);
+        if (!is_valid(header)) {
+            continue;
+        }
+        if (header.session > session_ ||
+            (header.session == session_ && header.index >= last_index)) {
+            session_ = header.session;
+            last_index = header.index;
+            last_sector = s;
+        }
+    }
+    next_sector_ = (last_sector + 1) % kSectorCount;
+    last_used_ = session_ == 0 ? 0 : std::min(last_index + 1, kSectorCount);
+
+    sink_ = gcinput::logging::Sink{
+        .writable = &FlashRecorder::sink_writable,
+        .write = &FlashRecorder::sink_write,
+        .user = this,
+    };
+}
+
+bool FlashRecorder::start() {
+    if (state_ == State::Unavailable) {
+        return false;
+    }
+    if (state_ == State::Recording) {
+        return true;
+    }
+    // 先に消したセクタ（erased_）はそのまま引き継ぐ
+    session_++;
+    first_sector_ = next_sector_;
+    write_index_ = 0;
+    write_page_ = 0;
+    bytes_written_ = 0;
+    staging_head_ = 0;
+    staging_tail_ = 0;
+    state_ = State::Recording;
+    logging::set_sink(&sink_);
+    return true;
+}
+
+void FlashRecorder::stop() {
+    if (state_ != State::Recording) {
+        return;
+    }
+    // ログのキューに残っている分もフラッシュへ入れる。書くのはserviceと同じ時間帯だけ
+    const uint32_t start_us = time_us_32();
+    while (state_ == State::Recording && (!logging::idle() || staged() > 0) &&
+           time_us_32() - start_us < kStopTimeoutUs) {
+        logging::poll();
+        const uint32_t now_us = time_us_32();
+        const uint32_t reply_us = g_last_reply_us.load(std::memory_order_relaxed);
+        bool console_idle = false;
+        if (window_.open(now_us, reply_us, true, console_idle) &&
+            step(/*flush=*/logging::idle(), /*allow_erase=*/console_idle)) {
+            window_.use(reply_us);
+        }
+    }
+    if (state_ == State::Recording && staged() > 0) {
+        logging::warn("recorder: stop dropped %lu bytes\n", static_cast<uint32_t>(staged()));
+    }
+    finish(State::Idle);
+}
+
+void FlashRecorder::service(uint32_t now_us) {
+    if (state_ != State::Recording && state_ != State::Idle) {
+        return;
+    }
+    const uint32_t reply_us = g_last_reply_us.load(std::memory_order_relaxed);
+    bool console_idle = false;
+    if (!window_.open(now_us, reply_us, true, console_idle)) {
+        return;
+    }
+    if (state_ == State::Idle) {
+        // 次のセッションの分を先に消す（最新のセッションは残す）
+        if (console_idle && erased_ < std::min(kEraseReserve, kSectorCount - last_used_)) {
+            erase_sector((next_sector_ + erased_) % kSectorCount);
+            erased_++;
+        }
+        return;
+    }
+    // 応答1回につき1操作まで
+    if (step(/*flush=*/false, /*allow_erase=*/console_idle)) {
+        window_.use(reply_us);
+    }
+}
+
+std::size_t FlashRecorder::sink_writable(void *user) {
+    const auto &self = *static_cast<const FlashRecorder *>(user);
+    return self.state_ == State::Recording ? kStagingSize - self.staged() : 0;
+}
+
+void FlashRecorder::sink_write(void *user, const uint8_t *data, std::size_t length) {
+    auto &self = *static_cast<FlashRecorder *>(user);
+    for (std::size_t i = 0; i < length; ++i) {
+        self.staging_[self.staging_head_++ % kStagingSize] = data[i];
+    }
+}
+
+bool FlashRecorder::step(bool flush, bool allow_erase) {
+    const std::size_t n = staged();
+    if (write_index_ < erased_ && (n >= page_capacity() || (flush && n > 0))) {
+        program_page();
+        return true;
+    }
+    // コンソールが止まっている間に、使い切った分を消し足す
+    if (allow_erase && erased_ < write_index_ + kEraseReserve && erased_ < kSectorCount) {
+        erase_next();
+        return true;
+    }
+    return false;
+}
+
+void FlashRecorder::erase_next() {
+    erase_sector((first_sector_ + erased_) % kSectorCount);
+    erased_++;
+}
+
+void FlashRecorder::program_page() {
+    std::array<uint8_t, FLASH_PAGE_SIZE> page{};
+    page.fill(0xFF);
+    std::size_t pos = 0;
+    if (write_page_ == 0) {
+        const SectorHeader header{
+            .magic = kSectorMagic,
+            .session = session_,
+            .index = write_index_,
+            .reserved = 0xFFFF'FFFFu,
+        };
+        std::memcpy(page.data(), &header, sizeof(header));
+        pos = sizeof(header);
+    }
+    // 埋まらなかった残りは0xFFのまま（stopの最後だけ）
+    const std::size_t n = std::min(staged(), page.size() - pos);
+    for (std::size_t i = 0; i < n; ++i) {
+        page[pos + i] = staging_[staging_tail_++ % kStagingSize];
+    }
+    gcinput::flash::program_page(sector_offset(write_index_) + write_page_ * FLASH_PAGE_SIZE,
+                                 page);
+    bytes_written_ += static_cast<uint32_t>(n);
+
+    if (++write_page_ < kPagesPerSector) {
+        return;
+    }
+    write_page_ = 0;
+    if (++write_index_ == kSectorCount) {
+        // 領域を一周した。セッションの先頭を上書きしないよう止める
+        finish(State::Full);
+        logging::warn("recorder: region full session=%lu bytes=%lu\n", session_, bytes_written_);
+    }
+}
+
+void FlashRecorder::finish(State next) {
+    logging::set_sink(nullptr);
+    const uint32_t used = write_index_ + (write_page_ > 0 ? 1 : 0);
+    next_sector_ = (first_sector_ + used) % kSectorCount;
+    last_used_ = used;
+    // 使わなかった消去済みのセクタは次のセッションへ回す
+    erased_ = erased_ > used ? erased_ - used : 0;
+    staging_tail_ = staging_head_;
+    state_ = next;
+}
+
+std::size_t FlashRecorder::page_capacity() const {
+    return (write_page_ == 0) ? FLASH_PAGE_SIZE - sizeof(SectorHeader) : FLASH_PAGE_SIZE;
+}
+
+uint32_t FlashRecorder::sector_offset(uint32_t index) const {
+    return kRegionOffset + ((first_sector_ + index) % kSectorCount) * FLASH_SECTOR_SIZE;
+}
+
+// ─── SessionReader ───
+
+bool SessionReader::open(uint32_t back) {
+    uint32_t newest = 0;
+    for (uint32_t s = 0; s < kSectorCount; ++s) {
+        const SectorHeader &header = header_at(s);
+        if (is_valid(header)) {
+            newest = std::max(newest, header.session);
+        }
+    }
+    if (newest == 0 || back >= newest) {
+        return false;
+    }
+    const uint32_t target = newest - back;
+
+    // 古いセクタは次のセッションに上書きされていることがあるので、残っている最小の番号から読む
+    bool found = false;
+    for (uint32_t s = 0; s < kSectorCount; ++s) {
+        const SectorHeader &header = header_at(s);
+        if (is_valid(header) && header.session == target &&
+            (!found || header.index < first_index_)) {
+            first_sector_ = s;
+            first_index_ = header.index;
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    sectors_ = 0;
+    while (sectors_ < kSectorCount) {
+        const SectorHeader &header = header_at((first_sector_ + sectors_) % kSectorCount);
+        if (!is_valid(header) || header.session != target ||
+            header.index != first_index_ + sectors_) {
+            break;
+        }
+        sectors_++;
+    }
+    session_ = target;
+    sector_ = 0;
+    offset_ = sizeof(SectorHeader);
+    skipped_ = 0;
+    return true;
+}
+
+std::size_t
+SessionReader::next_frame(std::span<uint8_t, gcinput::telemetry::kMaxEncodedFrame> out) {
+    std::size_t length = 0;
+    bool overflow = false;
+    while (sector_ < sectors_) {
+        const uint8_t *data = sector_data((first_sector_ + sector_) % kSectorCount);
+        while (offset_ < FLASH_SECTOR_SIZE) {
+            const uint8_t byte = data[offset_++];
+            if (length < out.size()) {
+                out[length++] = byte;
+            } else {
+                overflow = true;
+            }
+            if (byte != 0x00) {
+                continue;
+            }
+            if (!overflow) {
+                return length;
+            }
+            // 長すぎる（壊れている）フレームは区切りまで捨てる
+            skipped_++;
+            length = 0;
+            overflow = false;
+        }
+        sector_++;
+        offset_ = sizeof(SectorHeader);
+    }
+    // 区切りのない残り（最後のページの0xFF）は捨てる
+    return 0;
+}
+
+} // namespace debug_recorder
@@ -0,0 +1,147 @@
+#pragma once
+#include "hardware/flash.h"
+#include "logging/log.hpp"
+#include "telemetry/frame.hpp"
+#include "util/flash_region.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// 長時間の記録: ログのバイト列（テレメトリのフレーム）をUARTの代わりにフラッシュの末尾1MBへ書き溜める
+// 後でそのままのフレームをUARTへ送り直すので、ホストはいつものgc_telemetry_decodeで読める
+//
+// フラッシュを書いている間はXIPが止まるため割り込みも止める
+// ページ（256B）の書き込みは1ms弱なので、コンソールへの応答を送った直後に1回ずつ行う
+// セクタ（4KB）の消去は数十msかかり、その間の要求に応えられないので、コンソールが止まっているときだけ行う。
+// 記録していない間に次のセッションの分（kEraseReserve）を先に消しておき、遊んでいる間は消さない
+// 消した分を使い切ると、次にコンソールが止まるまで記録できない（ログのキューが溢れて数える）
+namespace debug_recorder {
+
+// コンソールへの応答を送り始めた時刻
+inline std::atomic<uint32_t> g_last_reply_us{0};
+
+// ISR安全: 応答の送信開始時に呼ぶ
+inline void note_console_reply(uint32_t now_us) {
+    g_last_reply_us.store(now_us, std::memory_order_relaxed);
+}
+
+// 記録領域（フラッシュ先頭からのオフセット）
+inline constexpr uint32_t kRegionSize = 1024 * 1024;
+inline constexpr uint32_t kRegionOffset = PICO_FLASH_SIZE_BYTES - kRegionSize;
+inline constexpr uint32_t kSectorCount = kRegionSize / FLASH_SECTOR_SIZE;
+inline constexpr uint32_t kPagesPerSector = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+
+// 各セクタの先頭16バイト。消去したままのセクタはmagicが合わない
+struct SectorHeader {
+    uint32_t magic;
+    uint32_t session; // 記録を始めるたびに1増える
+    uint32_t index;   // セッション内のセクタの通し番号（0から）
+    uint32_t reserved;
+};
+static_assert(sizeof(SectorHeader) == 16);
+
+inline constexpr uint32_t kSectorMagic = 0x5254'4347u; // "GCTR"
+
+class FlashRecorder {
+  public:
+    enum class State : uint8_t {
+        Unavailable, // 記録領域がファームウェアと重なっている
+        Idle,
+        Recording,
+        Full, // 領域を使い切った。出力はUARTへ戻っている
+    };
+
+    // 起動時に1回。前回までのセッションを探す
+    void init();
+
+    // 新しいセッションを始め、ログの出力先をフラッシュへ切り替える
+    // 先に消してあるセクタから書き始める（ここでは消去しない）
+    bool start();
+
+    // ログのキューと未書き込みの分を書き切り、出力先をUARTへ戻す（ブロックする）
+    // 書き込みはserviceと同じく応答の直後だけ行う
+    void stop();
+
+    // mainループから毎回呼ぶ。書き込める時間帯なら、ページの書き込みかセクタの消去を1回行う
+    // 記録していない間は、コンソールが止まっていれば次のセッションの分を先に消す
+    void service(uint32_t now_us);
+
+    State state() const { return state_; }
+    bool recording() const { return state_ == State::Recording; }
+    // 最新のセッション番号（記録がなければ0）
+    uint32_t session() const { return session_; }
+    // このセッションでフラッシュへ書いたバイト数
+    uint32_t bytes_written() const { return bytes_written_; }
+    // 書き込める、消去済みのセクタ数（記録中は書いているセクタを含む）
+    uint32_t erased_sectors() const {
+        return state_ == State::Recording ? erased_ - write_index_ : erased_;
+    }
+
+  private:
+    static constexpr std::size_t kStagingSize = 8192;
+    // 記録していない間に先に消去しておくセクタ数（領域の半分。古いセッションから消える）
+    static constexpr uint32_t kEraseReserve = kSectorCount / 2;
+
+    static std::size_t sink_writable(void *user);
+    static void sink_write(void *user, const uint8_t *data, std::size_t length);
+
+    // 1回分のフラッシュ操作。何もしなければfalse。flushなら半端なページも0xFFで埋めて書く
+    // 消去はallow_eraseのときだけ
+    bool step(bool flush, bool allow_erase);
+    void erase_next();
+    void program_page();
+    // 記録を終え、出力先をUARTへ戻す
+    void finish(State next);
+    std::size_t page_capacity() const;
+    uint32_t sector_offset(uint32_t index) const;
+    std::size_t staged() const { return staging_head_ - staging_tail_; }
+
+    State state_{State::Unavailable};
+    uint32_t session_{0};
+    uint32_t first_sector_{0}; // セッションの最初のセクタ（領域内の番号）
+    uint32_t next_sector_{0};  // 次のセッションを始めるセクタ
+    uint32_t last_used_{0};    // 最新のセッションのセクタ数（先に消すときに残す）
+    uint32_t write_index_{0};  // 書いているセクタ（セッション内の番号）
+    uint32_t write_page_{0};
+    // 消去済みのセクタ数。記録中はセッション内の番号で0からerased_-1まで、
+    // 記録していない間はnext_sector_から数える
+    uint32_t erased_{0};
+    uint32_t bytes_written_{0};
+    // 応答の送信開始からこの間だけフラッシュを触る（応答を送り終え、次の要求はまだ来ない）
+    gcinput::flash::ConsoleWindow window_{{.start_us = 400, .end_us = 2'000}};
+
+    // ログから受け取ってまだ書いていないバイト（mainループのみ）
+    std::array<uint8_t, kStagingSize> staging_{};
+    uint32_t staging_head_{0};
+    uint32_t staging_tail_{0};
+
+    gcinput::logging::Sink sink_{};
+};
+
+// フラッシュに残っているセッションを、書いた順にフレームへ切り分けて読む
+class SessionReader {
+  public:
+    // back=0で最新、1でその前のセッション。見つからなければfalse
+    bool open(uint32_t back);
+
+    // 次のフレーム（区切りの0x00を含む）をoutへ写して長さを返す。終わりなら0
+    // 長すぎるフレームや書きかけの0xFFは読み飛ばす
+    std::size_t next_frame(std::span<uint8_t, gcinput::telemetry::kMaxEncodedFrame> out);
+
+    uint32_t session() const { return session_; }
+    uint32_t sectors() const { return sectors_; }
+    uint32_t skipped() const { return skipped_; }
+
+  private:
+    uint32_t session_{0};
+    uint32_t first_sector_{0};
+    uint32_t first_index_{0};
+    uint32_t sectors_{0};
+    uint32_t sector_{0}; // 読んでいるセクタ（first_sector_からの数）
+    uint32_t offset_{0}; // セクタ内の位置
+    uint32_t skipped_{0};
+};
+
+} // namespace debug_recorder
@@ -0,0 +1,127 @@
+#pragma once
+#include "joybus/driver/joybus_sniffer.hpp"
+#include "sniffer/edge_decoder.hpp"
+#include "telemetry/emit.hpp"
+#include "telemetry/varint.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// スニファのエッジをmainループで読み、フレームとビットの時間として送る
+// Framesでは本体でフレームを組み立ててB行（ProbeBusFrame）を出す
+// Edgesでは生のエッジ（ProbeEdges）を送り、ホストで同じデコーダに通す
+// （エッジは1回のやり取りで200近くあり、UARTの帯域に収まらない分は丸ごと捨てる）
+namespace debug_sniffer {
+
+enum class Output : uint8_t { Frames, Edges };
+
+// これだけエッジが来なければ線は止まっている（フレームの途中なら4µs以内に次が来る）
+inline constexpr uint32_t kIdleUs = 100;
+
+class BusSniffer {
+  public:
+    BusSniffer(gcinput::JoybusSniffer &sniffer, gcinput::telemetry::ProbePort port, Output output)
+        : sniffer_{sniffer}, port_{port}, output_{output},
+          decoder_{gcinput::sniffer::ns_to_cycles(gcinput::sniffer::kDefaultEndHighNs,
+                                                  sniffer.clock_hz())} {}
+
+    // mainループから毎回呼ぶ
+    void poll(uint32_t now_us) {
+        std::array<uint32_t, 64> words{};
+        bool any = false;
+        std::size_t n = 0;
+        while ((n = sniffer_.read(words)) > 0) {
+            if (sniffer_.take_discontinuity()) {
+                clock_.reset();
+                decoder_.reset();
+                drop_batch();
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                on_edge(clock_.unpack(words[i]));
+            }
+            any = true;
+        }
+        if (any) {
+            last_edge_us_ = now_us;
+            idle_ = false;
+            return;
+        }
+        if (!idle_ && now_us - last_edge_us_ >= kIdleUs) {
+            idle_ = true;
+            decoder_.finish([&](const gcinput::sniffer::BusFrame &f) { emit_frame(f); });
+            flush_batch(/*idle=*/true);
+        }
+    }
+
+  private:
+    // 1レコードに入れる差分の最大バイト数（ヘッダを除いたペイロードに収まる分）
+    static constexpr std::size_t kBatchBytes = 200;
+
+    void on_edge(const gcinput::sniffer::Edge &edge) {
+        if (output_ == Output::Frames) {
+            decoder_.feed(edge, [&](const gcinput::sniffer::BusFrame &f) { emit_frame(f); });
+            return;
+        }
+        constexpr std::size_t kMaxDeltaBytes = gcinput::telemetry::varint::kMaxBytesU32;
+        if (batch_count_ > 0 && batch_size_ + kMaxDeltaBytes > kBatchBytes) {
+            flush_batch(/*idle=*/false);
+        }
+        if (batch_count_ == 0) {
+            batch_first_ = edge;
+        } else {
+            const uint32_t delta = edge.cycles - batch_last_cycles_;
+            batch_size_ += gcinput::telemetry::varint::encode_u32(delta, &batch_[batch_size_]);
+        }
+        batch_last_cycles_ = edge.cycles;
+        batch_count_++;
+    }
+
+    void emit_frame(const gcinput::sniffer::BusFrame &frame) {
+        gcinput::telemetry::emit(gcinput::sniffer::to_record(frame, port_, sniffer_.clock_hz()));
+    }
+
+    void flush_batch(bool idle) {
+        if (batch_count_ == 0) {
+            return;
+        }
+        const gcinput::telemetry::ProbeEdgesRecord record{
+            .port = port_,
+            .first_high = batch_first_.level,
+            .restart = restart_,
+            .idle = idle,
+            .clock_hz = sniffer_.clock_hz(),
+            .first_cycles = batch_first_.cycles,
+            .count = batch_count_,
+            .deltas = std::span<const uint8_t>(batch_.data(), batch_size_),
+        };
+        // 入りきらないなら捨て、ホストには次のレコードでつながっていないことを伝える
+        restart_ = !gcinput::telemetry::emit(record);
+        batch_count_ = 0;
+        batch_size_ = 0;
+    }
+
+    void drop_batch() {
+        batch_count_ = 0;
+        batch_size_ = 0;
+        restart_ = true;
+    }
+
+    gcinput::JoybusSniffer &sniffer_;
+    gcinput::telemetry::ProbePort port_;
+    Output output_;
+    gcinput::sniffer::EdgeClock clock_{};
+    gcinput::sniffer::EdgeDecoder decoder_;
+    uint32_t last_edge_us_{0};
+    bool idle_{true};
+
+    // Edges用
+    std::array<uint8_t, kBatchBytes> batch_{};
+    std::size_t batch_size_{0};
+    uint32_t batch_count_{0};
+    gcinput::sniffer::Edge batch_first_{};
+    uint32_t batch_last_cycles_{0};
+    bool restart_{true};
+};
+
+} // namespace debug_sniffer
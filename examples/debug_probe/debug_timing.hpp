@@ -0,0 +1,61 @@
+#pragma once
+#include "hardware/sync.h"
+#include "util/spsc_ring.hpp"
+#include "util/timing_stats.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// 通信タイミングの計測
+// ISRは測った値をリングに積むだけで、集計（TimingStats）はmainループで行う
+namespace debug_timing {
+
+// telemetry::ProbeTimingMetricと同じ値
+enum class Metric : uint8_t {
+    ConsolePollInterval, // コンソールのStatus要求の間隔
+    PadRoundTrip,        // パッドへの要求の送信開始から応答の受信完了まで
+    ReplyGap,            // コンソールの要求の受信完了割り込みから応答の送信開始まで
+    SampleAge,           // 応答に使ったパッドのStatusの受信から応答を組み立てるまで
+};
+inline constexpr std::size_t kMetricCount = 4;
+
+struct Sample {
+    Metric metric;
+    uint32_t value_us;
+};
+
+// Status応答1回で3件ほど積む。mainが数十ms止まっても落ちない数
+inline gcinput::SpscRing<Sample, 256> g_samples;
+
+// ISR安全: 測った値を積む（パッド側とコンソール側の割り込みから呼ぶので書き込み側を1つにする）
+inline void record(Metric metric, uint32_t value_us) {
+    const uint32_t irq = save_and_disable_interrupts();
+    g_samples.push(Sample{metric, value_us});
+    restore_interrupts(irq);
+}
+
+// main: 積まれた値を集計する
+class Collector {
+  public:
+    void drain() {
+        Sample sample{};
+        while (g_samples.pop(sample)) {
+            stats_[static_cast<std::size_t>(sample.metric)].add(sample.value_us);
+        }
+    }
+
+    const gcinput::TimingStats &stats(Metric metric) const {
+        return stats_[static_cast<std::size_t>(metric)];
+    }
+
+    void reset() {
+        for (auto &s : stats_) {
+            s.reset();
+        }
+    }
+
+  private:
+    std::array<gcinput::TimingStats, kMetricCount> stats_{};
+};
+
+} // namespace debug_timing
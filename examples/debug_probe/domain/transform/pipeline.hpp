@@ -14,6 +14,9 @@ using TransformFunction = void (*)(void *user, domain::PadState &state);
 struct Stage {
     TransformFunction func{nullptr};
     void *user{nullptr};
+    // このステージが書き換えうるフィールド（domain::input_fieldのビット）
+    // 申告より広く書き換えると応答に反映されないことがあるので、迷ったらkAllのままにする
+    uint16_t writes{domain::input_field::kAll};
 };
 
 template <class Context, void (*Func)(Context &, domain::PadState &)>
@@ -23,17 +26,19 @@ inline void thunk(void *user, domain::PadState &state) {
 }
 
 template <class Context, void (*Func)(Context &, domain::PadState &)>
-inline Stage make_stage(Context &context) {
+inline Stage make_stage(Context &context, uint16_t writes = domain::input_field::kAll) {
     return Stage{
         .func{&thunk<Context, Func>},
         .user{&context},
+        .writes{writes},
     };
 }
 
-inline Stage make_stage(TransformFunction func) {
+inline Stage make_stage(TransformFunction func, uint16_t writes = domain::input_field::kAll) {
     return Stage{
         .func{func},
         .user{nullptr},
+        .writes{writes},
     };
 }
 
@@ -82,8 +87,11 @@ class Pipeline {
         return (enabled & (1u << index)) != 0;
     }
 
-    void apply_from_isr(domain::PadState &state) const {
+    // 実行したステージが書き換えうるフィールドの和集合を返す
+    // 0なら入力をそのまま素通しした（有効なステージがない）
+    uint16_t apply_from_isr(domain::PadState &state) const {
         const uint32_t enabled = enable_mask_.load(std::memory_order_acquire);
+        uint16_t written = 0;
         for (std::size_t i = 0; i < stage_count_; ++i) {
             // is_stage_enabledでもいいけどISR内で何度もenabledをload()しなくて済むよう直接確認
             if ((enabled & (1u << i)) == 0) {
@@ -94,7 +102,9 @@ class Pipeline {
                 continue;
             }
             stage.func(stage.user, state);
+            written |= stage.writes;
         }
+        return written;
     }
 
   private:
@@ -9,11 +9,12 @@
 namespace gcinput::joybus::report {
 
 // JoybusのStatus wordにおけるレポートフラグのビット定義
+// 値は共通形式（PadInputのStatus word）と同じ
 enum class StatusWordBits : uint16_t {
-    OriginNotSent = (1u << 5),
-    ErrorLatched = (1u << 6),
-    Always1 = (1u << 7),
-    UseControllerOrigin = (1u << 15),
+    OriginNotSent = domain::to_mask(domain::PadStatusBit::OriginNotSent),
+    ErrorLatched = domain::to_mask(domain::PadStatusBit::ErrorLatched),
+    Always1 = domain::to_mask(domain::PadStatusBit::Always1),
+    UseControllerOrigin = domain::to_mask(domain::PadStatusBit::UseControllerOrigin),
 };
 
 enum class IdByte3Bits : uint8_t {
@@ -5,6 +5,7 @@
 #include "joybus/codec/report_wire.hpp"
 #include "joybus/protocol/protocol.hpp"
 #include <array>
+#include <cstring>
 #include <span>
 
 // https://jefflongo.dev/posts/gc-controller-reverse-engineering-part-1/#poll-mode
@@ -29,83 +30,38 @@ inline constexpr uint8_t pack4bitsToByte(uint8_t high4bits, uint8_t low4bits) {
 }
 
 // Status wordから共通形式のボタン入力を抽出
+// 共通形式もStatus wordをそのまま持つので、レポートフラグのビットも一緒に取り込まれる
 inline constexpr domain::ButtonInput
 decode_buttons_from_status_word(std::span<const uint8_t, 2> byte2) {
-    domain::ButtonInput buttons{};
-
-    const uint16_t status_word = util::read_u16_le(byte2);
-    buttons.a = (status_word & domain::to_mask(domain::PadButton::A)) != 0;
-    buttons.b = (status_word & domain::to_mask(domain::PadButton::B)) != 0;
-    buttons.x = (status_word & domain::to_mask(domain::PadButton::X)) != 0;
-    buttons.y = (status_word & domain::to_mask(domain::PadButton::Y)) != 0;
-    buttons.start = (status_word & domain::to_mask(domain::PadButton::Start)) != 0;
-    buttons.dpad_left = (status_word & domain::to_mask(domain::PadButton::DpadLeft)) != 0;
-    buttons.dpad_right = (status_word & domain::to_mask(domain::PadButton::DpadRight)) != 0;
-    buttons.dpad_down = (status_word & domain::to_mask(domain::PadButton::DpadDown)) != 0;
-    buttons.dpad_up = (status_word & domain::to_mask(domain::PadButton::DpadUp)) != 0;
-    buttons.z = (status_word & domain::to_mask(domain::PadButton::Z)) != 0;
-    buttons.r = (status_word & domain::to_mask(domain::PadButton::R)) != 0;
-    buttons.l = (status_word & domain::to_mask(domain::PadButton::L)) != 0;
-
-    return buttons;
+    return domain::ButtonInput{util::read_u16_le(byte2)};
 }
 
-// 共通形式の実行時レポートをStatus wordに変換
+// 共通形式のボタン入力と実行時レポートをStatus wordに変換
 inline constexpr void encode_to_status_word(const domain::PadState &state,
                                             std::span<uint8_t, 2> status_word_bytes) {
-    uint16_t status_word = 0;
-
-    // ボタン情報をStatus wordにセット
-    const auto &buttons = state.input.buttons;
-    status_word |= (static_cast<uint16_t>(buttons.a) ? domain::to_mask(domain::PadButton::A) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.b) ? domain::to_mask(domain::PadButton::B) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.x) ? domain::to_mask(domain::PadButton::X) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.y) ? domain::to_mask(domain::PadButton::Y) : 0u);
-    status_word |=
-        (static_cast<uint16_t>(buttons.start) ? domain::to_mask(domain::PadButton::Start) : 0u);
-    status_word |=
-        (static_cast<uint16_t>(buttons.dpad_left) ? domain::to_mask(domain::PadButton::DpadLeft)
-                                                  : 0u);
-    status_word |=
-        (static_cast<uint16_t>(buttons.dpad_right) ? domain::to_mask(domain::PadButton::DpadRight)
-                                                   : 0u);
-    status_word |=
-        (static_cast<uint16_t>(buttons.dpad_down) ? domain::to_mask(domain::PadButton::DpadDown)
-                                                  : 0u);
-    status_word |=
-        (static_cast<uint16_t>(buttons.dpad_up) ? domain::to_mask(domain::PadButton::DpadUp) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.z) ? domain::to_mask(domain::PadButton::Z) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.r) ? domain::to_mask(domain::PadButton::R) : 0u);
-    status_word |= (static_cast<uint16_t>(buttons.l) ? domain::to_mask(domain::PadButton::L) : 0u);
-
-    // レポートフラグをStatus wordにセット
-    // OriginNotSentはビットが立っているとOrigin未送信を意味するので反転
-    const auto &report = state.report;
-    status_word |=
-        report.origin_sent ? 0 : report::to_mask(report::StatusWordBits::OriginNotSent);
-    status_word |=
-        report.error_latched ? report::to_mask(report::StatusWordBits::ErrorLatched) : 0;
-
     // 2バイト目の7ビット目は常に1となる（Longo氏の資料では直近エラーの有無となっているが）
     // ここを1にしないとコントローラが認識されない
-    status_word |= report::to_mask(report::StatusWordBits::Always1);
+    const uint16_t status_word = state.input.buttons.status_word |
+                                 report::to_mask(report::StatusWordBits::Always1);
+    util::write_u16_le(status_word, status_word_bytes);
+}
 
-    status_word |= report.use_controller_origin
-                       ? report::to_mask(report::StatusWordBits::UseControllerOrigin)
-                       : 0;
+// アナログ値のバイト列を共通形式へそのままコピー
+// AnalogInputのフィールド順はMode3/Originレスポンスの3バイト目以降と同じ
+inline void copy_analog_from_wire(domain::AnalogInput &analog, std::span<const uint8_t> bytes) {
+    std::memcpy(reinterpret_cast<uint8_t *>(&analog), bytes.data(), bytes.size());
+}
 
-    util::write_u16_le(status_word, status_word_bytes);
+inline void copy_analog_to_wire(const domain::AnalogInput &analog, std::span<uint8_t> bytes) {
+    std::memcpy(bytes.data(), reinterpret_cast<const uint8_t *>(&analog), bytes.size());
 }
 
 // JoybusのStatusレスポンスを共通形式に変換
-inline constexpr domain::PadState
-decode_status(std::span<const uint8_t, joybus::kStatusResponseSize> rx,
-              joybus::PollMode poll_mode) {
+inline domain::PadState decode_status(std::span<const uint8_t, joybus::kStatusResponseSize> rx,
+                                     joybus::PollMode poll_mode) {
     domain::PadState out{};
 
-    // 先頭2バイト（Status word）を共通形式のレポートに変換
-    out.report = report::decode_report_from_status_word(rx.first<2>());
-    // Status wordを共通形式のボタン入力に変換
+    // 先頭2バイト（Status word）はボタンとレポートフラグを含めてそのまま保持
     out.input.buttons = decode_buttons_from_status_word(rx.first<2>());
 
     auto &analog_input = out.input.analog;
@@ -139,10 +95,8 @@ decode_status(std::span<const uint8_t, joybus::kStatusResponseSize> rx,
         analog_input.b_analog = rx[7];
         break;
     case joybus::PollMode::Mode3:
-        analog_input.c_stick_x = rx[4];
-        analog_input.c_stick_y = rx[5];
-        analog_input.l_analog = rx[6];
-        analog_input.r_analog = rx[7];
+        // スティックからRトリガーまで共通形式と同じ並び
+        copy_analog_from_wire(analog_input, rx.subspan<2, 6>());
         break;
     case joybus::PollMode::Mode4:
         analog_input.c_stick_x = rx[4];
@@ -157,102 +111,167 @@ decode_status(std::span<const uint8_t, joybus::kStatusResponseSize> rx,
     return out;
 }
 
-// 共通形式のStatus情報をJoybusレスポンス形式に変換
-inline JoybusReply encode_status(const domain::PadState &state, joybus::PollMode poll_mode) {
-    std::array<uint8_t, joybus::kStatusResponseSize> out{};
+// Statusレスポンスの各バイトの元になる共通形式のバイト位置
+// ビットが立っている位置が変化したときだけ、そのバイトを作り直せばよい
+namespace source = domain::input_field;
 
-    // out[0], out[1]: Status word
-    encode_to_status_word(state, std::span<uint8_t, 2>{out.data(), 2});
+// PollModeごとに特殊化したStatusレスポンスのエンコーダ
+// changedに含まれる入力から作られるバイトだけを書き換える。source::kAllなら全バイト
+// https://jefflongo.dev/posts/gc-controller-reverse-engineering-part-1/#poll-mode
+template <joybus::PollMode Mode>
+inline void patch_status_bytes_as(const domain::PadInput &input, uint16_t changed,
+                                  std::span<uint8_t, joybus::kStatusResponseSize> out) {
+    const auto &analog_input = input.analog;
+
+    // out[0], out[1]: Status word。Always1は下位バイトにある
+    if (changed & source::kStatusWordLow) {
+        out[0] = static_cast<uint8_t>(input.buttons.status_word |
+                                      report::to_mask(report::StatusWordBits::Always1));
+    }
+    if (changed & source::kStatusWordHigh) {
+        out[1] = static_cast<uint8_t>(input.buttons.status_word >> 8);
+    }
+    if (changed & source::kStickX) {
+        out[2] = analog_input.stick_x;
+    }
+    if (changed & source::kStickY) {
+        out[3] = analog_input.stick_y;
+    }
 
-    const auto &analog_input = state.input.analog;
+    if constexpr (Mode == joybus::PollMode::Mode0) {
+        if (changed & source::kCStickX) {
+            out[4] = analog_input.c_stick_x;
+        }
+        if (changed & source::kCStickY) {
+            out[5] = analog_input.c_stick_y;
+        }
+        if (changed & (source::kLAnalog | source::kRAnalog)) {
+            out[6] = pack4bitsToByte(shrink8bitTo4bit(analog_input.l_analog),
+                                     shrink8bitTo4bit(analog_input.r_analog));
+        }
+        if (changed & (source::kAAnalog | source::kBAnalog)) {
+            out[7] = pack4bitsToByte(shrink8bitTo4bit(analog_input.a_analog),
+                                     shrink8bitTo4bit(analog_input.b_analog));
+        }
+    } else if constexpr (Mode == joybus::PollMode::Mode1) {
+        if (changed & (source::kCStickX | source::kCStickY)) {
+            out[4] = pack4bitsToByte(shrink8bitTo4bit(analog_input.c_stick_x),
+                                     shrink8bitTo4bit(analog_input.c_stick_y));
+        }
+        if (changed & source::kLAnalog) {
+            out[5] = analog_input.l_analog;
+        }
+        if (changed & source::kRAnalog) {
+            out[6] = analog_input.r_analog;
+        }
+        if (changed & (source::kAAnalog | source::kBAnalog)) {
+            out[7] = pack4bitsToByte(shrink8bitTo4bit(analog_input.a_analog),
+                                     shrink8bitTo4bit(analog_input.b_analog));
+        }
+    } else if constexpr (Mode == joybus::PollMode::Mode2) {
+        if (changed & (source::kCStickX | source::kCStickY)) {
+            out[4] = pack4bitsToByte(shrink8bitTo4bit(analog_input.c_stick_x),
+                                     shrink8bitTo4bit(analog_input.c_stick_y));
+        }
+        if (changed & (source::kLAnalog | source::kRAnalog)) {
+            out[5] = pack4bitsToByte(shrink8bitTo4bit(analog_input.l_analog),
+                                     shrink8bitTo4bit(analog_input.r_analog));
+        }
+        if (changed & source::kAAnalog) {
+            out[6] = analog_input.a_analog;
+        }
+        if (changed & source::kBAnalog) {
+            out[7] = analog_input.b_analog;
+        }
+    } else if constexpr (Mode == joybus::PollMode::Mode3) {
+        if (changed & source::kCStickX) {
+            out[4] = analog_input.c_stick_x;
+        }
+        if (changed & source::kCStickY) {
+            out[5] = analog_input.c_stick_y;
+        }
+        if (changed & source::kLAnalog) {
+            out[6] = analog_input.l_analog;
+        }
+        if (changed & source::kRAnalog) {
+            out[7] = analog_input.r_analog;
+        }
+    } else if constexpr (Mode == joybus::PollMode::Mode4) {
+        if (changed & source::kCStickX) {
+            out[4] = analog_input.c_stick_x;
+        }
+        if (changed & source::kCStickY) {
+            out[5] = analog_input.c_stick_y;
+        }
+        if (changed & source::kAAnalog) {
+            out[6] = analog_input.a_analog;
+        }
+        if (changed & source::kBAnalog) {
+            out[7] = analog_input.b_analog;
+        }
+    }
+}
 
-    out[2] = analog_input.stick_x;
-    out[3] = analog_input.stick_y;
+// 全バイトを作る版。changedが定数なので分岐は消える
+template <joybus::PollMode Mode>
+inline void encode_status_bytes_as(const domain::PadInput &input,
+                                   std::span<uint8_t, joybus::kStatusResponseSize> out) {
+    patch_status_bytes_as<Mode>(input, source::kAll, out);
+}
 
-    // https://jefflongo.dev/posts/gc-controller-reverse-engineering-part-1/#poll-mode
-    switch (poll_mode) {
-    case joybus::PollMode::Mode0:
-        out[4] = analog_input.c_stick_x;
-        out[5] = analog_input.c_stick_y;
-        out[6] = pack4bitsToByte(shrink8bitTo4bit(analog_input.l_analog),
-                                 shrink8bitTo4bit(analog_input.r_analog));
-        out[7] = pack4bitsToByte(shrink8bitTo4bit(analog_input.a_analog),
-                                 shrink8bitTo4bit(analog_input.b_analog));
-        break;
-    case joybus::PollMode::Mode1:
-        out[4] = pack4bitsToByte(shrink8bitTo4bit(analog_input.c_stick_x),
-                                 shrink8bitTo4bit(analog_input.c_stick_y));
-        out[5] = analog_input.l_analog;
-        out[6] = analog_input.r_analog;
-        out[7] = pack4bitsToByte(shrink8bitTo4bit(analog_input.a_analog),
-                                 shrink8bitTo4bit(analog_input.b_analog));
-        break;
-    case joybus::PollMode::Mode2:
-        out[4] = pack4bitsToByte(shrink8bitTo4bit(analog_input.c_stick_x),
-                                 shrink8bitTo4bit(analog_input.c_stick_y));
-        out[5] = pack4bitsToByte(shrink8bitTo4bit(analog_input.l_analog),
-                                 shrink8bitTo4bit(analog_input.r_analog));
-        out[6] = analog_input.a_analog;
-        out[7] = analog_input.b_analog;
-        break;
-    case joybus::PollMode::Mode3:
-        out[4] = analog_input.c_stick_x;
-        out[5] = analog_input.c_stick_y;
-        out[6] = analog_input.l_analog;
-        out[7] = analog_input.r_analog;
-        break;
-    case joybus::PollMode::Mode4:
-        out[4] = analog_input.c_stick_x;
-        out[5] = analog_input.c_stick_y;
-        out[6] = analog_input.a_analog;
-        out[7] = analog_input.b_analog;
-        break;
-    default:
-        break;
-    }
+// PollModeごとのエンコーダを引く表。PollModeが変わったときに一度だけ引けばよい
+using StatusPatcher = void (*)(const domain::PadInput &, uint16_t,
+                               std::span<uint8_t, joybus::kStatusResponseSize>);
+
+inline constexpr std::array<StatusPatcher, 5> kStatusPatchers{
+    &patch_status_bytes_as<joybus::PollMode::Mode0>,
+    &patch_status_bytes_as<joybus::PollMode::Mode1>,
+    &patch_status_bytes_as<joybus::PollMode::Mode2>,
+    &patch_status_bytes_as<joybus::PollMode::Mode3>,
+    &patch_status_bytes_as<joybus::PollMode::Mode4>,
+};
+
+// 範囲外のPollModeはMode3として扱う（sanitize_poll_modeと同じ）
+inline constexpr StatusPatcher status_patcher_for(joybus::PollMode poll_mode) {
+    const auto index = static_cast<std::size_t>(poll_mode);
+    return index < kStatusPatchers.size()
+               ? kStatusPatchers[index]
+               : kStatusPatchers[static_cast<std::size_t>(joybus::PollMode::Mode3)];
+}
 
+// パッドから受信したStatusレスポンスをそのまま返すときのStatus wordの補正
+// コンソールへの応答ではAlways1を必ず立てる（encode_to_status_wordと同じ）
+inline constexpr void fix_up_raw_status(std::span<uint8_t, joybus::kStatusResponseSize> bytes) {
+    bytes[0] |= static_cast<uint8_t>(report::to_mask(report::StatusWordBits::Always1));
+}
+
+// 共通形式のStatus情報をJoybusレスポンス形式に変換
+inline JoybusReply encode_status(const domain::PadState &state, joybus::PollMode poll_mode) {
+    std::array<uint8_t, joybus::kStatusResponseSize> out{};
+    status_patcher_for(poll_mode)(state.input, source::kAll, out);
     return JoybusReply(joybus::Command::Status, out);
 }
 
-inline constexpr domain::PadState
-decode_origin(std::span<const uint8_t, joybus::kOriginResponseSize> rx) {
+inline domain::PadState decode_origin(std::span<const uint8_t, joybus::kOriginResponseSize> rx) {
     domain::PadState out{};
 
-    out.report = report::decode_report_from_status_word(rx.first<2>());
     out.input.buttons = decode_buttons_from_status_word(rx.first<2>());
-    auto &analog_input = out.input.analog;
-    analog_input.stick_x = rx[2];
-    analog_input.stick_y = rx[3];
-    analog_input.c_stick_x = rx[4];
-    analog_input.c_stick_y = rx[5];
-    analog_input.l_analog = rx[6];
-    analog_input.r_analog = rx[7];
-    analog_input.a_analog = rx[8];
-    analog_input.b_analog = rx[9];
+    copy_analog_from_wire(out.input.analog, rx.subspan<2, 8>());
     return out;
 }
 
-inline constexpr domain::PadState
+inline domain::PadState
 decode_recalibrate(std::span<const uint8_t, joybus::kRecalibrateResponseSize> rx) {
     return decode_origin(rx);
 }
 
-inline constexpr std::array<uint8_t, joybus::kOriginResponseSize>
+inline std::array<uint8_t, joybus::kOriginResponseSize>
 encode_origin_bytes(const domain::PadState &state) {
     std::array<uint8_t, joybus::kOriginResponseSize> out{};
 
     // out[0], out[1]: Status word
     encode_to_status_word(state, std::span<uint8_t, 2>{out.data(), 2});
-    const auto &analog_input = state.input.analog;
-
-    out[2] = analog_input.stick_x;
-    out[3] = analog_input.stick_y;
-    out[4] = analog_input.c_stick_x;
-    out[5] = analog_input.c_stick_y;
-    out[6] = analog_input.l_analog;
-    out[7] = analog_input.r_analog;
-    out[8] = analog_input.a_analog;
-    out[9] = analog_input.b_analog;
+    copy_analog_to_wire(state.input.analog, std::span<uint8_t>{out}.subspan<2, 8>());
 
     return out;
 }
@@ -230,6 +230,7 @@ void JoybusPioPort::on_pio_irq() {
     }
 
     // 送信中でないなら受信完了の通知を受けた
+    const uint32_t rx_done_us = time_us_32();
     finish_receive_from_irq();
 
     // 受信結果から即座に返信を生成
@@ -246,6 +247,9 @@ void JoybusPioPort::on_pio_irq() {
     if (tx_length > 0) {
         tx_busy_.store(true, std::memory_order_release);
         start_transmit_from_irq(tx_length);
+        if (config_.on_reply_started) {
+            config_.on_reply_started(callback_user_, time_us_32() - rx_done_us);
+        }
     } else {
         // 返信なしなら受信待ちに戻る
         start_receive();
@@ -35,6 +35,10 @@ class JoybusPioPort {
 
         // PIO側が `irq set 0 rel` 前提なら base=0 でOK（実IRQ=(base+sm)&7）
         uint irq_base = 0;
+
+        // 計測用（省略可）: 返信の送信を始めたときに割り込みから呼ぶ
+        // gap_usは受信完了の割り込みに入ってから送信を始めるまでの時間
+        void (*on_reply_started)(void *user, uint32_t gap_us) = nullptr;
     };
 
     // 返信生成用コールバック
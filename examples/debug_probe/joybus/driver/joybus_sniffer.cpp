@@ -0,0 +1,97 @@
+#include "joybus_sniffer.hpp"
+#include "hardware/clocks.h"
+#include "joybus_sniffer.pio.h"
+#include <algorithm>
+
+namespace gcinput {
+namespace {
+
+// DMAの転送数。残りがkRearmBelowを切ったら張り直す（11k語/秒なら数日に1回）
+constexpr uint32_t kTransferCount = 0xFFFF'FFFFu;
+constexpr uint32_t kRearmBelow = 0x8000'0000u;
+
+} // namespace
+
+JoybusSniffer::JoybusSniffer(const Config &config) : config_(config) {
+    program_offset_ = pio_add_program(config_.pio, &joybus_sniffer_program);
+
+    pio_sm_config c = joybus_sniffer_program_get_default_config(program_offset_);
+    // ピンは読むだけ（pio_gpio_initもピンの向きも触らない）
+    sm_config_set_in_pins(&c, config_.pin);
+    sm_config_set_jmp_pin(&c, config_.pin);
+    // in x, 31 と in null/y, 1 で32ビットになったら自動push
+    sm_config_set_in_shift(&c,
+                           /*shift_right=*/false,
+                           /*autopush=*/true,
+                           /*push_thresh=*/32);
+    // FIFOが詰まるとpushで止まり時刻がずれるので、受信側を8段にする
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    // 分解能を上げるためclk_sysのまま動かす
+    sm_config_set_clkdiv(&c, 1.0f);
+    clock_hz_ = clock_get_hz(clk_sys);
+
+    pio_sm_init(config_.pio, config_.state_machine, program_offset_ + joybus_sniffer_offset_start,
+                &c);
+    // プログラムに入れると32命令を超えるので、y = 1, x = ~0 はここで入れる
+    pio_sm_exec(config_.pio, config_.state_machine, pio_encode_set(pio_y, 1));
+    pio_sm_exec(config_.pio, config_.state_machine, pio_encode_mov_not(pio_x, pio_null));
+
+    dma_channel_ = dma_claim_unused_channel(true);
+    dma_channel_config dma_config = dma_channel_get_default_config(dma_channel_);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_32);
+    channel_config_set_dreq(&dma_config,
+                            pio_get_dreq(config_.pio, config_.state_machine, false));
+    channel_config_set_read_increment(&dma_config, false);
+    channel_config_set_write_increment(&dma_config, true);
+    channel_config_set_ring(&dma_config, /*write=*/true, kRingSizeBits);
+    dma_channel_configure(dma_channel_, &dma_config, ring_.data(),
+                          &config_.pio->rxf[config_.state_machine], kTransferCount, true);
+
+    pio_sm_set_enabled(config_.pio, config_.state_machine, true);
+}
+
+JoybusSniffer::~JoybusSniffer() {
+    if (!config_.pio) {
+        return;
+    }
+    pio_sm_set_enabled(config_.pio, config_.state_machine, false);
+    if (dma_channel_ >= 0) {
+        dma_channel_abort(dma_channel_);
+        dma_channel_unclaim(dma_channel_);
+        dma_channel_ = -1;
+    }
+    pio_remove_program(config_.pio, &joybus_sniffer_program, program_offset_);
+}
+
+std::size_t JoybusSniffer::read(std::span<uint32_t> out) {
+    rearm_if_needed();
+    const uint32_t written = written_words();
+    if (written - read_ > kRingWords) {
+        // DMAが追い越した。残っている分もつながらないので捨てる
+        overruns_++;
+        discontinuity_ = true;
+        read_ = written;
+    }
+    const std::size_t n = std::min<std::size_t>(written - read_, out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = ring_[read_++ % kRingWords];
+    }
+    return n;
+}
+
+uint32_t JoybusSniffer::written_words() const {
+    return base_ + (kTransferCount - dma_channel_hw_addr(dma_channel_)->transfer_count);
+}
+
+void JoybusSniffer::rearm_if_needed() {
+    if (dma_channel_hw_addr(dma_channel_)->transfer_count >= kRearmBelow) {
+        return;
+    }
+    // 止めている間に届いた語はFIFOに残る（8語を超えて詰まるほど長くは止めない）
+    // 止める直前に書かれた分はbase_に含めるので、続けて読める
+    dma_channel_abort(dma_channel_);
+    base_ = written_words();
+    dma_channel_set_trans_count(dma_channel_, kTransferCount, true);
+}
+
+} // namespace gcinput
@@ -0,0 +1,71 @@
+#pragma once
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "pico/stdlib.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gcinput {
+
+// JoyBusの線を受動的に見て、エッジの時刻をDMAでリングへ流す
+// 送受信を担うJoybusPioPortとは別の空いているステートマシンで、同じピンを入力として読むだけ
+// 語の解釈はsniffer::EdgeClock（examples/common/sniffer/edge_decoder.hpp）
+class JoybusSniffer {
+  public:
+    // 4KB（1024語）。Statusのやり取り1回でおよそ180エッジ
+    static constexpr std::size_t kRingWords = 1024;
+    static constexpr uint kRingSizeBits = 12;
+    static_assert((1u << kRingSizeBits) == kRingWords * sizeof(uint32_t));
+
+    struct Config {
+        PIO pio = nullptr;
+        uint state_machine = 0;
+        uint pin = 0;
+    };
+
+    explicit JoybusSniffer(const Config &config);
+    ~JoybusSniffer();
+
+    JoybusSniffer(const JoybusSniffer &) = delete;
+    JoybusSniffer &operator=(const JoybusSniffer &) = delete;
+    JoybusSniffer(JoybusSniffer &&) = delete;
+    JoybusSniffer &operator=(JoybusSniffer &&) = delete;
+
+    // main: 溜まった語を古い順にoutへ写し、写した数を返す
+    std::size_t read(std::span<uint32_t> out);
+
+    // 直前のreadで返した語が、それより前の語とつながっていないか（読むと消える）
+    // trueなら解釈側をリセットしてから、その語を使う
+    bool take_discontinuity() {
+        const bool d = discontinuity_;
+        discontinuity_ = false;
+        return d;
+    }
+
+    uint32_t overruns() const { return overruns_; }
+    // エッジの時刻の単位（clk_sys）
+    uint32_t clock_hz() const { return clock_hz_; }
+
+  private:
+    // DMAの転送数は減っていくので、最初からの書き込み数へ直す
+    uint32_t written_words() const;
+    void rearm_if_needed();
+
+    Config config_{};
+    uint program_offset_ = 0;
+    int dma_channel_ = -1;
+    uint32_t clock_hz_ = 0;
+
+    uint32_t base_ = 0; // 張り直す前までに書かれた数
+    uint32_t read_ = 0;
+    uint32_t overruns_ = 0;
+    bool discontinuity_ = false;
+
+    // DMAのリング（書き込みアドレスの下位ビットだけが回る）のため大きさで揃える
+    alignas(kRingWords * sizeof(uint32_t)) std::array<uint32_t, kRingWords> ring_{};
+};
+
+} // namespace gcinput
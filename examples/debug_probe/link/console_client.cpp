@@ -1,5 +1,6 @@
 #include "link/console_client.hpp"
 #include "debug_log.hpp"
+#include "debug_timing.hpp"
 #include "domain/transform/pipeline.hpp"
 #include "joybus/codec/identity_wire.hpp"
 #include "joybus/codec/state_wire.hpp"
@@ -24,10 +25,21 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
     }
 
     auto *self = static_cast<ConsoleClient *>(user);
+    const uint32_t now_us = time_us_32();
     self->link_.shared_console().on_request_isr(std::span<const uint8_t>(rx, rx_len));
 
     const auto cmd = static_cast<joybus::Command>(rx[0]);
 
+    // コンソールのポーリング間隔
+    if (cmd == joybus::Command::Status) {
+        if (self->has_last_poll_) {
+            debug_timing::record(debug_timing::Metric::ConsolePollInterval,
+                                 now_us - self->last_poll_us_);
+        }
+        self->last_poll_us_ = now_us;
+        self->has_last_poll_ = true;
+    }
+
     // CON RX: コンソールからのリクエストをログ
     // Statusコマンドの場合はPollMode情報付きでログ
     if (cmd == joybus::Command::Status) {
@@ -57,12 +69,37 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
     const auto &pipelines = self->link_.transform_pipelines();
     switch (cmd) {
     case joybus::Command::Status: {
+        if (original_snapshot.has_status_raw) {
+            debug_timing::record(debug_timing::Metric::SampleAge,
+                                 time_us_32() - original_snapshot.status_received_us);
+        }
         const domain::PadState original_state = original_snapshot.status;
-        original_reply = joybus::state_wire::encode_status(original_state, host_poll_mode);
-
         domain::PadState modified_state = original_state;
-        pipelines.status.apply_from_isr(modified_state);
-        modified_reply = joybus::state_wire::encode_status(modified_state, host_poll_mode);
+        const uint16_t written = pipelines.status.apply_from_isr(modified_state);
+
+        if (original_snapshot.has_status_raw &&
+            original_snapshot.status_raw_poll_mode == host_poll_mode) {
+            // パッドへの問い合わせとコンソールの指定が同じPollModeなら受信したバイト列をそのまま使い、
+            // ステージが書き換えたフィールドのバイトだけを作り直す（何も書き換えなければ素通し）
+            auto bytes = original_snapshot.status_raw;
+            joybus::state_wire::fix_up_raw_status(bytes);
+            original_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+            if (written != 0) {
+                host_console.status_patcher(modified_state.input, written, bytes);
+            }
+            modified_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+            break;
+        }
+
+        // コンソールの指定したPollModeで作り直す。加工後の応答はステージが書き換えたフィールドの
+        // バイトだけを書き換える
+        std::array<uint8_t, joybus::kStatusResponseSize> bytes{};
+        host_console.status_patcher(original_state.input, domain::input_field::kAll, bytes);
+        original_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
+        if (written != 0) {
+            host_console.status_patcher(modified_state.input, written, bytes);
+        }
+        modified_reply = joybus::JoybusReply(joybus::Command::Status, bytes);
         break;
     }
     case joybus::Command::Origin: {
@@ -18,6 +18,9 @@ class ConsoleClient {
 
   private:
     BridgeContext &link_;
+    // 前回のStatus要求を受けた時刻（ISR専用）
+    uint32_t last_poll_us_{0};
+    bool has_last_poll_{false};
     JoybusPioPort device_to_console_;
 };
 } // namespace gcinput
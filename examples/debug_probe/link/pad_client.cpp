@@ -1,5 +1,6 @@
 #include "link/pad_client.hpp"
 #include "debug_log.hpp"
+#include "debug_timing.hpp"
 #include "link/policy.hpp"
 
 namespace gcinput {
@@ -21,12 +22,14 @@ std::size_t PadClient::callback(void *user, const uint8_t *rx, std::size_t rx_le
         // 取り扱うべきでないコマンド
         return 0;
     }
+    debug_timing::record(debug_timing::Metric::PadRoundTrip,
+                         time_us_32() - self->request_sent_us_.load(std::memory_order_relaxed));
     self->on_pad_response_isr(command, std::span<const uint8_t>(rx, rx_len));
     // Picoからコントローラへの応答は不要
     return 0;
 }
 
-static const char *state_name(PadClient::State s) {
+const char *PadClient::state_name(State s) {
     switch (s) {
     case PadClient::State::Disconnected:     return "Disconnected";
     case PadClient::State::Resetting:        return "Resetting";
@@ -42,10 +45,9 @@ static const char *state_name(PadClient::State s) {
 }
 
 void PadClient::enter_state_(State next) {
-    // 状態遷移ログ
-    char msg[48];
-    snprintf(msg, sizeof(msg), "%s -> %s", state_name(state_), state_name(next));
-    debug_log::ring_push_state(debug_log::Port::Pad, msg);
+    // 状態遷移ログ（名前はmainで取り出すときにstate_nameで引く）
+    debug_log::ring_push_state(debug_log::Port::Pad, static_cast<uint8_t>(state_),
+                               static_cast<uint8_t>(next));
 
     state_ = next;
     abort_wait_();
@@ -72,7 +74,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
 
     // 繋がっていたコントローラとの接続が切れた
     if (!pad_alive && state_ != State::Disconnected) {
-        debug_log::ring_push_timeout(debug_log::Port::Pad, "pad connection lost");
+        debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::ConnectionLost);
         enter_state_(State::Disconnected);
         next_status_due_us_ = 0;
     }
@@ -105,7 +107,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
             // IDの応答が来たら次はOrigin
             enter_state_(State::BootOrigin);
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Id");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::Id);
             abort_wait_();
         }
         break;
@@ -121,7 +123,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
             load_reset_epoch_();
             enter_state_(State::BootId);
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Reset");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::Reset);
             abort_wait_();
         }
         break;
@@ -135,7 +137,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
         if (got(joybus::Command::Id)) {
             enter_state_(State::BootOrigin);
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Id (boot)");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::BootId);
             abort_wait_();
         }
         break;
@@ -149,7 +151,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
         if (got(joybus::Command::Origin)) {
             enter_state_(State::BootRecalibrate);
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Origin");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::Origin);
             abort_wait_();
         }
         break;
@@ -163,7 +165,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
         if (got(joybus::Command::Recalibrate)) {
             enter_state_(State::WarmStatus);
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Recalibrate");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::Recalibrate);
             abort_wait_();
         }
         break;
@@ -182,7 +184,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
             enter_state_(State::Ready);
             next_status_due_us_ = now_us + kStatusPeriodUs;
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Status (warm)");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::WarmStatus);
             abort_wait_();
         }
         break;
@@ -214,7 +216,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
                 next_status_due_us_ = now_us + kStatusPeriodUs;
                 abort_wait_();
             } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-                debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Status");
+                debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::Status);
                 next_status_due_us_ = now_us + kRetryDelayUs;
                 abort_wait_();
             }
@@ -244,7 +246,7 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
             enter_state_(State::Ready);
             next_status_due_us_ = now_us + kStatusPeriodUs;
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Origin (relay)");
+            debug_log::ring_push_timeout(debug_log::Port::Pad, debug_log::TimeoutId::RelayOrigin);
             // タイムアウトしてもパッドは接続済みなのでReadyに戻る
             enter_state_(State::Ready);
             next_status_due_us_ = now_us + kRetryDelayUs;
@@ -261,7 +263,8 @@ void PadClient::tick(uint32_t now_us, const ConsoleState &console) {
             enter_state_(State::Ready);
             next_status_due_us_ = now_us + kStatusPeriodUs;
         } else if (is_timeout_reached_(now_us, response_deadline_us_)) {
-            debug_log::ring_push_timeout(debug_log::Port::Pad, "waiting for Recalibrate (relay)");
+            debug_log::ring_push_timeout(debug_log::Port::Pad,
+                                         debug_log::TimeoutId::RelayRecalibrate);
             // タイムアウトしてもパッドは接続済みなのでReadyに戻る
             enter_state_(State::Ready);
             next_status_due_us_ = now_us + kRetryDelayUs;
@@ -41,6 +41,9 @@ class PadClient {
         RelayRecalibrate,   // 本体からのRecalibrateをコントローラに中継
     };
 
+    // 状態の表示名（トレースの状態IDを文字列へ戻す）
+    static const char *state_name(State s);
+
   private:
     template <std::size_t N>
     bool send_request_(const joybus::Request<N> &request, uint32_t now_us, uint32_t timeout_us) {
@@ -63,6 +66,8 @@ class PadClient {
             link_.real_pad_hub().load_original_snapshot().publish_count;
         await_publish_count_ = before_publish_count; // このカウントからずれたら応答あり
 
+        // 往復時間の起点。send_nowが割り込みを止めている間に応答は来ないので先に書いておく
+        request_sent_us_.store(time_us_32(), std::memory_order_relaxed);
         bool send_ok = host_to_pad_.send_now(bytes.data(), bytes.size());
         if (!send_ok) {
             abort_wait_();
@@ -136,6 +141,8 @@ class PadClient {
     uint32_t response_deadline_us_{0};
 
     std::atomic<uint8_t> await_command_{static_cast<uint8_t>(joybus::Command::Invalid)};
+    // 直近の要求を送り始めた時刻（応答の割り込みで往復時間を測る）
+    std::atomic<uint32_t> request_sent_us_{0};
 
     // 応答を待っているコマンド
     joybus::Command awaiting_command_() const {
@@ -1,4 +1,5 @@
 #pragma once
+#include "joybus/codec/state_wire.hpp"
 #include "joybus/protocol/protocol.hpp"
 #include "util/latest_slot.hpp"
 #include <span>
@@ -7,6 +8,9 @@ namespace gcinput {
 
 struct ConsoleState {
     domain::PollMode poll_mode = domain::PollMode::Mode3;
+    // poll_modeに対応するStatusレスポンスのエンコーダ。PollModeが変わったときだけ引き直す
+    joybus::state_wire::StatusPatcher status_patcher =
+        joybus::state_wire::status_patcher_for(domain::PollMode::Mode3);
     domain::RumbleMode rumble_mode = domain::RumbleMode::Off;
     uint16_t reset_count = 0;
 };
@@ -28,6 +32,9 @@ class SharedConsole {
                 const auto poll = joybus::sanitize_poll_mode(rx[1]);
                 const auto rumble = joybus::sanitize_rumble_mode(rx[2]);
                 if (poll != shadow_.poll_mode || rumble != shadow_.rumble_mode) {
+                    if (poll != shadow_.poll_mode) {
+                        shadow_.status_patcher = joybus::state_wire::status_patcher_for(poll);
+                    }
                     shadow_.poll_mode = poll;
                     shadow_.rumble_mode = rumble;
                     updated = true;
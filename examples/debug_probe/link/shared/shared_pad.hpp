@@ -7,6 +7,7 @@
 #include "joybus/codec/state_wire.hpp"
 #include "joybus/protocol/protocol.hpp"
 #include "link/policy.hpp"
+#include "pico/stdlib.h"
 #include "util/latest_slot.hpp"
 #include <algorithm>
 #include <array>
@@ -21,6 +22,14 @@ struct PadSnapshot {
     domain::PadIdentity identity{};
     domain::PadState status{};
     domain::PadState origin{};
+
+    // 直近に受信したStatusレスポンスの生バイト列と、その問い合わせに使ったPollMode
+    // コンソールの指定と同じPollModeならエンコードし直さずにこれをそのまま返せる
+    std::array<uint8_t, joybus::kStatusResponseSize> status_raw{};
+    domain::PollMode status_raw_poll_mode{policy::kPadPollModeForQuery};
+    bool has_status_raw{false};
+    // status_rawを受信した時刻（応答に使うまでの経過時間の計測用）
+    uint32_t status_received_us{0};
 };
 
 class SharedPad {
@@ -40,8 +49,11 @@ class SharedPad {
 
             auto decoded =
                 gcinput::joybus::state_wire::decode_status(view, policy::kPadPollModeForQuery);
-            shadow_.status.report = decoded.report;
-            shadow_.status.input = decoded.input;
+            shadow_.status = decoded;
+            std::copy_n(view.begin(), view.size(), shadow_.status_raw.begin());
+            shadow_.status_raw_poll_mode = policy::kPadPollModeForQuery;
+            shadow_.has_status_raw = true;
+            shadow_.status_received_us = time_us_32();
             got_valid_frame = true;
             break;
         }
@@ -53,8 +65,7 @@ class SharedPad {
             }
             auto view = std::span<const uint8_t, joybus::kOriginResponseSize>(rx);
             auto decoded = gcinput::joybus::state_wire::decode_origin(view);
-            shadow_.origin.report = decoded.report;
-            shadow_.origin.input = decoded.input;
+            shadow_.origin = decoded;
             got_valid_frame = true;
             break;
         }
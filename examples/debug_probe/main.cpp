@@ -1,18 +1,28 @@
 #include "debug_log.hpp"
+#include "debug_recorder.hpp"
+#include "debug_sniffer.hpp"
+#include "debug_timing.hpp"
 #include "domain/state.hpp"
 #include "domain/transform/builtins.hpp"
 #include "domain/transform/pipeline.hpp"
 #include "hardware/pio.h"
 #include "joybus/driver/joybus_pio_port.hpp"
+#include "joybus/driver/joybus_sniffer.hpp"
 #include "joybus_console.pio.h"
 #include "joybus_pad.pio.h"
 #include "link/console_client.hpp"
 #include "link/pad_client.hpp"
 #include "link/shared/shared_pad_hub.hpp"
+#include "logging/log.hpp"
 #include "pico/bootrom.h"
 #include "pico/stdlib.h"
-#include <cstdio>
-#include <cstring>
+#include "telemetry/emit.hpp"
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <span>
+#include <stdio.h>
+#include <string_view>
 
 namespace {
 
@@ -38,8 +48,9 @@ void handle_boot_btn_if_requested() {
     g_boot_btn_requested = false;
     busy_wait_ms(100);
     if (gpio_get(BOOT_BTN_PIN) == 0) {
-        printf("M,%lu,BOOTSEL button pressed. Entering USB boot mode\n",
-               (unsigned long)time_us_32());
+        gcinput::logging::info("BOOTSEL button pressed. Entering USB boot mode\n");
+        // キューに残っている行を送り切ってからリセットする
+        gcinput::logging::flush_blocking(200'000);
         reset_usb_boot(0, 0);
     }
 }
@@ -58,53 +69,247 @@ void init_led() {
 }
 
 // ─── ログ出力 ───
+// 各行はテレメトリレコードとしてloggingのキューへ積み、UARTへの送出はDMAに任せる
+// ホストではhost/telemetryのgc_telemetry_decodeで従来のT/S/M/U形式のCSVへ戻す
 
-void print_csv_header() {
-    printf("# debug_probe v1\n");
-    printf("# format: T,timestamp_us,port,dir,len,hex_data[,pm=P{n}/C{n}/R{n}]\n");
-    printf("# format: S,timestamp_us,from_state,to_state\n");
-    printf("# format: M,timestamp_us,message\n");
-    printf("# format: U,timestamp_us,port,polls,ok,timeout\n");
+namespace logging = gcinput::logging;
+namespace telemetry = gcinput::telemetry;
+
+telemetry::ProbePort to_probe_port(debug_log::Port port) {
+    return (port == debug_log::Port::Pad) ? telemetry::ProbePort::Pad
+                                          : telemetry::ProbePort::Console;
 }
 
-void print_log_entry(const debug_log::LogEntry &e) {
-    using debug_log::Port;
-    using debug_log::Dir;
+bool print_log_entry(const debug_log::LogEntry &e) {
+    const auto port = to_probe_port(e.port());
+    switch (e.kind()) {
+    case debug_log::Kind::State: {
+        // S行: 状態遷移 — "from -> to" 形式（分割はホスト側で行う）
+        using State = gcinput::PadClient::State;
+        char text[48];
+        const int n = snprintf(text, sizeof(text), "%s -> %s",
+                               gcinput::PadClient::state_name(State{e.state_from()}),
+                               gcinput::PadClient::state_name(State{e.state_to()}));
+        const std::size_t length = std::min<std::size_t>(n > 0 ? n : 0, sizeof(text) - 1);
+        return telemetry::emit_at(
+            telemetry::ProbeStateRecord{.port = port, .text = std::string_view(text, length)},
+            e.timestamp_us);
+    }
+    case debug_log::Kind::Timeout:
+        // M行: タイムアウトメッセージ
+        return telemetry::emit_at(
+            telemetry::ProbeTimeoutRecord{.port = port,
+                                          .text = debug_log::timeout_name(e.timeout_id())},
+            e.timestamp_us);
+    case debug_log::Kind::Frame:
+    case debug_log::Kind::FramePollMode:
+        break;
+    }
+    // T行: データフレーム
+    return telemetry::emit_at(
+        telemetry::ProbeFrameRecord{
+            .port = port,
+            .dir = (e.dir() == debug_log::Dir::TX) ? telemetry::ProbeDir::TX
+                                                   : telemetry::ProbeDir::RX,
+            .command = e.command_byte,
+            .data = std::span<const uint8_t>(e.data, e.data_len()),
+            .has_poll_mode = e.has_poll_mode(),
+            .poll_mode_pad = e.poll_mode_pad(),
+            .poll_mode_console = e.poll_mode_console(),
+            .poll_mode_reply = e.poll_mode_reply(),
+        },
+        e.timestamp_us);
+}
 
-    const char port_char = (e.port == Port::Pad) ? 'P' : 'C';
-
-    if (e.is_state) {
-        // S行: 状態遷移 — state_str は "from -> to" 形式
-        // " -> " で分割して from/to を取得
-        char buf[48];
-        strncpy(buf, e.state_str, sizeof(buf));
-        buf[sizeof(buf) - 1] = '\0';
-        char *arrow = strstr(buf, " -> ");
-        if (arrow) {
-            *arrow = '\0';
-            const char *from_state = buf;
-            const char *to_state = arrow + 4;
-            printf("S,%lu,%s,%s\n", (unsigned long)e.timestamp_us, from_state, to_state);
-        } else {
-            // フォールバック: パース不能ならM行で出力
-            printf("M,%lu,%s\n", (unsigned long)e.timestamp_us, e.state_str);
+// ─── トリガ前後の凍結区間 ───
+// 凍結したらProbeCaptureの見出しと中身を、ログのキューに空きがある分だけ数周に分けて送る
+// 送り終えたら同じ条件で待ち受け直す
+class CaptureDumper {
+  public:
+    explicit CaptureDumper(const debug_log::Trigger &trigger) : trigger_{trigger} {
+        debug_log::g_capture.arm(trigger_);
+    }
+
+    // 区間を送出中ならtrue。その間はリングの取り出しを止め、区間に他のレコードを混ぜない
+    bool poll() {
+        auto &capture = debug_log::g_capture;
+        if (capture.phase() != debug_log::TriggerCapture::Phase::Frozen) {
+            return false;
         }
-    } else if (e.is_timeout) {
-        // M行: タイムアウトメッセージ
-        printf("M,%lu,%c TIMEOUT %s\n", (unsigned long)e.timestamp_us, port_char, e.state_str);
-    } else {
-        // T行: データフレーム
-        const char dir_char = (e.dir == Dir::TX) ? 'T' : 'R';
-        printf("T,%lu,%c,%c,%u,", (unsigned long)e.timestamp_us, port_char, dir_char, e.data_len);
-        for (uint8_t i = 0; i < e.data_len; i++) {
-            if (i > 0) printf(" ");
-            printf("%02X", e.data[i]);
+        while (logging::has_room_for_frame(telemetry::kMaxEncodedFrame)) {
+            if (!header_sent_) {
+                // 見出しの前後の数は、続く行の数に合わせて件で数える
+                const std::size_t trigger_index = capture.trigger_index();
+                telemetry::emit_at(
+                    telemetry::ProbeCaptureRecord{
+                        .trigger = static_cast<telemetry::ProbeTrigger>(capture.trigger().type),
+                        .pre = static_cast<uint32_t>(capture.count_entries(0, trigger_index)),
+                        .post = static_cast<uint32_t>(
+                            capture.count_entries(trigger_index + 1, capture.size())),
+                    },
+                    capture.trigger_us());
+                unpacker_ = capture.unpacker();
+                header_sent_ = true;
+            } else if (next_ < capture.size()) {
+                debug_log::LogEntry e{};
+                if (unpacker_.feed(capture.at(next_++), e)) {
+                    print_log_entry(e);
+                }
+            } else {
+                next_ = 0;
+                header_sent_ = false;
+                capture.arm(trigger_);
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    debug_log::Trigger trigger_;
+    debug_log::EntryUnpacker unpacker_{};
+    std::size_t next_{0};
+    bool header_sent_{false};
+};
+
+// 既定のトリガ: Ready中のStatusポーリングがタイムアウトしたら、その前512個と後160個を残す
+// （Statusの1往復は7個なので、前は約70往復・後は約20往復分）
+// （起動中のタイムアウトはパッド未接続でも繰り返し起きるので対象にしない）
+constexpr debug_log::Trigger kCaptureTrigger{
+    .type = debug_log::TriggerType::Timeout,
+    .id = static_cast<uint8_t>(debug_log::TimeoutId::Status),
+    .pre = 512,
+    .post = 160,
+};
+
+// ─── 通信タイミングの統計 ───
+// ISRが積んだ値をmainで集計し、一定期間ごとにL行（ProbeTiming）として出す
+
+constexpr uint32_t kTimingIntervalUs = 5'000'000; // 5s
+
+// 返信の送信開始時に割り込みから呼ばれる
+void __not_in_flash_func(record_reply_gap)(void *user, uint32_t gap_us) {
+    (void)user;
+    debug_timing::record(debug_timing::Metric::ReplyGap, gap_us);
+    debug_recorder::note_console_reply(time_us_32());
+}
+
+void emit_timing(const debug_timing::Collector &collector, uint32_t now_us) {
+    for (std::size_t i = 0; i < debug_timing::kMetricCount; ++i) {
+        const auto metric = static_cast<debug_timing::Metric>(i);
+        const auto &stats = collector.stats(metric);
+        if (stats.count() == 0) {
+            continue;
+        }
+        telemetry::emit_at(
+            telemetry::ProbeTimingRecord{
+                .metric = static_cast<telemetry::ProbeTimingMetric>(metric),
+                .count = stats.count(),
+                .min = stats.min(),
+                .mean = stats.mean(),
+                .max = stats.max(),
+                .p50 = stats.percentile(500),
+                .p99 = stats.percentile(990),
+                .jitter = stats.jitter(),
+            },
+            now_us);
+    }
+}
+
+// ─── スニファ ───
+// コンソール側の線のエッジ時刻を空いているステートマシンで記録し、B行（ProbeBusFrame）を出す
+// 使わないならkEnableSnifferをfalseにする（PIOの命令メモリも9命令空く）
+constexpr bool kEnableSniffer = true;
+constexpr debug_sniffer::Output kSnifferOutput = debug_sniffer::Output::Frames;
+
+// ─── フラッシュへの記録 ───
+// シリアルから1文字のコマンドで操作する
+//   r: 記録を始める  s: 止める  d: 最新のセッションを送る  p: その前のセッションを送る
+// 送り直すのは記録したときのままのフレームなので、ホストではいつもどおりデコードする
+// PCをつながずに記録したいときはkRecordOnBootをtrueにする（起動のたびに新しいセッションになる。
+// 記録を持ち帰ってPCにつなぐと新しいセッションが始まるので、pで前のセッションを送る）
+constexpr bool kRecordOnBoot = false;
+// B行は1回のやり取りで数十バイトあり1MBを数分で使い切るので、記録中はスニファを読まない
+constexpr bool kRecordSniffer = false;
+
+// 記録したフレームを、ログのキューに空きがある分だけ数周に分けて送り直す
+class RecordingDumper {
+  public:
+    explicit RecordingDumper(debug_recorder::FlashRecorder &recorder) : recorder_{recorder} {}
+
+    void begin(uint32_t back) {
+        recorder_.stop();
+        if (!reader_.open(back)) {
+            logging::warn("recorder: no session to dump\n");
+            return;
+        }
+        logging::info("recorder: dump begin session=%lu sectors=%lu\n", reader_.session(),
+                      reader_.sectors());
+        active_ = true;
+    }
+
+    bool active() const { return active_; }
+
+    // 送出中ならtrue。その間はリングの取り出しを止め、記録に他のレコードを混ぜない
+    bool poll() {
+        if (!active_) {
+            return false;
         }
-        if (e.has_poll_mode) {
-            printf(",pm=P%u/C%u/R%u",
-                   e.poll_mode_pad, e.poll_mode_console, e.poll_mode_reply);
+        std::array<uint8_t, telemetry::kMaxEncodedFrame> frame{};
+        while (logging::has_room_for_frame(frame.size())) {
+            const std::size_t length = reader_.next_frame(frame);
+            if (length == 0) {
+                logging::info("recorder: dump end session=%lu skipped=%lu\n", reader_.session(),
+                              reader_.skipped());
+                active_ = false;
+                return false;
+            }
+            telemetry::emit_encoded(std::span<const uint8_t>(frame.data(), length));
         }
-        printf("\n");
+        return true;
+    }
+
+  private:
+    debug_recorder::FlashRecorder &recorder_;
+    debug_recorder::SessionReader reader_{};
+    bool active_{false};
+};
+
+void start_recording(debug_recorder::FlashRecorder &recorder) {
+    if (!recorder.start()) {
+        logging::warn("recorder: unavailable\n");
+        return;
+    }
+    // この行から記録に入る
+    logging::info("recorder: start session=%lu erased=%lu sectors\n", recorder.session(),
+                  recorder.erased_sectors());
+}
+
+void handle_command(debug_recorder::FlashRecorder &recorder, RecordingDumper &dumper) {
+    const int c = getchar_timeout_us(0);
+    switch (c) {
+    case 'r':
+    case 'R':
+        start_recording(recorder);
+        break;
+    case 's':
+    case 'S':
+        if (recorder.recording()) {
+            recorder.stop();
+            logging::info("recorder: stop session=%lu bytes=%lu\n", recorder.session(),
+                          recorder.bytes_written());
+        }
+        break;
+    case 'd':
+    case 'D':
+        dumper.begin(0);
+        break;
+    case 'p':
+    case 'P':
+        dumper.begin(1);
+        break;
+    default:
+        break;
     }
 }
 
@@ -135,26 +340,25 @@ void drain_ring(bool in_ready_state, StatusSummary &summary) {
     using debug_log::Port;
     using debug_log::Dir;
 
-    while (debug_log::g_ring_tail != debug_log::g_ring_head) {
-        const debug_log::LogEntry &e = debug_log::g_ring[debug_log::g_ring_tail];
-        debug_log::g_ring_tail = (debug_log::g_ring_tail + 1) % debug_log::kRingSize;
-
+    debug_log::LogEntry e{};
+    while (debug_log::g_ring.pop(e)) {
         // Ready状態のStatusコマンドデータログはサマリーに集計
-        if (in_ready_state && !e.is_state && !e.is_timeout && e.command_byte == 0x40) {
-            if (e.port == Port::Pad && e.dir == Dir::TX) {
+        if (in_ready_state && e.is_frame() && e.command_byte == 0x40) {
+            if (e.port() == Port::Pad && e.dir() == Dir::TX) {
                 summary.pad_tx_count++;
-            } else if (e.port == Port::Pad && e.dir == Dir::RX) {
+            } else if (e.port() == Port::Pad && e.dir() == Dir::RX) {
                 summary.pad_rx_count++;
-            } else if (e.port == Port::Console && e.dir == Dir::RX) {
+            } else if (e.port() == Port::Console && e.dir() == Dir::RX) {
                 summary.con_rx_count++;
-            } else if (e.port == Port::Console && e.dir == Dir::TX) {
+            } else if (e.port() == Port::Console && e.dir() == Dir::TX) {
                 summary.con_tx_count++;
             }
             continue;
         }
 
         // タイムアウトログもReady Statusならサマリーにカウントのみ
-        if (in_ready_state && e.is_timeout && e.command_byte == 0x40) {
+        if (in_ready_state && e.kind() == debug_log::Kind::Timeout &&
+            e.timeout_id() == debug_log::TimeoutId::Status) {
             summary.pad_timeout_count++;
             continue;
         }
@@ -167,6 +371,7 @@ void drain_ring(bool in_ready_state, StatusSummary &summary) {
 
 int main() {
     stdio_init_all();
+    logging::init(logging::Config{.framing = logging::Framing::Telemetry});
     bootsel_button_init();
     init_led();
 
@@ -198,6 +403,7 @@ int main() {
         .tx_start_offset = joybus_pad_offset_tx_start,
         .pio_hz = 4'000'000,
         .irq_base = 0,
+        .on_reply_started = &record_reply_gap,
     };
 
     gcinput::BridgeContext client_link{};
@@ -213,12 +419,45 @@ int main() {
     gcinput::PadClient pad_client(host_to_pad_config, client_link);
     gcinput::ConsoleClient console_client(device_to_console_config, client_link);
 
-    print_csv_header();
-    printf("M,0,Debug Probe firmware ready\n");
-    printf("M,0,host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
-           host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
-    printf("M,0,device_to_console: PIO%d SM%u pin GP%u\n", pio_get_index(device_to_console_config.pio),
-           device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    // スニファはリングを4KB境界に置くため静的に持つ
+    static std::optional<gcinput::JoybusSniffer> sniffer;
+    static std::optional<debug_sniffer::BusSniffer> bus_sniffer;
+    if (kEnableSniffer) {
+        sniffer.emplace(gcinput::JoybusSniffer::Config{
+            .pio = device_to_console_pio,
+            .state_machine = static_cast<uint>(pio_claim_unused_sm(device_to_console_pio, true)),
+            .pin = PIN_TO_REAL_CONSOLE,
+        });
+        bus_sniffer.emplace(*sniffer, telemetry::ProbePort::Console, kSnifferOutput);
+    }
+
+    telemetry::emit(telemetry::HelloRecord{.firmware = "debug_probe"});
+    logging::info("Debug Probe firmware ready\n");
+    logging::info("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
+                  host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
+    logging::info("device_to_console: PIO%d SM%u pin GP%u\n",
+                  pio_get_index(device_to_console_config.pio),
+                  device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    if (sniffer) {
+        logging::info("sniffer: PIO%d pin GP%u %lu Hz\n", pio_get_index(device_to_console_pio),
+                      PIN_TO_REAL_CONSOLE, sniffer->clock_hz());
+    }
+
+    // フラッシュへの記録（ステージングに8KB使うので静的に置く）
+    static debug_recorder::FlashRecorder recorder{};
+    recorder.init();
+    if (recorder.state() == debug_recorder::FlashRecorder::State::Unavailable) {
+        logging::warn("recorder: region overlaps firmware\n");
+    } else {
+        logging::info("recorder: flash 0x%08lx-0x%08lx last session=%lu\n",
+                      debug_recorder::kRegionOffset,
+                      debug_recorder::kRegionOffset + debug_recorder::kRegionSize,
+                      recorder.session());
+        if (kRecordOnBoot) {
+            start_recording(recorder);
+        }
+    }
+    RecordingDumper recording_dumper(recorder);
 
     // Statusポーリングサマリー
     StatusSummary status_summary{};
@@ -229,8 +468,20 @@ int main() {
     // ドロップカウント表示用
     uint32_t last_reported_drops = 0;
 
+    CaptureDumper capture_dumper(kCaptureTrigger);
+
+    // 通信タイミングの統計（約5.4KBなので静的に置く）
+    static debug_timing::Collector timing{};
+    uint32_t timing_start_us = time_us_32();
+
     while (true) {
         handle_boot_btn_if_requested();
+        handle_command(recorder, recording_dumper);
+        // フラッシュの操作で止まった分、時刻はこの後で取る
+        // 送り直している間は、読んでいるセッションを先の消去で消さないよう触らない
+        if (!recording_dumper.active()) {
+            recorder.service(time_us_32());
+        }
 
         const uint32_t now_us = time_us_32();
         auto console_state = client_link.shared_console().load();
@@ -246,6 +497,25 @@ int main() {
         }
         was_ready = ready_now;
 
+        // 通信タイミングの集計は区間の送出中も続ける
+        timing.drain();
+        if ((int32_t)(now_us - timing_start_us) >= (int32_t)kTimingIntervalUs) {
+            emit_timing(timing, now_us);
+            timing.reset();
+            timing_start_us = now_us;
+        }
+
+        // 記録や区間を送り終えるまではリングを取り出さない（落ちた分は下で警告）
+        if (recording_dumper.poll() || capture_dumper.poll()) {
+            logging::poll();
+            continue;
+        }
+
+        // スニファのエッジ（区間の送出中はリングが溢れても読まない。つながりは切れる）
+        if (bus_sniffer && (kRecordSniffer || !recorder.recording())) {
+            bus_sniffer->poll(now_us);
+        }
+
         // リングバッファドレイン
         drain_ring(in_ready_state, status_summary);
 
@@ -253,25 +523,34 @@ int main() {
         if (in_ready_state &&
             (int32_t)(now_us - status_summary.interval_start_us) >= (int32_t)kSummaryIntervalUs) {
             if (status_summary.pad_tx_count > 0 || status_summary.con_tx_count > 0) {
-                printf("U,%lu,P,%lu,%lu,%lu\n",
-                       (unsigned long)now_us, (unsigned long)status_summary.pad_tx_count,
-                       (unsigned long)status_summary.pad_rx_count,
-                       (unsigned long)status_summary.pad_timeout_count);
-                printf("U,%lu,C,%lu,%lu,0\n",
-                       (unsigned long)now_us, (unsigned long)status_summary.con_rx_count,
-                       (unsigned long)status_summary.con_tx_count);
+                telemetry::emit_at(
+                    telemetry::ProbeSummaryRecord{
+                        .port = telemetry::ProbePort::Pad,
+                        .polls = status_summary.pad_tx_count,
+                        .ok = status_summary.pad_rx_count,
+                        .timeout = status_summary.pad_timeout_count,
+                    },
+                    now_us);
+                telemetry::emit_at(
+                    telemetry::ProbeSummaryRecord{
+                        .port = telemetry::ProbePort::Console,
+                        .polls = status_summary.con_rx_count,
+                        .ok = status_summary.con_tx_count,
+                        .timeout = 0,
+                    },
+                    now_us);
             }
             status_summary.reset(now_us);
         }
 
         // ドロップ警告
-        if (debug_log::g_drop_count != last_reported_drops) {
-            printf("M,%lu,WARNING Ring buffer dropped %lu entries\n",
-                   (unsigned long)now_us,
-                   (unsigned long)(debug_log::g_drop_count - last_reported_drops));
-            last_reported_drops = debug_log::g_drop_count;
+        const uint32_t drops = debug_log::g_ring.dropped();
+        if (drops != last_reported_drops) {
+            logging::warn("WARNING Ring buffer dropped %lu entries\n", drops - last_reported_drops);
+            last_reported_drops = drops;
         }
 
+        logging::poll();
         tight_loop_contents();
     }
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include "joybus/protocol/reply.hpp"
 #include "link/shared/shared_pad.hpp"
+#include "pico/stdlib.h"
 #include "util/latest_slot.hpp"
+#include "util/spsc_ring.hpp"
+#include <algorithm>
+#include <array>
 
 namespace gcinput {
 struct TxRecord {
@@ -11,8 +15,21 @@ struct TxRecord {
     JoybusReply modified{};
 };
 
+// コンソールへ送った応答1件。LatestSlotと違い、ISRが送った応答をすべて順に残す
+struct TxStreamEntry {
+    uint32_t publish_count{0};
+    uint32_t timestamp_us{0};
+    joybus::Command command{joybus::Command::Invalid};
+    uint8_t length{0};
+    std::array<uint8_t, joybus::kMaxResponseSize> bytes{};
+};
+
 class SharedPadHub {
   public:
+    // コンソールはStatusを1フレーム（約16.7ms）に1回ほど要求するので、60Hzなら約2秒分
+    // 要求の間隔を1msまで詰めたときでも、mainループが100ms止まるまで取りこぼさない
+    static constexpr std::size_t kTxStreamCapacity = 128;
+
     // 受信したパッド応答を書き込む: Padクライアント向け
     void on_pad_response_isr(joybus::Command command, std::span<const uint8_t> rx) {
         rx_.on_response_isr(command, rx);
@@ -31,6 +48,16 @@ class SharedPadHub {
             .modified{modified},
         };
         tx_.publish(p);
+
+        // 全件ストリーム用。満杯なら捨て、publish_countの飛びとして読み出し側で検出する
+        TxStreamEntry entry{
+            .publish_count = p.publish_count,
+            .timestamp_us = time_us_32(),
+            .command = modified.command(),
+            .length = static_cast<uint8_t>(modified.view().size()),
+        };
+        std::copy(modified.view().begin(), modified.view().end(), entry.bytes.begin());
+        tx_stream_.push(entry);
     }
 
     // コンソールへ送信した変換済みパッド応答を読み取る: main, Consoleクライアント向け
@@ -46,9 +73,13 @@ class SharedPadHub {
         return false;
     }
 
+    // コンソールへ送った応答を古い順に1件取り出す: main向け
+    bool pop_tx_stream(TxStreamEntry &out) { return tx_stream_.pop(out); }
+
   private:
     SharedPad rx_;
     LatestSlot<TxRecord> tx_;
+    SpscRing<TxStreamEntry, kTxStreamCapacity> tx_stream_;
     uint32_t tx_publish_count_{0};
 };
 } // namespace gcinput
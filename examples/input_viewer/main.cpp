@@ -9,8 +9,13 @@
 #include "link/console_client.hpp"
 #include "link/pad_client.hpp"
 #include "link/shared/shared_pad_hub.hpp"
+#include "logging/log.hpp"
 #include "pico/bootrom.h"
 #include "pico/stdlib.h"
+#include "telemetry/emit.hpp"
+#include "telemetry/reply_stream.hpp"
+#include "usb/cdc_stream.hpp"
+#include <algorithm>
 #include <array>
 #include <span>
 #include <stdio.h>
@@ -27,7 +32,8 @@ constexpr uint PIN_TO_REAL_CONSOLE = 16;
 void boot_btn_irq(uint gpio, uint32_t events) {
     busy_wait_ms(100);
     if (gpio_get(BOOT_BTN_PIN) == 0) {
-        printf("BOOTSEL button pressed. Entering USB boot mode...\n");
+        // 割り込み内なのでキューを経由せずUARTへ直接書く
+        gcinput::logging::write_blocking("BOOTSEL button pressed. Entering USB boot mode...\r\n");
         reset_usb_boot(0, 0);
     }
 }
@@ -45,25 +51,73 @@ void init_led() {
     gpio_put(ONBOARD_LED_PIN, 1);
 }
 
-// CRC-8 ATM (poly=0x07, init=0x00) — 8バイト版
-static uint8_t crc8(const std::array<uint8_t, 8> &data) {
-    uint8_t crc = 0x00;
-    for (std::size_t i = 0; i < data.size(); ++i) {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x07;
-            } else {
-                crc <<= 1;
+// コンソールへ返した応答をUSB CDCへ全件流す
+// CDCの送信バッファが埋まったら残りはハブのリングに置いたままにする
+// リングがあふれて捨てた分はpublish_countの飛びになり、ReplyGapとして受信側へ伝わる
+class ReplyStreamer {
+  public:
+    // 1周で送る最大件数。パッドのポーリングを遅らせないよう区切る
+    static constexpr int kMaxPerPoll = 16;
+
+    void poll(gcinput::SharedPadHub &hub) {
+        const bool connected = gcinput::usb::connected();
+        if (connected && !streaming_) {
+            // つながり直したら受信側は前の状態を持っていないのでキーフレームから始める
+            encoder_.force_keyframe();
+        }
+        streaming_ = connected;
+
+        bool wrote = false;
+        for (int i = 0; i < kMaxPerPoll; ++i) {
+            if (!has_pending_) {
+                if (!hub.pop_tx_stream(pending_)) {
+                    break;
+                }
+                has_pending_ = true;
+            }
+            if (!streaming_) {
+                // ポートが閉じている間は読み捨てる。再開時にギャップとして出る
+                has_pending_ = false;
+                continue;
+            }
+            std::array<uint8_t, gcinput::telemetry::kMaxReplyStreamOutput> out{};
+            const gcinput::telemetry::ReplySample sample{
+                .publish_count = pending_.publish_count,
+                .timestamp_us = pending_.timestamp_us,
+                .command = static_cast<uint8_t>(pending_.command),
+                .bytes = std::span<const uint8_t>(pending_.bytes.data(), pending_.length),
+            };
+            // CDCの空きまでに収まらなければencodeは0を返し、状態も進めない
+            const std::size_t room = std::min(out.size(), gcinput::usb::write_available());
+            const std::size_t length = encoder_.encode(sample, std::span(out).first(room));
+            if (length == 0) {
+                break;
             }
+            gcinput::usb::write(std::span<const uint8_t>(out).first(length));
+            has_pending_ = false;
+            wrote = true;
+        }
+        if (wrote) {
+            gcinput::usb::flush();
         }
     }
-    return crc;
-}
+
+  private:
+    gcinput::telemetry::ReplyStreamEncoder encoder_{};
+    gcinput::TxStreamEntry pending_{};
+    bool has_pending_{false};
+    bool streaming_{false};
+};
+
 } // namespace
 
 int main() {
     stdio_init_all();
+    // 計測データはテレメトリフレームで送る（host/telemetryのgc_telemetry_decodeでCSVへ戻す）
+    gcinput::logging::init(
+        gcinput::logging::Config{.framing = gcinput::logging::Framing::Telemetry});
+    // 応答の全件ストリームはUSB CDCへ（UARTは間引いたInputSampleのまま）
+    gcinput::usb::init();
 
     bootsel_button_init();
     init_led();
@@ -110,16 +164,24 @@ int main() {
     gcinput::PadClient pad_client(host_to_pad_config, client_link);
     gcinput::ConsoleClient console_client(device_to_console_config, client_link);
 
-    printf("input_viewer ready.\n");
-    printf("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
-           host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
-    printf("device_to_console: PIO%d SM%u pin GP%u\n", pio_get_index(device_to_console_config.pio),
-           device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    namespace logging = gcinput::logging;
+    gcinput::telemetry::emit(gcinput::telemetry::HelloRecord{.firmware = "input_viewer"});
+    logging::info("input_viewer ready.\n");
+    logging::info("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
+                  host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
+    logging::info("device_to_console: PIO%d SM%u pin GP%u\n",
+                  pio_get_index(device_to_console_config.pio),
+                  device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
 
     bool is_pad_connected = false;
     uint32_t last_tx_publish_count = client_link.active_pad_hub().load_last_tx().publish_count;
+    ReplyStreamer reply_streamer{};
 
     while (true) {
+        // 前の周に積んだログと応答ストリームを送る（下のcontinueで飛ばされないようループ先頭で呼ぶ）
+        logging::poll();
+        gcinput::usb::poll();
+        reply_streamer.poll(client_link.active_pad_hub());
         pad_client.tick(time_us_32(), client_link.shared_console().load());
 
         gcinput::TxRecord last_tx = client_link.active_pad_hub().load_last_tx();
@@ -131,30 +193,18 @@ int main() {
                 if (status.size() < 8) {
                     continue;
                 }
-                // wireバイト: [0]=BH, [1]=BL, [2]=SX, [3]=SY, [4]=CX, [5]=CY, [6]=LT, [7]=RT
-                const uint8_t bh = status[0];
-                const uint8_t bl = status[1];
-                const uint8_t sx = status[2];
-                const uint8_t sy = status[3];
-                const uint8_t cx = status[4];
-                const uint8_t cy = status[5];
-                const uint8_t lt = status[6];
-                const uint8_t rt = status[7];
-
-                std::array<uint8_t, 8> crc_data{bh, bl, sx, sy, cx, cy, lt, rt};
-                const uint8_t cc = crc8(crc_data);
-
-                printf("I,%02X,%02X,%u,%u,%u,%u,%u,%u,%02X\n",
-                       bh, bl, sx, sy, cx, cy, lt, rt, cc);
+                gcinput::telemetry::InputSampleRecord record{};
+                std::copy_n(status.begin(), record.status.size(), record.status.begin());
+                gcinput::telemetry::emit(record);
             }
         }
 
         const bool ready = client_link.is_pad_ready();
         if (!is_pad_connected && ready) {
-            printf("PadClient: console responses enabled.\n");
+            logging::info("PadClient: console responses enabled.\n");
             is_pad_connected = true;
         } else if (is_pad_connected && !ready) {
-            printf("PadClient: console responses disabled.\n");
+            logging::info("PadClient: console responses disabled.\n");
             is_pad_connected = false;
         }
         tight_loop_contents();
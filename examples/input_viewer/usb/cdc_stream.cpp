@@ -0,0 +1,20 @@
+#include "usb/cdc_stream.hpp"
+#include "tusb.h"
+
+namespace gcinput::usb {
+
+void init() { tusb_init(); }
+
+void poll() { tud_task(); }
+
+bool connected() { return tud_cdc_connected(); }
+
+std::size_t write_available() { return tud_cdc_connected() ? tud_cdc_write_available() : 0; }
+
+void write(std::span<const uint8_t> data) {
+    tud_cdc_write(data.data(), static_cast<uint32_t>(data.size()));
+}
+
+void flush() { tud_cdc_write_flush(); }
+
+} // namespace gcinput::usb
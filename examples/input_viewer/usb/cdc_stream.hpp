@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// USB CDCの送信口（TinyUSBを直接使う）
+// 受信側のツールがポートを開いている（DTRが立っている）間だけ送る
+namespace gcinput::usb {
+
+void init();
+
+// TinyUSBのデバイス処理。mainループから毎周呼ぶ
+void poll();
+
+// ホストがポートを開いているか
+bool connected();
+
+// 送信バッファの空き。ポートが閉じていれば0
+std::size_t write_available();
+
+// write_available()以内のdataを送信バッファへ積む
+// フレームの途中で切れないよう、空きを確かめてからフレーム単位で呼ぶ
+void write(std::span<const uint8_t> data);
+
+// 溜まった分をすぐ送る
+void flush();
+
+} // namespace gcinput::usb
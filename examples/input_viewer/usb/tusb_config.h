@@ -0,0 +1,24 @@
+#pragma once
+
+// TinyUSBの設定（CDC 1ポートのみのデバイス）
+// pico_stdio_usbは使わず、全件ストリームの送信口としてCDCを直接使う
+// CFG_TUSB_MCUとCFG_TUSB_OSはPico SDKのtinyusb_deviceが定義する
+
+#ifndef CFG_TUSB_MCU
+#error CFG_TUSB_MCU must be defined
+#endif
+
+#define CFG_TUSB_RHPORT0_MODE (OPT_MODE_DEVICE)
+
+#define CFG_TUD_ENDPOINT0_SIZE 64
+
+#define CFG_TUD_CDC 1
+#define CFG_TUD_MSC 0
+#define CFG_TUD_HID 0
+#define CFG_TUD_MIDI 0
+#define CFG_TUD_VENDOR 0
+
+#define CFG_TUD_CDC_RX_BUFSIZE 64
+// Status応答のフレームは1件あたり12〜20バイト程度。100件分ほど溜められる大きさにする
+#define CFG_TUD_CDC_TX_BUFSIZE 2048
+#define CFG_TUD_CDC_EP_BUFSIZE 64
@@ -0,0 +1,104 @@
+#include "pico/unique_id.h"
+#include "tusb.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// CDC 1ポートだけのUSBデバイス記述子
+// コールバックはTinyUSBから呼ばれるのでCリンケージにする
+namespace {
+
+// Raspberry PiのVIDと、Pico SDKのstdio_usbと同じPID（同じドライバで認識させる）
+constexpr uint16_t kUsbVid = 0x2E8A;
+constexpr uint16_t kUsbPid = 0x000A;
+
+enum : uint8_t {
+    ITF_NUM_CDC = 0,
+    ITF_NUM_CDC_DATA,
+    ITF_NUM_TOTAL,
+};
+
+constexpr uint8_t EPNUM_CDC_NOTIF = 0x81;
+constexpr uint8_t EPNUM_CDC_OUT = 0x02;
+constexpr uint8_t EPNUM_CDC_IN = 0x82;
+
+enum : uint8_t {
+    STRID_LANGID = 0,
+    STRID_MANUFACTURER,
+    STRID_PRODUCT,
+    STRID_SERIAL,
+    STRID_CDC,
+};
+
+const tusb_desc_device_t kDeviceDescriptor = {
+    .bLength = sizeof(tusb_desc_device_t),
+    .bDescriptorType = TUSB_DESC_DEVICE,
+    .bcdUSB = 0x0200,
+    // CDCはIADでまとめるのでMiscellaneous/Common Class
+    .bDeviceClass = TUSB_CLASS_MISC,
+    .bDeviceSubClass = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0 = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor = kUsbVid,
+    .idProduct = kUsbPid,
+    .bcdDevice = 0x0100,
+    .iManufacturer = STRID_MANUFACTURER,
+    .iProduct = STRID_PRODUCT,
+    .iSerialNumber = STRID_SERIAL,
+    .bNumConfigurations = 1,
+};
+
+constexpr uint16_t kConfigTotalLength = TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN;
+
+const uint8_t kConfigurationDescriptor[] = {
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, kConfigTotalLength, 0x00, 100),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC, STRID_CDC, EPNUM_CDC_NOTIF, 8, EPNUM_CDC_OUT, EPNUM_CDC_IN,
+                       64),
+};
+
+const char *const kStrings[] = {
+    nullptr, // STRID_LANGID（下で別扱い）
+    "LitMc",
+    "pico-gc-bridge input_viewer",
+    nullptr, // STRID_SERIAL（ボード固有IDから作る）
+    "input_viewer reply stream",
+};
+
+// 文字列記述子の作業領域（先頭2バイトは長さと種類）
+std::array<uint16_t, 1 + 32> g_string_descriptor{};
+
+} // namespace
+
+extern "C" const uint8_t *tud_descriptor_device_cb() {
+    return reinterpret_cast<const uint8_t *>(&kDeviceDescriptor);
+}
+
+extern "C" const uint8_t *tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return kConfigurationDescriptor;
+}
+
+extern "C" const uint16_t *tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+    std::size_t length = 0;
+    if (index == STRID_LANGID) {
+        g_string_descriptor[1] = 0x0409; // English (United States)
+        length = 1;
+    } else if (index < std::size(kStrings)) {
+        char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1]{};
+        const char *text = kStrings[index];
+        if (index == STRID_SERIAL) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            text = serial;
+        }
+        // ASCIIをそのままUTF-16LEへ広げる
+        for (; text[length] != '\0' && length + 1 < g_string_descriptor.size(); ++length) {
+            g_string_descriptor[1 + length] = static_cast<uint8_t>(text[length]);
+        }
+    } else {
+        return nullptr;
+    }
+    g_string_descriptor[0] =
+        static_cast<uint16_t>((TUSB_DESC_STRING << 8) | (2 * length + 2));
+    return g_string_descriptor.data();
+}
@@ -116,5 +116,7 @@ struct PipelineSet {
     Pipeline recalibrate{};
     Pipeline id{};
     Pipeline reset{};
+    // 計測中のStatusに掛ける（statusは掛けない）。補正の検証用で、ふだんは空のまま素通し
+    Pipeline measure{};
 };
 } // namespace gcinput::domain::transform
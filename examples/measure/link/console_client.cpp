@@ -2,6 +2,7 @@
 #include "domain/transform/pipeline.hpp"
 #include "joybus/codec/identity_wire.hpp"
 #include "joybus/codec/state_wire.hpp"
+#include "pico/stdlib.h"
 
 namespace gcinput {
 
@@ -22,7 +23,8 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
     }
 
     auto *self = static_cast<ConsoleClient *>(user);
-    self->link_.shared_console().on_request_isr(std::span<const uint8_t>(rx, rx_len));
+    self->link_.shared_console().on_request_isr(std::span<const uint8_t>(rx, rx_len),
+                                                time_us_32());
 
     if (!self->link_.is_pad_ready()) {
         return 0;
@@ -50,8 +52,10 @@ std::size_t ConsoleClient::callback(void *user, const uint8_t *rx, std::size_t r
         domain::PadState modified_state = original_state;
         // 計測用
         if (!self->link_.is_measure_enabled()) {
-            // 計測時は厳密な値を送るため素通しする
             pipelines.status.apply_from_isr(modified_state);
+        } else {
+            // 計測時は厳密な値を送るため素通しする（補正の検証ではbridgeと同じ補正を掛ける）
+            pipelines.measure.apply_from_isr(modified_state);
         }
         modified_reply = joybus::state_wire::encode_status(modified_state, host_poll_mode);
         break;
@@ -1,10 +1,21 @@
 #pragma once
 #include "joybus/protocol/protocol.hpp"
+#include "util/frame_cadence.hpp"
 #include "util/latest_slot.hpp"
 #include <span>
 
 namespace gcinput {
 
+// コンソールのStatus要求から数えたフレーム
+// 1フレームに何回か要求するゲームもあるので、間がsame_frame_usより短い要求は同じフレームとみなす
+// same_frame_usは要求の間隔から見積もる（util/frame_cadence.hpp）
+struct ConsoleFrameClock {
+    uint32_t frames = 0;        // 数えたフレーム数（最初の要求で1）
+    uint32_t polls = 0;         // 受けたStatus要求の数（framesと比べて1フレームあたりの回数を出す）
+    uint32_t last_poll_us = 0;  // 最後のStatus要求を受けた時刻
+    uint32_t same_frame_us = 0; // 今の見積もりで同じフレームとみなす間隔
+};
+
 struct ConsoleState {
     joybus::PollMode poll_mode = joybus::PollMode::Default;
     joybus::RumbleMode rumble_mode = joybus::RumbleMode::Off;
@@ -13,12 +24,25 @@ struct ConsoleState {
 
 class SharedConsole {
   public:
+    // Status要求を受けるたびに割り込みから呼ぶ関数（数えた後のフレームを渡す）
+    using StatusPollHook = void (*)(void *user, const ConsoleFrameClock &clock);
+
     ConsoleState load() const { return db_.load(); }
+    ConsoleFrameClock load_frame_clock() const { return frame_clock_.load(); }
+
+    // 要求を受け始める前（ConsoleClientを作る前）に1回だけ設定する
+    void set_status_poll_hook(StatusPollHook hook, void *user) {
+        poll_hook_user_ = user;
+        poll_hook_ = hook;
+    }
 
-    void on_request_isr(std::span<const uint8_t> rx) {
+    void on_request_isr(std::span<const uint8_t> rx, uint32_t now_us) {
         if (rx.empty()) {
             return;
         }
+        if (static_cast<joybus::Command>(rx[0]) == joybus::Command::Status) {
+            count_frame_isr(now_us);
+        }
 
         bool updated = false;
         joybus::Command command = static_cast<joybus::Command>(rx[0]);
@@ -51,8 +75,26 @@ class SharedConsole {
     }
 
   private:
+    void count_frame_isr(uint32_t now_us) {
+        if (cadence_.on_poll(now_us)) {
+            frame_shadow_.frames++;
+        }
+        frame_shadow_.polls++;
+        frame_shadow_.last_poll_us = now_us;
+        frame_shadow_.same_frame_us = cadence_.same_frame_us();
+        frame_clock_.publish(frame_shadow_);
+        if (poll_hook_ != nullptr) {
+            poll_hook_(poll_hook_user_, frame_shadow_);
+        }
+    }
+
     ConsoleState shadow_{};
     LatestSlot<ConsoleState> db_{};
+    FrameCadence cadence_{};
+    ConsoleFrameClock frame_shadow_{};
+    LatestSlot<ConsoleFrameClock> frame_clock_{};
+    StatusPollHook poll_hook_{nullptr};
+    void *poll_hook_user_{nullptr};
 };
 
 } // namespace gcinput
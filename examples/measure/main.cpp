@@ -1,5 +1,7 @@
+#include "calibration/profile_store.hpp"
 #include "domain/state.hpp"
 #include "domain/transform/builtins.hpp"
+#include "domain/transform/correction.hpp"
 #include "domain/transform/pipeline.hpp"
 #include "hardware/pio.h"
 #include "hardware/sync.h"
@@ -9,11 +11,20 @@
 #include "link/console_client.hpp"
 #include "link/pad_client.hpp"
 #include "link/shared/shared_pad_hub.hpp"
+#include "logging/log.hpp"
+#include "measure/adaptive_plan.hpp"
+#include "measure/checkpoint_store.hpp"
+#include "measure/host_command_receiver.hpp"
+#include "measure/host_values.hpp"
 #include "measure/pad_injector.hpp"
+#include "measure/patterns/adaptive_stick_sweep.hpp"
 #include "measure/patterns/stick_grid_sweep.hpp"
+#include "measure/plan_receiver.hpp"
 #include "pico/bootrom.h"
 #include "pico/stdlib.h"
+#include "telemetry/emit.hpp"
 #include <array>
+#include <optional>
 #include <span>
 #include <stdio.h>
 
@@ -30,7 +41,8 @@ void boot_btn_irq(uint gpio, uint32_t events) {
     // ちょいデバウンス（押しっぱなし連打対策）
     busy_wait_ms(100);
     if (gpio_get(BOOT_BTN_PIN) == 0) {
-        printf("BOOTSEL button pressed. Entering USB boot mode...\n");
+        // 割り込み内なのでキューを経由せずUARTへ直接書く
+        gcinput::logging::write_blocking("BOOTSEL button pressed. Entering USB boot mode...\r\n");
         reset_usb_boot(0, 0);
     }
 }
@@ -48,20 +60,6 @@ void init_led() {
     gpio_put(ONBOARD_LED_PIN, 1);
 }
 
-static uint8_t crc8(const std::array<uint8_t, 4> &data) {
-    uint8_t crc = 0x00;
-    for (std::size_t i = 0; i < data.size(); ++i) {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x07;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
-}
 struct WireByteOffsets {
     uint8_t first;
     uint8_t second;
@@ -90,10 +88,203 @@ constexpr auto kMeasureTarget = gcinput::measure::StickGridSweep::Target::Joysti
 // LRトリガー 2D 全走査:        target=Trigger,  x=[0,255], y=[0,255]  (65536点)
 
 constexpr auto kWireOffsets = wire_offsets_for_target(kMeasureTarget);
+
+// 走査の順序
+// true:  粗い格子（16刻み、289点）の後、ホストから受け取った優先リストのマスだけを細かく測る
+//        リストがなければ格子の後に残りの全点を測る
+// false: 全点を順に測る
+constexpr bool kAdaptiveSweep = true;
+
+// 補正の検証
+// true: bridgeと同じ補正パイプラインP(s)を計測中の応答に掛け、注入した生の値sと一緒にQ行へ出す
+//       ゲーム側の表示S(P(s))を目標φ(C(s))と比べる（tools/verify_correction.py）
+//       走査は4刻みの全面（4096点）で、kAdaptiveSweepは使わない
+constexpr bool kVerifyCorrection = false;
+static_assert(!kVerifyCorrection ||
+                  kMeasureTarget == gcinput::measure::StickGridSweep::Target::Joystick,
+              "補正は主スティックだけに掛かる");
+// 補正の検証で引くプロファイル
+// 0: 組み込み。bridgeと同じ kBuiltinCorrection（折り畳んだ表かスプライン）をSRAMへ写して引く
+// 1..4: bridgeが書き込んだフラッシュのスロット。逆変換テーブルのものだけ引ける
+//       （順方向の写像は表を組み立てるRAMがないので、組み込みに戻す）
+constexpr std::size_t kVerifyProfile = gcinput::calibration::ProfileStore::kBuiltinProfile;
+
+// 補正の検証で引く表。bridgeと同じ ProfileStore から取る
+const gcinput::domain::transform::correction::InverseLutTable *verify_table() {
+    using gcinput::calibration::ProfileStore;
+    static ProfileStore store{};
+    store.init(gcinput::calibration::kBuiltinCorrection);
+    if (const auto *table = store.table(kVerifyProfile); table != nullptr) {
+        return table;
+    }
+    gcinput::logging::warn("Profile %u is not an inverse table, using builtin.\n",
+                           static_cast<unsigned>(kVerifyProfile));
+    return store.table(ProfileStore::kBuiltinProfile);
+}
+
+// 細分の優先リスト（tools/plan_adaptive_sweep.pyがシリアルへ送る）
+gcinput::measure::AdaptivePlan g_plan{};
+
+auto make_pattern() {
+    if constexpr (kVerifyCorrection) {
+        return gcinput::measure::StickGridSweep{gcinput::measure::StickGridSweep::Config{
+            .x = {.begin = 0, .end = 255, .step = 4},
+            .y = {.begin = 0, .end = 255, .step = 4},
+            .loop = true,
+            .target = kMeasureTarget,
+            .order = gcinput::measure::TraversalOrder::Hilbert,
+        }};
+    } else if constexpr (kAdaptiveSweep) {
+        return gcinput::measure::AdaptiveStickSweep{gcinput::measure::AdaptiveStickSweep::Config{
+            .coarse_step = 16,
+            .loop = true,
+            .target = kMeasureTarget,
+            .plan = &g_plan,
+        }};
+    } else {
+        return gcinput::measure::StickGridSweep{gcinput::measure::StickGridSweep::Config{
+            .x = {.begin = 0, .end = 255, .step = 1},
+            .y = {.begin = 0, .end = 255, .step = 1},
+            .loop = true,
+            .target = kMeasureTarget,
+            .order = gcinput::measure::TraversalOrder::Hilbert,
+        }};
+    }
+}
+
+// 各点を見せるフレーム数を前の点からの飛びで決める（隣なら3フレーム、端から端なら10フレーム）
+// std::nulloptにすると全点を下のscheduleのフレーム数（10フレーム）で送る
+constexpr std::optional<gcinput::measure::SettlingModel> kSettling =
+    gcinput::measure::SettlingModel{
+        .min_frames = 3,
+        .max_frames = 10,
+        .distance_per_frame = 32,
+    };
+
+// 点の差し替えをアラームの割り込みで行う（mainループの周期の揺れが見え始めるフレームに出ない）
+// falseにするとmainループのtickで差し替える
+constexpr bool kAlarmInjection = true;
+
+// 走査位置をフラッシュへ保存する間隔（中断しても測り直すのはこの時間の分まで）
+constexpr uint32_t kCheckpointIntervalUs = 60'000'000;
+
+void emit_run(gcinput::telemetry::MeasureRunEvent event, const gcinput::measure::Checkpoint &run) {
+    gcinput::telemetry::emit(gcinput::telemetry::MeasureRunRecord{
+        .event = event,
+        .run_id = run.run_id,
+        .position = run.position,
+        .frame = run.frame,
+    });
+}
+
+// コンソールのフレームの数え方を、1フレームあたりのStatus要求の回数が変わったときにログへ出す
+// 要求が詰まったゲームや120Hzのゲームで、D行のフレームが数え違っていないかを確かめる
+class CadenceReporter {
+  public:
+    void poll(const gcinput::ConsoleFrameClock &clock) {
+        const uint32_t frames = clock.frames - start_.frames;
+        if (frames < kWindowFrames) {
+            return;
+        }
+        // 0.1回単位。変わったかは整数に丸めて比べる（遅れた要求で小数点以下は揺れる）
+        const uint32_t tenths = ((clock.polls - start_.polls) * 10 + frames / 2) / frames;
+        const uint32_t per_frame = (tenths + 5) / 10;
+        if (per_frame != last_per_frame_) {
+            gcinput::logging::info("Console: %lu.%lu polls/frame, frame ~%lu us\n", tenths / 10,
+                                   tenths % 10, clock.same_frame_us * 2);
+            last_per_frame_ = per_frame;
+        }
+        start_ = clock;
+    }
+
+  private:
+    static constexpr uint32_t kWindowFrames = 60;
+    gcinput::ConsoleFrameClock start_{};
+    uint32_t last_per_frame_{0};
+};
+
+// ホストが指示した値（tools/measure_client.pyがシリアルへ送る）
+gcinput::measure::HostValueQueue g_host_values{};
+
+void emit_ack(gcinput::telemetry::MeasureAckStatus status, uint32_t seq,
+              uint32_t console_frame = 0, std::size_t queued = g_host_values.size()) {
+    gcinput::telemetry::emit(gcinput::telemetry::MeasureAckRecord{
+        .status = status,
+        .seq = seq,
+        .console_frame = console_frame,
+        .queued = static_cast<uint8_t>(queued),
+    });
+}
+
+// ホストの値の指示の結果を返す。計測が止まっていれば、ホストの値を送るために計測を有効にする
+// host_enabledはホストが有効にした計測か（Xで戻ったときに止める）
+void handle_host_command(const gcinput::measure::HostCommandReceiver::Result &result,
+                         gcinput::BridgeContext &link, bool &host_enabled) {
+    using Event = gcinput::measure::HostCommandReceiver::Event;
+    using Status = gcinput::telemetry::MeasureAckStatus;
+    switch (result.event) {
+    case Event::None:
+        return;
+    case Event::Queued:
+        emit_ack(Status::Queued, result.seq);
+        if (!link.is_measure_enabled()) {
+            link.enable_measure_from_main();
+            host_enabled = true;
+            gcinput::logging::info("HostValues: measurement enabled by host.\n");
+        }
+        return;
+    case Event::Full:
+        emit_ack(Status::Full, result.seq);
+        return;
+    case Event::Rejected:
+        emit_ack(Status::Rejected, 0);
+        return;
+    case Event::Released:
+        emit_ack(Status::Released, 0, 0, result.dropped);
+        if (host_enabled && link.is_measure_enabled()) {
+            link.disable_measure_from_main();
+        }
+        host_enabled = false;
+        return;
+    }
+}
+
+// シリアルから届いた分だけ行を読む（優先リストとホストの値の指示が同じ行の流れに混ざる）
+void poll_serial_lines(gcinput::measure::PlanReceiver &plan_receiver,
+                       gcinput::measure::HostCommandReceiver &command_receiver,
+                       gcinput::BridgeContext &link, bool &host_enabled) {
+    using Event = gcinput::measure::PlanReceiver::Event;
+    // 1周で読む文字数は抑える（残りは受信FIFOに残る）
+    for (int i = 0; i < 32; ++i) {
+        const int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) {
+            return;
+        }
+        handle_host_command(command_receiver.feed(static_cast<char>(c)), link, host_enabled);
+        switch (plan_receiver.feed(static_cast<char>(c))) {
+        case Event::Begun:
+            gcinput::logging::info("AdaptivePlan: receiving.\n");
+            break;
+        case Event::Committed:
+            gcinput::logging::info("AdaptivePlan: %u cells loaded.\n",
+                                   static_cast<unsigned>(g_plan.cells().size()));
+            break;
+        case Event::Rejected:
+            gcinput::logging::warn("AdaptivePlan: rejected after %u cells.\n",
+                                   static_cast<unsigned>(plan_receiver.received()));
+            break;
+        case Event::None:
+            break;
+        }
+    }
+}
 } // namespace
 
 int main() {
     stdio_init_all();
+    // 計測データはテレメトリフレームで送る（host/telemetryのgc_telemetry_decodeでCSVへ戻す）
+    gcinput::logging::init(
+        gcinput::logging::Config{.framing = gcinput::logging::Framing::Telemetry});
 
     // ボタンを押すだけでBOOTSELに入るようにする
     bootsel_button_init();
@@ -140,31 +331,63 @@ int main() {
     pipelines.recalibrate.add_stage(gcinput::domain::transform::make_stage(&fix_origin_to_neutral));
     pipelines.status.add_stage(gcinput::domain::transform::make_stage(&fix_origin_to_neutral));
 
+    // 補正の検証: bridgeの補正フェーズと同じステージを同じ順に並べる
+    // 注入するOriginはニュートラルなので、原点正規化は何もしない（bridgeと段数を揃えるために置く）
+    gcinput::domain::transform::correction::OriginOffsetContext origin_ctx{};
+    gcinput::domain::transform::correction::InverseLutContext inverse_ctx{};
+    if constexpr (kVerifyCorrection) {
+        using namespace gcinput::domain::transform::correction;
+        inverse_ctx.table.store(verify_table(), std::memory_order_release);
+        pipelines.measure.add_stage(
+            gcinput::domain::transform::make_stage<OriginOffsetContext, origin_normalize>(
+                origin_ctx));
+        pipelines.measure.add_stage(gcinput::domain::transform::make_stage(&octagon_clamp));
+        pipelines.measure.add_stage(gcinput::domain::transform::make_stage(&linear_scale));
+        pipelines.measure.add_stage(
+            gcinput::domain::transform::make_stage<InverseLutContext, inverse_lut>(inverse_ctx));
+    }
+
     gcinput::PadClient pad_client(host_to_pad_config, client_link);
 
     // 計測
-    const uint32_t interval_1f = 16'667; // 約60Hz
-    gcinput::measure::Schedule schedule{gcinput::measure::ScheduleConfig{
-        .interval_us = interval_1f * 10,
-        .catch_up = false,
-    }};
-
-    gcinput::measure::StickGridSweep pattern{gcinput::measure::StickGridSweep::Config{
-        .x = {.begin = 0, .end = 255, .step = 1},
-        .y = {.begin = 0, .end = 255, .step = 1},
-        .loop = true,
-        .target = kMeasureTarget,
-    }};
+    // パターンはコンソールのStatus要求から数えたフレームで切り替える
+    const gcinput::measure::FrameScheduleConfig frame_schedule{.frames = 10};
+    gcinput::measure::FrameLockedSchedule schedule{client_link.shared_console(), frame_schedule};
+    gcinput::measure::InjectionTimer injection_timer{client_link.measure_pad_hub(),
+                                                     frame_schedule};
+
+    gcinput::measure::PadInjector pad_injector(client_link, schedule, make_pattern(), kSettling);
+    gcinput::measure::PlanReceiver plan_receiver(g_plan);
+    gcinput::measure::HostCommandReceiver command_receiver(g_host_values);
+    pad_injector.attach_host_values(g_host_values);
+    if (kAlarmInjection) {
+        // コンソールの要求を受け始める前につなぐ
+        injection_timer.start(client_link.shared_console());
+        pad_injector.attach_timer(injection_timer);
+    }
+    bool host_enabled = false;
 
-    gcinput::measure::PadInjector pad_injector(client_link, schedule, pattern);
+    // 前回までの走査位置。Zで続きから、Z+Rで新しい計測として最初から
+    gcinput::measure::CheckpointStore checkpoints{};
+    checkpoints.init();
+    std::optional<gcinput::measure::Checkpoint> run = checkpoints.latest();
 
     gcinput::ConsoleClient console_client(device_to_console_config, client_link);
 
-    printf("JoybusPioPort ready.\n");
-    printf("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
-           host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
-    printf("device_to_console: PIO%d SM%u pin GP%u\n", pio_get_index(device_to_console_config.pio),
-           device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    namespace logging = gcinput::logging;
+    gcinput::telemetry::emit(gcinput::telemetry::HelloRecord{.firmware = "measure"});
+    logging::info("JoybusPioPort ready.\n");
+    logging::info("host_to_pad: PIO%d SM%u pin GP%u\n", pio_get_index(host_to_pad_config.pio),
+                  host_to_pad_config.state_machine, PIN_TO_REAL_PAD);
+    logging::info("device_to_console: PIO%d SM%u pin GP%u\n",
+                  pio_get_index(device_to_console_config.pio),
+                  device_to_console_config.state_machine, PIN_TO_REAL_CONSOLE);
+    if (!checkpoints.available()) {
+        logging::warn("Checkpoint: region overlaps the firmware. Runs cannot be resumed.\n");
+    } else if (run) {
+        logging::info("Checkpoint: run %lu position %lu frame %lu (Z resumes, Z+R starts over).\n",
+                      run->run_id, run->position, run->frame);
+    }
 
     bool is_pad_connected = false;
 
@@ -174,10 +397,21 @@ int main() {
 
     uint32_t frame_count = 0;
     std::pair<uint8_t, uint8_t> last_analog{128, 128};
+    uint32_t last_checkpoint_us = 0;
+    CadenceReporter cadence_reporter{};
 
     while (true) {
+        // 前の周に積んだログを送信する（下のcontinueで飛ばされないようループ先頭で呼ぶ）
+        logging::poll();
         pad_client.tick(time_us_32(), client_link.shared_console().load());
         pad_injector.tick(time_us_32());
+        if (const auto live = pad_injector.consume_host_live()) {
+            emit_ack(gcinput::telemetry::MeasureAckStatus::Live, live->seq, live->console_frame);
+        }
+        poll_serial_lines(plan_receiver, command_receiver, client_link, host_enabled);
+        const auto frame_clock = client_link.shared_console().load_frame_clock();
+        checkpoints.service(time_us_32(), frame_clock);
+        cadence_reporter.poll(frame_clock);
 
         const auto real_pad_snapshot = client_link.real_pad_hub().load_original_snapshot();
         if (real_pad_snapshot.last_rx_command == gcinput::joybus::Command::Status) {
@@ -187,17 +421,46 @@ int main() {
                 real_pad_snapshot.status.input.pressed(gcinput::domain::PadButton::DpadUp);
 
             if (measure_enable && !client_link.is_measure_enabled()) {
-                frame_count = 0;
+                using gcinput::telemetry::MeasureRunEvent;
+                const bool start_over =
+                    real_pad_snapshot.status.input.pressed(gcinput::domain::PadButton::R);
+                const bool same_pattern = run && run->fingerprint == pad_injector.fingerprint();
+                if (!start_over && same_pattern && pad_injector.resume(run->position)) {
+                    emit_run(MeasureRunEvent::Resume, *run);
+                } else {
+                    if (!start_over && run) {
+                        logging::warn("Checkpoint: run %lu is for another pattern.\n",
+                                      run->run_id);
+                    }
+                    pad_injector.restart();
+                    run = gcinput::measure::Checkpoint{
+                        .run_id = run ? run->run_id + 1 : 1,
+                        .position = pad_injector.position(),
+                        .frame = 0,
+                        .fingerprint = pad_injector.fingerprint(),
+                    };
+                    checkpoints.save(*run);
+                    emit_run(MeasureRunEvent::Start, *run);
+                }
+                // 再開した点のD行は中断前と同じフレーム番号から続く
+                frame_count = run->frame;
+                last_analog = {128, 128};
+                last_checkpoint_us = time_us_32();
                 client_link.enable_measure_from_main();
             } else if (measure_disable && client_link.is_measure_enabled()) {
                 client_link.disable_measure_from_main();
+                host_enabled = false;
+                if (run) {
+                    checkpoints.save(*run);
+                    emit_run(gcinput::telemetry::MeasureRunEvent::Checkpoint, *run);
+                }
             }
         }
 
         if (client_link.consume_measure_epoch(last_measure_epoch)) {
             last_tx_publish_count = client_link.active_pad_hub().load_last_tx().publish_count;
-            printf("PadInjector: sending fixed patterns %s.\n",
-                   client_link.is_measure_enabled() ? "enabled" : "disabled");
+            logging::info("PadInjector: sending fixed patterns %s.\n",
+                          client_link.is_measure_enabled() ? "enabled" : "disabled");
         }
 
         gcinput::TxRecord last_tx = client_link.active_pad_hub().load_last_tx();
@@ -207,36 +470,59 @@ int main() {
             const auto modified = last_tx.modified;
             const auto command = raw.command();
             if (command == gcinput::joybus::Command::Status && client_link.is_measure_enabled()) {
+                const auto injected = raw.view();
                 const auto status = modified.view();
-                if (status.size() < 8) {
+                if (injected.size() < 8 || status.size() < 8) {
                     continue;
                 }
-                std::pair<uint8_t, uint8_t> current_analog{
-                    status[kWireOffsets.first],
-                    status[kWireOffsets.second],
+                // 点の切り替わりは注入した値で見る（補正を掛けると隣の点が同じ値になることがある）
+                const std::pair<uint8_t, uint8_t> injected_analog{
+                    injected[kWireOffsets.first],
+                    injected[kWireOffsets.second],
                 };
-                if (current_analog != last_analog) {
-                    last_analog = current_analog;
-                    std::array<uint8_t, 4> crc_data{
-                        static_cast<uint8_t>((frame_count >> 8) & 0xFF),
-                        static_cast<uint8_t>(frame_count & 0xFF),
-                        current_analog.first,
-                        current_analog.second,
+                if (injected_analog != last_analog) {
+                    last_analog = injected_analog;
+                    const std::pair<uint8_t, uint8_t> current_analog{
+                        status[kWireOffsets.first],
+                        status[kWireOffsets.second],
                     };
-                    const uint8_t crc = crc8(crc_data);
-                    printf("D,%u,%u,%u,%02X\n", frame_count, current_analog.first,
-                           current_analog.second, crc);
-                    frame_count = (frame_count + 1) % 65536;
+                    gcinput::telemetry::emit(gcinput::telemetry::MeasureSampleRecord{
+                        .frame = static_cast<uint16_t>(frame_count),
+                        .first = current_analog.first,
+                        .second = current_analog.second,
+                    });
+                    if constexpr (kVerifyCorrection) {
+                        gcinput::telemetry::emit(gcinput::telemetry::MeasureCorrectionRecord{
+                            .frame = static_cast<uint16_t>(frame_count),
+                            .raw_x = injected_analog.first,
+                            .raw_y = injected_analog.second,
+                            .out_x = current_analog.first,
+                            .out_y = current_analog.second,
+                        });
+                    }
+                    // ホストの値はパターンの走査位置に関係しない
+                    if (run && !g_host_values.active()) {
+                        // ここから再開すれば、今の点をこのフレーム番号で測り直す
+                        run->position = pad_injector.position();
+                        run->frame = frame_count;
+                        const uint32_t now_us = time_us_32();
+                        if (now_us - last_checkpoint_us >= kCheckpointIntervalUs) {
+                            last_checkpoint_us = now_us;
+                            checkpoints.save(*run);
+                            emit_run(gcinput::telemetry::MeasureRunEvent::Checkpoint, *run);
+                        }
+                    }
+                    frame_count++;
                 }
             }
         }
 
         const bool ready = client_link.is_pad_ready();
         if (!is_pad_connected && ready) {
-            printf("PadClient: console responses enabled.\n");
+            logging::info("PadClient: console responses enabled.\n");
             is_pad_connected = true;
         } else if (is_pad_connected && !ready) {
-            printf("PadClient: console responses disabled.\n");
+            logging::info("PadClient: console responses disabled.\n");
             is_pad_connected = false;
         }
         tight_loop_contents();
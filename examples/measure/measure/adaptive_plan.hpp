@@ -0,0 +1,95 @@
+#pragma once
+#include "measure/pattern.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gcinput::measure {
+
+// 細分して測る1マス。[x0, x0+size) × [y0, y0+size) をstep刻みで測る
+struct RefineCell {
+    uint8_t x0{0};
+    uint8_t y0{0};
+    uint16_t size{0}; // 2..256の2の冪
+    uint8_t step{1};  // size以下の2の冪
+};
+
+inline bool is_power_of_two(uint32_t v) { return v != 0 && (v & (v - 1)) == 0; }
+
+inline bool is_valid_cell(const RefineCell &cell) {
+    return is_power_of_two(cell.size) && cell.size >= 2 && cell.size <= 256 &&
+           is_power_of_two(cell.step) && cell.step <= cell.size &&
+           static_cast<uint32_t>(cell.x0) + cell.size <= 256 &&
+           static_cast<uint32_t>(cell.y0) + cell.size <= 256;
+}
+
+// ホスト（tools/plan_adaptive_sweep.py）から受け取った細分の優先リスト。先頭ほど優先
+// 書き換えと読み出しはどちらもmainループから
+//
+// 受け取りは使っていない側のバッファへ書き、commitできたときだけ入れ替える
+// 受け取りの途中や、数が合わず捨てたときも、前の計画（とgeneration）はそのまま使われる
+// （6バイト x 1024マス x 2 = 12KB）
+class AdaptivePlan {
+  public:
+    static constexpr std::size_t kMaxCells = 1024;
+
+    // 受け取りを始める。今の計画はcommitするまで変わらない
+    void begin() {
+        staged_count_ = 0;
+        receiving_ = true;
+    }
+
+    bool add(const RefineCell &cell) {
+        if (!receiving_ || staged_count_ >= kMaxCells || !is_valid_cell(cell)) {
+            return false;
+        }
+        buffers_[active_ ^ 1][staged_count_++] = cell;
+        return true;
+    }
+
+    // 受け取った数がexpectedと合えば、受け取った計画に入れ替える。合わなければ捨てる
+    bool commit(std::size_t expected) {
+        const bool ok = receiving_ && expected == staged_count_;
+        receiving_ = false;
+        if (!ok) {
+            return false;
+        }
+        active_ ^= 1;
+        count_ = staged_count_;
+        committed_ = true;
+        generation_++;
+        digest_ = kFingerprintSeed;
+        for (const RefineCell &c : cells()) {
+            digest_ = fingerprint_mix(digest_, c.x0 | (c.y0 << 8) | (c.step << 16));
+            digest_ = fingerprint_mix(digest_, c.size);
+        }
+        return true;
+    }
+
+    // 受け取りをやめる（受け取った分は捨てる）
+    void abort() { receiving_ = false; }
+
+    std::span<const RefineCell> cells() const {
+        return committed_ ? std::span<const RefineCell>(buffers_[active_].data(), count_)
+                          : std::span<const RefineCell>{};
+    }
+
+    // 計画が差し替わるたびに増える
+    uint32_t generation() const { return generation_; }
+    bool loaded() const { return committed_; }
+    // 計画の中身から決まる値（同じリストを送り直せば同じ）。空なら0
+    uint32_t digest() const { return committed_ ? digest_ : 0; }
+
+  private:
+    std::array<std::array<RefineCell, kMaxCells>, 2> buffers_{};
+    std::size_t active_{0};
+    std::size_t count_{0};
+    std::size_t staged_count_{0};
+    bool receiving_{false};
+    bool committed_{false};
+    uint32_t generation_{0};
+    uint32_t digest_{0};
+};
+
+} // namespace gcinput::measure
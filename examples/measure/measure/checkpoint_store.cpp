@@ -0,0 +1,164 @@
+#include "measure/checkpoint_store.hpp"
+#include "telemetry/crc8.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace gcinput::measure {
+namespace {
+
+// 保存領域（フラッシュ先頭からのオフセット）
+constexpr uint32_t kSectorCount = 2;
+constexpr uint32_t kRegionSize = kSectorCount * FLASH_SECTOR_SIZE;
+constexpr uint32_t kRegionOffset = PICO_FLASH_SIZE_BYTES - kRegionSize;
+
+// フラッシュ上の1件。消去したままの場所はmagicが合わない
+struct StoredCheckpoint {
+    uint32_t magic;
+    uint32_t sequence; // 書くたびに1増える。一番大きいものが最新
+    Checkpoint body;
+    uint8_t reserved[7];
+    uint8_t crc; // magicからreservedまでのCRC-8
+};
+static_assert(sizeof(StoredCheckpoint) == 32);
+static_assert(FLASH_PAGE_SIZE % sizeof(StoredCheckpoint) == 0);
+
+constexpr uint32_t kMagic = 0x434D'4347u; // "GCMC"
+constexpr uint32_t kSlotSize = sizeof(StoredCheckpoint);
+constexpr uint32_t kSlotsPerSector = FLASH_SECTOR_SIZE / kSlotSize;
+constexpr uint32_t kSlotCount = kSectorCount * kSlotsPerSector;
+
+const uint8_t *slot_data(uint32_t slot) { return flash::read(kRegionOffset + slot * kSlotSize); }
+
+uint8_t checksum(const StoredCheckpoint &stored) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&stored);
+    return telemetry::crc8(std::span<const uint8_t>(bytes, offsetof(StoredCheckpoint, crc)));
+}
+
+bool read_slot(uint32_t slot, StoredCheckpoint &out) {
+    std::memcpy(&out, slot_data(slot), sizeof(out));
+    return out.magic == kMagic && out.crc == checksum(out);
+}
+
+// 消去したまま（全部0xFF）か
+bool is_blank(uint32_t first_slot, uint32_t count) {
+    return flash::is_blank(kRegionOffset + first_slot * kSlotSize, count * kSlotSize);
+}
+
+uint32_t sector_of(uint32_t slot) { return slot / kSlotsPerSector; }
+uint32_t first_slot(uint32_t sector) { return sector * kSlotsPerSector; }
+uint32_t other_sector(uint32_t sector) { return (sector + 1) % kSectorCount; }
+bool sector_blank(uint32_t sector) { return is_blank(first_slot(sector), kSlotsPerSector); }
+
+void erase_sector(uint32_t sector) {
+    flash::erase_sector(kRegionOffset + sector * FLASH_SECTOR_SIZE);
+}
+
+// ページ単位でしか書けないので、書く1件以外は0xFF（書いても変わらない）で埋める
+void program_slot(uint32_t slot, const StoredCheckpoint &stored) {
+    std::array<uint8_t, FLASH_PAGE_SIZE> page{};
+    page.fill(0xFF);
+    const uint32_t offset = slot * kSlotSize;
+    const uint32_t page_offset = offset - offset % FLASH_PAGE_SIZE;
+    std::memcpy(page.data() + (offset - page_offset), &stored, sizeof(stored));
+    flash::program_page(kRegionOffset + page_offset, page);
+}
+
+} // namespace
+
+void CheckpointStore::init() {
+    available_ = flash::region_available(kRegionOffset);
+    if (!available_) {
+        return;
+    }
+
+    std::optional<uint32_t> latest_slot{};
+    for (uint32_t slot = 0; slot < kSlotCount; ++slot) {
+        StoredCheckpoint stored{};
+        if (!read_slot(slot, stored)) {
+            continue;
+        }
+        if (!latest_slot || stored.sequence > sequence_) {
+            sequence_ = stored.sequence;
+            latest_ = stored.body;
+            latest_slot = slot;
+        }
+    }
+
+    // 計測中に消さずに済むよう、最新の1件だけがセクタの先頭にある形にしておく
+    // 前回の起動で済んでいれば（そのあと書いていなければ）何もしない
+    if (!latest_slot) {
+        for (uint32_t sector = 0; sector < kSectorCount; ++sector) {
+            if (!sector_blank(sector)) {
+                erase_sector(sector);
+            }
+        }
+        next_slot_ = 0;
+        return;
+    }
+    const uint32_t sector = sector_of(*latest_slot);
+    if (*latest_slot == first_slot(sector) && is_blank(*latest_slot + 1, kSlotsPerSector - 1) &&
+        sector_blank(other_sector(sector))) {
+        next_slot_ = *latest_slot + 1;
+        return;
+    }
+    // 最新の1件をもう一方のセクタへ書き直してから、元のセクタを消す
+    const uint32_t fresh = other_sector(sector);
+    if (!sector_blank(fresh)) {
+        erase_sector(fresh);
+    }
+    next_slot_ = first_slot(fresh);
+    write(*latest_);
+    erase_sector(sector);
+    erase_ahead_ = false;
+}
+
+void CheckpointStore::save(const Checkpoint &checkpoint) {
+    latest_ = checkpoint;
+    pending_ = available_;
+}
+
+void CheckpointStore::service(uint32_t now_us, const ConsoleFrameClock &clock) {
+    if (!pending_ && !erase_ahead_) {
+        return;
+    }
+    bool console_idle = false;
+    if (!window_.open(now_us, clock.last_poll_us, clock.frames != 0, console_idle)) {
+        return;
+    }
+    if (erase_ahead_ && console_idle) {
+        window_.use(clock.last_poll_us);
+        // 最後に書いたセクタの次
+        const uint32_t last_slot = (next_slot_ + kSlotCount - 1) % kSlotCount;
+        erase_sector(other_sector(sector_of(last_slot)));
+        erase_ahead_ = false;
+        return;
+    }
+    // 今のセクタを使い切っていて、次のセクタをまだ消せていない
+    if (!pending_ || (erase_ahead_ && next_slot_ % kSlotsPerSector == 0)) {
+        return;
+    }
+    window_.use(clock.last_poll_us);
+    write(*latest_);
+    pending_ = false;
+}
+
+void CheckpointStore::write(const Checkpoint &checkpoint) {
+    StoredCheckpoint stored{};
+    stored.magic = kMagic;
+    stored.sequence = sequence_ + 1;
+    stored.body = checkpoint;
+    std::memset(stored.reserved, 0xFF, sizeof(stored.reserved));
+    stored.crc = checksum(stored);
+    program_slot(next_slot_, stored);
+
+    sequence_ = stored.sequence;
+    // セクタの最初の1件を書いたら、もう一方には古い件しか残っていない
+    if (next_slot_ % kSlotsPerSector == 0) {
+        erase_ahead_ = !sector_blank(other_sector(sector_of(next_slot_)));
+    }
+    next_slot_ = (next_slot_ + 1) % kSlotCount;
+}
+
+} // namespace gcinput::measure
@@ -0,0 +1,61 @@
+#pragma once
+#include "hardware/flash.h"
+#include "link/shared/shared_console.hpp"
+#include "util/flash_region.hpp"
+#include <cstdint>
+#include <optional>
+
+// 計測の走査位置をフラッシュの末尾2セクタへ残す（電源を切っても続きから再開できる）
+//
+// 1件32バイトを書き足していき、セクタの終わりまで来たらもう一方のセクタへ移る
+// 最新の1件は常に消していない方のセクタに残る
+// フラッシュを書いている間はXIPが止まるため割り込みも止める。ページの書き込み（1ms弱）は
+// コンソールのStatus要求の直後に行う。セクタの消去（数十ms）の間は要求に応答できないので、
+// コンソールが止まっている間にしか行わない
+//   - init()（コンソールの要求を受け始める前）で、最新の1件を消したセクタの先頭へ書き直し、
+//     残りを消す。計測中は255件（1分ごとなら4時間ほど）消さずに書ける
+//   - 計測中は、移ったセクタに書いた後、もう一方をコンソールが止まったときに消す
+//     消す前に今のセクタを使い切ったら、消せるまで書かない（latest()は新しい内容を返し続ける）
+namespace gcinput::measure {
+
+// 保存する内容
+struct Checkpoint {
+    uint32_t run_id{0};      // 計測の通し番号（最初からやり直すたびに増える）
+    uint32_t position{0};    // PadInjector::position()
+    uint32_t frame{0};       // その点のD行のフレーム番号
+    uint32_t fingerprint{0}; // パターンの設定（違うパターンの位置からは再開しない）
+};
+
+class CheckpointStore {
+  public:
+    // 起動時に1回、ConsoleClientより前に。保存領域がファームウェアと重なっていれば何もしない
+    // 消去が要ればここで行うので数十〜百ms掛かる
+    void init();
+
+    bool available() const { return available_; }
+
+    // 最後に保存した（または保存を予約した）内容
+    const std::optional<Checkpoint> &latest() const { return latest_; }
+
+    // 保存を予約する。まだ書いていない分は新しい内容で置き換える
+    void save(const Checkpoint &checkpoint);
+    bool pending() const { return pending_; }
+
+    // mainループから毎回呼ぶ。書き込める時間帯なら書き込みを、コンソールが止まっていれば
+    // 消去を1回行う
+    void service(uint32_t now_us, const ConsoleFrameClock &clock);
+
+  private:
+    void write(const Checkpoint &checkpoint);
+
+    bool available_{false};
+    std::optional<Checkpoint> latest_{};
+    bool pending_{false};
+    uint32_t sequence_{0};  // 最後に書いた件の通し番号
+    uint32_t next_slot_{0}; // 次に書く場所（領域内の番号）
+    bool erase_ahead_{false}; // 次に移るセクタに古い件が残っている（消すまで移れない）
+    // Status要求からこの間だけフラッシュを触る（応答を送り終え、次の要求はまだ来ない）
+    flash::ConsoleWindow window_{{.start_us = 600, .end_us = 2'500}};
+};
+
+} // namespace gcinput::measure
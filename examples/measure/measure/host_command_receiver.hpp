@@ -0,0 +1,84 @@
+#pragma once
+#include "measure/host_values.hpp"
+#include "util/line_fields.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// シリアルからホストの値の指示を受け取る（tools/measure_client.py）
+// 1行1指示のテキスト（改行は\nか\r\n）
+//   V,seq,target,x,y,frames   値を待ち行列に積む。targetは0=スティック, 1=Cスティック, 2=トリガー
+//                             framesは見せるフレーム数（1..600）
+//   X                         待っている値を捨て、コンパイル時のパターンへ戻す
+// 結果はMeasureAckレコードで返す（積んだ、満杯、読めない、値を送り始めた、戻した）
+namespace gcinput::measure {
+
+inline bool is_host_command(std::string_view line) {
+    return line.starts_with("V,") || line == "X";
+}
+
+class HostCommandReceiver {
+  public:
+    enum class Event : uint8_t {
+        None,
+        Queued,
+        Full,
+        Rejected, // 行が読めない、値が範囲外
+        Released,
+    };
+
+    struct Result {
+        Event event{Event::None};
+        uint32_t seq{0};        // Queued/Fullのとき
+        std::size_t dropped{0}; // Releasedのとき
+    };
+
+    explicit HostCommandReceiver(HostValueQueue &queue) : queue_{queue} {}
+
+    // 1文字ずつ渡す。行が終わったときだけNone以外を返すことがある
+    Result feed(char c) {
+        std::string_view line{};
+        if (!line_.feed(c, line)) {
+            return {};
+        }
+        if (line_.overflowed()) {
+            // 値の指示は最長でも30文字に収まるので、長すぎる行は別の用途の行
+            return {};
+        }
+        return handle_line(line);
+    }
+
+  private:
+    static constexpr std::size_t kMaxLine = 48;
+
+    Result handle_line(std::string_view line) {
+        if (line == "X") {
+            return {.event = Event::Released, .dropped = queue_.release()};
+        }
+        if (!line.starts_with("V,")) {
+            return {};
+        }
+        std::array<uint32_t, 5> v{};
+        if (!parse_fields(line.substr(2), v) || v[1] > 2 || v[2] > 255 || v[3] > 255 ||
+            v[4] == 0 || v[4] > HostValueQueue::kMaxFrames) {
+            return {.event = Event::Rejected};
+        }
+        const HostValue value{
+            .seq = v[0],
+            .target = static_cast<SweepTarget>(v[1]),
+            .x = static_cast<uint8_t>(v[2]),
+            .y = static_cast<uint8_t>(v[3]),
+            .frames = static_cast<uint16_t>(v[4]),
+        };
+        if (!queue_.push(value)) {
+            return {.event = Event::Full, .seq = value.seq};
+        }
+        return {.event = Event::Queued, .seq = value.seq};
+    }
+
+    HostValueQueue &queue_;
+    LineBuffer<kMaxLine> line_{};
+};
+
+} // namespace gcinput::measure
@@ -0,0 +1,64 @@
+#pragma once
+#include "measure/patterns/stick_grid_sweep.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gcinput::measure {
+
+// ホストが指示した1つの値。framesフレームだけ見せてから次の値へ進む
+struct HostValue {
+    uint32_t seq{0}; // ホストが付けた番号（応答に入れて返す）
+    SweepTarget target{SweepTarget::Joystick};
+    uint8_t x{128};
+    uint8_t y{128};
+    uint16_t frames{10};
+};
+
+// ホストから届いた値の待ち行列。書き込みも読み出しもmainループから
+// active()の間はPadInjectorがパターンの代わりにここの値を送る（空なら最後の値のまま）
+class HostValueQueue {
+  public:
+    static constexpr std::size_t kCapacity = 64;
+    static constexpr uint16_t kMaxFrames = 600;
+
+    bool push(const HostValue &value) {
+        if (count_ >= kCapacity) {
+            return false;
+        }
+        values_[(head_ + count_) % kCapacity] = value;
+        count_++;
+        active_ = true;
+        return true;
+    }
+
+    bool pop(HostValue &out) {
+        if (count_ == 0) {
+            return false;
+        }
+        out = values_[head_];
+        head_ = (head_ + 1) % kCapacity;
+        count_--;
+        return true;
+    }
+
+    // 待っている値を捨ててパターンへ戻す。捨てた数を返す
+    std::size_t release() {
+        const std::size_t dropped = count_;
+        head_ = 0;
+        count_ = 0;
+        active_ = false;
+        return dropped;
+    }
+
+    bool active() const { return active_; }
+    std::size_t size() const { return count_; }
+
+  private:
+    std::array<HostValue, kCapacity> values_{};
+    std::size_t head_{0};
+    std::size_t count_{0};
+    bool active_{false};
+};
+
+} // namespace gcinput::measure
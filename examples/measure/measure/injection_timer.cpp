@@ -0,0 +1,58 @@
+#include "measure/injection_timer.hpp"
+#include "hardware/timer.h"
+
+namespace gcinput::measure {
+namespace {
+
+// アラームのコールバックには番号しか渡らないので、使っている1つを覚えておく
+InjectionTimer *g_timer = nullptr;
+
+void on_alarm(uint /*alarm_num*/) { g_timer->on_alarm_isr(); }
+
+void on_status_poll(void *user, const ConsoleFrameClock &clock) {
+    static_cast<InjectionTimer *>(user)->on_status_poll_isr(clock);
+}
+
+} // namespace
+
+void InjectionTimer::start(SharedConsole &console) {
+    g_timer = this;
+    alarm_ = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(static_cast<uint>(alarm_), &on_alarm);
+    console.set_status_poll_hook(&on_status_poll, this);
+}
+
+void InjectionTimer::on_status_poll_isr(const ConsoleFrameClock &clock) {
+    clock_ = clock;
+    // 同じフレームの要求が続けば、最後の要求からquiet_usまで延びる
+    hardware_alarm_set_target(static_cast<uint>(alarm_),
+                              make_timeout_time_us(config_.quiet_for(clock)));
+}
+
+void InjectionTimer::on_alarm_isr() {
+    if (restart_requested_.exchange(false, std::memory_order_acq_rel)) {
+        armed_ = false;
+    }
+    // 差し替えた後の要求からholdフレーム分を見せ終えるまで待つ
+    if (armed_ && clock_.frames - sent_frames_ < hold_) {
+        return;
+    }
+    if (!staged_ready_.load(std::memory_order_acquire)) {
+        return;
+    }
+    const StagedPoint point = staged_;
+    staged_ready_.store(false, std::memory_order_release);
+
+    hub_.on_pad_response_isr(point.reply.command(), point.reply.view());
+    armed_ = true;
+    sent_frames_ = clock_.frames;
+    hold_ = point.frames == 0 ? config_.frames : point.frames;
+    commits_.push(InjectionCommit{
+        .position = point.position,
+        .host_seq = point.host_seq,
+        .host = point.host,
+        .console_frame = clock_.frames + 1,
+    });
+}
+
+} // namespace gcinput::measure
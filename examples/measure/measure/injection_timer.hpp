@@ -0,0 +1,84 @@
+#pragma once
+#include "joybus/protocol/reply.hpp"
+#include "link/shared/shared_console.hpp"
+#include "link/shared/shared_pad_hub.hpp"
+#include "measure/scheduler.hpp"
+#include "util/spsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+
+// ハードウェアアラームの割り込みでパターンを差し替える
+// mainループはログの送信などで1周の長さが揺れるので、tickで差し替えると見え始める時刻も揺れる
+// ここではmainループが次の点を用意しておき（stage）、割り込みがStatus要求のquiet_us後に
+// 差し替える。見え始めるフレームが決まるので、点ごとの保持フレームを詰めても取りこぼさない
+//
+// 差し替える時機はFrameLockedScheduleと同じ（保持フレームを数え、同じフレームの要求の後）
+// 用意が間に合わなければ、今の点をそのまま次のフレームまで見せる
+namespace gcinput::measure {
+
+// mainループが用意する次の点
+struct StagedPoint {
+    JoybusReply reply{};
+    uint32_t frames{0};   // 見せるフレーム数（0ならFrameScheduleConfig::frames）
+    uint32_t position{0}; // この点を出す前のパターンの位置
+    uint32_t host_seq{0}; // ホストの値なら、その番号
+    bool host{false};
+};
+
+// 割り込みが差し替えた点の報告
+struct InjectionCommit {
+    uint32_t position{0};
+    uint32_t host_seq{0};
+    bool host{false};
+    uint32_t console_frame{0}; // この点が見え始めるフレーム（ConsoleFrameClock::frames）
+};
+
+class InjectionTimer {
+  public:
+    InjectionTimer(SharedPadHub &hub, FrameScheduleConfig config)
+        : hub_{hub}, config_{config} {}
+
+    // アラームを1つ確保し、consoleのStatus要求で動かす
+    // ConsoleClientを作る前に呼ぶ（1つのファームウェアで1つだけ）
+    void start(SharedConsole &console);
+
+    // mainループ側
+
+    // 次の点を置けるか（前に置いた点はもう差し替えられた）
+    bool can_stage() const { return !staged_ready_.load(std::memory_order_acquire); }
+    void stage(const StagedPoint &point) {
+        staged_ = point;
+        staged_ready_.store(true, std::memory_order_release);
+    }
+    // 置いた点を取り下げる。取り下げたらtrue（まだ差し替えられていなかった）
+    bool withdraw() { return staged_ready_.exchange(false, std::memory_order_acq_rel); }
+    // 今の点の残りの保持フレームを捨て、次に置く点を次のフレームから見せる
+    void restart() {
+        withdraw();
+        restart_requested_.store(true, std::memory_order_release);
+    }
+
+    bool consume_commit(InjectionCommit &out) { return commits_.pop(out); }
+
+    // 割り込み側（start()がつなぐ）
+    void on_status_poll_isr(const ConsoleFrameClock &clock);
+    void on_alarm_isr();
+
+  private:
+    SharedPadHub &hub_;
+    FrameScheduleConfig config_;
+    int alarm_{-1};
+
+    StagedPoint staged_{};
+    std::atomic<bool> staged_ready_{false};
+    std::atomic<bool> restart_requested_{false};
+    SpscRing<InjectionCommit, 8> commits_{};
+
+    // 割り込みだけが触る
+    ConsoleFrameClock clock_{};
+    bool armed_{false};
+    uint32_t sent_frames_{0}; // 今の点へ差し替えたときのフレーム数
+    uint32_t hold_{0};
+};
+
+} // namespace gcinput::measure
@@ -3,24 +3,43 @@
 #include "link/bridge_context.hpp"
 #include "link/policy.hpp"
 #include "link/shared/shared_console.hpp"
+#include "measure/host_values.hpp"
+#include "measure/injection_timer.hpp"
 #include "measure/pattern.hpp"
 #include "measure/scheduler.hpp"
 #include "measure/seed.hpp"
+#include "measure/settling.hpp"
+#include <optional>
+#include <utility>
 
 namespace gcinput::measure {
 
-template <TestPattern P> class PadInjector {
+// 計測の切り替え（Z/DpadUp）ではパターンの位置を保ったまま止めて、続きから再開する
+// 最初からやり直すときはrestart()、保存した位置から続けるときはresume()を有効化の前に呼ぶ
+// ホストの値の待ち行列（attach_host_values）が有効な間はパターンを止め、届いた値を送る
+// InjectionTimer（attach_timer）をつなぐと、tickは次の点を用意するだけで差し替えは割り込みが行う
+template <ResumablePattern P, StepSchedule S = Schedule> class PadInjector {
   public:
-    PadInjector(BridgeContext &link, Schedule schedule, P pattern)
-        : link_{link}, schedule_{schedule}, pattern_{pattern} {
+    // settlingを渡すと、各パターンを保持するフレーム数を前のパターンからの飛びで決める
+    // （渡さなければscheduleの間隔のまま）
+    PadInjector(BridgeContext &link, S schedule, P pattern,
+                std::optional<SettlingModel> settling = std::nullopt)
+        : link_{link}, schedule_{schedule}, pattern_{pattern}, settling_{settling} {
         last_measure_epoch_ = link_.load_measure_epoch();
+        shown_position_ = pattern_.position();
     }
 
     // mainループから呼ぶ（非ブロッキング）
     void tick(uint32_t now_us) {
         if (link_.consume_measure_epoch(last_measure_epoch_)) {
-            // テストモードの切り替えを検知したらリセット
-            reset_();
+            // テストモードの切り替えを検知したら、見せていた点からやり直す
+            if (timer_) {
+                timer_->restart();
+                staged_ = false;
+            }
+            pattern_.seek(shown_position_);
+            schedule_.reset();
+            has_last_ = false;
             // テスト開始前に初期応答をセット
             if (link_.is_measure_enabled()) {
                 const auto console = link_.shared_console().load();
@@ -34,16 +53,167 @@ template <TestPattern P> class PadInjector {
             return;
         }
 
+        const bool host_active = host_values_ && host_values_->active();
+        if (host_active != host_was_active_ && timer_) {
+            // 置いたままの点は出さず、パターンとホストの値を切り替えてすぐ見せる
+            withdraw_staged_();
+        }
+        if (!host_active && host_was_active_) {
+            // ホストの値から戻ったら、止めたときに見せていた点からやり直す
+            pattern_.seek(shown_position_);
+            has_last_ = false;
+        }
+        host_was_active_ = host_active;
+
+        if (timer_) {
+            stage_next_(host_active);
+            return;
+        }
+
         const uint32_t steps = schedule_.poll_steps(now_us);
         if (steps == 0) {
             return;
         }
+        if (host_active) {
+            send_host_value_();
+            return;
+        }
 
         domain::PadState state{};
+        const uint32_t position = pattern_.position();
         if (!pattern_.sample_and_advance(state, steps)) {
             return;
         }
+        shown_position_ = position;
+        if (settling_) {
+            schedule_.hold_frames(settle_frames_(state));
+        }
+        send_(state);
+    }
+
+    // 差し替えを割り込みにまかせる。scheduleは使わなくなる（保持フレームはtimerの設定で数える）
+    void attach_timer(InjectionTimer &timer) { timer_ = &timer; }
+
+    // ホストの値の待ち行列をつなぐ（mainのHostCommandReceiverが積む）
+    void attach_host_values(HostValueQueue &queue) { host_values_ = &queue; }
+
+    // ホストの値を含む応答をコンソールへ送り始めたら、その値の番号とフレームを1回だけ返す
+    // フレームはコンソールのStatus要求の数（ConsoleFrameClock::frames）
+    struct HostValueLive {
+        uint32_t seq{0};
+        uint32_t console_frame{0};
+    };
+    std::optional<HostValueLive> consume_host_live() {
+        if (timer_) {
+            return std::exchange(timer_live_, std::nullopt);
+        }
+        if (!pending_live_) {
+            return std::nullopt;
+        }
+        const TxRecord tx = link_.measure_pad_hub().load_last_tx();
+        if (tx.raw.command() != joybus::Command::Status ||
+            static_cast<int32_t>(tx.raw_publish_count - pending_live_->publish_count) < 0) {
+            return std::nullopt;
+        }
+        const HostValueLive live{
+            .seq = pending_live_->seq,
+            .console_frame = link_.shared_console().load_frame_clock().frames,
+        };
+        pending_live_.reset();
+        return live;
+    }
+
+    // 最初の点からやり直す
+    void restart() {
+        withdraw_staged_();
+        schedule_.reset();
+        pattern_.reset();
+        has_last_ = false;
+        shown_position_ = pattern_.position();
+    }
+
+    // 保存した位置（position()の値）から続ける。範囲外ならfalseで何もしない
+    bool resume(uint32_t position) {
+        withdraw_staged_();
+        if (!pattern_.seek(position)) {
+            return false;
+        }
+        schedule_.reset();
+        has_last_ = false;
+        shown_position_ = position;
+        return true;
+    }
+
+    // 今見せている点の位置。ここから再開すれば取りこぼしはない（その点は測り直しになる）
+    uint32_t position() const { return shown_position_; }
+    uint32_t fingerprint() const { return pattern_.fingerprint(); }
+
+  private:
+    // 前の点からの飛びで保持するフレーム数（最初の1点は前が分からないので一番長く待つ）
+    uint32_t settle_frames_(const domain::PadState &state) {
+        const uint32_t distance = has_last_ ? analog_distance(last_state_, state) : 255;
+        last_state_ = state;
+        has_last_ = true;
+        return settling_->frames_for(distance);
+    }
+
+    // InjectionTimerが差し替えた点を受け取り、空いていれば次の点を置く
+    void stage_next_(bool host_active) {
+        InjectionCommit commit{};
+        if (timer_->consume_commit(commit)) {
+            if (commit.host) {
+                timer_live_ = HostValueLive{.seq = commit.host_seq,
+                                            .console_frame = commit.console_frame};
+            } else {
+                shown_position_ = commit.position;
+            }
+        }
+        if (!timer_->can_stage()) {
+            return;
+        }
+        staged_ = false;
+
+        StagedPoint point{};
+        domain::PadState state{};
+        if (host_active) {
+            HostValue value{};
+            if (!host_values_->pop(value)) {
+                return;
+            }
+            state = make_neutral_pad_state();
+            set_target_axes(state, value.target, value.x, value.y);
+            point.frames = value.frames;
+            point.host_seq = value.seq;
+            point.host = true;
+        } else {
+            point.position = pattern_.position();
+            if (!pattern_.sample_and_advance(state, 1)) {
+                return;
+            }
+            if (settling_) {
+                point.frames = settle_frames_(state);
+            }
+        }
+        point.reply = joybus::state_wire::encode_status(state, policy::kPadPollModeForQuery);
+        staged_position_ = point.position;
+        staged_host_ = point.host;
+        timer_->stage(point);
+        staged_ = true;
+    }
+
+    // 置いたまま差し替えられていない点を取り下げ、パターンの点なら位置を戻す
+    void withdraw_staged_() {
+        if (!timer_ || !staged_) {
+            return;
+        }
+        staged_ = false;
+        if (timer_->withdraw() && !staged_host_) {
+            pattern_.seek(staged_position_);
+            has_last_ = false;
+        }
+    }
 
+    void send_(const domain::PadState &state) {
         auto &hub = link_.measure_pad_hub();
         const auto console = link_.shared_console().load();
         // （存在しない）パッドへも固定のPollModeでポーリングしたということにする
@@ -51,16 +221,45 @@ template <TestPattern P> class PadInjector {
         hub.on_pad_response_isr(reply.command(), reply.view());
     }
 
-  private:
-    void reset_() {
-        schedule_.reset();
-        pattern_.reset();
+    // 次のホストの値を決められたフレーム数だけ送る。待ち行列が空なら今の値のまま
+    void send_host_value_() {
+        HostValue value{};
+        if (!host_values_->pop(value)) {
+            return;
+        }
+        domain::PadState state = make_neutral_pad_state();
+        set_target_axes(state, value.target, value.x, value.y);
+        schedule_.hold_frames(value.frames);
+        send_(state);
+        pending_live_ = PendingLive{
+            .seq = value.seq,
+            .publish_count = link_.measure_pad_hub().load_original_snapshot().publish_count,
+        };
     }
 
-  private:
+    struct PendingLive {
+        uint32_t seq{0};
+        uint32_t publish_count{0}; // 値を書き込んだ後のパッド応答の公開回数
+    };
+
     BridgeContext &link_;
-    Schedule schedule_;
+    S schedule_;
     P pattern_;
+    std::optional<SettlingModel> settling_;
+    domain::PadState last_state_{};
+    bool has_last_{false};
+    // 今見せている点を出す前のパターンの位置
+    uint32_t shown_position_{0};
+
+    HostValueQueue *host_values_{nullptr};
+    bool host_was_active_{false};
+    std::optional<PendingLive> pending_live_{};
+
+    InjectionTimer *timer_{nullptr};
+    bool staged_{false}; // timer_へ置いた点がある（差し替えられたかはtimer_が知っている）
+    uint32_t staged_position_{0};
+    bool staged_host_{false};
+    std::optional<HostValueLive> timer_live_{};
 
     // 最後に実行したテストのエポック（テスト開始検知用）
     uint32_t last_measure_epoch_{0};
@@ -13,4 +13,24 @@ concept TestPattern = requires(P p, domain::PadState &state, uint32_t steps) {
     // 現在のパッド状態とステップ数から次の状態へ進められること
     { p.sample_and_advance(state, steps) } -> std::same_as<bool>;
 };
+
+// 途中から再開できるテストパターン
+// position()は次に出す点の位置。seek()でその位置へ戻せる（範囲外ならfalseで何もしない）
+// fingerprint()は設定から決まる値で、保存した位置が同じ走査のものかを確かめるのに使う
+template <class P>
+concept ResumablePattern = TestPattern<P> && requires(P p, const P cp, uint32_t position) {
+    { cp.position() } -> std::same_as<uint32_t>;
+    { p.seek(position) } -> std::same_as<bool>;
+    { cp.fingerprint() } -> std::same_as<uint32_t>;
+};
+
+// fingerprint用のFNV-1a（4バイトずつ混ぜる）
+inline constexpr uint32_t kFingerprintSeed = 0x811C'9DC5u;
+constexpr uint32_t fingerprint_mix(uint32_t hash, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        hash ^= (value >> (8 * i)) & 0xFFu;
+        hash *= 0x0100'0193u;
+    }
+    return hash;
+}
 } // namespace gcinput::measure
@@ -0,0 +1,221 @@
+#pragma once
+#include "domain/state.hpp"
+#include "measure/adaptive_plan.hpp"
+#include "measure/patterns/stick_grid_sweep.hpp"
+#include <cstdint>
+#include <span>
+
+namespace gcinput::measure {
+
+// 粗い格子を先に測り、その後で優先リスト（AdaptivePlan）のマスだけを細かく測る
+// 優先リストは前回の計測結果からホストで作る（tools/plan_adaptive_sweep.py）
+// 格子だけで補間できるマスを飛ばすので、全点走査（約3時間）よりずっと短く済む
+//
+// 優先リストがまだなければ、格子の後に残りの全点を測る（全点走査と同じ点を、粗い順に）
+// 走査の途中で優先リストが差し替わったら、細分の段は新しいリストの先頭からやり直す
+class AdaptiveStickSweep {
+  public:
+    using Target = SweepTarget;
+
+    struct Config {
+        // 粗い格子の間隔（2..128の2の冪）。255の列と行も格子に含める
+        uint8_t coarse_step{16};
+        bool loop{false};
+        Target target{Target::Joystick};
+        const AdaptivePlan *plan{nullptr};
+
+        // パターン生成のベースとする状態。指定なければニュートラル
+        domain::PadState base{};
+        bool base_is_custom{false};
+    };
+
+    explicit AdaptiveStickSweep(Config config) : config_(config) {
+        if (!config_.base_is_custom) {
+            config_.base.input.clear_buttons();
+            config_.base.input.set_analog_neutral();
+            config_.base.report = domain::PadStatusFlags{};
+        }
+        if (!is_power_of_two(config_.coarse_step) || config_.coarse_step < 2 ||
+            config_.coarse_step > 128) {
+            config_.coarse_step = 16;
+        }
+        coarse_count_ = 256u / config_.coarse_step + 1u;
+        reset();
+    }
+
+    void reset() {
+        phase_ = Phase::Coarse;
+        index_ = 0;
+        cell_ = 0;
+        point_ = 0;
+        generation_ = config_.plan ? config_.plan->generation() : 0;
+    }
+
+    bool sample_and_advance(domain::PadState &out, uint32_t steps) {
+        if (steps == 0) {
+            steps = 1;
+        }
+        sync_plan();
+
+        uint8_t x = 0;
+        uint8_t y = 0;
+        for (uint32_t i = 0; i < steps; ++i) {
+            if (!next_point(x, y)) {
+                return false;
+            }
+        }
+        out = config_.base;
+        set_target_axes(out, config_.target, x, y);
+        return true;
+    }
+
+    // 次に出す点の位置
+    // 格子の段は何点目か、細分の段は最上位ビットを立てて (マスの番号 << 16) | マスの中の何点目か
+    // 細分の段の位置は優先リストが同じときだけ意味がある（fingerprintに含める）
+    uint32_t position() const {
+        if (phase_ == Phase::Coarse) {
+            return index_;
+        }
+        uint32_t cell = cell_;
+        uint32_t point = point_;
+        const auto list = cells();
+        if (cell < list.size() && point >= points_in(list[cell])) {
+            cell++;
+            point = 0;
+        }
+        return kRefineBit | (cell << 16) | point;
+    }
+
+    bool seek(uint32_t position) {
+        sync_plan();
+        if ((position & kRefineBit) == 0) {
+            if (position > coarse_count_ * coarse_count_) {
+                return false;
+            }
+            phase_ = Phase::Coarse;
+            index_ = position;
+            return true;
+        }
+        const uint32_t cell = (position & ~kRefineBit) >> 16;
+        const uint32_t point = position & 0xFFFFu;
+        const auto list = cells();
+        if (cell > list.size() || (cell < list.size() && point >= points_in(list[cell])) ||
+            (cell == list.size() && point != 0)) {
+            return false;
+        }
+        phase_ = Phase::Refine;
+        cell_ = cell;
+        point_ = point;
+        return true;
+    }
+
+    uint32_t fingerprint() const {
+        uint32_t hash = kFingerprintSeed;
+        hash = fingerprint_mix(hash, config_.coarse_step);
+        hash = fingerprint_mix(hash, static_cast<uint32_t>(config_.target));
+        return fingerprint_mix(hash, config_.plan ? config_.plan->digest() : 0);
+    }
+
+    // デバッグ用
+    bool refining() const { return phase_ == Phase::Refine; }
+    uint32_t current_cell() const { return cell_; }
+
+  private:
+    enum class Phase : uint8_t { Coarse, Refine };
+
+    static constexpr uint32_t kRefineBit = 0x8000'0000u;
+
+    // 優先リストがないときの1マス（全点）
+    static constexpr RefineCell kFillAll{.x0 = 0, .y0 = 0, .size = 256, .step = 1};
+
+    void sync_plan() {
+        if (!config_.plan || config_.plan->generation() == generation_) {
+            return;
+        }
+        generation_ = config_.plan->generation();
+        if (phase_ == Phase::Refine) {
+            cell_ = 0;
+            point_ = 0;
+        }
+    }
+
+    std::span<const RefineCell> cells() const {
+        if (config_.plan && config_.plan->loaded()) {
+            return config_.plan->cells();
+        }
+        return std::span<const RefineCell>(&kFillAll, 1);
+    }
+
+    static uint32_t points_in(const RefineCell &cell) {
+        const uint32_t per_axis = cell.size / cell.step;
+        return per_axis * per_axis;
+    }
+
+    uint8_t coarse_value(uint32_t i) const {
+        const uint32_t v = i * config_.coarse_step;
+        return static_cast<uint8_t>(v > 255 ? 255 : v);
+    }
+
+    // 行ごとに向きを反転する（行の端で反対側へ飛ばない）
+    static uint32_t serpentine_column(uint32_t index, uint32_t columns) {
+        const uint32_t column = index % columns;
+        return ((index / columns) % 2 == 0) ? column : columns - 1 - column;
+    }
+
+    bool on_coarse_grid(uint32_t v) const { return v % config_.coarse_step == 0 || v == 255; }
+
+    bool next_point(uint8_t &x, uint8_t &y) {
+        while (true) {
+            if (phase_ == Phase::Coarse) {
+                if (index_ < coarse_count_ * coarse_count_) {
+                    x = coarse_value(serpentine_column(index_, coarse_count_));
+                    y = coarse_value(index_ / coarse_count_);
+                    index_++;
+                    return true;
+                }
+                phase_ = Phase::Refine;
+                cell_ = 0;
+                point_ = 0;
+                continue;
+            }
+
+            const auto list = cells();
+            if (cell_ >= list.size()) {
+                if (!config_.loop) {
+                    return false;
+                }
+                phase_ = Phase::Coarse;
+                index_ = 0;
+                continue;
+            }
+            const RefineCell &cell = list[cell_];
+            const uint32_t per_axis = cell.size / cell.step;
+            if (point_ >= points_in(cell)) {
+                cell_++;
+                point_ = 0;
+                continue;
+            }
+            const uint32_t px = cell.x0 + serpentine_column(point_, per_axis) * cell.step;
+            const uint32_t py = cell.y0 + (point_ / per_axis) * cell.step;
+            point_++;
+            // 格子の点は測り済み
+            if (on_coarse_grid(px) && on_coarse_grid(py)) {
+                continue;
+            }
+            x = static_cast<uint8_t>(px);
+            y = static_cast<uint8_t>(py);
+            return true;
+        }
+    }
+
+    Config config_;
+    uint32_t coarse_count_{0};
+
+    Phase phase_{Phase::Coarse};
+    uint32_t index_{0}; // 格子の何点目か
+    uint32_t cell_{0};  // 優先リストの何マス目か
+    uint32_t point_{0}; // マスの中の何点目か
+    uint32_t generation_{0};
+};
+
+} // namespace gcinput::measure
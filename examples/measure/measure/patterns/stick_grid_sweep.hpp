@@ -1,5 +1,7 @@
 #pragma once
 #include "domain/state.hpp"
+#include "measure/pattern.hpp"
+#include "measure/patterns/traversal.hpp"
 #include <cstdint>
 
 namespace gcinput::measure {
@@ -22,19 +24,43 @@ inline uint32_t count_range(const Uint8Range &range) {
     return span / static_cast<uint32_t>(range.step) + 1u;
 }
 
+// 走査する軸の組
+enum class SweepTarget : uint8_t {
+    Joystick,
+    Cstick,
+    Trigger, // x → l_analog, y → r_analog
+};
+
+// 走査する軸の組へ値を入れる
+inline void set_target_axes(domain::PadState &out, SweepTarget target, uint8_t x, uint8_t y) {
+    switch (target) {
+    case SweepTarget::Joystick:
+        out.input.analog.stick_x = x;
+        out.input.analog.stick_y = y;
+        break;
+    case SweepTarget::Cstick:
+        out.input.analog.c_stick_x = x;
+        out.input.analog.c_stick_y = y;
+        break;
+    case SweepTarget::Trigger:
+        out.input.analog.l_analog = x;
+        out.input.analog.r_analog = y;
+        break;
+    }
+}
+
 class StickGridSweep {
   public:
-    enum class Target : uint8_t {
-        Joystick,
-        Cstick,
-        Trigger, // x → l_analog, y → r_analog
-    };
+    using Target = SweepTarget;
 
     struct Config {
         Uint8Range x{};
         Uint8Range y{};
         bool loop{true};
         Target target{Target::Joystick};
+        // たどる順序。Hilbertは両軸の点の数が同じ2の冪のときだけで、それ以外はSerpentineと同じ
+        // （正方形から切り出すと隣へ動かない所が出る）。Mortonは片方の軸が1点だけならRowMajorと同じ
+        TraversalOrder order{TraversalOrder::RowMajor};
 
         // パターン生成のベースとする状態。指定なければニュートラル
         domain::PadState base{};
@@ -56,10 +82,47 @@ class StickGridSweep {
         } else {
             total_ = x_count_ * y_count_;
         }
+
+        // 曲線は2の冪の正方形をたどり、範囲外の点は飛ばす（Hilbertは飛ばす点がない場合だけ）
+        const uint32_t side = ceil_power_of_two(x_count_ > y_count_ ? x_count_ : y_count_);
+        if (config_.order == TraversalOrder::Hilbert &&
+            (x_count_ != side || y_count_ != side || side <= 1)) {
+            config_.order = TraversalOrder::Serpentine;
+        }
+        if (config_.order == TraversalOrder::Morton && (x_count_ <= 1 || y_count_ <= 1)) {
+            config_.order = TraversalOrder::RowMajor;
+        }
+        const bool curve = (config_.order == TraversalOrder::Hilbert ||
+                            config_.order == TraversalOrder::Morton);
+        if (curve) {
+            side_ = side;
+            positions_ = side_ * side_;
+        } else {
+            positions_ = total_;
+        }
     }
 
     void reset() { index_ = 0; }
 
+    // 次に出す点の、順序の上の位置
+    uint32_t position() const { return index_; }
+
+    bool seek(uint32_t position) {
+        if (position >= positions_) {
+            return false;
+        }
+        index_ = position;
+        return true;
+    }
+
+    uint32_t fingerprint() const {
+        uint32_t hash = kFingerprintSeed;
+        hash = fingerprint_mix(hash, range_key(config_.x));
+        hash = fingerprint_mix(hash, range_key(config_.y));
+        hash = fingerprint_mix(hash, static_cast<uint32_t>(config_.target));
+        return fingerprint_mix(hash, static_cast<uint32_t>(config_.order));
+    }
+
     bool sample_and_advance(domain::PadState &out, uint32_t steps) {
         if (steps == 0) {
             steps = 1;
@@ -69,58 +132,84 @@ class StickGridSweep {
         }
 
         // 範囲をstepsごとに刻んで出力
-        uint32_t out_index = index_ + (steps - 1);
-
-        if (config_.loop) {
-            out_index %= total_;
-            index_ = (index_ + steps) % total_;
-        } else {
-            if (out_index >= total_) {
+        uint32_t x_index = 0;
+        uint32_t y_index = 0;
+        for (uint32_t i = 0; i < steps; ++i) {
+            if (!next_position(x_index, y_index)) {
                 return false;
             }
-            index_ += steps;
         }
 
-        const uint32_t x_index = out_index % x_count_;
-        const uint32_t y_index = out_index / x_count_;
-
         const uint32_t x = static_cast<uint32_t>(config_.x.begin) + x_index * config_.x.step;
         const uint32_t y = static_cast<uint32_t>(config_.y.begin) + y_index * config_.y.step;
 
         // 毎回ベースから組み立てる（前回の状態にインクリメントというわけではない）
         out = config_.base;
-
-        switch (config_.target) {
-        case Target::Joystick:
-            out.input.analog.stick_x = static_cast<uint8_t>(x);
-            out.input.analog.stick_y = static_cast<uint8_t>(y);
-            break;
-        case Target::Cstick:
-            out.input.analog.c_stick_x = static_cast<uint8_t>(x);
-            out.input.analog.c_stick_y = static_cast<uint8_t>(y);
-            break;
-        case Target::Trigger:
-            out.input.analog.l_analog = static_cast<uint8_t>(x);
-            out.input.analog.r_analog = static_cast<uint8_t>(y);
-            break;
-        }
+        set_target_axes(out, config_.target, static_cast<uint8_t>(x), static_cast<uint8_t>(y));
         return true;
     }
 
     // デバッグ用
     // 走査する範囲内にある点の数
     uint32_t total_steps() const { return total_; }
-    // 何番目の点か
+    // 何番目の点か（曲線では範囲外の点も数える）
     uint32_t current_index() const { return index_; }
 
   private:
+    static uint32_t range_key(const Uint8Range &range) {
+        return range.begin | (static_cast<uint32_t>(range.end) << 8) |
+               (static_cast<uint32_t>(range.step) << 16);
+    }
+
+    // 順序の上で次の点へ進む。loopでなければ最後の点の後はfalse
+    bool next_position(uint32_t &x_index, uint32_t &y_index) {
+        for (uint32_t tries = 0; tries < positions_; ++tries) {
+            if (index_ >= positions_) {
+                if (!config_.loop) {
+                    return false;
+                }
+                index_ = 0;
+            }
+            position_to_index(index_++, x_index, y_index);
+            if (x_index < x_count_ && y_index < y_count_) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void position_to_index(uint32_t position, uint32_t &x_index, uint32_t &y_index) const {
+        switch (config_.order) {
+        case TraversalOrder::RowMajor:
+            x_index = position % x_count_;
+            y_index = position / x_count_;
+            return;
+        case TraversalOrder::Serpentine:
+            x_index = position % x_count_;
+            y_index = position / x_count_;
+            if (y_index % 2 == 1) {
+                x_index = x_count_ - 1 - x_index;
+            }
+            return;
+        case TraversalOrder::Hilbert:
+            hilbert_d2xy(side_, position, x_index, y_index);
+            return;
+        case TraversalOrder::Morton:
+            morton_d2xy(position, x_index, y_index);
+            return;
+        }
+    }
+
     Config config_;
 
     uint32_t x_count_{0};
     uint32_t y_count_{0};
     uint32_t total_{0};
+    // 順序の上の位置の数（曲線なら正方形の点の数）
+    uint32_t positions_{0};
+    uint32_t side_{0};
 
-    // 次の出力点のインデックス
+    // 次の出力点の、順序の上の位置
     uint32_t index_{0};
 };
 } // namespace gcinput::measure
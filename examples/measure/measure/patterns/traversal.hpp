@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+
+// 2次元の格子をたどる順序
+// 行の端で0へ戻る飛びをなくすと、ゲーム側の表示が落ち着くまでの待ちを短くできる
+namespace gcinput::measure {
+
+enum class TraversalOrder : uint8_t {
+    RowMajor,   // 行ごとに左から右（行の終わりで端から端へ飛ぶ）
+    Serpentine, // 行ごとに向きを反転（隣の行へ1つ動くだけ）
+    Hilbert,    // ヒルベルト曲線（常に隣の点へ動く。2の冪の正方形だけ）
+    Morton,     // Z階数曲線（近い点がまとまるが、ブロックの境目で飛ぶ）
+};
+
+// ヒルベルト曲線上のd番目の点。sideは2の冪
+inline void hilbert_d2xy(uint32_t side, uint32_t d, uint32_t &x, uint32_t &y) {
+    x = 0;
+    y = 0;
+    for (uint32_t s = 1; s < side; s *= 2) {
+        const uint32_t rx = 1u & (d / 2);
+        const uint32_t ry = 1u & (d ^ rx);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            const uint32_t t = x;
+            x = y;
+            y = t;
+        }
+        x += s * rx;
+        y += s * ry;
+        d /= 4;
+    }
+}
+
+// 偶数番目のビットだけを詰める
+inline uint32_t compact_even_bits(uint32_t v) {
+    v &= 0x5555'5555u;
+    v = (v | (v >> 1)) & 0x3333'3333u;
+    v = (v | (v >> 2)) & 0x0F0F'0F0Fu;
+    v = (v | (v >> 4)) & 0x00FF'00FFu;
+    v = (v | (v >> 8)) & 0x0000'FFFFu;
+    return v;
+}
+
+// Z階数曲線上のd番目の点
+inline void morton_d2xy(uint32_t d, uint32_t &x, uint32_t &y) {
+    x = compact_even_bits(d);
+    y = compact_even_bits(d >> 1);
+}
+
+// count以上の最小の2の冪
+inline uint32_t ceil_power_of_two(uint32_t count) {
+    uint32_t side = 1;
+    while (side < count) {
+        side *= 2;
+    }
+    return side;
+}
+
+} // namespace gcinput::measure
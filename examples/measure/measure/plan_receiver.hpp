@@ -0,0 +1,106 @@
+#pragma once
+#include "measure/adaptive_plan.hpp"
+#include "measure/host_command_receiver.hpp"
+#include "util/line_fields.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// シリアルから細分の優先リストを受け取る
+// 1行1レコードのテキスト（改行は\nか\r\n）
+//   P                      受け取りを始める（今の計画はEで入れ替わるまで使い続ける）
+//   C,x0,y0,size,step      細分するマス（先頭ほど優先）
+//   E,count                終わり。受け取ったマスの数が合えば今の計画と入れ替える
+// 受け取りの途中に値の指示（V/X）が混ざっても受け取りは続く
+namespace gcinput::measure {
+
+class PlanReceiver {
+  public:
+    enum class Event : uint8_t {
+        None,
+        Begun,
+        Committed,
+        Rejected, // 行が読めない、マスが範囲外、数が合わない
+    };
+
+    explicit PlanReceiver(AdaptivePlan &plan) : plan_{plan} {}
+
+    // 1文字ずつ渡す。行が終わったときだけNone以外を返すことがある
+    Event feed(char c) {
+        std::string_view line{};
+        if (!line_.feed(c, line)) {
+            return Event::None;
+        }
+        if (line_.overflowed()) {
+            return fail();
+        }
+        return handle_line(line);
+    }
+
+    // 受け取り中か（Rejectedの後は次のPまで行を捨てる）
+    bool receiving() const { return receiving_; }
+    std::size_t received() const { return received_; }
+
+  private:
+    static constexpr std::size_t kMaxLine = 32;
+
+    Event handle_line(std::string_view line) {
+        // 空行と、同じシリアルで届く値の指示（host_command_receiver.hpp）は読み飛ばす
+        if (line.empty() || is_host_command(line)) {
+            return Event::None;
+        }
+        if (line == "P") {
+            plan_.begin();
+            receiving_ = true;
+            received_ = 0;
+            return Event::Begun;
+        }
+        if (!receiving_) {
+            return Event::None;
+        }
+        if (line.starts_with("C,")) {
+            std::array<uint32_t, 4> v{};
+            if (!parse_fields(line.substr(2), v)) {
+                return fail();
+            }
+            const RefineCell cell{
+                .x0 = static_cast<uint8_t>(v[0]),
+                .y0 = static_cast<uint8_t>(v[1]),
+                .size = static_cast<uint16_t>(v[2]),
+                .step = static_cast<uint8_t>(v[3]),
+            };
+            if (v[0] > 255 || v[1] > 255 || v[2] > 256 || v[3] > 255 || !plan_.add(cell)) {
+                return fail();
+            }
+            received_++;
+            return Event::None;
+        }
+        if (line.starts_with("E,")) {
+            receiving_ = false;
+            std::array<uint32_t, 1> v{};
+            if (!parse_fields(line.substr(2), v) || !plan_.commit(v[0])) {
+                return Event::Rejected;
+            }
+            return Event::Committed;
+        }
+        return fail();
+    }
+
+    Event fail() {
+        if (!receiving_) {
+            return Event::None;
+        }
+        // Pで始めた分は捨て、前の計画を使い続ける
+        receiving_ = false;
+        plan_.abort();
+        return Event::Rejected;
+    }
+
+    AdaptivePlan &plan_;
+    LineBuffer<kMaxLine> line_{};
+    bool receiving_{false};
+    std::size_t received_{0};
+};
+
+} // namespace gcinput::measure
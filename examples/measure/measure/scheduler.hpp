@@ -1,21 +1,36 @@
 #pragma once
 
+#include "link/shared/shared_console.hpp"
+#include <algorithm>
+#include <concepts>
 #include <cstdint>
 
 namespace gcinput::measure {
+// PadInjectorが次のパターンへ進む時機を決めるもの
+template <class S>
+concept StepSchedule = requires(S s, uint32_t now_us, uint32_t frames) {
+    { s.reset() } -> std::same_as<void>;
+    // 今進める数（0なら待つ）
+    { s.poll_steps(now_us) } -> std::same_as<uint32_t>;
+    // poll_stepsが0以外を返した直後に呼ぶと、今回のパターンだけ保持するフレーム数を変える
+    { s.hold_frames(frames) } -> std::same_as<void>;
+};
+
 struct ScheduleConfig {
     uint32_t interval_us{16'667}; // デフォルト60Hz
     bool catch_up{false};         // 遅延してでもテストパターンは捨てない
+    uint32_t frame_us{16'667};    // hold_framesの1フレーム
 };
 
 class Schedule {
   public:
     Schedule() = default;
     explicit Schedule(ScheduleConfig config)
-        : interval_us{config.interval_us}, catch_up{config.catch_up} {}
+        : interval_us{config.interval_us}, catch_up{config.catch_up}, frame_us{config.frame_us} {}
 
     uint32_t interval_us{16'667};
     bool catch_up{true};
+    uint32_t frame_us{16'667};
 
     void reset() { armed_ = false; }
 
@@ -40,14 +55,19 @@ class Schedule {
         if (catch_up) {
             // 途中のテストパターンを飛ばしてでも追いつく
             steps += late / interval;
+            current_due_us_ = next_due_us_ + (steps - 1) * interval;
             next_due_us_ += steps * interval;
         } else {
             // 用意したパターンは遅延してでも必ず送る
+            current_due_us_ = now_us;
             next_due_us_ = now_us + interval;
         }
         return steps;
     }
 
+    // 今回送るパターンだけ、次までの間隔をinterval_usの代わりにframes * frame_usにする
+    void hold_frames(uint32_t frames) { next_due_us_ = current_due_us_ + frames * frame_us; }
+
   private:
     // 現在時刻が期限を過ぎているか
     static bool has_passed_due(uint32_t now_us, uint32_t due_us) {
@@ -57,5 +77,57 @@ class Schedule {
   private:
     bool armed_{false};
     uint32_t next_due_us_{0};
+    // 今回送るパターンの期限
+    uint32_t current_due_us_{0};
+};
+
+// コンソールのStatus要求の間隔からフレームの境目を数え、各パターンをちょうどframesフレーム見せる
+// 時刻で刻むScheduleはコンソールのフレームとずれ、9フレームしか見えない点や11フレーム見える点が出る
+//
+// パターンは同じフレームの要求が終わった後（最後の要求からquiet_us経ってから）に差し替えるので、
+// 1つのフレームの中で値が変わることはない。コンソールが要求してこない間は進まない
+// quiet_usが0なら、フレームを数えるときに同じフレームとみなす間隔（要求の間隔から見積もった
+// ConsoleFrameClock::same_frame_us）を使う。指定してもそれより短くはしない
+struct FrameScheduleConfig {
+    uint32_t frames{10};
+    uint32_t quiet_us{0};
+
+    // 最後の要求からパターンを差し替えるまで待つ時間
+    uint32_t quiet_for(const ConsoleFrameClock &clock) const {
+        return std::max(quiet_us, clock.same_frame_us);
+    }
+};
+
+class FrameLockedSchedule {
+  public:
+    FrameLockedSchedule(const SharedConsole &console, FrameScheduleConfig config)
+        : console_{&console}, config_{config} {}
+
+    void reset() { armed_ = false; }
+
+    uint32_t poll_steps(uint32_t now_us) {
+        const ConsoleFrameClock clock = console_->load_frame_clock();
+        if (clock.frames == 0 || now_us - clock.last_poll_us < config_.quiet_for(clock)) {
+            return 0;
+        }
+        // 差し替えた後の要求からholdフレーム分を見せ終えたら進む
+        if (armed_ && clock.frames - sent_frames_ < hold_) {
+            return 0;
+        }
+        armed_ = true;
+        sent_frames_ = clock.frames;
+        hold_ = config_.frames;
+        return 1;
+    }
+
+    void hold_frames(uint32_t frames) { hold_ = frames == 0 ? 1 : frames; }
+
+  private:
+    const SharedConsole *console_;
+    FrameScheduleConfig config_;
+
+    bool armed_{false};
+    uint32_t sent_frames_{0}; // 今のパターンへ差し替えたときのフレーム数
+    uint32_t hold_{0};
 };
 } // namespace gcinput::measure
@@ -0,0 +1,40 @@
+#pragma once
+#include "domain/state.hpp"
+#include <cstdint>
+#include <cstdlib>
+
+namespace gcinput::measure {
+
+// ゲーム側の表示が落ち着くまでの待ちを、前の点からの飛びの大きさで決める
+// 隣の点へ動くだけならmin_frames、端から端へ飛べばmax_framesに近づく
+// 既定値は控えめな見積もり。計測動画で読み取りが崩れるようなら伸ばす
+struct SettlingModel {
+    uint8_t min_frames{3};
+    uint8_t max_frames{10};
+    // 飛びがこれだけ増えるごとに1フレーム足す（これより短い飛びはmin_framesのまま）
+    uint8_t distance_per_frame{32};
+
+    uint32_t frames_for(uint32_t distance) const {
+        const uint32_t per = distance_per_frame == 0 ? 1 : distance_per_frame;
+        const uint32_t frames = min_frames + distance / per;
+        return frames < max_frames ? frames : max_frames;
+    }
+};
+
+// 2つの状態のアナログ値の飛び（軸ごとの差の最大）
+inline uint32_t analog_distance(const domain::PadState &a, const domain::PadState &b) {
+    const auto &p = a.input.analog;
+    const auto &q = b.input.analog;
+    const int diffs[] = {
+        p.stick_x - q.stick_x,     p.stick_y - q.stick_y,   p.c_stick_x - q.c_stick_x,
+        p.c_stick_y - q.c_stick_y, p.l_analog - q.l_analog, p.r_analog - q.r_analog,
+    };
+    uint32_t distance = 0;
+    for (const int d : diffs) {
+        const auto magnitude = static_cast<uint32_t>(std::abs(d));
+        distance = magnitude > distance ? magnitude : distance;
+    }
+    return distance;
+}
+
+} // namespace gcinput::measure
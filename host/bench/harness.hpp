@@ -0,0 +1,90 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+// ホスト向けベンチマーク/等価性検証の最小ハーネス
+namespace gcinput::bench {
+
+// スティック入力の全組み合わせ (0..255)²
+inline constexpr uint32_t kAllStickInputs = 256u * 256u;
+
+// 計測対象。1回の呼び出しで ops 回分の処理を行い、最適化で消されないようチェックサムを返す
+struct BenchCase {
+    const char *name{nullptr};
+    uint32_t (*run)(){nullptr};
+    uint32_t ops{kAllStickInputs};
+};
+
+// 等価性検証。不一致があれば最初の数件を表示してfalseを返す
+struct CheckCase {
+    const char *name{nullptr};
+    bool (*run)(){nullptr};
+};
+
+class Registry {
+  public:
+    void add(BenchCase c) { benches_.push_back(c); }
+    void add(CheckCase c) { checks_.push_back(c); }
+
+    const std::vector<BenchCase> &benches() const { return benches_; }
+    const std::vector<CheckCase> &checks() const { return checks_; }
+
+  private:
+    std::vector<BenchCase> benches_;
+    std::vector<CheckCase> checks_;
+};
+
+// 各スイートの登録関数
+void register_transform_suite(Registry &registry);
+void register_codec_suite(Registry &registry);
+void register_telemetry_suite(Registry &registry);
+void register_util_suite(Registry &registry);
+// measure_bench（measure のヘッダは bridge と同じ名前で中身が違うので、別の実行ファイルにする）
+void register_measure_suite(Registry &registry);
+
+// コマンドラインを読み、register_suitesで登録した検証とベンチマークを実行する（runner.cpp）
+int run_host_bench(int argc, char **argv, void (*register_suites)(Registry &registry));
+
+// 不一致の報告。1つの検証につき表示は先頭kMaxReportsまで
+class MismatchReporter {
+  public:
+    static constexpr uint32_t kMaxReports = 8;
+
+    explicit MismatchReporter(const char *name) : name_{name} {}
+
+    template <class... Args> void report(const char *fmt, Args... args) {
+        if (count_ < kMaxReports) {
+            std::printf("  [%s] mismatch: ", name_);
+            std::printf(fmt, args...);
+            std::printf("\n");
+        }
+        ++count_;
+    }
+
+    bool ok() const { return count_ == 0; }
+    uint32_t count() const { return count_; }
+
+  private:
+    const char *name_;
+    uint32_t count_{0};
+};
+
+// コンパイラに結果を捨てさせないためのシンク
+inline volatile uint32_t g_sink = 0;
+
+inline uint64_t now_ns() {
+    using clock = std::chrono::steady_clock;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch())
+            .count());
+}
+
+inline bool name_matches(std::string_view name, std::string_view filter) {
+    return filter.empty() || name.find(filter) != std::string_view::npos;
+}
+
+} // namespace gcinput::bench
@@ -0,0 +1,11 @@
+#include "harness.hpp"
+
+// bridge のコード（補正ステージ・コーデック・テレメトリ）の検証とベンチマーク
+int main(int argc, char **argv) {
+    return gcinput::bench::run_host_bench(argc, argv, [](gcinput::bench::Registry &registry) {
+        gcinput::bench::register_transform_suite(registry);
+        gcinput::bench::register_codec_suite(registry);
+        gcinput::bench::register_telemetry_suite(registry);
+        gcinput::bench::register_util_suite(registry);
+    });
+}
@@ -0,0 +1,6 @@
+#include "harness.hpp"
+
+// measure のコード（走査パターンなど）の検証
+int main(int argc, char **argv) {
+    return gcinput::bench::run_host_bench(argc, argv, &gcinput::bench::register_measure_suite);
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Status/Originレスポンスの参照コーデック
+// https://jefflongo.dev/posts/gc-controller-reverse-engineering-part-1/#poll-mode
+// ファームウェア側の state_wire を最適化するときの正解とするため、各フィールドを個別の変数に
+// 展開する素直な書き方にしてある。ファームウェアの型には依存しない
+namespace gcinput::bench::ref {
+
+struct Pad {
+    // Status word（Little-endian）のビット位置ごとの値
+    bool a, b, x, y, start;
+    bool origin_not_sent, error_latched, always1;
+    bool dpad_left, dpad_right, dpad_down, dpad_up;
+    bool z, r, l;
+    bool use_controller_origin;
+
+    uint8_t stick_x, stick_y;
+    uint8_t c_stick_x, c_stick_y;
+    uint8_t l_analog, r_analog;
+    uint8_t a_analog, b_analog;
+};
+
+inline constexpr uint8_t expand4(uint8_t v) { return static_cast<uint8_t>((v & 0x0Fu) << 4); }
+inline constexpr uint8_t shrink4(uint8_t v) { return static_cast<uint8_t>(v >> 4); }
+inline constexpr uint8_t pack4(uint8_t hi, uint8_t lo) {
+    return static_cast<uint8_t>(((hi & 0x0Fu) << 4) | (lo & 0x0Fu));
+}
+
+inline Pad decode_status_word(uint8_t b0, uint8_t b1) {
+    const uint16_t w = static_cast<uint16_t>(b0 | (b1 << 8));
+    auto bit = [w](int n) { return ((w >> n) & 1u) != 0; };
+    Pad p{};
+    p.a = bit(0);
+    p.b = bit(1);
+    p.x = bit(2);
+    p.y = bit(3);
+    p.start = bit(4);
+    p.origin_not_sent = bit(5);
+    p.error_latched = bit(6);
+    p.always1 = bit(7);
+    p.dpad_left = bit(8);
+    p.dpad_right = bit(9);
+    p.dpad_down = bit(10);
+    p.dpad_up = bit(11);
+    p.z = bit(12);
+    p.r = bit(13);
+    p.l = bit(14);
+    p.use_controller_origin = bit(15);
+    // アナログの既定値（未受信のフィールド）
+    p.stick_x = p.stick_y = p.c_stick_x = p.c_stick_y = 0x80;
+    p.l_analog = p.r_analog = p.a_analog = p.b_analog = 0x00;
+    return p;
+}
+
+// 応答時のStatus word。Always1は常に立てる（立てないと本体に認識されない）
+inline void encode_status_word(const Pad &p, uint8_t &b0, uint8_t &b1) {
+    uint16_t w = 0;
+    auto put = [&w](bool v, int n) { w |= v ? static_cast<uint16_t>(1u << n) : 0u; };
+    put(p.a, 0);
+    put(p.b, 1);
+    put(p.x, 2);
+    put(p.y, 3);
+    put(p.start, 4);
+    put(p.origin_not_sent, 5);
+    put(p.error_latched, 6);
+    put(true, 7);
+    put(p.dpad_left, 8);
+    put(p.dpad_right, 9);
+    put(p.dpad_down, 10);
+    put(p.dpad_up, 11);
+    put(p.z, 12);
+    put(p.r, 13);
+    put(p.l, 14);
+    put(p.use_controller_origin, 15);
+    b0 = static_cast<uint8_t>(w & 0xFFu);
+    b1 = static_cast<uint8_t>(w >> 8);
+}
+
+inline Pad decode_status(const std::array<uint8_t, 8> &rx, uint8_t mode) {
+    Pad p = decode_status_word(rx[0], rx[1]);
+    p.stick_x = rx[2];
+    p.stick_y = rx[3];
+    switch (mode) {
+    case 0:
+        p.c_stick_x = rx[4];
+        p.c_stick_y = rx[5];
+        p.l_analog = expand4(rx[6] >> 4);
+        p.r_analog = expand4(rx[6]);
+        p.a_analog = expand4(rx[7] >> 4);
+        p.b_analog = expand4(rx[7]);
+        break;
+    case 1:
+        p.c_stick_x = expand4(rx[4] >> 4);
+        p.c_stick_y = expand4(rx[4]);
+        p.l_analog = rx[5];
+        p.r_analog = rx[6];
+        p.a_analog = expand4(rx[7] >> 4);
+        p.b_analog = expand4(rx[7]);
+        break;
+    case 2:
+        p.c_stick_x = expand4(rx[4] >> 4);
+        p.c_stick_y = expand4(rx[4]);
+        p.l_analog = expand4(rx[5] >> 4);
+        p.r_analog = expand4(rx[5]);
+        p.a_analog = rx[6];
+        p.b_analog = rx[7];
+        break;
+    case 3:
+        p.c_stick_x = rx[4];
+        p.c_stick_y = rx[5];
+        p.l_analog = rx[6];
+        p.r_analog = rx[7];
+        break;
+    case 4:
+        p.c_stick_x = rx[4];
+        p.c_stick_y = rx[5];
+        p.a_analog = rx[6];
+        p.b_analog = rx[7];
+        break;
+    default:
+        break;
+    }
+    return p;
+}
+
+inline std::array<uint8_t, 8> encode_status(const Pad &p, uint8_t mode) {
+    std::array<uint8_t, 8> out{};
+    encode_status_word(p, out[0], out[1]);
+    out[2] = p.stick_x;
+    out[3] = p.stick_y;
+    switch (mode) {
+    case 0:
+        out[4] = p.c_stick_x;
+        out[5] = p.c_stick_y;
+        out[6] = pack4(shrink4(p.l_analog), shrink4(p.r_analog));
+        out[7] = pack4(shrink4(p.a_analog), shrink4(p.b_analog));
+        break;
+    case 1:
+        out[4] = pack4(shrink4(p.c_stick_x), shrink4(p.c_stick_y));
+        out[5] = p.l_analog;
+        out[6] = p.r_analog;
+        out[7] = pack4(shrink4(p.a_analog), shrink4(p.b_analog));
+        break;
+    case 2:
+        out[4] = pack4(shrink4(p.c_stick_x), shrink4(p.c_stick_y));
+        out[5] = pack4(shrink4(p.l_analog), shrink4(p.r_analog));
+        out[6] = p.a_analog;
+        out[7] = p.b_analog;
+        break;
+    case 3:
+        out[4] = p.c_stick_x;
+        out[5] = p.c_stick_y;
+        out[6] = p.l_analog;
+        out[7] = p.r_analog;
+        break;
+    case 4:
+        out[4] = p.c_stick_x;
+        out[5] = p.c_stick_y;
+        out[6] = p.a_analog;
+        out[7] = p.b_analog;
+        break;
+    default:
+        break;
+    }
+    return out;
+}
+
+inline Pad decode_origin(const std::array<uint8_t, 10> &rx) {
+    Pad p = decode_status_word(rx[0], rx[1]);
+    p.stick_x = rx[2];
+    p.stick_y = rx[3];
+    p.c_stick_x = rx[4];
+    p.c_stick_y = rx[5];
+    p.l_analog = rx[6];
+    p.r_analog = rx[7];
+    p.a_analog = rx[8];
+    p.b_analog = rx[9];
+    return p;
+}
+
+inline std::array<uint8_t, 10> encode_origin(const Pad &p) {
+    std::array<uint8_t, 10> out{};
+    encode_status_word(p, out[0], out[1]);
+    out[2] = p.stick_x;
+    out[3] = p.stick_y;
+    out[4] = p.c_stick_x;
+    out[5] = p.c_stick_y;
+    out[6] = p.l_analog;
+    out[7] = p.r_analog;
+    out[8] = p.a_analog;
+    out[9] = p.b_analog;
+    return out;
+}
+
+} // namespace gcinput::bench::ref
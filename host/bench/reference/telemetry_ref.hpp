@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// テレメトリ導入前のテキスト出力の参照実装
+// measure/input_viewer が持っていたビットループ版CRC-8と、D/I行の書式をそのまま写したもの
+namespace gcinput::bench::ref {
+
+// CRC-8 ATM (poly=0x07, init=0x00)
+template <std::size_t N> uint8_t crc8_bitwise(const std::array<uint8_t, N> &data) {
+    uint8_t crc = 0x00;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        crc ^= data[i];
+        for (uint8_t j = 0; j < 8; ++j) {
+            if (crc & 0x80) {
+                crc = (crc << 1) ^ 0x07;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+// measureのD行（改行を除く）。書いた文字数を返す
+inline int format_measure_line(char *out, std::size_t size, uint32_t frame, uint8_t first,
+                               uint8_t second) {
+    const std::array<uint8_t, 4> crc_data{
+        static_cast<uint8_t>((frame >> 8) & 0xFF),
+        static_cast<uint8_t>(frame & 0xFF),
+        first,
+        second,
+    };
+    return std::snprintf(out, size, "D,%u,%u,%u,%02X", frame, first, second,
+                         crc8_bitwise(crc_data));
+}
+
+// input_viewerのI行（改行を除く）
+inline int format_input_line(char *out, std::size_t size, const std::array<uint8_t, 8> &s) {
+    return std::snprintf(out, size, "I,%02X,%02X,%u,%u,%u,%u,%u,%u,%02X", s[0], s[1], s[2], s[3],
+                         s[4], s[5], s[6], s[7], crc8_bitwise(s));
+}
+
+} // namespace gcinput::bench::ref
@@ -0,0 +1,151 @@
+#pragma once
+#include "domain/transform/inverse_lut_data.hpp"
+#include "domain/transform/inverse_spline_data.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+// 補正ステージの参照実装
+// ファームウェア側を最適化するときの正解とするため、docs/transforms.md の定義に沿った
+// 素直な整数演算で書き、PadStateのメモリ配置にも依存させない
+namespace gcinput::bench::ref {
+
+struct Stick {
+    uint8_t x;
+    uint8_t y;
+};
+
+inline constexpr int32_t kCenter = 128;
+
+inline uint8_t clamp_u8(int32_t v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+// 原点正規化: 実ニュートラル (ox, oy) を (128, 128) に揃える
+inline Stick origin_normalize(Stick s, uint8_t ox, uint8_t oy) {
+    return {clamp_u8(s.x - ox + kCenter), clamp_u8(s.y - oy + kCenter)};
+}
+
+// C: Oct(125) への放射クランプ（Q15固定小数点、除算あり）
+inline Stick octagon_clamp(Stick s) {
+    constexpr int32_t kCos8 = 30274;
+    constexpr int32_t kSin8 = 12540;
+    constexpr int32_t kApothem = 125 * kCos8;
+
+    const int32_t px = s.x - kCenter;
+    const int32_t py = s.y - kCenter;
+    const int32_t c[4] = {
+        kCos8 * px + kSin8 * py,
+        kCos8 * px - kSin8 * py,
+        kSin8 * px + kCos8 * py,
+        kSin8 * px - kCos8 * py,
+    };
+    int32_t max_abs = 0;
+    for (int32_t v : c) {
+        max_abs = std::max(max_abs, v < 0 ? -v : v);
+    }
+    if (max_abs <= kApothem) {
+        return s;
+    }
+    return {clamp_u8(px * kApothem / max_abs + kCenter),
+            clamp_u8(py * kApothem / max_abs + kCenter)};
+}
+
+// φ: k = 4/5 の線形スケーリング。0から遠ざかる向きに四捨五入（除算あり）
+inline int32_t scale_axis(int32_t p) {
+    return (p >= 0) ? (p * 4 + 2) / 5 : -(((-p) * 4 + 2) / 5);
+}
+
+inline Stick linear_scale(Stick s) {
+    return {clamp_u8(scale_axis(s.x - kCenter) + kCenter),
+            clamp_u8(scale_axis(s.y - kCenter) + kCenter)};
+}
+
+// S⁻¹⁺: 生成済みテーブルを直接参照
+inline Stick inverse_lut(Stick s) {
+    return {domain::transform::correction::kInverseLutX[s.x][s.y],
+            domain::transform::correction::kInverseLutY[s.x][s.y]};
+}
+
+// P(s) = S⁻¹⁺(φ(C(normalize(s))))
+inline Stick correction_chain(Stick s, uint8_t ox, uint8_t oy) {
+    return inverse_lut(linear_scale(octagon_clamp(origin_normalize(s, ox, oy))));
+}
+
+// S⁻¹⁺ のスプライン近似: (mx, my) の象限の制御点 4×4 に基底の重みを掛けて足す
+// 行（my方向）ごとの和を Q8 に四捨五入してから列の重みを掛け、最後に整数へ四捨五入する
+inline Stick inverse_spline(Stick s) {
+    namespace c = domain::transform::correction;
+    constexpr int32_t kSpacing = 1 << c::kSplineShift;
+    const int32_t quadrant = (s.x >= 128 ? 2 : 0) + (s.y >= 128 ? 1 : 0);
+    const int32_t lx = s.x % 128;
+    const int32_t ly = s.y % 128;
+    const int32_t i = lx / kSpacing;
+    const int32_t j = ly / kSpacing;
+    const int16_t *wx = c::kSplineWeights[lx % kSpacing];
+    const int16_t *wy = c::kSplineWeights[ly % kSpacing];
+    auto axis = [&](const auto &control) {
+        int32_t acc = 0;
+        for (int32_t p = 0; p < 4; ++p) {
+            int32_t row = 0;
+            for (int32_t q = 0; q < 4; ++q) {
+                row += wy[q] * control[quadrant][i + p][j + q];
+            }
+            acc += wx[p] * ((row + 128) >> 8);
+        }
+        return clamp_u8((acc + (1 << 19)) >> 20);
+    };
+    return {axis(c::kSplineX), axis(c::kSplineY)};
+}
+
+inline Stick spline_chain(Stick s, uint8_t ox, uint8_t oy) {
+    return inverse_spline(linear_scale(octagon_clamp(origin_normalize(s, ox, oy))));
+}
+
+// S⁻¹⁺ の導出: tools/generate_inverse_lut.py の build_inverse と bfs_fill をそのまま写したもの
+// forward[sx*256+sy] が計測した S(s)。戻り値は [mx*256+my] の原像。シードがなければ空
+inline std::vector<Stick> build_inverse(const std::vector<std::optional<Stick>> &forward) {
+    constexpr int32_t kN = 256;
+    std::vector<std::optional<Stick>> inv(kN * kN);
+    for (int32_t sx = 0; sx < kN; ++sx) {
+        for (int32_t sy = 0; sy < kN; ++sy) {
+            const auto &entry = forward[sx * kN + sy];
+            if (entry) {
+                inv[entry->x * kN + entry->y] =
+                    Stick{static_cast<uint8_t>(sx), static_cast<uint8_t>(sy)};
+            }
+        }
+    }
+
+    std::deque<int32_t> queue;
+    for (int32_t m = 0; m < kN * kN; ++m) {
+        if (inv[m]) {
+            queue.push_back(m);
+        }
+    }
+    if (queue.empty()) {
+        return {};
+    }
+    constexpr int32_t kDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    while (!queue.empty()) {
+        const int32_t m = queue.front();
+        queue.pop_front();
+        for (const auto &[dx, dy] : kDirections) {
+            const int32_t nx = m / kN + dx;
+            const int32_t ny = m % kN + dy;
+            if (0 <= nx && nx < kN && 0 <= ny && ny < kN && !inv[nx * kN + ny]) {
+                inv[nx * kN + ny] = inv[m];
+                queue.push_back(nx * kN + ny);
+            }
+        }
+    }
+
+    std::vector<Stick> result;
+    result.reserve(inv.size());
+    for (const auto &cell : inv) {
+        result.push_back(*cell);
+    }
+    return result;
+}
+
+} // namespace gcinput::bench::ref
@@ -0,0 +1,123 @@
+#include "harness.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+// host_bench / measure_bench 共通のコマンドライン
+// 使い方:
+//   host_bench                     等価性検証のあと全ベンチマークを実行
+//   host_bench --check-only        等価性検証のみ（ctestから実行）
+//   host_bench --bench-only        ベンチマークのみ
+//   host_bench --filter codec/     名前に部分一致するものだけ実行
+//   host_bench --only <name>       名前が完全一致する1件だけ実行（qemu-armでの命令数計測用）
+//   host_bench --reps 20           ベンチマークの繰り返し回数（最小値を採用）
+
+namespace {
+using namespace gcinput::bench;
+
+struct Options {
+    bool run_checks{true};
+    bool run_benches{true};
+    std::string_view filter{};
+    std::string_view only{};
+    uint32_t reps{10};
+};
+
+void print_usage(const char *argv0) {
+    std::printf("usage: %s [--check-only | --bench-only] [--filter SUBSTR] [--only NAME] "
+                "[--reps N]\n",
+                argv0);
+}
+
+bool parse_options(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        const bool has_value = i + 1 < argc;
+        if (arg == "--check-only") {
+            opt.run_benches = false;
+        } else if (arg == "--bench-only") {
+            opt.run_checks = false;
+        } else if (arg == "--filter" && has_value) {
+            opt.filter = argv[++i];
+        } else if (arg == "--only" && has_value) {
+            opt.only = argv[++i];
+        } else if (arg == "--reps" && has_value) {
+            opt.reps = static_cast<uint32_t>(std::max(1L, std::strtol(argv[++i], nullptr, 10)));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool selected(const char *name, const Options &opt) {
+    if (!opt.only.empty()) {
+        return opt.only == name;
+    }
+    return name_matches(name, opt.filter);
+}
+
+// 失敗した検証の数を返す
+uint32_t run_checks(const Registry &registry, const Options &opt) {
+    uint32_t failed = 0;
+    for (const auto &c : registry.checks()) {
+        if (!selected(c.name, opt)) {
+            continue;
+        }
+        const bool ok = c.run();
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", c.name);
+        if (!ok) {
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+void run_benches(const Registry &registry, const Options &opt) {
+    for (const auto &b : registry.benches()) {
+        if (!selected(b.name, opt)) {
+            continue;
+        }
+        // 1回目は入力テーブルの構築とキャッシュの温めを兼ねる
+        g_sink = g_sink + b.run();
+        uint64_t best = UINT64_MAX;
+        for (uint32_t r = 0; r < opt.reps; ++r) {
+            const uint64_t t0 = now_ns();
+            g_sink = g_sink + b.run();
+            best = std::min(best, now_ns() - t0);
+        }
+        std::printf("%-36s %8.2f ns/op\n", b.name,
+                    static_cast<double>(best) / static_cast<double>(b.ops));
+    }
+}
+
+} // namespace
+
+namespace gcinput::bench {
+
+int run_host_bench(int argc, char **argv, void (*register_suites)(Registry &registry)) {
+    Options opt{};
+    if (!parse_options(argc, argv, opt)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    Registry registry{};
+    register_suites(registry);
+
+    if (opt.run_checks) {
+        const uint32_t failed = run_checks(registry, opt);
+        if (failed != 0) {
+            std::printf("%u check(s) failed\n", failed);
+            return 1;
+        }
+    }
+    if (opt.run_benches) {
+        run_benches(registry, opt);
+    }
+    return 0;
+}
+
+} // namespace gcinput::bench
@@ -0,0 +1,289 @@
+#include "domain/state.hpp"
+#include "harness.hpp"
+#include "joybus/codec/state_wire.hpp"
+#include "reference/state_wire_ref.hpp"
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace gcinput::bench {
+namespace {
+namespace state_wire = joybus::state_wire;
+using joybus::PollMode;
+
+constexpr std::array<PollMode, 5> kPollModes{PollMode::Mode0, PollMode::Mode1, PollMode::Mode2,
+                                             PollMode::Mode3, PollMode::Mode4};
+
+constexpr std::array<domain::PadButton, 12> kButtons{
+    domain::PadButton::A,         domain::PadButton::B,        domain::PadButton::X,
+    domain::PadButton::Y,         domain::PadButton::Start,    domain::PadButton::DpadLeft,
+    domain::PadButton::DpadRight, domain::PadButton::DpadDown, domain::PadButton::DpadUp,
+    domain::PadButton::Z,         domain::PadButton::R,        domain::PadButton::L,
+};
+
+// 入力インデックスから決定的に散らばった値を作る（Status wordとスティック以外のバイト用）
+constexpr uint32_t mix(uint32_t v) {
+    v ^= v >> 16;
+    v *= 0x7feb352du;
+    v ^= v >> 15;
+    v *= 0x846ca68bu;
+    v ^= v >> 16;
+    return v;
+}
+
+// 主スティックがインデックスiに対応し、残りのバイトが疑似乱数のStatusレスポンス
+std::array<uint8_t, 8> make_status_frame(uint32_t i) {
+    const uint32_t h0 = mix(i);
+    const uint32_t h1 = mix(i ^ 0x9e3779b9u);
+    return {
+        static_cast<uint8_t>(h0),       static_cast<uint8_t>(h0 >> 8),
+        static_cast<uint8_t>(i >> 8),   static_cast<uint8_t>(i),
+        static_cast<uint8_t>(h0 >> 16), static_cast<uint8_t>(h0 >> 24),
+        static_cast<uint8_t>(h1),       static_cast<uint8_t>(h1 >> 8),
+    };
+}
+
+std::array<uint8_t, 10> make_origin_frame(uint32_t i) {
+    const auto status = make_status_frame(i);
+    const uint32_t h2 = mix(i ^ 0x85ebca6bu);
+    std::array<uint8_t, 10> out{};
+    std::copy(status.begin(), status.end(), out.begin());
+    out[8] = static_cast<uint8_t>(h2);
+    out[9] = static_cast<uint8_t>(h2 >> 8);
+    return out;
+}
+
+bool same_bytes(std::span<const uint8_t> got, std::span<const uint8_t> want) {
+    return got.size() == want.size() && std::equal(got.begin(), got.end(), want.begin());
+}
+
+void report_bytes(MismatchReporter &reporter, uint32_t i, PollMode mode,
+                  std::span<const uint8_t> got, std::span<const uint8_t> want) {
+    auto at = [](std::span<const uint8_t> s, std::size_t n) -> unsigned {
+        return n < s.size() ? s[n] : 0xFFFu;
+    };
+    reporter.report("i=%u mode=%u got=%02X%02X %02X%02X %02X%02X %02X%02X want=%02X%02X "
+                    "%02X%02X %02X%02X %02X%02X",
+                    i, static_cast<unsigned>(mode), at(got, 0), at(got, 1), at(got, 2),
+                    at(got, 3), at(got, 4), at(got, 5), at(got, 6), at(got, 7), at(want, 0),
+                    at(want, 1), at(want, 2), at(want, 3), at(want, 4), at(want, 5), at(want, 6),
+                    at(want, 7));
+}
+
+bool same_fields(const domain::PadState &state, const ref::Pad &pad) {
+    const auto &analog = state.input.analog;
+    const std::array<bool, 12> want_buttons{
+        pad.a,          pad.b,         pad.x,     pad.y, pad.start, pad.dpad_left,
+        pad.dpad_right, pad.dpad_down, pad.dpad_up, pad.z, pad.r,     pad.l,
+    };
+    for (std::size_t b = 0; b < kButtons.size(); ++b) {
+        if (state.input.pressed(kButtons[b]) != want_buttons[b]) {
+            return false;
+        }
+    }
+    return analog.stick_x == pad.stick_x && analog.stick_y == pad.stick_y &&
+           analog.c_stick_x == pad.c_stick_x && analog.c_stick_y == pad.c_stick_y &&
+           analog.l_analog == pad.l_analog && analog.r_analog == pad.r_analog &&
+           analog.a_analog == pad.a_analog && analog.b_analog == pad.b_analog;
+}
+
+// Statusレスポンスのデコード結果と、同じPollModeでの再エンコード結果を参照実装と比較
+bool check_decode_status() {
+    MismatchReporter reporter{"decode_status"};
+    for (const PollMode mode : kPollModes) {
+        for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+            const auto frame = make_status_frame(i);
+            const auto state = state_wire::decode_status(
+                std::span<const uint8_t, joybus::kStatusResponseSize>{frame}, mode);
+            const auto pad = ref::decode_status(frame, static_cast<uint8_t>(mode));
+            if (!same_fields(state, pad)) {
+                reporter.report("i=%u mode=%u decoded fields differ", i,
+                                static_cast<unsigned>(mode));
+                continue;
+            }
+            const auto got = state_wire::encode_status(state, mode);
+            const auto want = ref::encode_status(pad, static_cast<uint8_t>(mode));
+            if (!same_bytes(got.view(), want)) {
+                report_bytes(reporter, i, mode, got.view(), want);
+            }
+        }
+    }
+    return reporter.ok();
+}
+
+// 全フィールドが埋まった状態（Origin由来）を各PollModeへエンコードして比較
+bool check_encode_status() {
+    MismatchReporter reporter{"encode_status"};
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const auto frame = make_origin_frame(i);
+        const auto state = state_wire::decode_origin(
+            std::span<const uint8_t, joybus::kOriginResponseSize>{frame});
+        const auto pad = ref::decode_origin(frame);
+        for (const PollMode mode : kPollModes) {
+            const auto got = state_wire::encode_status(state, mode);
+            const auto want = ref::encode_status(pad, static_cast<uint8_t>(mode));
+            if (!same_bytes(got.view(), want)) {
+                report_bytes(reporter, i, mode, got.view(), want);
+            }
+        }
+    }
+    return reporter.ok();
+}
+
+bool check_origin() {
+    MismatchReporter reporter{"origin"};
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const auto frame = make_origin_frame(i);
+        const auto state = state_wire::decode_origin(
+            std::span<const uint8_t, joybus::kOriginResponseSize>{frame});
+        const auto pad = ref::decode_origin(frame);
+        if (!same_fields(state, pad)) {
+            reporter.report("i=%u decoded fields differ", i);
+            continue;
+        }
+        const auto got = state_wire::encode_origin(state);
+        const auto want = ref::encode_origin(pad);
+        if (!same_bytes(got.view(), want)) {
+            report_bytes(reporter, i, PollMode::Mode3, got.view(), want);
+        }
+    }
+    return reporter.ok();
+}
+
+// ── 計時 ──
+
+const std::vector<std::array<uint8_t, 8>> &status_frames() {
+    static const std::vector<std::array<uint8_t, 8>> frames = [] {
+        std::vector<std::array<uint8_t, 8>> v(kAllStickInputs);
+        for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+            v[i] = make_status_frame(i);
+        }
+        return v;
+    }();
+    return frames;
+}
+
+const std::vector<std::array<uint8_t, 10>> &origin_frames() {
+    static const std::vector<std::array<uint8_t, 10>> frames = [] {
+        std::vector<std::array<uint8_t, 10>> v(kAllStickInputs);
+        for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+            v[i] = make_origin_frame(i);
+        }
+        return v;
+    }();
+    return frames;
+}
+
+const std::vector<domain::PadState> &full_states() {
+    static const std::vector<domain::PadState> states = [] {
+        std::vector<domain::PadState> v(kAllStickInputs);
+        const auto &frames = origin_frames();
+        for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+            v[i] = state_wire::decode_origin(
+                std::span<const uint8_t, joybus::kOriginResponseSize>{frames[i]});
+        }
+        return v;
+    }();
+    return states;
+}
+
+template <PollMode Mode> uint32_t bench_decode_status() {
+    uint32_t sum = 0;
+    for (const auto &frame : status_frames()) {
+        const auto state = state_wire::decode_status(
+            std::span<const uint8_t, joybus::kStatusResponseSize>{frame}, Mode);
+        sum += state.input.analog.c_stick_x + state.input.analog.l_analog +
+               static_cast<uint32_t>(state.input.pressed(domain::PadButton::A));
+    }
+    return sum;
+}
+
+template <PollMode Mode> uint32_t bench_encode_status() {
+    uint32_t sum = 0;
+    for (const auto &state : full_states()) {
+        const auto reply = state_wire::encode_status(state, Mode);
+        const auto view = reply.view();
+        sum += view[0] + view[4] + view[7];
+    }
+    return sum;
+}
+
+uint32_t bench_encode_status_as_mode3() {
+    uint32_t sum = 0;
+    std::array<uint8_t, joybus::kStatusResponseSize> out{};
+    for (const auto &state : full_states()) {
+        state_wire::encode_status_bytes_as<PollMode::Mode3>(state.input, out);
+        sum += out[0] + out[4] + out[7];
+    }
+    return sum;
+}
+
+uint32_t bench_decode_origin() {
+    uint32_t sum = 0;
+    for (const auto &frame : origin_frames()) {
+        const auto state = state_wire::decode_origin(
+            std::span<const uint8_t, joybus::kOriginResponseSize>{frame});
+        sum += state.input.analog.b_analog +
+               static_cast<uint32_t>(state.input.pressed(domain::PadButton::L));
+    }
+    return sum;
+}
+
+uint32_t bench_encode_origin() {
+    uint32_t sum = 0;
+    for (const auto &state : full_states()) {
+        const auto reply = state_wire::encode_origin(state);
+        const auto view = reply.view();
+        sum += view[0] + view[9];
+    }
+    return sum;
+}
+
+// パッドへMode3で問い合わせた応答をコンソール指定のPollModeへ詰め替える（ConsoleClientの経路）
+template <PollMode Mode> uint32_t bench_status_relay() {
+    uint32_t sum = 0;
+    for (const auto &frame : status_frames()) {
+        const auto state = state_wire::decode_status(
+            std::span<const uint8_t, joybus::kStatusResponseSize>{frame}, PollMode::Mode3);
+        const auto reply = state_wire::encode_status(state, Mode);
+        sum += reply.view()[1] + reply.view()[6];
+    }
+    return sum;
+}
+
+uint32_t bench_ref_status_relay() {
+    uint32_t sum = 0;
+    for (const auto &frame : status_frames()) {
+        const auto out = ref::encode_status(ref::decode_status(frame, 3), 3);
+        sum += out[1] + out[6];
+    }
+    return sum;
+}
+
+} // namespace
+
+void register_codec_suite(Registry &registry) {
+    registry.add(CheckCase{"codec/decode_status", &check_decode_status});
+    registry.add(CheckCase{"codec/encode_status", &check_encode_status});
+    registry.add(CheckCase{"codec/origin", &check_origin});
+
+    registry.add(BenchCase{"codec/decode_status/mode0", &bench_decode_status<PollMode::Mode0>});
+    registry.add(BenchCase{"codec/decode_status/mode1", &bench_decode_status<PollMode::Mode1>});
+    registry.add(BenchCase{"codec/decode_status/mode2", &bench_decode_status<PollMode::Mode2>});
+    registry.add(BenchCase{"codec/decode_status/mode3", &bench_decode_status<PollMode::Mode3>});
+    registry.add(BenchCase{"codec/decode_status/mode4", &bench_decode_status<PollMode::Mode4>});
+    registry.add(BenchCase{"codec/encode_status/mode0", &bench_encode_status<PollMode::Mode0>});
+    registry.add(BenchCase{"codec/encode_status/mode1", &bench_encode_status<PollMode::Mode1>});
+    registry.add(BenchCase{"codec/encode_status/mode2", &bench_encode_status<PollMode::Mode2>});
+    registry.add(BenchCase{"codec/encode_status/mode3", &bench_encode_status<PollMode::Mode3>});
+    registry.add(BenchCase{"codec/encode_status/mode4", &bench_encode_status<PollMode::Mode4>});
+    registry.add(BenchCase{"codec/encode_status_as/mode3", &bench_encode_status_as_mode3});
+    registry.add(BenchCase{"codec/decode_origin", &bench_decode_origin});
+    registry.add(BenchCase{"codec/encode_origin", &bench_encode_origin});
+    registry.add(BenchCase{"codec/status_relay/mode0", &bench_status_relay<PollMode::Mode0>});
+    registry.add(BenchCase{"codec/status_relay/mode3", &bench_status_relay<PollMode::Mode3>});
+    registry.add(BenchCase{"ref/status_relay/mode3", &bench_ref_status_relay});
+}
+
+} // namespace gcinput::bench
@@ -0,0 +1,435 @@
+#include "domain/state.hpp"
+#include "harness.hpp"
+#include "measure/adaptive_plan.hpp"
+#include "measure/patterns/adaptive_stick_sweep.hpp"
+#include "measure/patterns/stick_grid_sweep.hpp"
+#include "measure/patterns/traversal.hpp"
+#include "measure/plan_receiver.hpp"
+#include "measure/settling.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gcinput::bench {
+namespace {
+using measure::AdaptivePlan;
+using measure::AdaptiveStickSweep;
+using measure::RefineCell;
+using measure::StickGridSweep;
+using measure::TraversalOrder;
+using measure::Uint8Range;
+
+constexpr std::array<TraversalOrder, 4> kOrders{
+    TraversalOrder::RowMajor,
+    TraversalOrder::Serpentine,
+    TraversalOrder::Hilbert,
+    TraversalOrder::Morton,
+};
+
+// 正方形（2の冪とそうでないもの）、長方形、片方が1点だけのもの、刻みのあるもの
+constexpr std::array<std::array<Uint8Range, 2>, 10> kRanges{{
+    {{{0, 255, 1}, {0, 255, 1}}},
+    {{{0, 255, 4}, {0, 255, 4}}},
+    {{{10, 14, 1}, {20, 24, 1}}},
+    {{{0, 199, 1}, {0, 199, 1}}},
+    {{{3, 9, 1}, {0, 2, 1}}},
+    {{{0, 255, 16}, {100, 160, 3}}},
+    {{{128, 128, 1}, {0, 255, 1}}},
+    {{{0, 255, 1}, {7, 7, 1}}},
+    {{{5, 5, 1}, {9, 9, 1}}},
+    {{{0, 1, 1}, {0, 1, 1}}},
+}};
+
+struct Visit {
+    uint32_t position; // 出す前のposition()
+    uint8_t x;
+    uint8_t y;
+};
+
+// loopなしで最後までたどる
+template <class Pattern> std::vector<Visit> walk(Pattern &sweep) {
+    std::vector<Visit> visits;
+    domain::PadState state{};
+    while (true) {
+        const uint32_t position = sweep.position();
+        if (!sweep.sample_and_advance(state, 1)) {
+            return visits;
+        }
+        visits.push_back({position, state.input.analog.stick_x, state.input.analog.stick_y});
+    }
+}
+
+// 各順序で、範囲の点をちょうど1回ずつ出すか、HilbertとSerpentineは常に隣（刻み1つ）へ動くか、
+// position()の位置へseek()すると同じ点から続くか
+bool check_traversal() {
+    MismatchReporter reporter{"measure/traversal"};
+    for (const auto order : kOrders) {
+        for (const auto &[rx, ry] : kRanges) {
+            const StickGridSweep::Config config{.x = rx, .y = ry, .loop = false, .order = order};
+            StickGridSweep sweep{config};
+            const std::vector<Visit> visits = walk(sweep);
+            const uint32_t nx = measure::count_range(rx);
+            const uint32_t ny = measure::count_range(ry);
+            const auto o = static_cast<unsigned>(order);
+
+            std::vector<uint8_t> seen(nx * ny);
+            bool in_range = true;
+            for (const Visit &v : visits) {
+                const uint32_t ix = (v.x - rx.begin) / rx.step;
+                const uint32_t iy = (v.y - ry.begin) / ry.step;
+                if (v.x < rx.begin || v.y < ry.begin || (v.x - rx.begin) % rx.step != 0 ||
+                    (v.y - ry.begin) % ry.step != 0 || ix >= nx || iy >= ny) {
+                    in_range = false;
+                    continue;
+                }
+                ++seen[iy * nx + ix];
+            }
+            const bool once =
+                std::all_of(seen.begin(), seen.end(), [](uint8_t n) { return n == 1; });
+            if (!in_range || !once || visits.size() != sweep.total_steps()) {
+                reporter.report("order=%u range=%ux%u visits=%zu total=%u in_range=%d once=%d", o,
+                                nx, ny, visits.size(), sweep.total_steps(), in_range, once);
+                continue;
+            }
+
+            if (order == TraversalOrder::Hilbert || order == TraversalOrder::Serpentine) {
+                for (std::size_t i = 1; i < visits.size(); ++i) {
+                    const int dx = std::abs(visits[i].x - visits[i - 1].x) / rx.step;
+                    const int dy = std::abs(visits[i].y - visits[i - 1].y) / ry.step;
+                    if (dx + dy != 1) {
+                        reporter.report("order=%u range=%ux%u step %zu jumps (%d,%d)", o, nx, ny,
+                                        i, dx, dy);
+                        break;
+                    }
+                }
+            }
+
+            // 途中の位置から再開しても同じ点が続く
+            for (const std::size_t i : {std::size_t{0}, visits.size() / 3, visits.size() - 1}) {
+                StickGridSweep resumed{config};
+                domain::PadState state{};
+                if (!resumed.seek(visits[i].position) || !resumed.sample_and_advance(state, 1) ||
+                    state.input.analog.stick_x != visits[i].x ||
+                    state.input.analog.stick_y != visits[i].y) {
+                    reporter.report("order=%u range=%ux%u seek %u", o, nx, ny, visits[i].position);
+                }
+            }
+            // 最後の点の後は終わり、loopなら最初の点へ戻る
+            StickGridSweep looped{StickGridSweep::Config{
+                .x = rx, .y = ry, .loop = true, .order = order}};
+            domain::PadState state{};
+            for (std::size_t i = 0; i <= visits.size(); ++i) {
+                looped.sample_and_advance(state, 1);
+            }
+            if (state.input.analog.stick_x != visits[0].x ||
+                state.input.analog.stick_y != visits[0].y) {
+                reporter.report("order=%u range=%ux%u loop", o, nx, ny);
+            }
+            if (sweep.seek(UINT32_MAX)) {
+                reporter.report("order=%u range=%ux%u seek past end", o, nx, ny);
+            }
+        }
+    }
+    return reporter.ok();
+}
+
+// ─── 適応走査 ───
+
+// 細分の段の位置（AdaptiveStickSweep::position()の最上位ビット）
+constexpr uint32_t kRefineBit = 0x8000'0000u;
+
+// 適応走査が出すはずの点の列。格子を行ごとに反転してたどり、マスを先頭から、
+// マスの中も行ごとに反転してたどる。マスの中の格子の点は飛ばす
+std::vector<std::array<uint8_t, 2>> adaptive_reference(uint32_t coarse_step,
+                                                       std::span<const RefineCell> cells) {
+    std::vector<std::array<uint8_t, 2>> points;
+    const uint32_t n = 256 / coarse_step + 1;
+    const auto value = [&](uint32_t i) {
+        return static_cast<uint8_t>(std::min(i * coarse_step, 255u));
+    };
+    for (uint32_t row = 0; row < n; ++row) {
+        for (uint32_t c = 0; c < n; ++c) {
+            points.push_back({value(row % 2 == 0 ? c : n - 1 - c), value(row)});
+        }
+    }
+    const auto on_grid = [&](uint32_t v) { return v % coarse_step == 0 || v == 255; };
+    for (const RefineCell &cell : cells) {
+        const uint32_t per_axis = cell.size / cell.step;
+        for (uint32_t row = 0; row < per_axis; ++row) {
+            for (uint32_t c = 0; c < per_axis; ++c) {
+                const uint32_t px = cell.x0 + (row % 2 == 0 ? c : per_axis - 1 - c) * cell.step;
+                const uint32_t py = cell.y0 + row * cell.step;
+                if (!(on_grid(px) && on_grid(py))) {
+                    points.push_back({static_cast<uint8_t>(px), static_cast<uint8_t>(py)});
+                }
+            }
+        }
+    }
+    return points;
+}
+
+void load_plan(AdaptivePlan &plan, std::span<const RefineCell> cells) {
+    plan.begin();
+    for (const RefineCell &cell : cells) {
+        plan.add(cell);
+    }
+    plan.commit(cells.size());
+}
+
+// 出した点の列が参照と一致するか、position()の位置へseek()すると同じ点から続くか
+bool check_adaptive_walk(MismatchReporter &reporter, const char *label,
+                         const AdaptiveStickSweep::Config &config,
+                         std::span<const RefineCell> cells, std::size_t seek_stride) {
+    AdaptiveStickSweep sweep{config};
+    const std::vector<Visit> visits = walk(sweep);
+    const auto want = adaptive_reference(config.coarse_step, cells);
+    if (visits.size() != want.size()) {
+        reporter.report("%s: visits=%zu want=%zu", label, visits.size(), want.size());
+        return false;
+    }
+    for (std::size_t i = 0; i < visits.size(); ++i) {
+        if (visits[i].x != want[i][0] || visits[i].y != want[i][1]) {
+            reporter.report("%s: #%zu got=(%u,%u) want=(%u,%u)", label, i, visits[i].x,
+                            visits[i].y, want[i][0], want[i][1]);
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < visits.size(); i += seek_stride) {
+        for (const std::size_t j : {i, visits.size() - 1 - i}) {
+            AdaptiveStickSweep resumed{config};
+            domain::PadState state{};
+            if (!resumed.seek(visits[j].position) || !resumed.sample_and_advance(state, 1) ||
+                state.input.analog.stick_x != visits[j].x ||
+                state.input.analog.stick_y != visits[j].y) {
+                reporter.report("%s: seek #%zu position=%08x", label, j, visits[j].position);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool check_adaptive_sweep() {
+    MismatchReporter reporter{"measure/adaptive_sweep"};
+
+    // 優先リストがなければ、格子の後に残りの全点を1回ずつ
+    {
+        const AdaptiveStickSweep::Config config{.coarse_step = 16};
+        constexpr RefineCell kAll{.x0 = 0, .y0 = 0, .size = 256, .step = 1};
+        check_adaptive_walk(reporter, "no plan", config, std::span(&kAll, 1), 997);
+        AdaptiveStickSweep sweep{config};
+        std::vector<uint8_t> seen(kAllStickInputs);
+        for (const Visit &v : walk(sweep)) {
+            ++seen[(v.y << 8) | v.x];
+        }
+        if (!std::all_of(seen.begin(), seen.end(), [](uint8_t n) { return n == 1; })) {
+            reporter.report("no plan: points not visited exactly once");
+        }
+    }
+
+    // 優先リストのマスだけを細かく。格子と重なる点と、255の列と行の扱い
+    constexpr std::array<RefineCell, 4> kCells{{
+        {.x0 = 0, .y0 = 0, .size = 32, .step = 4},
+        {.x0 = 64, .y0 = 64, .size = 16, .step = 1},
+        {.x0 = 240, .y0 = 240, .size = 16, .step = 2},
+        {.x0 = 128, .y0 = 0, .size = 2, .step = 1},
+    }};
+    AdaptivePlan plan{};
+    load_plan(plan, kCells);
+    for (const uint8_t coarse_step : {uint8_t{16}, uint8_t{64}}) {
+        const AdaptiveStickSweep::Config config{.coarse_step = coarse_step, .plan = &plan};
+        check_adaptive_walk(reporter, coarse_step == 16 ? "plan/16" : "plan/64", config, kCells,
+                            7);
+    }
+
+    // 範囲外の位置へは移らない
+    const AdaptiveStickSweep::Config config{.coarse_step = 16, .plan = &plan};
+    AdaptiveStickSweep sweep{config};
+    const uint32_t coarse_points = 17 * 17;
+    const uint32_t bad[] = {
+        coarse_points + 1,
+        kRefineBit | (0u << 16) | 64u,                     // マス0は64点
+        kRefineBit | (uint32_t{kCells.size()} << 16) | 1u, // 終わりの次は0点目だけ
+        kRefineBit | ((uint32_t{kCells.size()} + 1) << 16),
+    };
+    for (const uint32_t position : bad) {
+        if (sweep.seek(position)) {
+            reporter.report("seek accepted %08x", position);
+        }
+    }
+
+    // loopなら最後の点の後に格子の先頭へ戻る
+    {
+        AdaptiveStickSweep looped{AdaptiveStickSweep::Config{
+            .coarse_step = 16, .loop = true, .plan = &plan}};
+        const std::size_t count = adaptive_reference(16, kCells).size();
+        domain::PadState state{};
+        for (std::size_t i = 0; i <= count; ++i) {
+            looped.sample_and_advance(state, 1);
+        }
+        if (state.input.analog.stick_x != 0 || state.input.analog.stick_y != 0 ||
+            looped.refining()) {
+            reporter.report("loop: got=(%u,%u)", state.input.analog.stick_x,
+                            state.input.analog.stick_y);
+        }
+    }
+
+    // 細分の途中で計画が差し替わったら、新しいリストの先頭からやり直す
+    // fingerprintは計画の中身で決まり、同じリストを送り直せば戻る
+    {
+        const uint32_t fingerprint = sweep.fingerprint();
+        domain::PadState state{};
+        for (uint32_t i = 0; i < coarse_points + 3; ++i) {
+            sweep.sample_and_advance(state, 1);
+        }
+        constexpr std::array<RefineCell, 1> kNext{{{.x0 = 32, .y0 = 96, .size = 4, .step = 1}}};
+        load_plan(plan, kNext);
+        sweep.sample_and_advance(state, 1);
+        if (!sweep.refining() || state.input.analog.stick_x != 33 ||
+            state.input.analog.stick_y != 96 || sweep.fingerprint() == fingerprint) {
+            reporter.report("plan swap: got=(%u,%u) refining=%d", state.input.analog.stick_x,
+                            state.input.analog.stick_y, sweep.refining());
+        }
+        load_plan(plan, kCells);
+        if (sweep.fingerprint() != fingerprint) {
+            reporter.report("plan digest changed after re-sending the same list");
+        }
+    }
+    return reporter.ok();
+}
+
+// 文字列を1文字ずつ渡し、None以外のイベントを集める
+std::vector<measure::PlanReceiver::Event> feed_plan(measure::PlanReceiver &receiver,
+                                                    std::string_view text) {
+    std::vector<measure::PlanReceiver::Event> events;
+    for (const char c : text) {
+        const auto event = receiver.feed(c);
+        if (event != measure::PlanReceiver::Event::None) {
+            events.push_back(event);
+        }
+    }
+    return events;
+}
+
+bool check_plan_receiver() {
+    using Event = measure::PlanReceiver::Event;
+    MismatchReporter reporter{"measure/plan_receiver"};
+    struct Case {
+        const char *name;
+        std::string_view text;
+        std::vector<Event> events;
+        std::size_t cells; // 有効になった計画のマスの数（なければ0）
+    };
+    const std::string_view too_long = "C,0,0,32,4,0000000000000000000000000\n";
+    const std::vector<Case> cases{
+        {"ok", "P\nC,0,0,32,4\nC,64,64,16,1\nE,2\n", {Event::Begun, Event::Committed}, 2},
+        {"crlf", "P\r\nC,240,240,16,2\r\nE,1\r\n", {Event::Begun, Event::Committed}, 1},
+        {"host command", "P\nV,1,128,128\nC,0,0,32,4\nX\n\nE,1\n",
+         {Event::Begun, Event::Committed}, 1},
+        {"empty plan", "P\nE,0\n", {Event::Begun, Event::Committed}, 0},
+        {"count", "P\nC,0,0,32,4\nE,2\n", {Event::Begun, Event::Rejected}, 0},
+        {"size", "P\nC,0,0,24,4\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"step", "P\nC,0,0,32,64\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"edge", "P\nC,250,0,16,1\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"range", "P\nC,300,0,2,1\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"fields", "P\nC,0,0,32\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"number", "P\nC,a,0,32,4\nE,1\n", {Event::Begun, Event::Rejected}, 0},
+        {"unknown", "P\nQ\nE,0\n", {Event::Begun, Event::Rejected}, 0},
+        {"no begin", "C,0,0,32,4\nE,1\n", {}, 0},
+        {"restart", "P\nC,0,0,24,4\nC,0,0,32,4\nE,1\nP\nC,0,0,32,4\nE,1\n",
+         {Event::Begun, Event::Rejected, Event::Begun, Event::Committed}, 1},
+    };
+    for (const Case &c : cases) {
+        AdaptivePlan plan{};
+        measure::PlanReceiver receiver{plan};
+        const auto events = feed_plan(receiver, c.text);
+        const bool loaded = c.events.size() >= 1 && c.events.back() == Event::Committed;
+        if (events != c.events || plan.loaded() != loaded || plan.cells().size() != c.cells ||
+            receiver.receiving()) {
+            reporter.report("%s: events=%zu loaded=%d cells=%zu", c.name, events.size(),
+                            plan.loaded(), plan.cells().size());
+        }
+    }
+
+    // 長すぎる行は受け取りを止める。マスの値はそのまま入る
+    AdaptivePlan plan{};
+    measure::PlanReceiver receiver{plan};
+    feed_plan(receiver, "P\n");
+    if (feed_plan(receiver, too_long) != std::vector<Event>{Event::Rejected}) {
+        reporter.report("long line not rejected");
+    }
+    feed_plan(receiver, "P\nC,64,128,16,2\nE,1\n");
+    const auto cells = plan.cells();
+    if (cells.size() != 1 || cells[0].x0 != 64 || cells[0].y0 != 128 || cells[0].size != 16 ||
+        cells[0].step != 2 || receiver.received() != 1) {
+        reporter.report("cell values");
+    }
+
+    // 受け取りの途中や捨てたときも、前の計画とgenerationをそのまま使う
+    AdaptivePlan kept{};
+    measure::PlanReceiver kept_receiver{kept};
+    feed_plan(kept_receiver, "P\nC,0,0,32,4\nC,64,64,16,1\nE,2\n");
+    const uint32_t generation = kept.generation();
+    const uint32_t digest = kept.digest();
+    const auto unchanged = [&] {
+        return kept.loaded() && kept.cells().size() == 2 && kept.cells()[1].x0 == 64 &&
+               kept.generation() == generation && kept.digest() == digest;
+    };
+    const std::array<std::pair<const char *, std::string_view>, 4> kSteps{{
+        {"receiving", "P\nC,128,128,8,1\n"},
+        {"count", "E,5\n"},
+        {"size", "P\nC,0,0,24,4\n"},
+        {"unknown", "P\nC,0,0,32,4\nQ\n"},
+    }};
+    for (const auto &[name, text] : kSteps) {
+        feed_plan(kept_receiver, text);
+        if (!unchanged()) {
+            reporter.report("%s: cells=%zu generation=%u", name, kept.cells().size(),
+                            kept.generation());
+        }
+    }
+    feed_plan(kept_receiver, "P\nC,128,128,8,1\nE,1\n");
+    if (kept.cells().size() != 1 || kept.cells()[0].x0 != 128 ||
+        kept.generation() != generation + 1) {
+        reporter.report("replace after reject: cells=%zu generation=%u", kept.cells().size(),
+                        kept.generation());
+    }
+    return reporter.ok();
+}
+
+// 隣の点はmin_frames、distance_per_frameごとに1フレーム足し、max_framesで止まる
+bool check_settling() {
+    MismatchReporter reporter{"measure/settling"};
+    const measure::SettlingModel model{.min_frames = 3, .max_frames = 10, .distance_per_frame = 32};
+    constexpr std::array<std::array<uint32_t, 2>, 7> kWant{{
+        {0, 3},
+        {1, 3},
+        {31, 3},
+        {32, 4},
+        {100, 6},
+        {224, 10},
+        {255, 10},
+    }};
+    for (const auto &[distance, frames] : kWant) {
+        if (model.frames_for(distance) != frames) {
+            reporter.report("distance=%u frames=%u want=%u", distance, model.frames_for(distance),
+                            frames);
+        }
+    }
+    return reporter.ok();
+}
+
+} // namespace
+
+void register_measure_suite(Registry &registry) {
+    registry.add(CheckCase{"measure/traversal", &check_traversal});
+    registry.add(CheckCase{"measure/settling", &check_settling});
+    registry.add(CheckCase{"measure/adaptive_sweep", &check_adaptive_sweep});
+    registry.add(CheckCase{"measure/plan_receiver", &check_plan_receiver});
+}
+
+} // namespace gcinput::bench
@@ -0,0 +1,723 @@
+#include "csv_writer.hpp"
+#include "decoder.hpp"
+#include "harness.hpp"
+#include "reference/telemetry_ref.hpp"
+#include "sniffer/edge_decoder.hpp"
+#include "telemetry/cobs.hpp"
+#include "telemetry/crc8.hpp"
+#include "telemetry/frame.hpp"
+#include "telemetry/records.hpp"
+#include "telemetry/reply_stream.hpp"
+#include "telemetry/varint.hpp"
+#include "util/timing_stats.hpp"
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace gcinput::bench {
+namespace {
+namespace tm = gcinput::telemetry;
+namespace th = gcinput::telemetry::host;
+
+constexpr uint32_t mix(uint32_t v) {
+    v ^= v >> 16;
+    v *= 0x7feb352du;
+    v ^= v >> 15;
+    v *= 0x846ca68bu;
+    v ^= v >> 16;
+    return v;
+}
+
+std::array<uint8_t, 8> make_status(uint32_t i) {
+    const uint32_t h0 = mix(i);
+    const uint32_t h1 = mix(i ^ 0x9e3779b9u);
+    return {
+        static_cast<uint8_t>(h0),       static_cast<uint8_t>(h0 >> 8),
+        static_cast<uint8_t>(i >> 8),   static_cast<uint8_t>(i),
+        static_cast<uint8_t>(h0 >> 16), static_cast<uint8_t>(h0 >> 24),
+        static_cast<uint8_t>(h1),       static_cast<uint8_t>(h1 >> 8),
+    };
+}
+
+// 表引き版CRC-8が全ての(crc, byte)でビットループ版と一致すること
+bool check_crc8() {
+    MismatchReporter reporter("telemetry/crc8");
+    for (uint32_t crc = 0; crc < 256; ++crc) {
+        for (uint32_t byte = 0; byte < 256; ++byte) {
+            // ビットループ版は初期値0固定なので、crc^byteの1バイト入力として比べる
+            const std::array<uint8_t, 1> data{static_cast<uint8_t>(crc ^ byte)};
+            const uint8_t want = ref::crc8_bitwise(data);
+            const uint8_t got =
+                tm::crc8_update(static_cast<uint8_t>(crc), static_cast<uint8_t>(byte));
+            if (got != want) {
+                reporter.report("crc=%02X byte=%02X got=%02X want=%02X", crc, byte, got, want);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const auto status = make_status(i);
+        const uint8_t want = ref::crc8_bitwise(status);
+        const uint8_t got = tm::crc8(status);
+        if (got != want) {
+            reporter.report("i=%u got=%02X want=%02X", i, got, want);
+        }
+    }
+    return reporter.ok();
+}
+
+// 0の密度と長さを変えた列でCOBSの往復と、出力に0が含まれないことを確かめる
+bool check_cobs() {
+    MismatchReporter reporter("telemetry/cobs");
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> decoded;
+    for (uint32_t length = 0; length <= 600; ++length) {
+        for (uint32_t density = 0; density < 4; ++density) {
+            in.resize(length);
+            for (uint32_t i = 0; i < length; ++i) {
+                const uint32_t h = mix(length * 4 + density + i * 977u);
+                // density 0: 0なし / 1: 1/16 / 2: 1/2 / 3: すべて0
+                const bool zero = (density == 3) || (density == 2 && (h & 1u)) ||
+                                  (density == 1 && (h & 15u) == 0);
+                in[i] = zero ? 0 : static_cast<uint8_t>((h >> 8) | 1u);
+            }
+            encoded.assign(tm::cobs::max_encoded_size(length), 0xAA);
+            const std::size_t n = tm::cobs::encode(in, encoded);
+            if (n == 0 || n > encoded.size()) {
+                reporter.report("len=%u density=%u encode failed", length, density);
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                if (encoded[i] == 0) {
+                    reporter.report("len=%u density=%u zero at %zu", length, density, i);
+                    break;
+                }
+            }
+            decoded.assign(length + 1, 0);
+            std::size_t decoded_length = 0;
+            if (!tm::cobs::decode(std::span<const uint8_t>(encoded.data(), n), decoded,
+                                  decoded_length) ||
+                decoded_length != length ||
+                !std::equal(in.begin(), in.end(), decoded.begin())) {
+                reporter.report("len=%u density=%u roundtrip mismatch", length, density);
+            }
+        }
+    }
+    return reporter.ok();
+}
+
+bool check_varint() {
+    MismatchReporter reporter("telemetry/varint");
+    std::vector<uint32_t> values{0, 1, 127, 128, 255, 16383, 16384, 0x1FFFFF, 0x200000,
+                                 0x0FFFFFFF, 0x10000000, 0xFFFFFFFFu};
+    for (uint32_t i = 0; i < 4096; ++i) {
+        values.push_back(mix(i));
+    }
+    for (const uint32_t value : values) {
+        std::array<uint8_t, tm::varint::kMaxBytesU32> bytes{};
+        const std::size_t n = tm::varint::encode_u32(value, bytes.data());
+        uint32_t got = 0;
+        if (tm::varint::decode_u32(std::span<const uint8_t>(bytes.data(), n), got) != n ||
+            got != value) {
+            reporter.report("value=%u n=%zu got=%u", value, n, got);
+        }
+        // 1バイト欠けたら読めないこと
+        if (tm::varint::decode_u32(std::span<const uint8_t>(bytes.data(), n - 1), got) != 0) {
+            reporter.report("value=%u truncated input accepted", value);
+        }
+    }
+    return reporter.ok();
+}
+
+template <class Record>
+void append_frame(std::vector<uint8_t> &stream, const Record &record, uint32_t timestamp_us) {
+    std::array<uint8_t, tm::kMaxEncodedFrame> frame{};
+    const std::size_t n = tm::encode_frame(record, timestamp_us, frame);
+    stream.insert(stream.end(), frame.begin(), frame.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+// D/I行: フレーム→デコード→CSVが、テレメトリ導入前のprintf出力と一致すること
+bool check_legacy_lines() {
+    MismatchReporter reporter("telemetry/legacy_lines");
+    std::vector<uint8_t> stream;
+    std::vector<std::string> want;
+    std::array<char, 128> line{};
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const uint8_t first = static_cast<uint8_t>(i >> 8);
+        const uint8_t second = static_cast<uint8_t>(i);
+        append_frame(stream,
+                     tm::MeasureSampleRecord{.frame = static_cast<uint16_t>(i),
+                                             .first = first,
+                                             .second = second},
+                     i * 1000u);
+        ref::format_measure_line(line.data(), line.size(), i, first, second);
+        want.emplace_back(line.data());
+
+        const auto status = make_status(i);
+        append_frame(stream, tm::InputSampleRecord{.status = status}, i * 1000u + 500u);
+        ref::format_input_line(line.data(), line.size(), status);
+        want.emplace_back(line.data());
+    }
+
+    th::StreamDecoder decoder{};
+    std::size_t index = 0;
+    decoder.feed(stream, [&](const th::DecodedRecord &r) {
+        const std::string got = th::to_csv_line(r);
+        if (index >= want.size() || got != want[index]) {
+            reporter.report("index=%zu got=%s want=%s", index, got.c_str(),
+                            index < want.size() ? want[index].c_str() : "(none)");
+        }
+        ++index;
+    });
+    if (index != want.size()) {
+        reporter.report("decoded %zu records, want %zu", index, want.size());
+    }
+    const auto stats = decoder.stats();
+    if (stats.frames.crc_errors || stats.frames.framing_errors || stats.malformed_payloads) {
+        reporter.report("errors crc=%u framing=%u malformed=%u", stats.frames.crc_errors,
+                        stats.frames.framing_errors, stats.malformed_payloads);
+    }
+    return reporter.ok();
+}
+
+// debug_probeなどのレコードと、途中から読み始めた場合・壊れたフレームの扱い
+bool check_probe_stream() {
+    MismatchReporter reporter("telemetry/probe_stream");
+    const std::array<uint8_t, 3> tx{0x40, 0x03, 0x00};
+    // 前のフレームの途中から受信した想定（末尾の区切りだけが揃っている）
+    std::vector<uint8_t> stream{0x12, 0x34, 0x56, 0x00};
+    append_frame(stream,
+                 tm::ProbeFrameRecord{.port = tm::ProbePort::Pad,
+                                      .dir = tm::ProbeDir::TX,
+                                      .command = 0x40,
+                                      .data = tx,
+                                      .has_poll_mode = true,
+                                      .poll_mode_pad = 3,
+                                      .poll_mode_console = 3,
+                                      .poll_mode_reply = 3},
+                 1000);
+    append_frame(stream,
+                 tm::ProbeStateRecord{.port = tm::ProbePort::Console, .text = "Idle -> Ready"},
+                 2000);
+    append_frame(stream, tm::ProbeTimeoutRecord{.port = tm::ProbePort::Pad, .text = "Status"},
+                 3000);
+    append_frame(stream,
+                 tm::ProbeSummaryRecord{.port = tm::ProbePort::Pad, .polls = 60, .ok = 59,
+                                        .timeout = 1},
+                 4000);
+    append_frame(stream,
+                 tm::ProbeCaptureRecord{.trigger = tm::ProbeTrigger::Timeout, .pre = 256,
+                                        .post = 64},
+                 4500);
+    append_frame(stream,
+                 tm::ProbeTimingRecord{.metric = tm::ProbeTimingMetric::ReplyGap, .count = 300,
+                                       .min = 3, .mean = 4, .max = 9, .p50 = 4, .p99 = 8,
+                                       .jitter = 1},
+                 4800);
+    append_frame(stream,
+                 tm::MeasureRunRecord{.event = tm::MeasureRunEvent::Resume, .run_id = 3,
+                                      .position = 0x8002'0011u, .frame = 70000},
+                 4900);
+    append_frame(stream,
+                 tm::MeasureAckRecord{.status = tm::MeasureAckStatus::Live, .seq = 42,
+                                      .console_frame = 123456, .queued = 7},
+                 4950);
+    append_frame(stream,
+                 tm::MeasureCorrectionRecord{.frame = 513, .raw_x = 255, .raw_y = 128,
+                                             .out_x = 231, .out_y = 127},
+                 4970);
+    append_frame(stream,
+                 tm::ProfileAckRecord{.status = tm::ProfileAckStatus::Activated, .slot = 2,
+                                      .offset = 135168, .crc = 0xCBF4'3926u},
+                 4980);
+    // CRCが合わないフレーム
+    const std::size_t corrupt_at = stream.size() + 2;
+    append_frame(stream, tm::TextRecord{.level = 2, .text = "corrupted"}, 5000);
+    stream[corrupt_at] ^= 0x01;
+    append_frame(stream, tm::TextRecord{.level = 2, .text = "Debug Probe firmware ready"},
+                 6000);
+
+    const std::array<std::string, 11> want{
+        "T,1000,P,T,3,40 03 00,pm=P3/C3/R3",
+        "S,2000,Idle,Ready",
+        "M,3000,P TIMEOUT Status",
+        "U,4000,P,60,59,1",
+        "X,4500,timeout,256,64",
+        "L,4800,reply_gap,300,3,4,9,4,8,1",
+        "K,4900,resume,3,2147614737,70000",
+        "A,4950,live,42,123456,7",
+        "Q,513,255,128,231,127",
+        "F,4980,activated,2,135168,CBF43926",
+        "M,6000,Debug Probe firmware ready",
+    };
+    th::StreamDecoder decoder{};
+    std::size_t index = 0;
+    decoder.feed(stream, [&](const th::DecodedRecord &r) {
+        const std::string got = th::to_csv_line(r);
+        if (index >= want.size() || got != want[index]) {
+            reporter.report("index=%zu got=%s", index, got.c_str());
+        }
+        ++index;
+    });
+    const auto stats = decoder.stats();
+    if (index != want.size() || stats.frames.crc_errors + stats.frames.framing_errors != 2) {
+        reporter.report("records=%zu crc=%u framing=%u", index, stats.frames.crc_errors,
+                        stats.frames.framing_errors);
+    }
+    return reporter.ok();
+}
+
+// TimingStats: 最小・最大・平均・ジッタは厳密値、分位点は並べ替えた厳密値からビン幅の半分以内
+// （32µs未満は厳密に一致）
+bool check_timing_stats() {
+    MismatchReporter reporter("telemetry/timing_stats");
+    // ポーリング間隔らしい値、応答の隙間らしい小さい値、広く散らばる値
+    const std::array<uint32_t, 3> bases{16'666, 4, 0};
+    const std::array<uint32_t, 3> spreads{400, 28, 1u << 22};
+    for (std::size_t set = 0; set < bases.size(); ++set) {
+        TimingStats stats{};
+        std::vector<uint32_t> values;
+        uint64_t jitter_sum = 0;
+        for (uint32_t i = 0; i < 5000; ++i) {
+            const uint32_t v = bases[set] + mix(i + static_cast<uint32_t>(set) * 7919u) %
+                                                (spreads[set] + 1);
+            if (!values.empty()) {
+                jitter_sum += (v > values.back()) ? v - values.back() : values.back() - v;
+            }
+            values.push_back(v);
+            stats.add(v);
+        }
+        uint64_t sum = 0;
+        for (uint32_t v : values) {
+            sum += v;
+        }
+        const uint32_t mean = static_cast<uint32_t>(sum / values.size());
+        const uint32_t jitter = static_cast<uint32_t>(jitter_sum / (values.size() - 1));
+        std::vector<uint32_t> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        if (stats.count() != values.size() || stats.min() != sorted.front() ||
+            stats.max() != sorted.back() || stats.mean() != mean || stats.jitter() != jitter) {
+            reporter.report("set=%zu count=%u min=%u max=%u mean=%u jitter=%u", set,
+                            stats.count(), stats.min(), stats.max(), stats.mean(),
+                            stats.jitter());
+        }
+        for (uint32_t per_mille : {1u, 100u, 500u, 900u, 990u, 999u, 1000u}) {
+            const std::size_t rank = std::max<std::size_t>(
+                1, (values.size() * per_mille + 999) / 1000);
+            const uint32_t exact = sorted[rank - 1];
+            const uint32_t got = stats.percentile(per_mille);
+            const std::size_t bucket = TimingStats::bucket_of(exact);
+            const uint32_t half_width =
+                (exact < TimingStats::kExactLimit)
+                    ? 0
+                    : (TimingStats::bucket_mid(bucket) - TimingStats::bucket_mid(bucket - 1)) / 2;
+            const uint32_t error = (got > exact) ? got - exact : exact - got;
+            if (error > half_width) {
+                reporter.report("set=%zu p%u got=%u exact=%u", set, per_mille, got, exact);
+            }
+        }
+        stats.reset();
+        if (stats.count() != 0 || stats.percentile(500) != 0 || stats.jitter() != 0) {
+            reporter.report("set=%zu reset left count=%u", set, stats.count());
+        }
+    }
+    return reporter.ok();
+}
+
+// ─── スニファ ───
+
+// 合成する波形の1フレーム（時間はサイクル）
+// スニファの語にできるようエッジの間隔は3以上の奇数にする（Low幅とgapは奇数、周期は偶数）
+struct WaveFrame {
+    std::vector<uint8_t> bytes;
+    uint32_t gap;      // 直前のフレームの終わりから
+    uint32_t one_low;  // '1'のLow幅
+    uint32_t zero_low; // '0'のLow幅
+    uint32_t period;   // ビットの周期
+    uint32_t stop_low; // ストップビットのLow幅
+};
+
+// 波形をエッジにし、期待するフレームも組み立てる。ビットごとにLow幅を2サイクル単位で揺らす
+std::vector<sniffer::Edge> make_wave(const std::vector<WaveFrame> &frames,
+                                     std::vector<sniffer::BusFrame> &want) {
+    std::vector<sniffer::Edge> edges;
+    uint32_t t = 1'000;
+    uint32_t wobble = 0;
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        const WaveFrame &w = frames[f];
+        t += w.gap;
+        sniffer::BusFrame frame{};
+        frame.start_cycles = t;
+        frame.has_gap = f > 0;
+        frame.gap = frame.has_gap ? w.gap : 0;
+        frame.bit_count = static_cast<uint32_t>(w.bytes.size() * 8);
+        frame.length = w.bytes.size();
+        std::copy(w.bytes.begin(), w.bytes.end(), frame.bytes.begin());
+        uint64_t period_sum = 0;
+        uint32_t zero_low_min = UINT32_MAX;
+        for (const uint8_t byte : w.bytes) {
+            for (int bit = 7; bit >= 0; --bit) {
+                const bool one = ((byte >> bit) & 1u) != 0;
+                const uint32_t shift = 2 * (mix(wobble++) % 3);
+                const uint32_t low = (one ? w.one_low : w.zero_low) + shift;
+                const uint32_t period = w.period + 2 * (mix(wobble++) % 2);
+                edges.push_back({t, false});
+                edges.push_back({t + low, true});
+                t += period;
+                period_sum += period;
+                if (one) {
+                    frame.one_low_max = std::max(frame.one_low_max, low);
+                } else {
+                    zero_low_min = std::min(zero_low_min, low);
+                }
+            }
+        }
+        frame.zero_low_min = (zero_low_min == UINT32_MAX) ? 0 : zero_low_min;
+        frame.bit_period = static_cast<uint32_t>(period_sum / frame.bit_count);
+        edges.push_back({t, false});
+        edges.push_back({t + w.stop_low, true});
+        t += w.stop_low;
+        frame.stop_low = w.stop_low;
+        frame.end_cycles = t;
+        want.push_back(frame);
+    }
+    return edges;
+}
+
+// エッジをスニファがpushする語へ（EdgeClockの逆）。カウンタは31ビットで一周させる
+std::vector<uint32_t> to_sniffer_words(const std::vector<sniffer::Edge> &edges) {
+    std::vector<uint32_t> words;
+    uint32_t count = 40;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (i > 0) {
+            const uint32_t delta = edges[i].cycles - edges[i - 1].cycles;
+            count -= (delta - sniffer::EdgeClock::kCyclesPerEdge) /
+                     sniffer::EdgeClock::kCyclesPerCount;
+        }
+        words.push_back(((count & sniffer::EdgeClock::kCountMask) << 1) |
+                        (edges[i].level ? 1u : 0u));
+    }
+    return words;
+}
+
+bool same_frame(const sniffer::BusFrame &a, const sniffer::BusFrame &b) {
+    return a.start_cycles == b.start_cycles && a.end_cycles == b.end_cycles &&
+           a.bit_count == b.bit_count && a.length == b.length && a.bytes == b.bytes &&
+           a.bit_period == b.bit_period && a.one_low_max == b.one_low_max &&
+           a.zero_low_min == b.zero_low_min && a.stop_low == b.stop_low &&
+           a.has_gap == b.has_gap && a.gap == b.gap;
+}
+
+// スニファの語→エッジ→フレームで、合成した波形のバイトとビットの時間がサイクル単位で戻ること
+// 本体で組み立てたB行と、生のエッジ（ProbeEdges）をホストで組み立てたB行が一致すること
+bool check_edge_decoder() {
+    MismatchReporter reporter("telemetry/edge_decoder");
+    constexpr uint32_t kClockHz = 125'000'000;
+    // 本体のStatus要求（4µs周期）→ 6µs後にこちらの応答（5µs周期）→ 16.6ms後に次の要求
+    const std::vector<WaveFrame> frames{
+        {{0x40, 0x03, 0x00}, 0, 125, 375, 500, 125},
+        {{0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x1F, 0x1F}, 751, 157, 469, 626, 251},
+        {{0x40, 0x03, 0x01}, 2'083'333, 125, 375, 500, 125},
+        {{0xFF}, 9'999, 125, 375, 500, 125},
+    };
+    std::vector<sniffer::BusFrame> want;
+    const auto edges = make_wave(frames, want);
+    const auto words = to_sniffer_words(edges);
+
+    sniffer::EdgeClock clock{};
+    sniffer::EdgeDecoder decoder{sniffer::ns_to_cycles(sniffer::kDefaultEndHighNs, kClockHz)};
+    std::vector<uint8_t> device_stream;
+    std::size_t index = 0;
+    const auto on_frame = [&](const sniffer::BusFrame &f) {
+        if (index >= want.size() || !same_frame(f, want[index])) {
+            reporter.report("frame=%zu bits=%u period=%u one=%u zero=%u stop=%u gap=%u", index,
+                            f.bit_count, f.bit_period, f.one_low_max, f.zero_low_min,
+                            f.stop_low, f.gap);
+        }
+        append_frame(device_stream, sniffer::to_record(f, tm::ProbePort::Console, kClockHz), 0);
+        ++index;
+    };
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const sniffer::Edge edge = clock.unpack(words[i]);
+        if (edge.cycles != edges[i].cycles - edges[0].cycles || edge.level != edges[i].level) {
+            reporter.report("edge=%zu cycles=%u level=%d", i, edge.cycles, edge.level);
+        }
+        // 期待値は波形の時刻なので、最初のエッジの時刻を足して比べる
+        decoder.feed(sniffer::Edge{edge.cycles + edges[0].cycles, edge.level}, on_frame);
+    }
+    decoder.finish(on_frame);
+    if (index != want.size()) {
+        reporter.report("frames=%zu want=%zu", index, want.size());
+    }
+
+    // 生のエッジを1レコード40件ずつ送る。最後のレコードで線が止まったことを伝える
+    std::vector<uint8_t> edge_stream;
+    for (std::size_t first = 0; first < edges.size(); first += 40) {
+        const std::size_t last = std::min(edges.size(), first + 40);
+        std::vector<uint8_t> deltas;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            std::array<uint8_t, tm::varint::kMaxBytesU32> buf{};
+            const std::size_t n =
+                tm::varint::encode_u32(edges[i].cycles - edges[i - 1].cycles, buf.data());
+            deltas.insert(deltas.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+        }
+        append_frame(edge_stream,
+                     tm::ProbeEdgesRecord{.port = tm::ProbePort::Console,
+                                          .first_high = edges[first].level,
+                                          .restart = first == 0,
+                                          .idle = last == edges.size(),
+                                          .clock_hz = kClockHz,
+                                          .first_cycles = edges[first].cycles,
+                                          .count = static_cast<uint32_t>(last - first),
+                                          .deltas = deltas},
+                     0);
+    }
+
+    std::vector<std::string> device_lines;
+    th::StreamDecoder device_decoder{};
+    device_decoder.feed(device_stream, [&](const th::DecodedRecord &r) {
+        device_lines.push_back(th::to_csv_line(r));
+    });
+    std::vector<std::string> host_lines;
+    th::StreamDecoder host_decoder{};
+    host_decoder.feed(edge_stream, [&](const th::DecodedRecord &r) {
+        host_lines.push_back(th::to_csv_line(r));
+    });
+    if (host_lines.size() != want.size() || device_lines.size() != want.size()) {
+        reporter.report("host=%zu device=%zu want=%zu", host_lines.size(), device_lines.size(),
+                        want.size());
+    }
+    for (std::size_t i = 0; i < std::min(host_lines.size(), device_lines.size()); ++i) {
+        if (host_lines[i] != device_lines[i]) {
+            reporter.report("line=%zu host=%s device=%s", i, host_lines[i].c_str(),
+                            device_lines[i].c_str());
+        }
+    }
+    if (!host_lines.empty() && !host_lines[0].starts_with("B,0,C,24,40 03 00,")) {
+        reporter.report("first line=%s", host_lines[0].c_str());
+    }
+    const auto stats = host_decoder.stats();
+    if (stats.malformed_payloads != 0 || stats.edge_restarts != 0) {
+        reporter.report("malformed=%u restarts=%u", stats.malformed_payloads,
+                        stats.edge_restarts);
+    }
+    return reporter.ok();
+}
+
+// input_viewerの全件ストリーム: 飛び、コマンドの切り替え、壊れた差分のあとも元の応答へ戻ること
+bool check_reply_stream() {
+    MismatchReporter reporter("telemetry/reply_stream");
+    constexpr uint32_t kCount = 1200;
+    constexpr uint32_t kSkipFirst = 401;
+    constexpr uint32_t kSkipCount = 30;
+    constexpr uint32_t kCorrupt = 900;
+
+    struct Sent {
+        uint8_t command;
+        std::array<uint8_t, tm::kMaxReplyBytes> bytes;
+        std::size_t length;
+    };
+    std::vector<Sent> sent(kCount + 1);
+    std::vector<uint8_t> stream;
+    tm::ReplyStreamEncoder encoder{};
+    for (uint32_t pc = 1; pc <= kCount; ++pc) {
+        if (pc >= kSkipFirst && pc < kSkipFirst + kSkipCount) {
+            continue;
+        }
+        Sent &s = sent[pc];
+        // Status応答は8フレームごとに値が変わる。途中の数件だけOrigin応答（10バイト）
+        const bool origin = pc >= 700 && pc < 705;
+        s.command = origin ? 0x41 : 0x40;
+        s.length = origin ? 10 : 8;
+        const auto status = make_status(pc >> 3);
+        std::copy(status.begin(), status.end(), s.bytes.begin());
+        s.bytes[8] = static_cast<uint8_t>(pc);
+
+        const tm::ReplySample sample{
+            .publish_count = pc,
+            .timestamp_us = pc * 1000u,
+            .command = s.command,
+            .bytes = std::span<const uint8_t>(s.bytes.data(), s.length),
+        };
+        std::array<uint8_t, tm::kMaxReplyStreamOutput> out{};
+        // 空きが足りなければ何も書かず、同じsampleで呼び直せること
+        if (encoder.encode(sample, std::span(out).first(4)) != 0) {
+            reporter.report("pc=%u encoded into 4 bytes", pc);
+        }
+        const std::size_t length = encoder.encode(sample, out);
+        if (length == 0) {
+            reporter.report("pc=%u encode failed", pc);
+            continue;
+        }
+        if (pc == kCorrupt) {
+            out[2] ^= 0x01;
+        }
+        stream.insert(stream.end(), out.begin(), out.begin() + length);
+    }
+
+    th::StreamDecoder decoder{};
+    uint32_t replies = 0;
+    uint32_t resumed_at = 0;
+    uint32_t gaps = 0;
+    decoder.feed(stream, [&](const th::DecodedRecord &r) {
+        if (const auto *reply = std::get_if<th::ReplyRecord>(&r.record)) {
+            const uint32_t pc = reply->publish_count;
+            const Sent &s = sent[std::min(pc, kCount)];
+            if (pc == 0 || pc > kCount || reply->command != s.command ||
+                !std::equal(reply->bytes.begin(), reply->bytes.end(), s.bytes.begin(),
+                            s.bytes.begin() + static_cast<std::ptrdiff_t>(s.length)) ||
+                r.timestamp_us != pc * 1000u) {
+                reporter.report("R pc=%u got=%s", pc, th::to_csv_line(r).c_str());
+            }
+            if (pc > kCorrupt && resumed_at == 0) {
+                resumed_at = pc;
+            }
+            ++replies;
+        } else if (const auto *gap = std::get_if<tm::ReplyGapRecord>(&r.record)) {
+            if (gap->first_missing != kSkipFirst || gap->count != kSkipCount) {
+                reporter.report("G got=%s", th::to_csv_line(r).c_str());
+            }
+            ++gaps;
+        } else {
+            reporter.report("unexpected %s", th::to_csv_line(r).c_str());
+        }
+    });
+
+    // 壊した1件と、次のキーフレームまでの差分だけが欠ける
+    const auto stats = decoder.stats();
+    const uint32_t lost = (resumed_at > kCorrupt) ? resumed_at - kCorrupt : 0;
+    if (gaps != 1 || resumed_at == 0 || stats.frames.crc_errors != 1 ||
+        stats.reply_desyncs != lost - 1 || replies != kCount - kSkipCount - lost) {
+        reporter.report("replies=%u gaps=%u resumed_at=%u crc=%u desyncs=%u", replies, gaps,
+                        resumed_at, stats.frames.crc_errors, stats.reply_desyncs);
+    }
+    return reporter.ok();
+}
+
+// キーフレームは件数ではなく時刻で入ること（要求の間隔とタイムスタンプの折り返しに依らない）
+bool check_reply_keyframes() {
+    MismatchReporter reporter("telemetry/reply_keyframes");
+    // 同じ応答を送り続けると、キーフレーム以外は変化なしの短い差分になる
+    const auto status = make_status(0x1234);
+    const auto count_keyframes = [&](uint32_t start_us, uint32_t step_us, uint32_t count,
+                                     uint32_t force_at) {
+        tm::ReplyStreamEncoder encoder{};
+        uint32_t keyframes = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (i == force_at) {
+                encoder.force_keyframe();
+            }
+            const tm::ReplySample sample{
+                .publish_count = i + 1,
+                .timestamp_us = start_us + i * step_us,
+                .command = 0x40,
+                .bytes = status,
+            };
+            // 新しいエンコーダの1件目は必ずキーフレームなので、それと同じバイト列か比べる
+            std::array<uint8_t, tm::kMaxReplyStreamOutput> out{};
+            std::array<uint8_t, tm::kMaxReplyStreamOutput> keyframe{};
+            const std::size_t length = encoder.encode(sample, out);
+            const std::size_t keyframe_length = tm::ReplyStreamEncoder{}.encode(sample, keyframe);
+            keyframes += (length == keyframe_length && out == keyframe) ? 1 : 0;
+        }
+        return keyframes;
+    };
+
+    constexpr uint32_t kNever = 0xFFFF'FFFFu;
+    struct Case {
+        uint32_t start_us;
+        uint32_t step_us;
+        uint32_t count;
+        uint32_t force_at;
+        uint32_t keyframes;
+    };
+    constexpr Case kCases[] = {
+        {0, 16'667, 120, kNever, 8},              // 1フレームに1回: 15件ごと
+        {0, 1'000, 1'000, kNever, 4},             // 1msごと: 250件ごと
+        {0xFFF0'0000u, 16'667, 120, kNever, 8},   // タイムスタンプが折り返しても同じ
+        {0, 16'667, 120, 20, 9},                  // 強制したキーフレームから数え直す
+        {0, 500'000, 10, kNever, 10},             // 間隔より空けば毎回
+    };
+    for (const Case &c : kCases) {
+        const uint32_t keyframes = count_keyframes(c.start_us, c.step_us, c.count, c.force_at);
+        if (keyframes != c.keyframes) {
+            reporter.report("start=%u step=%u force=%u keyframes=%u want=%u", c.start_us,
+                            c.step_us, c.force_at, keyframes, c.keyframes);
+        }
+    }
+    return reporter.ok();
+}
+
+// ─── ベンチマーク ───
+// ファームウェアのmainループで1サンプルを送り出す準備にかかる時間の比較
+
+uint32_t bench_text_measure() {
+    std::array<char, 64> line{};
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        sum += static_cast<uint32_t>(ref::format_measure_line(
+            line.data(), line.size(), i & 0xFFFFu, static_cast<uint8_t>(i >> 8),
+            static_cast<uint8_t>(i)));
+        sum += static_cast<uint8_t>(line[2]);
+    }
+    return sum;
+}
+
+uint32_t bench_frame_measure() {
+    std::array<uint8_t, tm::kMaxEncodedFrame> frame{};
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        sum += static_cast<uint32_t>(tm::encode_frame(
+            tm::MeasureSampleRecord{.frame = static_cast<uint16_t>(i),
+                                    .first = static_cast<uint8_t>(i >> 8),
+                                    .second = static_cast<uint8_t>(i)},
+            i * 1000u, frame));
+        sum += frame[2];
+    }
+    return sum;
+}
+
+uint32_t bench_text_input() {
+    std::array<char, 64> line{};
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        sum += static_cast<uint32_t>(
+            ref::format_input_line(line.data(), line.size(), make_status(i)));
+        sum += static_cast<uint8_t>(line[2]);
+    }
+    return sum;
+}
+
+uint32_t bench_frame_input() {
+    std::array<uint8_t, tm::kMaxEncodedFrame> frame{};
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        sum += static_cast<uint32_t>(
+            tm::encode_frame(tm::InputSampleRecord{.status = make_status(i)}, i * 1000u, frame));
+        sum += frame[2];
+    }
+    return sum;
+}
+
+} // namespace
+
+void register_telemetry_suite(Registry &registry) {
+    registry.add(CheckCase{"telemetry/crc8", &check_crc8});
+    registry.add(CheckCase{"telemetry/cobs", &check_cobs});
+    registry.add(CheckCase{"telemetry/varint", &check_varint});
+    registry.add(CheckCase{"telemetry/legacy_lines", &check_legacy_lines});
+    registry.add(CheckCase{"telemetry/probe_stream", &check_probe_stream});
+    registry.add(CheckCase{"telemetry/reply_stream", &check_reply_stream});
+    registry.add(CheckCase{"telemetry/reply_keyframes", &check_reply_keyframes});
+    registry.add(CheckCase{"telemetry/timing_stats", &check_timing_stats});
+    registry.add(CheckCase{"telemetry/edge_decoder", &check_edge_decoder});
+
+    registry.add(BenchCase{"ref/text_line/measure", &bench_text_measure});
+    registry.add(BenchCase{"telemetry/encode_frame/measure", &bench_frame_measure});
+    registry.add(BenchCase{"ref/text_line/input", &bench_text_input});
+    registry.add(BenchCase{"telemetry/encode_frame/input", &bench_frame_input});
+}
+
+} // namespace gcinput::bench
@@ -0,0 +1,611 @@
+#include "domain/state.hpp"
+#include "domain/transform/builtins.hpp"
+#include "domain/transform/correction.hpp"
+#include "domain/transform/inverse_builder.hpp"
+#include "domain/transform/pipeline.hpp"
+#include "domain/transform/pipeline_profiler.hpp"
+#include "harness.hpp"
+#include "joybus/codec/state_wire.hpp"
+#include "reference/transform_ref.hpp"
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace gcinput::bench {
+namespace {
+namespace correction = domain::transform::correction;
+
+// 検証に使う原点オフセット。中心、典型的なずれ、両端
+constexpr std::array<std::array<uint8_t, 2>, 5> kOrigins{{
+    {128, 128},
+    {124, 133},
+    {140, 117},
+    {0, 255},
+    {255, 0},
+}};
+
+domain::PadState make_state(uint8_t x, uint8_t y) {
+    domain::PadState state{};
+    state.input.analog.stick_x = x;
+    state.input.analog.stick_y = y;
+    return state;
+}
+
+// ステージ関数を全スティック入力に適用し、参照実装と比較する
+template <class Production, class Reference>
+bool check_all_sticks(const char *name, Production production, Reference reference) {
+    MismatchReporter reporter{name};
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const uint8_t x = static_cast<uint8_t>(i >> 8);
+        const uint8_t y = static_cast<uint8_t>(i & 0xFFu);
+        domain::PadState state = make_state(x, y);
+        production(state);
+        const ref::Stick expected = reference(ref::Stick{x, y});
+        const auto &analog = state.input.analog;
+        if (analog.stick_x != expected.x || analog.stick_y != expected.y) {
+            reporter.report("in=(%u,%u) got=(%u,%u) want=(%u,%u)", x, y, analog.stick_x,
+                            analog.stick_y, expected.x, expected.y);
+        }
+    }
+    return reporter.ok();
+}
+
+bool check_origin_normalize() {
+    bool ok = true;
+    for (const auto &[ox, oy] : kOrigins) {
+        correction::OriginOffsetContext ctx{};
+        ctx.origin_x.store(ox);
+        ctx.origin_y.store(oy);
+        ok &= check_all_sticks(
+            "origin_normalize",
+            [&ctx](domain::PadState &s) { correction::origin_normalize(ctx, s); },
+            [ox, oy](ref::Stick s) { return ref::origin_normalize(s, ox, oy); });
+    }
+    return ok;
+}
+
+bool check_octagon_clamp() {
+    return check_all_sticks(
+        "octagon_clamp", [](domain::PadState &s) { correction::octagon_clamp(nullptr, s); },
+        [](ref::Stick s) { return ref::octagon_clamp(s); });
+}
+
+bool check_linear_scale() {
+    return check_all_sticks(
+        "linear_scale", [](domain::PadState &s) { correction::linear_scale(nullptr, s); },
+        [](ref::Stick s) { return ref::linear_scale(s); });
+}
+
+bool check_inverse_lut() {
+    correction::InverseLutContext ctx{};
+    return check_all_sticks(
+        "inverse_lut", [&ctx](domain::PadState &s) { correction::inverse_lut(ctx, s); },
+        [](ref::Stick s) { return ref::inverse_lut(s); });
+}
+
+// プロファイルの切り替え（表のポインタの差し替え）が次の呼び出しから効くか
+bool check_inverse_lut_swap() {
+    // mx と my を入れ替えるだけの表
+    static uint8_t swap_x[256][256];
+    static uint8_t swap_y[256][256];
+    for (uint32_t mx = 0; mx < 256; ++mx) {
+        for (uint32_t my = 0; my < 256; ++my) {
+            swap_x[mx][my] = static_cast<uint8_t>(my);
+            swap_y[mx][my] = static_cast<uint8_t>(mx);
+        }
+    }
+    static const correction::InverseLutTable kSwapTable{swap_x, swap_y};
+
+    correction::InverseLutContext ctx{};
+    ctx.table.store(&kSwapTable);
+    bool ok = check_all_sticks(
+        "inverse_lut_swap", [&ctx](domain::PadState &s) { correction::inverse_lut(ctx, s); },
+        [](ref::Stick s) { return ref::Stick{s.y, s.x}; });
+    ctx.table.store(&correction::kBuiltinInverseLut);
+    ok &= check_all_sticks(
+        "inverse_lut_swap_back",
+        [&ctx](domain::PadState &s) { correction::inverse_lut(ctx, s); },
+        [](ref::Stick s) { return ref::inverse_lut(s); });
+    return ok;
+}
+
+// ── S⁻¹⁺ の導出（InverseBuilder） ──
+
+using ForwardSamples = std::vector<std::optional<ref::Stick>>;
+
+// 順方向の写像をプロファイルと同じ形（計測したビット＋点の列）に詰める
+struct PackedForwardMap {
+    std::vector<uint8_t> measured = std::vector<uint8_t>(kAllStickInputs / 8);
+    std::vector<uint8_t> points;
+
+    explicit PackedForwardMap(const ForwardSamples &forward) {
+        for (uint32_t s = 0; s < kAllStickInputs; ++s) {
+            if (forward[s]) {
+                measured[s / 8] |= static_cast<uint8_t>(1u << (s % 8));
+                points.push_back(forward[s]->x);
+                points.push_back(forward[s]->y);
+            }
+        }
+    }
+
+    correction::ForwardMap view() const {
+        return {measured.data(), points.data(), static_cast<uint32_t>(points.size() / 2)};
+    }
+};
+
+// 組み込みの計測（inverse_lut_data.hpp の kForwardLut はすべての s を計測している）
+ForwardSamples builtin_forward() {
+    ForwardSamples forward(kAllStickInputs);
+    for (uint32_t s = 0; s < kAllStickInputs; ++s) {
+        forward[s] = ref::Stick{correction::kForwardLutX[s >> 8][s & 0xFF],
+                                correction::kForwardLutY[s >> 8][s & 0xFF]};
+    }
+    return forward;
+}
+
+correction::InverseBuilder &inverse_builder() {
+    static correction::InverseBuilder builder{};
+    return builder;
+}
+
+// progress_okを渡せば、進み具合が減らずに最後にkProgressTotalへ届いたかを返す
+correction::InverseBuilder::State build_inverse(const correction::ForwardMap &map,
+                                                uint32_t budget, bool *progress_ok = nullptr) {
+    using State = correction::InverseBuilder::State;
+    auto &builder = inverse_builder();
+    builder.begin(map);
+    State state = State::Inverting;
+    uint32_t progress = 0;
+    bool monotonic = true;
+    while (state != State::Done && state != State::Failed) {
+        state = builder.step(budget);
+        if (progress_ok != nullptr) {
+            monotonic &= builder.progress() >= progress;
+            progress = builder.progress();
+        }
+    }
+    if (progress_ok != nullptr) {
+        *progress_ok = monotonic && (state != State::Done ||
+                                     progress == correction::InverseBuilder::kProgressTotal);
+    }
+    return state;
+}
+
+// 組み立てた表が want（[mx*256+my] の原像）と一致するか
+bool check_built_inverse(const char *name, const ForwardSamples &forward, uint32_t budget,
+                         const std::vector<ref::Stick> &want) {
+    MismatchReporter reporter{name};
+    const PackedForwardMap packed{forward};
+    bool progress_ok = false;
+    if (build_inverse(packed.view(), budget, &progress_ok) !=
+        correction::InverseBuilder::State::Done) {
+        reporter.report("failed (peak queue %u)", inverse_builder().peak_queue());
+        return false;
+    }
+    if (!progress_ok) {
+        reporter.report("progress went backwards or stopped short");
+    }
+    const auto &table = inverse_builder().table();
+    for (uint32_t m = 0; m < kAllStickInputs; ++m) {
+        const uint8_t got_x = table.x[m >> 8][m & 0xFF];
+        const uint8_t got_y = table.y[m >> 8][m & 0xFF];
+        if (got_x != want[m].x || got_y != want[m].y) {
+            reporter.report("m=(%u,%u) got=(%u,%u) want=(%u,%u)", m >> 8, m & 0xFF, got_x, got_y,
+                            want[m].x, want[m].y);
+        }
+    }
+    return reporter.ok();
+}
+
+bool check_inverse_build() {
+    bool ok = true;
+
+    // 組み込みの計測から、生成済みの表（Pythonの出力）と同じ表ができるか
+    const ForwardSamples builtin = builtin_forward();
+    std::vector<ref::Stick> generated(kAllStickInputs);
+    for (uint32_t m = 0; m < kAllStickInputs; ++m) {
+        generated[m] = ref::inverse_lut(
+            ref::Stick{static_cast<uint8_t>(m >> 8), static_cast<uint8_t>(m & 0xFF)});
+    }
+    ok &= check_built_inverse("inverse_build_builtin", builtin, 4096, generated);
+    // 1セルずつ進めても同じ
+    ok &= check_built_inverse("inverse_build_budget1", builtin, 1, generated);
+
+    // 間引いた計測（ギャップが広い）
+    ForwardSamples sparse(kAllStickInputs);
+    for (uint32_t s = 0; s < kAllStickInputs; ++s) {
+        if ((s >> 8) % 4 == 0 && (s & 0xFF) % 4 == 0) {
+            sparse[s] = builtin[s];
+        }
+    }
+    ok &= check_built_inverse("inverse_build_sparse", sparse, 4096, ref::build_inverse(sparse));
+
+    // ばらばらに計測が抜け、中央の64×64へ写る写像（同じ m へ写る s が多く、後勝ちを確かめる）
+    ForwardSamples scattered(kAllStickInputs);
+    for (uint32_t s = 0; s < kAllStickInputs; ++s) {
+        const uint32_t h = s * 0x9e3779b1u;
+        if ((h >> 28) < 2) {
+            scattered[s] = ref::Stick{static_cast<uint8_t>(96 + ((h >> 8) & 0x3F)),
+                                      static_cast<uint8_t>(96 + ((h >> 16) & 0x3F))};
+        }
+    }
+    ok &= check_built_inverse("inverse_build_scattered", scattered, 4096,
+                              ref::build_inverse(scattered));
+
+    // my % 3 == 0 の列だけがシード: 最初の展開で残りのセルが全部キューに入る
+    ForwardSamples stripes(kAllStickInputs);
+    uint32_t next = 0;
+    for (uint32_t m = 0; m < kAllStickInputs; ++m) {
+        if ((m & 0xFF) % 3 == 0) {
+            stripes[next++] =
+                ref::Stick{static_cast<uint8_t>(m >> 8), static_cast<uint8_t>(m & 0xFF)};
+        }
+    }
+    ok &= check_built_inverse("inverse_build_stripes", stripes, 4096,
+                              ref::build_inverse(stripes));
+    // シードが1つだけ（キューが長く、親をたどる距離も長い）
+    ForwardSamples single(kAllStickInputs);
+    single[0] = ref::Stick{3, 250};
+    ok &= check_built_inverse("inverse_build_single", single, 4096, ref::build_inverse(single));
+
+    // 使えない写像はFailedになる
+    MismatchReporter reporter{"inverse_build_failed"};
+    using State = correction::InverseBuilder::State;
+    ForwardSamples empty(kAllStickInputs);
+    if (build_inverse(PackedForwardMap{empty}.view(), 4096) != State::Failed) {
+        reporter.report("no seeds");
+    }
+    PackedForwardMap truncated{sparse};
+    truncated.points.resize(truncated.points.size() - 2);
+    if (build_inverse(truncated.view(), 4096) != State::Failed) {
+        reporter.report("points shorter than measured bits");
+    }
+    return ok && reporter.ok();
+}
+
+// bridgeのStatusパイプライン（補正フェーズ）と同じ構成
+struct CorrectionPipeline {
+    correction::OriginOffsetContext ctx{};
+    correction::InverseLutContext lut{};
+    domain::transform::Pipeline pipeline{};
+
+    CorrectionPipeline(uint8_t ox, uint8_t oy) {
+        ctx.origin_x.store(ox);
+        ctx.origin_y.store(oy);
+        using domain::transform::make_stage;
+        constexpr uint16_t kStick = domain::input_field::kStick;
+        pipeline.add_stage(
+            make_stage<correction::OriginOffsetContext, correction::origin_normalize>(ctx, kStick));
+        pipeline.add_stage(make_stage(&correction::octagon_clamp, kStick));
+        pipeline.add_stage(make_stage(&correction::linear_scale, kStick));
+        pipeline.add_stage(
+            make_stage<correction::InverseLutContext, correction::inverse_lut>(lut, kStick));
+    }
+};
+
+bool check_correction_pipeline() {
+    bool ok = true;
+    for (const auto &[ox, oy] : kOrigins) {
+        CorrectionPipeline p{ox, oy};
+        ok &= check_all_sticks(
+            "pipeline", [&p](domain::PadState &s) { p.pipeline.apply_from_isr(s); },
+            [ox, oy](ref::Stick s) { return ref::correction_chain(s, ox, oy); });
+    }
+    return ok;
+}
+
+// 偽のカウンタ。読むたびにkFakeStepだけ進み、24ビットで折り返す（SysTickと同じ幅）
+constexpr uint32_t kFakeMask = 0x00FF'FFFFu;
+constexpr uint32_t kFakeStep = 7;
+uint32_t fake_cycles = 0;
+uint32_t read_fake_cycles() {
+    fake_cycles = (fake_cycles + kFakeStep) & kFakeMask;
+    return fake_cycles;
+}
+
+// プロファイラを付けても出力が変わらないか、ステージごとの集計と中間値が合っているか
+bool check_pipeline_profiler() {
+    using Profiler = domain::transform::PipelineProfiler;
+    MismatchReporter reporter{"pipeline_profiler"};
+    bool ok = true;
+    for (const auto &[ox, oy] : kOrigins) {
+        Profiler profiler{&read_fake_cycles, kFakeMask};
+        CorrectionPipeline p{ox, oy};
+        p.pipeline.set_profiler(&profiler);
+        fake_cycles = kFakeMask - 100; // 途中で折り返す
+        ok &= check_all_sticks(
+            "pipeline_profiled", [&p](domain::PadState &s) { p.pipeline.apply_from_isr(s); },
+            [ox, oy](ref::Stick s) { return ref::correction_chain(s, ox, oy); });
+        for (std::size_t i = 0; i < 4; ++i) {
+            const auto stats = profiler.snapshot(i);
+            if (stats.count != kAllStickInputs || stats.min != kFakeStep ||
+                stats.max != kFakeStep || stats.mean() != kFakeStep) {
+                reporter.report("stage %zu n=%u min=%u mean=%u max=%u", i, stats.count, stats.min,
+                                stats.mean(), stats.max);
+            }
+        }
+        const auto total = profiler.snapshot(Profiler::kTotal);
+        if (total.count != kAllStickInputs || total.min != 4 * kFakeStep ||
+            total.max != 4 * kFakeStep) {
+            reporter.report("total n=%u min=%u max=%u", total.count, total.min, total.max);
+        }
+
+        // 中間値は要求した次の1回だけ取る。無効なステージはビットが立たない
+        const ref::Stick in{200, 37};
+        const ref::Stick norm = ref::origin_normalize(in, ox, oy);
+        const ref::Stick clamp = ref::octagon_clamp(norm);
+        const ref::Stick lut = ref::inverse_lut(clamp);
+        p.pipeline.set_stage_enabled(2, false);
+        profiler.reset();
+        profiler.request_capture();
+        for (int n = 0; n < 2; ++n) {
+            domain::PadState state = make_state(in.x, in.y);
+            p.pipeline.apply_from_isr(state);
+        }
+        Profiler::Capture capture{};
+        const bool captured = profiler.pop_capture(capture);
+        const std::array<ref::Stick, 4> want{norm, clamp, {}, lut};
+        for (std::size_t i = 0; captured && i < want.size(); ++i) {
+            if (i != 2 && (capture.stages[i].x != want[i].x || capture.stages[i].y != want[i].y)) {
+                reporter.report("capture stage %zu got=(%u,%u) want=(%u,%u)", i,
+                                capture.stages[i].x, capture.stages[i].y, want[i].x, want[i].y);
+            }
+        }
+        if (!captured || capture.executed != 0b1011u || capture.input.x != in.x ||
+            capture.input.y != in.y || profiler.pop_capture(capture)) {
+            reporter.report("capture origin=(%u,%u) executed=%X", ox, oy, capture.executed);
+        }
+        if (profiler.snapshot(0).count != 2 || profiler.snapshot(2).count != 0) {
+            reporter.report("reset n0=%u n2=%u", profiler.snapshot(0).count,
+                            profiler.snapshot(2).count);
+        }
+    }
+
+    // カウンタがなければ中間値だけ取り、時間は数えない
+    Profiler capture_only{};
+    CorrectionPipeline p{128, 128};
+    p.pipeline.set_profiler(&capture_only);
+    capture_only.request_capture();
+    domain::PadState state = make_state(128, 128);
+    p.pipeline.apply_from_isr(state);
+    Profiler::Capture capture{};
+    if (!capture_only.pop_capture(capture) || capture.executed != 0b1111u ||
+        capture_only.snapshot(Profiler::kTotal).count != 0) {
+        reporter.report("capture_only executed=%X", capture.executed);
+    }
+    return ok && reporter.ok();
+}
+
+// 折り畳んだ組み込みの表が、補正パイプラインが引く入力 φ(C(m)) で元の表と一致するか
+bool check_inverse_lut_folded() {
+    MismatchReporter reporter{"inverse_lut_folded"};
+    std::vector<bool> domain(kAllStickInputs);
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const ref::Stick m = ref::linear_scale(ref::octagon_clamp(
+            ref::Stick{static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i & 0xFF)}));
+        domain[(m.x << 8) | m.y] = true;
+    }
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        if (!domain[i]) {
+            continue;
+        }
+        const uint8_t mx = static_cast<uint8_t>(i >> 8);
+        const uint8_t my = static_cast<uint8_t>(i & 0xFF);
+        const auto [x, y] = correction::folded_lookup(correction::kBuiltinFoldedLut, mx, my);
+        const ref::Stick want = ref::inverse_lut(ref::Stick{mx, my});
+        if (x != want.x || y != want.y) {
+            reporter.report("m=(%u,%u) got=(%u,%u) want=(%u,%u)", mx, my, x, y, want.x, want.y);
+        }
+    }
+
+    // パイプライン全体では、原点がずれていても折り畳まない表と同じ出力になる
+    bool ok = reporter.ok();
+    for (const auto &[ox, oy] : kOrigins) {
+        CorrectionPipeline p{ox, oy};
+        p.lut.table.store(&correction::kBuiltinFoldedInverseLut);
+        ok &= check_all_sticks(
+            "pipeline_folded", [&p](domain::PadState &s) { p.pipeline.apply_from_isr(s); },
+            [ox, oy](ref::Stick s) { return ref::correction_chain(s, ox, oy); });
+    }
+    return ok;
+}
+
+// スプラインの評価が参照実装と全入力で一致するか。パイプライン全体でも同じ
+bool check_inverse_spline() {
+    MismatchReporter reporter{"inverse_spline"};
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const uint8_t mx = static_cast<uint8_t>(i >> 8);
+        const uint8_t my = static_cast<uint8_t>(i & 0xFF);
+        const auto [x, y] = correction::spline_lookup(correction::kBuiltinSpline, mx, my);
+        const ref::Stick want = ref::inverse_spline(ref::Stick{mx, my});
+        if (x != want.x || y != want.y) {
+            reporter.report("m=(%u,%u) got=(%u,%u) want=(%u,%u)", mx, my, x, y, want.x, want.y);
+        }
+    }
+
+    bool ok = reporter.ok();
+    for (const auto &[ox, oy] : kOrigins) {
+        CorrectionPipeline p{ox, oy};
+        p.lut.table.store(&correction::kBuiltinSplineInverseLut);
+        ok &= check_all_sticks(
+            "pipeline_spline", [&p](domain::PadState &s) { p.pipeline.apply_from_isr(s); },
+            [ox, oy](ref::Stick s) { return ref::spline_chain(s, ox, oy); });
+    }
+    return ok;
+}
+
+// パッドの生フレームに、ステージが申告したフィールドのバイトだけを書き戻した結果が
+// 変換後の状態を全体エンコードした結果と一致するか（ConsoleClientの素通し経路）
+bool check_raw_patch() {
+    MismatchReporter reporter{"raw_patch"};
+    namespace state_wire = joybus::state_wire;
+    constexpr auto kMode = joybus::PollMode::Mode3;
+    CorrectionPipeline correction_pipeline{124, 133};
+    domain::transform::Pipeline neutral_pipeline{};
+    neutral_pipeline.add_stage(domain::transform::make_stage(
+        &domain::transform::builtins::fix_origin_to_neutral,
+        domain::input_field::kStick | domain::input_field::kCStick |
+            domain::input_field::kTriggers));
+    const domain::transform::Pipeline empty_pipeline{};
+    const std::array<const domain::transform::Pipeline *, 3> pipelines{
+        &correction_pipeline.pipeline, &neutral_pipeline, &empty_pipeline};
+
+    for (const auto *pipeline : pipelines) {
+        for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+            // スティック以外のバイトとStatus wordは入力ごとに変える（Always1が落ちたフレームも含む）
+            const uint32_t h = i * 0x9e3779b1u;
+            std::array<uint8_t, joybus::kStatusResponseSize> raw{
+                static_cast<uint8_t>(h >> 24),         static_cast<uint8_t>(h >> 16),
+                static_cast<uint8_t>(i >> 8),          static_cast<uint8_t>(i),
+                static_cast<uint8_t>(h >> 8),          static_cast<uint8_t>(h),
+                static_cast<uint8_t>((h >> 4) & 0xFF), static_cast<uint8_t>((h >> 12) & 0xFF),
+            };
+            domain::PadState state = state_wire::decode_status(raw, kMode);
+            const uint16_t written = pipeline->apply_from_isr(state);
+            const auto want = state_wire::encode_status(state, kMode);
+
+            state_wire::fix_up_raw_status(raw);
+            if (written != 0) {
+                state_wire::status_patcher_for(kMode)(state.input, written, raw);
+            }
+            const auto view = want.view();
+            if (!std::equal(raw.begin(), raw.end(), view.begin(), view.end())) {
+                reporter.report("i=%u written=%03X", i, written);
+            }
+        }
+    }
+    return reporter.ok();
+}
+
+// ── 計時 ──
+
+template <class Stage> uint32_t run_all_sticks(Stage stage) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        domain::PadState state = make_state(static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i));
+        stage(state);
+        sum += state.input.analog.stick_x + (state.input.analog.stick_y << 8);
+    }
+    return sum;
+}
+
+template <class Stage> uint32_t run_all_sticks_ref(Stage stage) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < kAllStickInputs; ++i) {
+        const ref::Stick out =
+            stage(ref::Stick{static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)});
+        sum += out.x + (out.y << 8);
+    }
+    return sum;
+}
+
+correction::OriginOffsetContext &bench_origin() {
+    static correction::OriginOffsetContext ctx{};
+    ctx.origin_x.store(124);
+    ctx.origin_y.store(133);
+    return ctx;
+}
+
+uint32_t bench_origin_normalize() {
+    auto &ctx = bench_origin();
+    return run_all_sticks([&ctx](domain::PadState &s) { correction::origin_normalize(ctx, s); });
+}
+
+uint32_t bench_octagon_clamp() {
+    return run_all_sticks([](domain::PadState &s) { correction::octagon_clamp(nullptr, s); });
+}
+
+uint32_t bench_linear_scale() {
+    return run_all_sticks([](domain::PadState &s) { correction::linear_scale(nullptr, s); });
+}
+
+uint32_t bench_inverse_lut() {
+    static correction::InverseLutContext ctx{};
+    return run_all_sticks([](domain::PadState &s) { correction::inverse_lut(ctx, s); });
+}
+
+uint32_t bench_inverse_lut_folded() {
+    static correction::InverseLutContext ctx{};
+    ctx.table.store(&correction::kBuiltinFoldedInverseLut);
+    return run_all_sticks([](domain::PadState &s) { correction::inverse_lut(ctx, s); });
+}
+
+uint32_t bench_inverse_spline() {
+    static correction::InverseLutContext ctx{};
+    ctx.table.store(&correction::kBuiltinSplineInverseLut);
+    return run_all_sticks([](domain::PadState &s) { correction::inverse_lut(ctx, s); });
+}
+
+uint32_t bench_fix_origin_to_neutral() {
+    return run_all_sticks([](domain::PadState &s) {
+        domain::transform::builtins::fix_origin_to_neutral(nullptr, s);
+    });
+}
+
+uint32_t bench_pipeline() {
+    static CorrectionPipeline p{124, 133};
+    return run_all_sticks([](domain::PadState &s) { p.pipeline.apply_from_isr(s); });
+}
+
+uint32_t bench_pipeline_profiled() {
+    static domain::transform::PipelineProfiler profiler{&read_fake_cycles, kFakeMask};
+    static CorrectionPipeline p{124, 133};
+    p.pipeline.set_profiler(&profiler);
+    return run_all_sticks([](domain::PadState &s) { p.pipeline.apply_from_isr(s); });
+}
+
+uint32_t bench_inverse_build() {
+    static const PackedForwardMap packed{builtin_forward()};
+    build_inverse(packed.view(), 4096);
+    const auto &table = inverse_builder().table();
+    uint32_t sum = 0;
+    for (uint32_t m = 0; m < kAllStickInputs; m += 255) {
+        sum += table.x[m >> 8][m & 0xFF] + (table.y[m >> 8][m & 0xFF] << 8);
+    }
+    return sum;
+}
+
+uint32_t bench_ref_octagon_clamp() {
+    return run_all_sticks_ref([](ref::Stick s) { return ref::octagon_clamp(s); });
+}
+
+uint32_t bench_ref_linear_scale() {
+    return run_all_sticks_ref([](ref::Stick s) { return ref::linear_scale(s); });
+}
+
+uint32_t bench_ref_chain() {
+    return run_all_sticks_ref([](ref::Stick s) { return ref::correction_chain(s, 124, 133); });
+}
+
+} // namespace
+
+void register_transform_suite(Registry &registry) {
+    registry.add(CheckCase{"transform/origin_normalize", &check_origin_normalize});
+    registry.add(CheckCase{"transform/octagon_clamp", &check_octagon_clamp});
+    registry.add(CheckCase{"transform/linear_scale", &check_linear_scale});
+    registry.add(CheckCase{"transform/inverse_lut", &check_inverse_lut});
+    registry.add(CheckCase{"transform/inverse_lut_swap", &check_inverse_lut_swap});
+    registry.add(CheckCase{"transform/inverse_build", &check_inverse_build});
+    registry.add(CheckCase{"transform/pipeline", &check_correction_pipeline});
+    registry.add(CheckCase{"transform/pipeline_profiler", &check_pipeline_profiler});
+    registry.add(CheckCase{"transform/inverse_lut_folded", &check_inverse_lut_folded});
+    registry.add(CheckCase{"transform/inverse_spline", &check_inverse_spline});
+    registry.add(CheckCase{"transform/raw_patch", &check_raw_patch});
+
+    registry.add(BenchCase{"transform/origin_normalize", &bench_origin_normalize});
+    registry.add(BenchCase{"transform/octagon_clamp", &bench_octagon_clamp});
+    registry.add(BenchCase{"transform/linear_scale", &bench_linear_scale});
+    registry.add(BenchCase{"transform/inverse_lut", &bench_inverse_lut});
+    registry.add(BenchCase{"transform/inverse_lut_folded", &bench_inverse_lut_folded});
+    registry.add(BenchCase{"transform/inverse_spline", &bench_inverse_spline});
+    registry.add(BenchCase{"transform/inverse_build", &bench_inverse_build});
+    registry.add(BenchCase{"transform/fix_origin_to_neutral", &bench_fix_origin_to_neutral});
+    registry.add(BenchCase{"transform/pipeline", &bench_pipeline});
+    registry.add(BenchCase{"transform/pipeline_profiled", &bench_pipeline_profiled});
+    registry.add(BenchCase{"ref/octagon_clamp", &bench_ref_octagon_clamp});
+    registry.add(BenchCase{"ref/linear_scale", &bench_ref_linear_scale});
+    registry.add(BenchCase{"ref/pipeline", &bench_ref_chain});
+}
+
+} // namespace gcinput::bench
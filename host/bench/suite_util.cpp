@@ -0,0 +1,198 @@
+#include "harness.hpp"
+#include "util/frame_cadence.hpp"
+#include "util/job_scheduler.hpp"
+#include <array>
+
+namespace gcinput::bench {
+namespace {
+
+// 偽の時計で、予算の使い方・超過・終わったジョブ・止めたジョブを確かめる
+bool check_job_scheduler() {
+    MismatchReporter reporter("util/job_scheduler");
+    struct FakeJob {
+        uint32_t *clock;
+        uint32_t cost_us; // 1単位に掛かる時間
+        uint32_t steps;   // 終わるまでの単位の数
+        uint32_t done{0};
+    };
+    using Scheduler = JobScheduler<3>;
+    const auto step = [](void *user) {
+        auto &job = *static_cast<FakeJob *>(user);
+        *job.clock += job.cost_us;
+        return ++job.done < job.steps;
+    };
+    const auto progress = [](const void *user) {
+        const auto &job = *static_cast<const FakeJob *>(user);
+        return Scheduler::Progress{.done = job.done, .total = job.steps};
+    };
+
+    uint32_t clock = 0xFFFF'FF00u; // 途中で一周する
+    const auto now = [&clock] { return clock; };
+    FakeJob fits{&clock, 25, 20};  // 予算100µsにちょうど4単位入る
+    FakeJob slow{&clock, 250, 3};  // 1単位で予算を超える
+    FakeJob idle{&clock, 1, 1};    // start()しない
+    Scheduler scheduler{};
+    const auto a = scheduler.add({"fits", step, progress, &fits, 100});
+    const auto b = scheduler.add({"slow", step, progress, &slow, 100});
+    const auto c = scheduler.add({"idle", step, progress, &idle, 100});
+    if (scheduler.add({"full", step, progress, &idle, 100}) != Scheduler::kInvalid) {
+        reporter.report("add beyond capacity succeeded");
+    }
+    scheduler.start(a);
+    scheduler.start(b);
+
+    uint32_t finished = 0;
+    for (uint32_t call = 1; call <= 5; ++call) {
+        const uint32_t before = clock;
+        const uint32_t bits = scheduler.run(now);
+        const uint32_t want_bits = (call == 3 ? 1u << b : 0u) | (call == 5 ? 1u << a : 0u);
+        const uint32_t want_elapsed = 100 + (call <= 3 ? 250 : 0);
+        if (bits != want_bits || clock - before != want_elapsed) {
+            reporter.report("call=%u finished=%x want=%x elapsed=%u want=%u", call, bits,
+                            want_bits, clock - before, want_elapsed);
+        }
+        finished |= bits;
+    }
+    const auto &sa = scheduler.stats(a);
+    const auto &sb = scheduler.stats(b);
+    if (sa.slices != 5 || sa.steps != 20 || sa.busy_us != 500 || sa.max_slice_us != 100 ||
+        sa.overruns != 0) {
+        reporter.report("fits: slices=%u steps=%u busy=%u max=%u overruns=%u", sa.slices,
+                        sa.steps, sa.busy_us, sa.max_slice_us, sa.overruns);
+    }
+    if (sb.slices != 3 || sb.steps != 3 || sb.overruns != 3 || sb.max_overrun_us != 150) {
+        reporter.report("slow: slices=%u steps=%u overruns=%u max_over=%u", sb.slices, sb.steps,
+                        sb.overruns, sb.max_overrun_us);
+    }
+    if (scheduler.running(a) || scheduler.running(b) || scheduler.running(c) || idle.done != 0 ||
+        scheduler.progress(a).done != 20 || scheduler.progress(a).total != 20) {
+        reporter.report("state after finish: a=%d b=%d c=%d idle=%u", scheduler.running(a),
+                        scheduler.running(b), scheduler.running(c), idle.done);
+    }
+
+    // 止めたジョブは進まない。start()で集計は消える
+    fits.done = 0;
+    scheduler.start(a);
+    scheduler.run(now);
+    scheduler.stop(a);
+    if (scheduler.run(now) != 0 || fits.done != 4 || scheduler.stats(a).slices != 1) {
+        reporter.report("stop: done=%u slices=%u", fits.done, scheduler.stats(a).slices);
+    }
+
+    // 1単位が予算を割り切れなくても、次の1単位が収まらなければ手前で止めて超過しない
+    FakeJob uneven{&clock, 30, 7};
+    Scheduler uneven_scheduler{};
+    const auto u = uneven_scheduler.add({"uneven", step, progress, &uneven, 100});
+    uneven_scheduler.start(u);
+    for (const uint32_t want_elapsed : {90u, 90u, 30u}) {
+        const uint32_t before = clock;
+        uneven_scheduler.run(now);
+        if (clock - before != want_elapsed) {
+            reporter.report("uneven: elapsed=%u want=%u", clock - before, want_elapsed);
+        }
+    }
+    const auto &su = uneven_scheduler.stats(u);
+    if (uneven_scheduler.running(u) || su.steps != 7 || su.max_slice_us != 90 ||
+        su.overruns != 0) {
+        reporter.report("uneven: steps=%u max=%u overruns=%u", su.steps, su.max_slice_us,
+                        su.overruns);
+    }
+
+    // 1単位の時間が変わるとき。見込みより重い1単位が来た回だけ超過になる
+    struct VaryingJob {
+        uint32_t *clock;
+        std::array<uint32_t, 6> cost_us;
+        uint32_t done{0};
+    };
+    const auto varying_step = [](void *user) {
+        auto &job = *static_cast<VaryingJob *>(user);
+        *job.clock += job.cost_us[job.done];
+        return ++job.done < job.cost_us.size();
+    };
+    VaryingJob varying{&clock, {10, 10, 70, 10, 10, 95}};
+    Scheduler varying_scheduler{};
+    const auto v = varying_scheduler.add({"varying", varying_step, nullptr, &varying, 100});
+    varying_scheduler.start(v);
+    // 10+10+70（次も70とみて止める）、10+10+95（超過15）
+    for (const uint32_t want_elapsed : {90u, 115u}) {
+        const uint32_t before = clock;
+        varying_scheduler.run(now);
+        if (clock - before != want_elapsed) {
+            reporter.report("varying: elapsed=%u want=%u", clock - before, want_elapsed);
+        }
+    }
+    const auto &sv = varying_scheduler.stats(v);
+    if (varying_scheduler.running(v) || sv.slices != 2 || sv.overruns != 1 ||
+        sv.max_overrun_us != 15) {
+        reporter.report("varying: slices=%u overruns=%u max_over=%u", sv.slices, sv.overruns,
+                        sv.max_overrun_us);
+    }
+    return reporter.ok();
+}
+
+// 要求の並び方を変えながら、数えたフレームが実際のフレームと合うかを確かめる
+// 見積もりが追いつくまでの区間（kBlockPolls * 2回）は数えない
+bool check_frame_cadence() {
+    MismatchReporter reporter("util/frame_cadence");
+    struct Case {
+        const char *name;
+        uint32_t period_us;    // フレームの長さ
+        uint32_t polls;        // 1フレームの要求の数
+        uint32_t spacing_us;   // 同じフレームの要求の間隔
+    };
+    constexpr std::array<Case, 5> kCases{{
+        {"60Hz x1", 16'683, 1, 0},
+        {"60Hz x2", 16'683, 2, 1'200},
+        {"60Hz x3", 16'683, 3, 600},
+        {"120Hz x1", 8'341, 1, 0},
+        {"2ms x1", 2'000, 1, 0},
+    }};
+    // 1つの見積もりを続けて使い、前のケースの並びから切り替わっても追いつくことも見る
+    FrameCadence cadence{};
+    uint32_t now = 0xFFFF'0000u; // 途中で一周する
+    for (const Case &c : kCases) {
+        constexpr uint32_t kFrames = 120;
+        constexpr uint32_t kWarmupPolls = FrameCadence::kBlockPolls * 2;
+        uint32_t polls = 0;
+        uint32_t counted = 0;
+        uint32_t expected = 0;
+        for (uint32_t frame = 0; frame < kFrames; ++frame) {
+            for (uint32_t i = 0; i < c.polls; ++i) {
+                const bool new_frame = cadence.on_poll(now + i * c.spacing_us);
+                if (++polls > kWarmupPolls) {
+                    counted += new_frame ? 1 : 0;
+                    expected += (i == 0) ? 1 : 0;
+                }
+            }
+            // 揺れ（±40µs）を入れる
+            now += c.period_us + ((frame % 3) * 40) - 40;
+        }
+        if (counted != expected) {
+            reporter.report("%s: counted=%u expected=%u period=%u", c.name, counted, expected,
+                            cadence.period_us());
+        }
+    }
+
+    // 長く要求が止まった後も、次のフレームから数え続ける
+    const uint32_t before = cadence.period_us();
+    now += 500'000;
+    uint32_t counted = 0;
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        counted += cadence.on_poll(now) ? 1 : 0;
+        now += 2'000;
+    }
+    if (counted != 20 || cadence.period_us() > before * 3 / 2) {
+        reporter.report("after pause: counted=%u period=%u before=%u", counted,
+                        cadence.period_us(), before);
+    }
+    return reporter.ok();
+}
+
+} // namespace
+
+void register_util_suite(Registry &registry) {
+    registry.add(CheckCase{"util/job_scheduler", &check_job_scheduler});
+    registry.add(CheckCase{"util/frame_cadence", &check_frame_cadence});
+}
+
+} // namespace gcinput::bench
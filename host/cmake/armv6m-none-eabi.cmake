@@ -0,0 +1,21 @@
+# host/ を Cortex-M0+ (RP2040) 向けにクロスビルドするためのツールチェーンファイル
+# newlib の semihosting (rdimon) で printf/exit を扱うので、qemu-arm のユーザモードでそのまま実行できる
+#   cmake -S host -B build-host-arm -DCMAKE_TOOLCHAIN_FILE=host/cmake/armv6m-none-eabi.cmake
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR armv6-m)
+
+set(CMAKE_C_COMPILER arm-none-eabi-gcc)
+set(CMAKE_CXX_COMPILER arm-none-eabi-g++)
+
+# ファームウェアと同じコード生成（Pico SDK の既定に合わせる）
+set(GCINPUT_ARM_FLAGS "-mcpu=cortex-m0plus -mthumb")
+set(CMAKE_C_FLAGS_INIT "${GCINPUT_ARM_FLAGS}")
+set(CMAKE_CXX_FLAGS_INIT "${GCINPUT_ARM_FLAGS}")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${GCINPUT_ARM_FLAGS} --specs=rdimon.specs")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+
+# ctest からは qemu-arm 経由で実行する
+set(CMAKE_CROSSCOMPILING_EMULATOR qemu-arm -cpu cortex-m0)
@@ -0,0 +1,212 @@
+#include "column_writer.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <system_error>
+
+namespace gcinput::telemetry::host {
+namespace {
+
+template <class T> bool write_array(const std::filesystem::path &path, const std::vector<T> &data) {
+    std::ofstream out(path, std::ios::binary);
+    // ホストはリトルエンディアン前提（x86-64/AArch64）
+    out.write(reinterpret_cast<const char *>(data.data()),
+              static_cast<std::streamsize>(data.size() * sizeof(T)));
+    return static_cast<bool>(out);
+}
+
+std::span<const uint8_t> as_bytes(std::string_view text) {
+    return {reinterpret_cast<const uint8_t *>(text.data()), text.size()};
+}
+
+} // namespace
+
+ColumnWriter::Column &ColumnWriter::Table::column(std::string_view name, bool variable) {
+    auto it = std::find_if(columns.begin(), columns.end(),
+                           [&](const Column &c) { return c.name == name; });
+    if (it != columns.end()) {
+        return *it;
+    }
+    Column &added = columns.emplace_back();
+    added.name = std::string(name);
+    added.variable = variable;
+    if (variable) {
+        added.offsets.push_back(0);
+    }
+    return added;
+}
+
+void ColumnWriter::Table::bytes(std::string_view name, std::span<const uint8_t> value) {
+    Column &c = column(name, true);
+    c.bytes.insert(c.bytes.end(), value.begin(), value.end());
+    c.offsets.push_back(static_cast<uint32_t>(c.bytes.size()));
+}
+
+void ColumnWriter::Table::text(std::string_view name, std::string_view value) {
+    bytes(name, as_bytes(value));
+}
+
+ColumnWriter::Table &ColumnWriter::table(std::string_view name) {
+    auto it = std::find_if(tables_.begin(), tables_.end(),
+                           [&](const Table &t) { return t.name == name; });
+    if (it != tables_.end()) {
+        return *it;
+    }
+    Table &added = tables_.emplace_back();
+    added.name = std::string(name);
+    return added;
+}
+
+void ColumnWriter::add(const DecodedRecord &decoded) {
+    // 各レコードの列。1行ごとにすべての列へ1つずつ値を入れる
+    auto row = [&](std::string_view name) -> Table & {
+        Table &t = table(name);
+        t.u32("timestamp_us", decoded.timestamp_us);
+        t.rows++;
+        return t;
+    };
+
+    if (const auto *r = std::get_if<HelloRecord>(&decoded.record)) {
+        Table &t = row("hello");
+        t.u32("version", r->version);
+        t.text("firmware", r->firmware);
+    } else if (const auto *r = std::get_if<TextRecord>(&decoded.record)) {
+        Table &t = row("text");
+        t.u32("level", r->level);
+        t.text("text", r->text);
+    } else if (const auto *r = std::get_if<DroppedRecord>(&decoded.record)) {
+        Table &t = row("dropped");
+        t.u32("full", r->full);
+        t.u32("rate", r->rate);
+    } else if (const auto *r = std::get_if<MeasureSampleRecord>(&decoded.record)) {
+        Table &t = row("measure_sample");
+        t.u32("frame", r->frame);
+        t.u32("first", r->first);
+        t.u32("second", r->second);
+    } else if (const auto *r = std::get_if<InputSampleRecord>(&decoded.record)) {
+        static constexpr std::array<std::string_view, 8> kNames{"bh", "bl", "sx", "sy",
+                                                                "cx", "cy", "lt", "rt"};
+        Table &t = row("input_sample");
+        for (std::size_t i = 0; i < kNames.size(); ++i) {
+            t.u32(kNames[i], r->status[i]);
+        }
+    } else if (const auto *r = std::get_if<ReplyRecord>(&decoded.record)) {
+        Table &t = row("reply");
+        t.u32("publish_count", r->publish_count);
+        t.u32("command", r->command);
+        t.bytes("bytes", r->bytes);
+    } else if (const auto *r = std::get_if<ReplyGapRecord>(&decoded.record)) {
+        Table &t = row("reply_gap");
+        t.u32("first_missing", r->first_missing);
+        t.u32("count", r->count);
+    } else if (const auto *r = std::get_if<MeasureRunRecord>(&decoded.record)) {
+        Table &t = row("measure_run");
+        t.u32("event", static_cast<uint32_t>(r->event));
+        t.u32("run_id", r->run_id);
+        t.u32("position", r->position);
+        t.u32("frame", r->frame);
+    } else if (const auto *r = std::get_if<MeasureAckRecord>(&decoded.record)) {
+        Table &t = row("measure_ack");
+        t.u32("status", static_cast<uint32_t>(r->status));
+        t.u32("seq", r->seq);
+        t.u32("console_frame", r->console_frame);
+        t.u32("queued", r->queued);
+    } else if (const auto *r = std::get_if<MeasureCorrectionRecord>(&decoded.record)) {
+        Table &t = row("measure_correction");
+        t.u32("frame", r->frame);
+        t.u32("raw_x", r->raw_x);
+        t.u32("raw_y", r->raw_y);
+        t.u32("out_x", r->out_x);
+        t.u32("out_y", r->out_y);
+    } else if (const auto *r = std::get_if<ProfileAckRecord>(&decoded.record)) {
+        Table &t = row("profile_ack");
+        t.u32("status", static_cast<uint32_t>(r->status));
+        t.u32("slot", r->slot);
+        t.u32("offset", r->offset);
+        t.u32("crc", r->crc);
+    } else if (const auto *r = std::get_if<ProbeFrameRecord>(&decoded.record)) {
+        Table &t = row("probe_frame");
+        t.u32("port", static_cast<uint32_t>(r->port));
+        t.u32("dir", static_cast<uint32_t>(r->dir));
+        t.u32("command", r->command);
+        t.bytes("data", r->data);
+        t.u32("has_poll_mode", r->has_poll_mode ? 1u : 0u);
+        t.u32("poll_mode_pad", r->poll_mode_pad);
+        t.u32("poll_mode_console", r->poll_mode_console);
+        t.u32("poll_mode_reply", r->poll_mode_reply);
+    } else if (const auto *r = std::get_if<ProbeStateRecord>(&decoded.record)) {
+        Table &t = row("probe_state");
+        t.u32("port", static_cast<uint32_t>(r->port));
+        t.text("text", r->text);
+    } else if (const auto *r = std::get_if<ProbeTimeoutRecord>(&decoded.record)) {
+        Table &t = row("probe_timeout");
+        t.u32("port", static_cast<uint32_t>(r->port));
+        t.text("text", r->text);
+    } else if (const auto *r = std::get_if<ProbeSummaryRecord>(&decoded.record)) {
+        Table &t = row("probe_summary");
+        t.u32("port", static_cast<uint32_t>(r->port));
+        t.u32("polls", r->polls);
+        t.u32("ok", r->ok);
+        t.u32("timeout", r->timeout);
+    } else if (const auto *r = std::get_if<ProbeCaptureRecord>(&decoded.record)) {
+        Table &t = row("probe_capture");
+        t.u32("trigger", static_cast<uint32_t>(r->trigger));
+        t.u32("pre", r->pre);
+        t.u32("post", r->post);
+    } else if (const auto *r = std::get_if<ProbeBusFrameRecord>(&decoded.record)) {
+        Table &t = row("bus_frame");
+        t.u32("port", static_cast<uint32_t>(r->port));
+        t.u32("bits", r->bits);
+        t.bytes("data", r->data);
+        t.u32("bit_period_ns", r->bit_period_ns);
+        t.u32("one_low_max_ns", r->one_low_max_ns);
+        t.u32("zero_low_min_ns", r->zero_low_min_ns);
+        t.u32("stop_low_ns", r->stop_low_ns);
+        t.u32("has_gap", r->has_gap ? 1u : 0u);
+        t.u32("gap_ns", r->gap_ns);
+    } else if (const auto *r = std::get_if<ProbeTimingRecord>(&decoded.record)) {
+        Table &t = row("probe_timing");
+        t.u32("metric", static_cast<uint32_t>(r->metric));
+        t.u32("count", r->count);
+        t.u32("min", r->min);
+        t.u32("mean", r->mean);
+        t.u32("max", r->max);
+        t.u32("p50", r->p50);
+        t.u32("p99", r->p99);
+        t.u32("jitter", r->jitter);
+    }
+    // UnknownRecordは列にしない（デコーダの統計に数が残る）
+}
+
+bool ColumnWriter::write(const std::filesystem::path &dir) const {
+    for (const Table &t : tables_) {
+        const auto table_dir = dir / t.name;
+        std::error_code ec;
+        std::filesystem::create_directories(table_dir, ec);
+        if (ec) {
+            return false;
+        }
+        std::ofstream schema(table_dir / "schema.csv");
+        schema << "column,type,rows\n";
+        for (const Column &c : t.columns) {
+            bool ok = true;
+            if (c.variable) {
+                ok = write_array(table_dir / (c.name + ".offsets.u32"), c.offsets) &&
+                     write_array(table_dir / (c.name + ".bytes"), c.bytes);
+                schema << c.name << ",bytes," << (c.offsets.size() - 1) << "\n";
+            } else {
+                ok = write_array(table_dir / (c.name + ".u32"), c.values);
+                schema << c.name << ",u32," << c.values.size() << "\n";
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        if (!schema) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace gcinput::telemetry::host
@@ -0,0 +1,54 @@
+#pragma once
+#include "decoder.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gcinput::telemetry::host {
+
+// レコードを種類ごとの表にまとめ、列ごとのファイルへ書き出す（Parquetに近い列指向の配置）
+//
+//   <dir>/<table>/schema.csv           column,type,rows
+//   <dir>/<table>/<column>.u32         数値列。リトルエンディアンのuint32_t配列
+//   <dir>/<table>/<column>.offsets.u32 可変長列の各行の開始位置（rows + 1個）
+//   <dir>/<table>/<column>.bytes       可変長列の中身を連結したもの
+//
+// numpy.fromfile(path, "<u4") などでそのまま読める
+class ColumnWriter {
+  public:
+    void add(const DecodedRecord &decoded);
+
+    // 表ごとのディレクトリを作って書き出す。失敗したらfalse
+    bool write(const std::filesystem::path &dir) const;
+
+  private:
+    struct Column {
+        std::string name;
+        bool variable{false};
+        std::vector<uint32_t> values;  // 数値列
+        std::vector<uint32_t> offsets; // 可変長列（先頭は0）
+        std::vector<uint8_t> bytes;    // 可変長列
+    };
+
+    struct Table {
+        std::string name;
+        std::vector<Column> columns;
+        std::size_t rows{0};
+
+        Column &column(std::string_view name, bool variable);
+        void u32(std::string_view name, uint32_t value) {
+            column(name, false).values.push_back(value);
+        }
+        void bytes(std::string_view name, std::span<const uint8_t> value);
+        void text(std::string_view name, std::string_view value);
+    };
+
+    Table &table(std::string_view name);
+
+    std::vector<Table> tables_;
+};
+
+} // namespace gcinput::telemetry::host
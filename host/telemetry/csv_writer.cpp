@@ -0,0 +1,218 @@
+#include "csv_writer.hpp"
+#include "telemetry/crc8.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <span>
+#include <string_view>
+
+namespace gcinput::telemetry::host {
+namespace {
+
+template <class... Args> void append(std::string &out, const char *fmt, Args... args) {
+    std::array<char, 256> buffer{};
+    const int n = std::snprintf(buffer.data(), buffer.size(), fmt, args...);
+    if (n > 0) {
+        out.append(buffer.data(), std::min<std::size_t>(static_cast<std::size_t>(n),
+                                                        buffer.size() - 1));
+    }
+}
+
+void append_text(std::string &out, std::string_view text) { out.append(text); }
+
+void append_hex(std::string &out, std::span<const uint8_t> bytes) {
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        append(out, (i > 0) ? " %02X" : "%02X", bytes[i]);
+    }
+}
+
+char port_char(ProbePort port) { return (port == ProbePort::Pad) ? 'P' : 'C'; }
+
+const char *run_event_name(MeasureRunEvent event) {
+    switch (event) {
+    case MeasureRunEvent::Start:
+        return "start";
+    case MeasureRunEvent::Resume:
+        return "resume";
+    case MeasureRunEvent::Checkpoint:
+        return "checkpoint";
+    }
+    return "unknown";
+}
+
+const char *ack_status_name(MeasureAckStatus status) {
+    switch (status) {
+    case MeasureAckStatus::Queued:
+        return "queued";
+    case MeasureAckStatus::Live:
+        return "live";
+    case MeasureAckStatus::Full:
+        return "full";
+    case MeasureAckStatus::Rejected:
+        return "rejected";
+    case MeasureAckStatus::Released:
+        return "released";
+    }
+    return "unknown";
+}
+
+const char *profile_ack_name(ProfileAckStatus status) {
+    switch (status) {
+    case ProfileAckStatus::Ready:
+        return "ready";
+    case ProfileAckStatus::Written:
+        return "written";
+    case ProfileAckStatus::Activated:
+        return "activated";
+    case ProfileAckStatus::Rejected:
+        return "rejected";
+    case ProfileAckStatus::Failed:
+        return "failed";
+    }
+    return "unknown";
+}
+
+const char *trigger_name(ProbeTrigger trigger) {
+    switch (trigger) {
+    case ProbeTrigger::Command:
+        return "command";
+    case ProbeTrigger::Timeout:
+        return "timeout";
+    case ProbeTrigger::State:
+        return "state";
+    case ProbeTrigger::Pattern:
+        return "pattern";
+    }
+    return "unknown";
+}
+
+const char *metric_name(ProbeTimingMetric metric) {
+    switch (metric) {
+    case ProbeTimingMetric::ConsolePollInterval:
+        return "console_poll_interval";
+    case ProbeTimingMetric::PadRoundTrip:
+        return "pad_round_trip";
+    case ProbeTimingMetric::ReplyGap:
+        return "reply_gap";
+    case ProbeTimingMetric::SampleAge:
+        return "sample_age";
+    }
+    return "unknown";
+}
+
+unsigned long ts(const DecodedRecord &decoded) { return decoded.timestamp_us; }
+
+struct LineFormatter {
+    const DecodedRecord &decoded;
+    std::string &out;
+
+    void operator()(const HelloRecord &r) {
+        out = "# ";
+        append_text(out, r.firmware);
+        append(out, " telemetry v%u", r.version);
+    }
+    void operator()(const TextRecord &r) {
+        append(out, "M,%lu,", ts(decoded));
+        append_text(out, r.text);
+    }
+    void operator()(const DroppedRecord &r) {
+        append(out, "M,%lu,WARNING telemetry dropped full=%u rate=%u", ts(decoded), r.full,
+               r.rate);
+    }
+    void operator()(const MeasureSampleRecord &r) {
+        const std::array<uint8_t, 4> crc_data{
+            static_cast<uint8_t>(r.frame >> 8),
+            static_cast<uint8_t>(r.frame),
+            r.first,
+            r.second,
+        };
+        append(out, "D,%u,%u,%u,%02X", r.frame, r.first, r.second, crc8(crc_data));
+    }
+    void operator()(const InputSampleRecord &r) {
+        const auto &s = r.status;
+        append(out, "I,%02X,%02X,%u,%u,%u,%u,%u,%u,%02X", s[0], s[1], s[2], s[3], s[4], s[5],
+               s[6], s[7], crc8(s));
+    }
+    void operator()(const ReplyRecord &r) {
+        append(out, "R,%lu,%u,%02X,%zu,", ts(decoded), r.publish_count, r.command,
+               r.bytes.size());
+        append_hex(out, r.bytes);
+    }
+    void operator()(const ReplyGapRecord &r) {
+        append(out, "G,%lu,%u,%u", ts(decoded), r.first_missing, r.count);
+    }
+    void operator()(const MeasureRunRecord &r) {
+        append(out, "K,%lu,%s,%u,%u,%u", ts(decoded), run_event_name(r.event), r.run_id,
+               r.position, r.frame);
+    }
+    void operator()(const MeasureAckRecord &r) {
+        append(out, "A,%lu,%s,%u,%u,%u", ts(decoded), ack_status_name(r.status), r.seq,
+               r.console_frame, r.queued);
+    }
+    void operator()(const MeasureCorrectionRecord &r) {
+        append(out, "Q,%u,%u,%u,%u,%u", r.frame, r.raw_x, r.raw_y, r.out_x, r.out_y);
+    }
+    void operator()(const ProfileAckRecord &r) {
+        append(out, "F,%lu,%s,%u,%u,%08X", ts(decoded), profile_ack_name(r.status), r.slot,
+               r.offset, r.crc);
+    }
+    void operator()(const ProbeFrameRecord &r) {
+        append(out, "T,%lu,%c,%c,%zu,", ts(decoded), port_char(r.port),
+               (r.dir == ProbeDir::TX) ? 'T' : 'R', r.data.size());
+        append_hex(out, r.data);
+        if (r.has_poll_mode) {
+            append(out, ",pm=P%u/C%u/R%u", r.poll_mode_pad, r.poll_mode_console,
+                   r.poll_mode_reply);
+        }
+    }
+    void operator()(const ProbeStateRecord &r) {
+        const std::size_t arrow = r.text.find(" -> ");
+        if (arrow == std::string_view::npos) {
+            // パース不能ならM行で出力
+            append(out, "M,%lu,", ts(decoded));
+            append_text(out, r.text);
+            return;
+        }
+        append(out, "S,%lu,", ts(decoded));
+        append_text(out, r.text.substr(0, arrow));
+        out.push_back(',');
+        append_text(out, r.text.substr(arrow + 4));
+    }
+    void operator()(const ProbeTimeoutRecord &r) {
+        append(out, "M,%lu,%c TIMEOUT ", ts(decoded), port_char(r.port));
+        append_text(out, r.text);
+    }
+    void operator()(const ProbeSummaryRecord &r) {
+        append(out, "U,%lu,%c,%u,%u,%u", ts(decoded), port_char(r.port), r.polls, r.ok,
+               r.timeout);
+    }
+    void operator()(const ProbeCaptureRecord &r) {
+        append(out, "X,%lu,%s,%u,%u", ts(decoded), trigger_name(r.trigger), r.pre, r.post);
+    }
+    void operator()(const ProbeTimingRecord &r) {
+        append(out, "L,%lu,%s,%u,%u,%u,%u,%u,%u,%u", ts(decoded), metric_name(r.metric), r.count,
+               r.min, r.mean, r.max, r.p50, r.p99, r.jitter);
+    }
+    void operator()(const ProbeBusFrameRecord &r) {
+        append(out, "B,%lu,%c,%u,", ts(decoded), port_char(r.port), r.bits);
+        append_hex(out, r.data);
+        append(out, ",%u,%u,%u,%u,", r.bit_period_ns, r.one_low_max_ns, r.zero_low_min_ns,
+               r.stop_low_ns);
+        if (r.has_gap) {
+            append(out, "%u", r.gap_ns);
+        }
+    }
+    void operator()(const UnknownRecord &r) {
+        append(out, "# unknown record type=0x%02X len=%zu", r.type, r.payload.size());
+    }
+};
+
+} // namespace
+
+std::string to_csv_line(const DecodedRecord &decoded) {
+    std::string line;
+    std::visit(LineFormatter{decoded, line}, decoded.record);
+    return line;
+}
+
+} // namespace gcinput::telemetry::host
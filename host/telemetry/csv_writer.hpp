@@ -0,0 +1,28 @@
+#pragma once
+#include "decoder.hpp"
+#include <string>
+
+namespace gcinput::telemetry::host {
+
+// レコードを従来のテキスト出力と同じ行に戻す
+//   MeasureSample -> D,frame,first,second,crc
+//   InputSample   -> I,BH,BL,SX,SY,CX,CY,LT,RT,crc
+//   Reply         -> R,timestamp_us,publish_count,command,len,hex
+//   ReplyGap      -> G,timestamp_us,first_missing,count
+//   MeasureRun    -> K,timestamp_us,event,run_id,position,frame
+//   MeasureAck    -> A,timestamp_us,status,seq,console_frame,queued
+//   MeasureCorrection -> Q,frame,raw_x,raw_y,out_x,out_y
+//   ProfileAck    -> F,timestamp_us,status,slot,offset,crc
+//   ProbeFrame    -> T,timestamp_us,port,dir,len,hex[,pm=P/C/R]
+//   ProbeState    -> S,timestamp_us,from,to
+//   ProbeTimeout  -> M,timestamp_us,port TIMEOUT message
+//   ProbeSummary  -> U,timestamp_us,port,polls,ok,timeout
+//   ProbeCapture  -> X,timestamp_us,trigger,pre,post（続くpre + 1 + post行が凍結区間）
+//   ProbeTiming   -> L,timestamp_us,metric,count,min,mean,max,p50,p99,jitter（µs）
+//   ProbeBusFrame -> B,timestamp_us,port,bits,hex,bit_period,one_low_max,zero_low_min,stop_low,gap
+//                    （ns。直前のフレームがなければgapは空。ProbeEdgesもこの行へ組み立てる）
+//   Text          -> M,timestamp_us,message
+// D/I行のcrcは旧形式と同じCRC-8をホストで計算し直したもの
+std::string to_csv_line(const DecodedRecord &decoded);
+
+} // namespace gcinput::telemetry::host
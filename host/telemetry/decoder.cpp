@@ -0,0 +1,69 @@
+#include "decoder.hpp"
+
+namespace gcinput::telemetry::host {
+namespace {
+
+template <class Record> bool decode_as(const RawFrame &frame, DecodedRecord &out) {
+    Record record{};
+    if (!frame.decode(record)) {
+        return false;
+    }
+    out.record = record;
+    return true;
+}
+
+} // namespace
+
+bool decode_record(const RawFrame &frame, DecodedRecord &out) {
+    out.timestamp_us = frame.timestamp_us;
+    switch (frame.type) {
+    case RecordType::Hello:
+        return decode_as<HelloRecord>(frame, out);
+    case RecordType::Text:
+        return decode_as<TextRecord>(frame, out);
+    case RecordType::Dropped:
+        return decode_as<DroppedRecord>(frame, out);
+    case RecordType::MeasureSample:
+        return decode_as<MeasureSampleRecord>(frame, out);
+    case RecordType::InputSample:
+        return decode_as<InputSampleRecord>(frame, out);
+    case RecordType::ReplyGap:
+        return decode_as<ReplyGapRecord>(frame, out);
+    case RecordType::MeasureRun:
+        return decode_as<MeasureRunRecord>(frame, out);
+    case RecordType::MeasureAck:
+        return decode_as<MeasureAckRecord>(frame, out);
+    case RecordType::MeasureCorrection:
+        return decode_as<MeasureCorrectionRecord>(frame, out);
+    case RecordType::ProfileAck:
+        return decode_as<ProfileAckRecord>(frame, out);
+    case RecordType::ReplyKeyframe:
+    case RecordType::ReplyDelta:
+        // 単独では戻せない（StreamDecoderが扱う）
+        return false;
+    case RecordType::ProbeFrame:
+        return decode_as<ProbeFrameRecord>(frame, out);
+    case RecordType::ProbeState:
+        return decode_as<ProbeStateRecord>(frame, out);
+    case RecordType::ProbeTimeout:
+        return decode_as<ProbeTimeoutRecord>(frame, out);
+    case RecordType::ProbeSummary:
+        return decode_as<ProbeSummaryRecord>(frame, out);
+    case RecordType::ProbeCapture:
+        return decode_as<ProbeCaptureRecord>(frame, out);
+    case RecordType::ProbeTiming:
+        return decode_as<ProbeTimingRecord>(frame, out);
+    case RecordType::ProbeEdges:
+        // 単独では戻せない（StreamDecoderが扱う）
+        return false;
+    case RecordType::ProbeBusFrame:
+        return decode_as<ProbeBusFrameRecord>(frame, out);
+    }
+    out.record = UnknownRecord{
+        .type = static_cast<uint8_t>(frame.type),
+        .payload = frame.payload,
+    };
+    return true;
+}
+
+} // namespace gcinput::telemetry::host
@@ -0,0 +1,105 @@
+#pragma once
+#include "edge_stream.hpp"
+#include "reply_stream.hpp"
+#include "telemetry/frame.hpp"
+#include "telemetry/records.hpp"
+#include <cstdint>
+#include <span>
+#include <variant>
+
+// テレメトリのバイト列をレコードへ戻す
+// レコード内の文字列やバイト列はデコーダのバッファを指すので、コールバックの中で使い切る
+namespace gcinput::telemetry::host {
+
+// 型が分からない（新しいファームウェアが送った）レコード
+struct UnknownRecord {
+    uint8_t type{0};
+    std::span<const uint8_t> payload{};
+};
+
+using Record = std::variant<HelloRecord, TextRecord, DroppedRecord, MeasureSampleRecord,
+                            InputSampleRecord, ReplyRecord, ReplyGapRecord, MeasureRunRecord,
+                            MeasureAckRecord, MeasureCorrectionRecord, ProfileAckRecord,
+                            ProbeFrameRecord, ProbeStateRecord,
+                            ProbeTimeoutRecord, ProbeSummaryRecord, ProbeCaptureRecord,
+                            ProbeTimingRecord, ProbeBusFrameRecord, UnknownRecord>;
+
+struct DecodedRecord {
+    uint32_t timestamp_us{0};
+    Record record{};
+};
+
+// フレームとして正しいがペイロードが定義と合わないものを数える
+struct DecodeStats {
+    FrameDecoder::Stats frames{};
+    uint32_t malformed_payloads{0};
+    uint32_t unknown_types{0};
+    // 基準が合わず捨てた全件ストリームの差分
+    uint32_t reply_desyncs{0};
+    // 本体で送れずに捨てられ、つながりが切れたスニファのエッジ列
+    uint32_t edge_restarts{0};
+};
+
+// 検証済みのフレームをレコードへ変換する。ペイロードが定義と合わなければfalse
+// ReplyKeyframe/ReplyDeltaは前のフレームに依存するので、StreamDecoderがReplyRecordへ戻す
+// ProbeEdgesも同じく、StreamDecoderがProbeBusFrameRecordへ組み立てる
+bool decode_record(const RawFrame &frame, DecodedRecord &out);
+
+class StreamDecoder {
+  public:
+    template <class OnRecord> void feed(std::span<const uint8_t> data, OnRecord &&on_record) {
+        frames_.feed(data, [&](const RawFrame &frame) {
+            DecodedRecord decoded{};
+            if (frame.type == RecordType::ReplyKeyframe || frame.type == RecordType::ReplyDelta) {
+                ReplyRecord reply{};
+                switch (replies_.apply(frame, reply)) {
+                case ReplyReconstructor::Result::Reply:
+                    on_record(DecodedRecord{.timestamp_us = frame.timestamp_us, .record = reply});
+                    break;
+                case ReplyReconstructor::Result::Desync:
+                    break;
+                case ReplyReconstructor::Result::Malformed:
+                    malformed_payloads_++;
+                    break;
+                }
+                return;
+            }
+            if (frame.type == RecordType::ProbeEdges) {
+                const bool ok = edges_.apply(frame, [&](const ProbeBusFrameRecord &bus) {
+                    on_record(DecodedRecord{.timestamp_us = frame.timestamp_us, .record = bus});
+                });
+                if (!ok) {
+                    malformed_payloads_++;
+                }
+                return;
+            }
+            if (!decode_record(frame, decoded)) {
+                malformed_payloads_++;
+                return;
+            }
+            if (std::holds_alternative<UnknownRecord>(decoded.record)) {
+                unknown_types_++;
+            }
+            on_record(decoded);
+        });
+    }
+
+    DecodeStats stats() const {
+        return DecodeStats{
+            .frames = frames_.stats(),
+            .malformed_payloads = malformed_payloads_,
+            .unknown_types = unknown_types_,
+            .reply_desyncs = replies_.desyncs(),
+            .edge_restarts = edges_.restarts(),
+        };
+    }
+
+  private:
+    FrameDecoder frames_{};
+    ReplyReconstructor replies_{};
+    EdgeReconstructor edges_{};
+    uint32_t malformed_payloads_{0};
+    uint32_t unknown_types_{0};
+};
+
+} // namespace gcinput::telemetry::host
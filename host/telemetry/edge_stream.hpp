@@ -0,0 +1,65 @@
+#pragma once
+#include "sniffer/edge_decoder.hpp"
+#include "telemetry/frame.hpp"
+#include "telemetry/records.hpp"
+#include "telemetry/varint.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// スニファの生のエッジ（ProbeEdges）をフレーム（ProbeBusFrame）へ組み立てる
+// 本体がFramesで送るときと同じデコーダ（examples/common/sniffer/edge_decoder.hpp）を使う
+namespace gcinput::telemetry::host {
+
+class EdgeReconstructor {
+  public:
+    // ProbeEdgesのフレームを1つ受け取り、閉じたフレームごとにon_frameを呼ぶ
+    // ペイロードが定義と合わなければfalse
+    template <class OnFrame> bool apply(const RawFrame &frame, OnFrame &&on_frame) {
+        ProbeEdgesRecord record{};
+        if (!frame.decode(record)) {
+            return false;
+        }
+        Port &port = ports_[record.port == ProbePort::Console ? 1 : 0];
+        if (record.restart || !port.decoder || port.clock_hz != record.clock_hz) {
+            if (port.decoder && record.restart) {
+                restarts_++;
+            }
+            port.clock_hz = record.clock_hz;
+            port.decoder.emplace(
+                sniffer::ns_to_cycles(sniffer::kDefaultEndHighNs, record.clock_hz));
+        }
+
+        const auto emit = [&](const sniffer::BusFrame &f) {
+            on_frame(sniffer::to_record(f, record.port, record.clock_hz));
+        };
+        sniffer::Edge edge{record.first_cycles, record.first_high};
+        std::size_t pos = 0;
+        for (uint32_t i = 0; i < record.count; ++i) {
+            if (i > 0) {
+                uint32_t delta = 0;
+                pos += varint::decode_u32(record.deltas.subspan(pos), delta);
+                edge.cycles += delta;
+                edge.level = !edge.level;
+            }
+            port.decoder->feed(edge, emit);
+        }
+        if (record.idle) {
+            port.decoder->finish(emit);
+        }
+        return true;
+    }
+
+    // 本体で送れずに捨てられ、つながりが切れた回数
+    uint32_t restarts() const { return restarts_; }
+
+  private:
+    struct Port {
+        std::optional<sniffer::EdgeDecoder> decoder{};
+        uint32_t clock_hz{0};
+    };
+    std::array<Port, 2> ports_{};
+    uint32_t restarts_{0};
+};
+
+} // namespace gcinput::telemetry::host
@@ -0,0 +1,123 @@
+#include "column_writer.hpp"
+#include "csv_writer.hpp"
+#include "decoder.hpp"
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <unistd.h>
+
+// 使い方:
+//   gc_telemetry_decode [INPUT]                    従来形式のCSVを標準出力へ
+//   gc_telemetry_decode --columns DIR [INPUT]      列指向のファイルをDIRへ
+//   gc_telemetry_decode --stats [INPUT]            統計だけを表示
+//   gc_telemetry_decode --live [INPUT]             届いた分ずつ読み、行ごとに標準出力へ流す
+// INPUTを省略すると標準入力から読む（シリアルをそのまま保存したファイルやパイプ）
+// --live はシリアルのデバイスを直接開くとき用（4KBたまるのを待たず、出力もためない）
+// 統計（フレーム数、CRCエラー等）は標準エラーへ出す
+
+namespace {
+using namespace gcinput::telemetry::host;
+
+struct Options {
+    const char *input{nullptr};
+    const char *columns_dir{nullptr};
+    bool csv{true};
+    bool live{false};
+};
+
+void print_usage(const char *argv0) {
+    std::fprintf(stderr, "usage: %s [--columns DIR | --stats | --live] [INPUT]\n", argv0);
+}
+
+bool parse_options(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg == "--columns" && i + 1 < argc) {
+            opt.columns_dir = argv[++i];
+            opt.csv = false;
+        } else if (arg == "--stats") {
+            opt.csv = false;
+        } else if (arg == "--live") {
+            opt.live = true;
+        } else if (!arg.starts_with("--") && opt.input == nullptr) {
+            opt.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_stats(const DecodeStats &stats) {
+    std::fprintf(stderr,
+                 "frames=%u crc_errors=%u framing_errors=%u overruns=%u malformed=%u "
+                 "unknown=%u reply_desyncs=%u edge_restarts=%u\n",
+                 stats.frames.frames, stats.frames.crc_errors, stats.frames.framing_errors,
+                 stats.frames.overruns, stats.malformed_payloads, stats.unknown_types,
+                 stats.reply_desyncs, stats.edge_restarts);
+}
+
+// liveなら読めた分だけで戻る（freadはバッファが埋まるまで待つ）
+std::size_t read_chunk(std::FILE *in, std::span<uint8_t> buffer, bool live) {
+    if (!live) {
+        return std::fread(buffer.data(), 1, buffer.size(), in);
+    }
+    while (true) {
+        const ssize_t n = ::read(fileno(in), buffer.data(), buffer.size());
+        if (n >= 0) {
+            return static_cast<std::size_t>(n);
+        }
+        if (errno != EINTR) {
+            std::perror("read");
+            return 0;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt{};
+    if (!parse_options(argc, argv, opt)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::FILE *in = opt.input ? std::fopen(opt.input, "rb") : stdin;
+    if (in == nullptr) {
+        std::perror(opt.input);
+        return 1;
+    }
+
+    StreamDecoder decoder{};
+    ColumnWriter columns{};
+    std::array<uint8_t, 4096> buffer{};
+    std::size_t n = 0;
+    while ((n = read_chunk(in, buffer, opt.live)) > 0) {
+        decoder.feed(std::span<const uint8_t>(buffer.data(), n), [&](const DecodedRecord &r) {
+            if (opt.csv) {
+                const std::string line = to_csv_line(r);
+                std::fwrite(line.data(), 1, line.size(), stdout);
+                std::fputc('\n', stdout);
+            }
+            if (opt.columns_dir) {
+                columns.add(r);
+            }
+        });
+        if (opt.live) {
+            std::fflush(stdout);
+        }
+    }
+    if (in != stdin) {
+        std::fclose(in);
+    }
+
+    print_stats(decoder.stats());
+    if (opt.columns_dir && !columns.write(opt.columns_dir)) {
+        std::fprintf(stderr, "failed to write columns to %s\n", opt.columns_dir);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "reply_stream.hpp"
+#include <algorithm>
+
+namespace gcinput::telemetry::host {
+
+ReplyReconstructor::Result ReplyReconstructor::apply(const RawFrame &frame, ReplyRecord &out) {
+    if (ReplyKeyframeRecord key{}; frame.decode(key)) {
+        has_base_ = true;
+        publish_count_ = key.publish_count;
+        command_ = key.command;
+        length_ = key.bytes.size();
+        std::copy(key.bytes.begin(), key.bytes.end(), bytes_.begin());
+    } else if (ReplyDeltaRecord delta{}; frame.decode(delta)) {
+        // 差分の前のフレームをCRCエラー等で落としていたら、基準が合わないので使わない
+        const uint32_t expected = publish_count_ + 1;
+        if (!has_base_ || delta.seq != static_cast<uint8_t>(expected) ||
+            (delta.mask >> length_) != 0) {
+            has_base_ = false;
+            desyncs_++;
+            return Result::Desync;
+        }
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < length_; ++i) {
+            if ((delta.mask >> i) & 1u) {
+                bytes_[i] = delta.changed[next++];
+            }
+        }
+        publish_count_ = expected;
+    } else {
+        return Result::Malformed;
+    }
+
+    out = ReplyRecord{
+        .publish_count = publish_count_,
+        .command = command_,
+        .bytes = std::span<const uint8_t>(bytes_.data(), length_),
+    };
+    return Result::Reply;
+}
+
+} // namespace gcinput::telemetry::host
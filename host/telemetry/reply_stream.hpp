@@ -0,0 +1,43 @@
+#pragma once
+#include "telemetry/frame.hpp"
+#include "telemetry/records.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// 全件ストリーム（ReplyKeyframe/ReplyDelta）を応答の全バイトへ戻す
+// 符号化側はexamples/common/telemetry/reply_stream.hpp
+namespace gcinput::telemetry::host {
+
+// 復元した応答1件。bytesは復元器の中を指すので、次のフレームを渡すまでに使う
+struct ReplyRecord {
+    uint32_t publish_count{0};
+    uint8_t command{0};
+    std::span<const uint8_t> bytes{};
+};
+
+class ReplyReconstructor {
+  public:
+    enum class Result : uint8_t {
+        Reply,     // outへ1件復元した
+        Desync,    // 基準がない、または差分の取りこぼしに気づいた。次のキーフレームまで捨てる
+        Malformed, // ペイロードが定義と合わない
+    };
+
+    // ReplyKeyframeかReplyDeltaのフレームを1つ受け取る
+    Result apply(const RawFrame &frame, ReplyRecord &out);
+
+    // 捨てた差分の数
+    uint32_t desyncs() const { return desyncs_; }
+
+  private:
+    bool has_base_{false};
+    uint32_t publish_count_{0};
+    uint8_t command_{0};
+    std::size_t length_{0};
+    std::array<uint8_t, kMaxReplyBytes> bytes_{};
+    uint32_t desyncs_{0};
+};
+
+} // namespace gcinput::telemetry::host
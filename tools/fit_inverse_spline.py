@@ -0,0 +1,419 @@
+"""readings.csv から S⁻¹⁺ を近似する双3次Bスプラインを当てはめ、C++ ヘッダを生成する。
+
+256×256 の逆変換テーブル（generate_inverse_lut.py）は最も近いシードの値を写して隙間を埋めるので、
+出力が1カウントの段になり、表も 128KB ある。ここでは (mx, my) の各象限に、間隔 --spacing の
+一様な節点を持つ双3次Bスプラインを当てはめ、制御点を固定小数点で出力する（数KB）。
+象限に分けるのは、デッドゾーンで S⁻¹⁺ が 127 と 128 の間で大きく跳ぶため。
+
+  1. build_inverse のシード（計測した原像）のうち、補正パイプラインが引く入力 φ(C(m)) の
+     近く（--margin 以内）にあるものを集める
+  2. 象限ごとに、シードとの二乗誤差＋制御点の2階差分（--smoothing 倍）を最小にする制御点を解く
+  3. 原像が複数ある m のシードを、今のモデルの値に最も近い原像に選び直して 2 へ（--passes 回）
+  4. 制御点を Q4、基底の重みを Q12 に丸め、ファームウェアと同じ整数演算で評価して誤差を出す
+
+ファームウェアでの評価（domain/transform/correction.hpp の spline_lookup）は乗算とシフトだけで、
+除算を使わない（M0+ には除算器がない）。誤差は φ(C(m)) の全セルについて、往復誤差
+||S(P(m)) - m|| と隣り合う出力の2階差分（段の大きさ）を逆変換テーブルと比べて表示する。
+
+Usage:
+    uv run tools/fit_inverse_spline.py \
+        --input resources/switch2/20260205/readings.csv \
+        --output examples/bridge/domain/transform/inverse_spline_data.hpp
+"""
+
+import argparse
+import math
+import sys
+from datetime import datetime, timezone
+from pathlib import Path
+
+from generate_inverse_lut import N, bfs_fill, build_inverse, pipeline_domain, read_s_data
+
+# examples/bridge/domain/transform/correction.hpp の spline_lookup と同じ固定小数点
+CONTROL_BITS = 4  # 制御点 Q4
+WEIGHT_BITS = 12  # 基底の重み Q12（4つの和は 1 << WEIGHT_BITS）
+ROW_SHIFT = 8  # 行ごとの和 Q16 を Q8 へ落とす
+OUT_SHIFT = CONTROL_BITS + 2 * WEIGHT_BITS - ROW_SHIFT  # 最後の和 Q20 を整数へ
+# 制御点の範囲（カウント）。評価の途中が int32 に収まるように丸めた値をここへ収める
+CONTROL_MIN = -64
+CONTROL_MAX = 319
+HALF = N // 2  # 象限の大きさ
+
+
+def basis(u: float) -> list[float]:
+    """一様3次Bスプラインの基底（区間内の位置 0 <= u < 1）。"""
+    return [
+        (1 - u) ** 3 / 6,
+        (3 * u**3 - 6 * u**2 + 4) / 6,
+        (-3 * u**3 + 3 * u**2 + 3 * u + 1) / 6,
+        u**3 / 6,
+    ]
+
+
+def quantized_weights(spacing: int) -> list[list[int]]:
+    """区間内の位置 t = 0..spacing-1 ごとの基底の重み（和がちょうど 1 << WEIGHT_BITS）。"""
+    one = 1 << WEIGHT_BITS
+    table = []
+    for t in range(spacing):
+        w = [round(v * one) for v in basis(t / spacing)]
+        w[w.index(max(w))] += one - sum(w)
+        table.append(w)
+    return table
+
+
+def cell_position(m: int, shift: int) -> tuple[int, int, int]:
+    """入力の1軸を (象限, 区間, 区間内の位置) に分ける。"""
+    local = m & (HALF - 1)
+    return m // HALF, local >> shift, local & ((1 << shift) - 1)
+
+
+def dilate(cells: set[tuple[int, int]], radius: int) -> set[tuple[int, int]]:
+    """チェビシェフ距離 radius 以内へ広げる（軸ごとに広げれば正方形になる）。"""
+    grown = {(x + d, y) for x, y in cells for d in range(-radius, radius + 1)}
+    grown = {(x, y + d) for x, y in grown for d in range(-radius, radius + 1)}
+    return {(x, y) for x, y in grown if 0 <= x < N and 0 <= y < N}
+
+
+def solve_spd(a: list[list[float]], rhs: list[list[float]]) -> list[list[float]]:
+    """対称正定値の a について a·x = rhs を解く（コレスキー分解。rhs は右辺の列のリスト）。"""
+    n = len(a)
+    lower = [[0.0] * n for _ in range(n)]
+    for i in range(n):
+        row_i = lower[i]
+        for j in range(i + 1):
+            row_j = lower[j]
+            s = a[i][j] - sum(row_i[k] * row_j[k] for k in range(j))
+            row_i[j] = math.sqrt(s) if i == j else s / row_j[j]
+    solutions = []
+    for b in rhs:
+        z = [0.0] * n
+        for i in range(n):
+            z[i] = (b[i] - sum(lower[i][k] * z[k] for k in range(i))) / lower[i][i]
+        x = [0.0] * n
+        for i in range(n - 1, -1, -1):
+            x[i] = (z[i] - sum(lower[k][i] * x[k] for k in range(i + 1, n))) / lower[i][i]
+        solutions.append(x)
+    return solutions
+
+
+def fit_quadrant(
+    seeds: list[tuple[int, int, tuple[int, int]]], shift: int, smoothing: float
+) -> tuple[list[float], list[float]]:
+    """1象限の制御点（行優先、X と Y）を最小二乗で求める。"""
+    spacing = 1 << shift
+    points = (HALF >> shift) + 3
+    n = points * points
+    a = [[0.0] * n for _ in range(n)]
+    bx = [0.0] * n
+    by = [0.0] * n
+    for mx, my, (sx, sy) in seeds:
+        _, i, tx = cell_position(mx, shift)
+        _, j, ty = cell_position(my, shift)
+        wx = basis(tx / spacing)
+        wy = basis(ty / spacing)
+        terms = [
+            ((i + p) * points + (j + q), wx[p] * wy[q]) for p in range(4) for q in range(4)
+        ]
+        for index, w in terms:
+            bx[index] += w * sx
+            by[index] += w * sy
+            row = a[index]
+            for other, v in terms:
+                row[other] += w * v
+
+    # 2階差分の正則化。シードのない制御点も、隣からまっすぐ延ばした値に決まる
+    for i in range(points):
+        for j in range(points):
+            for di, dj in ((1, 0), (0, 1)):
+                if i + 2 * di >= points or j + 2 * dj >= points:
+                    continue
+                terms = [
+                    (i * points + j, 1.0),
+                    ((i + di) * points + (j + dj), -2.0),
+                    ((i + 2 * di) * points + (j + 2 * dj), 1.0),
+                ]
+                for index, w in terms:
+                    for other, v in terms:
+                        a[index][other] += smoothing * w * v
+
+    cx, cy = solve_spd(a, [bx, by])
+    return cx, cy
+
+
+def quantize(values: list[float]) -> list[int]:
+    lo, hi = CONTROL_MIN << CONTROL_BITS, CONTROL_MAX << CONTROL_BITS
+    return [max(lo, min(hi, round(v * (1 << CONTROL_BITS)))) for v in values]
+
+
+class SplineModel:
+    """固定小数点の制御点。evaluate はファームウェアの spline_lookup と同じ結果を返す。"""
+
+    def __init__(self, shift: int, x: list[list[int]], y: list[list[int]]):
+        self.shift = shift
+        self.points = (HALF >> shift) + 3
+        self.weights = quantized_weights(1 << shift)
+        self.x = x  # 象限 (mx >= 128) * 2 + (my >= 128) ごとの制御点
+        self.y = y
+
+    def _axis(self, control: list[int], i: int, j: int, wx: list[int], wy: list[int]) -> int:
+        acc = 0
+        for p in range(4):
+            base = (i + p) * self.points + j
+            row = sum(wy[q] * control[base + q] for q in range(4))
+            acc += wx[p] * ((row + (1 << (ROW_SHIFT - 1))) >> ROW_SHIFT)
+        return max(0, min(255, (acc + (1 << (OUT_SHIFT - 1))) >> OUT_SHIFT))
+
+    def evaluate(self, mx: int, my: int) -> tuple[int, int]:
+        qx, i, tx = cell_position(mx, self.shift)
+        qy, j, ty = cell_position(my, self.shift)
+        quadrant = qx * 2 + qy
+        wx = self.weights[tx]
+        wy = self.weights[ty]
+        return (
+            self._axis(self.x[quadrant], i, j, wx, wy),
+            self._axis(self.y[quadrant], i, j, wx, wy),
+        )
+
+    def size_bytes(self) -> int:
+        return 2 * 4 * self.points * self.points * 2 + len(self.weights) * 4 * 2
+
+
+def preimages(
+    s_data: list[list[tuple[int, int] | None]],
+) -> dict[tuple[int, int], list[tuple[int, int]]]:
+    """m ごとの計測した原像 s の一覧。"""
+    result: dict[tuple[int, int], list[tuple[int, int]]] = {}
+    for sx in range(N):
+        for sy in range(N):
+            entry = s_data[sx][sy]
+            if entry is not None:
+                result.setdefault(entry, []).append((sx, sy))
+    return result
+
+
+def fit_spline(
+    s_data: list[list[tuple[int, int] | None]],
+    inv_s: list[list[tuple[int, int] | None]],
+    domain: set[tuple[int, int]],
+    shift: int,
+    smoothing: float,
+    margin: int,
+    passes: int,
+) -> tuple[SplineModel, int]:
+    """φ(C(m)) の近くのシードに当てはめたモデルと、使ったシードの数を返す。
+
+    デッドゾーンやゲートで張り付く m には原像がたくさんあり、build_inverse の後勝ちの値は
+    その端のどれかになる。2回目からは前のモデルの値に最も近い原像をシードにして当てはめ直す。
+    """
+    near = dilate(domain, margin)
+    candidates = preimages(s_data)
+    seeds = {
+        (mx, my): inv_s[mx][my]
+        for mx in range(N)
+        for my in range(N)
+        if inv_s[mx][my] is not None and (mx, my) in near
+    }
+    model = None
+    for _ in range(passes):
+        if model is not None:
+            for m in seeds:
+                px, py = model.evaluate(*m)
+                seeds[m] = min(
+                    candidates[m], key=lambda s: (s[0] - px) ** 2 + (s[1] - py) ** 2
+                )
+        x, y = [], []
+        for quadrant in range(4):
+            qx, qy = divmod(quadrant, 2)
+            quadrant_seeds = [
+                (mx, my, s) for (mx, my), s in seeds.items() if (mx // HALF, my // HALF) == (qx, qy)
+            ]
+            cx, cy = fit_quadrant(quadrant_seeds, shift, smoothing)
+            x.append(quantize(cx))
+            y.append(quantize(cy))
+        model = SplineModel(shift, x, y)
+    return model, len(seeds)
+
+
+def summarize(values: list[float]) -> str:
+    if not values:
+        return "(なし)"
+    values = sorted(values)
+
+    def pct(p: float) -> float:
+        return values[min(len(values) - 1, int(len(values) * p))]
+
+    mean = sum(values) / len(values)
+    return f"max={values[-1]:6.2f} mean={mean:5.2f} p95={pct(0.95):5.2f} p99={pct(0.99):5.2f}"
+
+
+def roundtrip_errors(s_data, domain, lookup) -> list[float]:
+    """||S(P(m)) - m||。P(m) の S を計測していないセルは数えない。"""
+    errors = []
+    for mx, my in domain:
+        sx, sy = lookup(mx, my)
+        entry = s_data[sx][sy]
+        if entry is not None:
+            errors.append(math.hypot(entry[0] - mx, entry[1] - my))
+    return errors
+
+
+def step_sizes(domain, lookup) -> list[float]:
+    """隣り合う3セルの出力の2階差分（軸ごと、成分ごと）の大きさ。"""
+    steps = []
+    for mx, my in domain:
+        for dx, dy in ((1, 0), (0, 1)):
+            prev, succ = (mx - dx, my - dy), (mx + dx, my + dy)
+            if prev not in domain or succ not in domain:
+                continue
+            a, b, c = lookup(*prev), lookup(mx, my), lookup(*succ)
+            steps.extend(abs(a[k] - 2 * b[k] + c[k]) for k in range(2))
+    return steps
+
+
+def report(s_data, inv_sf, domain, model: SplineModel) -> str:
+    """逆変換テーブルとスプラインの誤差を表示し、ヘッダに残す1行を返す。"""
+
+    def table(mx: int, my: int) -> tuple[int, int]:
+        return inv_sf[mx][my]
+
+    spline = model.evaluate
+    lut_rt = roundtrip_errors(s_data, domain, table)
+    spline_rt = roundtrip_errors(s_data, domain, spline)
+    candidates = preimages(s_data)
+    preimage_error = []
+    for m in domain:
+        if m in candidates:
+            px, py = spline(*m)
+            preimage_error.append(min(math.hypot(px - sx, py - sy) for sx, sy in candidates[m]))
+    lut_steps = step_sizes(domain, table)
+    spline_steps = step_sizes(domain, spline)
+
+    def large(steps: list[float]) -> str:
+        return f"{100 * sum(1 for s in steps if s >= 2) / len(steps):.1f}%"
+
+    print(f"誤差（φ(C(m)) の {len(domain)} セル）")
+    print(f"  往復 ||S(P(m)) - m||  表:       {summarize(lut_rt)} ({len(lut_rt)} セル)")
+    print(f"                        スプライン: {summarize(spline_rt)} ({len(spline_rt)} セル)")
+    print(
+        f"  最も近い原像との差 ||P(m) - s||  {summarize(preimage_error)} "
+        f"({len(preimage_error)} セル)"
+    )
+    print(
+        f"  段 |Δ²P|              表:       mean={sum(lut_steps) / len(lut_steps):.3f}, "
+        f"2以上 {large(lut_steps)}"
+    )
+    print(
+        f"                        スプライン: mean={sum(spline_steps) / len(spline_steps):.3f}, "
+        f"2以上 {large(spline_steps)}"
+    )
+    print(f"  大きさ                表: {2 * N * N} バイト, スプライン: {model.size_bytes()} バイト")
+    return f"round trip {summarize(spline_rt)} (table: {summarize(lut_rt)})"
+
+
+def emit_header(
+    model: SplineModel,
+    smoothing: float,
+    seeds: int,
+    summary: str,
+    input_path: Path,
+    output_path: Path,
+) -> None:
+    """制御点と基底の重みの C++ ヘッダを生成する。"""
+    now = datetime.now(timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+    points = model.points
+
+    with open(output_path, "w") as f:
+        f.write("// Auto-generated by tools/fit_inverse_spline.py\n")
+        f.write(f"// Source: {input_path}\n")
+        f.write(f"// Generated: {now}\n")
+        f.write(
+            f"// Knot spacing {1 << model.shift}, smoothing {smoothing}, seeds {seeds}, "
+            f"{model.size_bytes()} bytes\n"
+        )
+        f.write(f"// {summary}\n")
+        f.write("#pragma once\n")
+        f.write("#include <cstdint>\n")
+        f.write("\n")
+        f.write("namespace gcinput::domain::transform::correction {\n")
+        f.write("\n")
+        f.write(f"inline constexpr uint8_t kSplineShift = {model.shift};\n")
+        f.write(f"inline constexpr uint8_t kSplineControlPoints = {points};\n")
+        f.write("\n")
+        f.write("// clang-format off\n")
+        f.write(f"inline constexpr int16_t kSplineWeights[{1 << model.shift}][4] = {{\n")
+        for w in model.weights:
+            f.write(f"  {{{','.join(str(v) for v in w)}}},\n")
+        f.write("};\n")
+        f.write("// clang-format on\n")
+        f.write("\n")
+        for name, control in (("kSplineX", model.x), ("kSplineY", model.y)):
+            f.write("// clang-format off\n")
+            f.write(f"inline constexpr int16_t {name}[4][{points}][{points}] = {{\n")
+            for quadrant in control:
+                f.write("  {\n")
+                for i in range(points):
+                    row = quadrant[i * points : (i + 1) * points]
+                    f.write(f"    {{{','.join(str(v) for v in row)}}},\n")
+                f.write("  },\n")
+            f.write("};\n")
+            f.write("// clang-format on\n")
+            f.write("\n")
+        f.write("} // namespace gcinput::domain::transform::correction\n")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description="readings.csv から S⁻¹⁺ を近似するスプラインの C++ ヘッダを生成する"
+    )
+    parser.add_argument("--input", type=Path, required=True, help="readings.csv のパス")
+    parser.add_argument(
+        "--output", type=Path, help="出力する C++ ヘッダのパス（省略すると誤差だけ表示する）"
+    )
+    parser.add_argument(
+        "--spacing",
+        type=int,
+        choices=[8, 16, 32],
+        default=16,
+        help="節点の間隔（カウント）。狭いほど元の写像に近く、制御点が増える",
+    )
+    parser.add_argument(
+        "--smoothing", type=float, default=0.001, help="制御点の2階差分に掛ける重み"
+    )
+    parser.add_argument(
+        "--passes", type=int, default=3, help="シードの原像を選び直して当てはめる回数"
+    )
+    parser.add_argument(
+        "--margin",
+        type=int,
+        help="φ(C(m)) からこの距離までのシードを使う（省略時は --spacing と同じ）",
+    )
+    args = parser.parse_args()
+
+    if not args.input.exists():
+        print(f"エラー: {args.input} が見つかりません", file=sys.stderr)
+        sys.exit(1)
+
+    s_data = read_s_data(args.input)
+    inv_s = build_inverse(s_data)
+    if all(cell is None for row in inv_s for cell in row):
+        print("エラー: 逆変換テーブルにシードが1つもありません。入力CSVが空か全欠損です", file=sys.stderr)
+        sys.exit(1)
+    inv_sf, _, _ = bfs_fill(inv_s)
+
+    domain = pipeline_domain()
+    shift = args.spacing.bit_length() - 1
+    margin = args.spacing if args.margin is None else args.margin
+    model, seeds = fit_spline(
+        s_data, inv_s, domain, shift, args.smoothing, margin, max(1, args.passes)
+    )
+    print(f"当てはめ: 節点の間隔 {args.spacing}, シード {seeds}, 片軸の制御点 {model.points}")
+    summary = report(s_data, inv_sf, domain, model)
+
+    if args.output is not None:
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        emit_header(model, args.smoothing, seeds, summary, args.input, args.output)
+        print(f"出力: {args.output}")
+
+
+if __name__ == "__main__":
+    main()
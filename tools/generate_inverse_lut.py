@@ -1,21 +1,59 @@
 """readings.csv から S⁻¹⁺ (BFS補間付き逆変換) の C++ LUT ヘッダを生成する。
 
+--format profile ではヘッダの代わりに、bridge のフラッシュのスロットへ書く補正プロファイルを
+生成する（形式は examples/bridge/calibration/profile_format.hpp）。--format forward は逆変換
+テーブルの代わりに計測した順方向の写像だけを入れたプロファイルで、bridge が選んだときに
+build_inverse と bfs_fill と同じ表を RAM に組み立てる（domain/transform/inverse_builder.hpp）。
+
+--format folded は表の対称性（(127.5, 127.5) を中心とする八分円か象限）を確かめ、成り立てば
+折り畳んだ表と対称にならないセルの例外を inverse_lut_folded_data.hpp として出力する。確かめるのは
+補正パイプラインが引く入力 φ(C(m)) だけで、その範囲では --fold-tolerance 以内で元の表を再現する。
+
 Usage:
     uv run tools/generate_inverse_lut.py \
         --input resources/switch2/20260205/readings.csv \
         --output examples/bridge/domain/transform/inverse_lut_data.hpp
+
+    uv run tools/generate_inverse_lut.py --format profile --name switch2-20260205 \
+        --input resources/switch2/20260205/readings.csv \
+        --output build/profile.bin
+
+    uv run tools/generate_inverse_lut.py --format forward --name switch2-20260205 \
+        --input resources/switch2/20260205/readings.csv \
+        --output build/forward.bin
+
+    uv run tools/generate_inverse_lut.py --format folded \
+        --input resources/switch2/20260205/readings.csv \
+        --output examples/bridge/domain/transform/inverse_lut_folded_data.hpp
 """
 
 import argparse
 import csv
 import math
+import struct
 import sys
+import zlib
 from collections import deque
 from datetime import datetime, timezone
 from pathlib import Path
 
 N = 256
 
+# examples/bridge/calibration/profile_format.hpp
+PROFILE_MAGIC = 0x46504347  # "GCPF"
+PROFILE_VERSION = 2
+PROFILE_HEADER = struct.Struct("<IHHHHIIII32s")  # header_crc の手前まで
+PROFILE_HEADER_SIZE = PROFILE_HEADER.size + 4
+PROFILE_DATA_OFFSET = 4096
+PROFILE_NAME_BYTES = 32
+PROFILE_KIND_INVERSE_TABLE = 0
+PROFILE_KIND_FORWARD_MAP = 1
+
+# examples/bridge/domain/transform/correction.hpp の octagon_clamp と linear_scale（Q15）
+COS8_Q15 = 30274
+SIN8_Q15 = 12540
+APOTHEM125_Q15 = 125 * COS8_Q15
+
 
 def read_s_data(path: Path) -> list[list[tuple[int, int] | None]]:
     """readings.csv を読み込み S[sx][sy] = (gx+128, gy+128) を構築する。"""
@@ -187,6 +225,242 @@ def emit_header(
         f.write(f"}} // namespace gcinput::domain::transform::correction\n")
 
 
+def inverse_table_data(inv_sf: list[list[tuple[int, int]]]) -> bytes:
+    """逆変換テーブルのプロファイルのデータ（X表＋Y表）。"""
+    return bytes(inv_sf[mx][my][0] for mx in range(N) for my in range(N)) + bytes(
+        inv_sf[mx][my][1] for mx in range(N) for my in range(N)
+    )
+
+
+def forward_map_data(s_data: list[list[tuple[int, int] | None]]) -> bytes:
+    """順方向の写像のプロファイルのデータ（計測したビット＋計測した s の順の (mx, my)）。"""
+    measured = bytearray(N * N // 8)
+    points = bytearray()
+    for sx in range(N):
+        for sy in range(N):
+            entry = s_data[sx][sy]
+            if entry is None:
+                continue
+            s = sx * N + sy
+            measured[s // 8] |= 1 << (s % 8)
+            points += bytes(entry)
+    return bytes(measured) + bytes(points)
+
+
+def build_profile(kind: int, data: bytes, source: bytes, name: str, created: int) -> bytes:
+    """フラッシュのスロットへ書くプロファイル（ヘッダ1セクタ＋データ）を組み立てる。"""
+    encoded_name = name.encode("utf-8")[: PROFILE_NAME_BYTES - 1]
+    header = PROFILE_HEADER.pack(
+        PROFILE_MAGIC,
+        PROFILE_VERSION,
+        PROFILE_HEADER_SIZE,
+        kind,
+        0,
+        len(data),
+        zlib.crc32(data),
+        zlib.crc32(source),
+        created,
+        encoded_name.ljust(PROFILE_NAME_BYTES, b"\0"),
+    )
+    header += struct.pack("<I", zlib.crc32(header))
+    return header + b"\xff" * (PROFILE_DATA_OFFSET - len(header)) + data
+
+
+def emit_profile(kind: int, data: bytes, input_path: Path, output_path: Path, name: str) -> None:
+    source = input_path.read_bytes()
+    profile = build_profile(
+        kind, data, source, name, int(datetime.now(timezone.utc).timestamp())
+    )
+    output_path.write_bytes(profile)
+    print(f"プロファイル: {name} source_hash={zlib.crc32(source):08x} ({len(profile)} バイト)")
+
+
+def _trunc_div(a: int, b: int) -> int:
+    """C++ の整数除算（0 方向への切り捨て）。"""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def _clamp_u8(v: int) -> int:
+    return max(0, min(255, v))
+
+
+def octagon_clamp(x: int, y: int) -> tuple[int, int]:
+    """C: Oct(125) への放射クランプ（ファームウェアと同じ整数演算）。"""
+    px, py = x - 128, y - 128
+    c = [
+        COS8_Q15 * px + SIN8_Q15 * py,
+        COS8_Q15 * px - SIN8_Q15 * py,
+        SIN8_Q15 * px + COS8_Q15 * py,
+        SIN8_Q15 * px - COS8_Q15 * py,
+    ]
+    max_abs = max(abs(v) for v in c)
+    if max_abs <= APOTHEM125_Q15:
+        return x, y
+    return (
+        _clamp_u8(_trunc_div(px * APOTHEM125_Q15, max_abs) + 128),
+        _clamp_u8(_trunc_div(py * APOTHEM125_Q15, max_abs) + 128),
+    )
+
+
+def linear_scale(x: int, y: int) -> tuple[int, int]:
+    """φ: k = 4/5（0 から遠ざかる向きに四捨五入）。"""
+
+    def axis(p: int) -> int:
+        return (p * 4 + 2) // 5 if p >= 0 else -(((-p) * 4 + 2) // 5)
+
+    return _clamp_u8(axis(x - 128) + 128), _clamp_u8(axis(y - 128) + 128)
+
+
+def pipeline_domain() -> set[tuple[int, int]]:
+    """補正パイプラインが逆変換テーブルを引く入力 φ(C(m)) の集合。"""
+    return {linear_scale(*octagon_clamp(x, y)) for x in range(N) for y in range(N)}
+
+
+def fold_cell(mx: int, my: int, octant: bool) -> tuple[int, bool, bool, bool]:
+    """(mx, my) を折り畳んだセルの番号と、x を反転したか、y を反転したか、入れ替えたかを返す。
+
+    軸は 127.5（m と 255 − m が対になる）。八分円では a >= b の三角形に寄せる。
+    """
+    rx, ry = mx < 128, my < 128
+    a = 127 - mx if rx else mx - 128
+    b = 127 - my if ry else my - 128
+    swap = octant and b > a
+    if swap:
+        a, b = b, a
+    index = a * (a + 1) // 2 + b if octant else a * 128 + b
+    return index, rx, ry, swap
+
+
+def to_canonical(value: tuple[int, int], rx: bool, ry: bool, swap: bool) -> tuple[int, int]:
+    u, v = value
+    if rx:
+        u = 255 - u
+    if ry:
+        v = 255 - v
+    return (v, u) if swap else (u, v)
+
+
+def fold_inverse(
+    inv_sf: list[list[tuple[int, int]]], domain: set[tuple[int, int]], octant: bool, tolerance: int
+) -> tuple[list[tuple[int, int]], list[tuple[int, int, int]], int]:
+    """折り畳んだ表、例外 [(mx<<8|my, x, y)]、domain での最大誤差を返す。
+
+    折り畳んだセルの値は、そこへ寄るセルのうち tolerance 以内に収まる数が最も多い値にする。
+    domain のセルで tolerance を超えるものは例外として元の値を持つ。domain のセルが寄らない
+    折り畳んだセルは domain の外のセルから同じように選ぶ（パイプラインからは引かれない）。
+    """
+    cells = 128 * 129 // 2 if octant else 128 * 128
+    members: list[list[tuple[tuple[int, int], tuple[int, int]]]] = [[] for _ in range(cells)]
+    for mx in range(N):
+        for my in range(N):
+            index, rx, ry, swap = fold_cell(mx, my, octant)
+            members[index].append(((mx, my), to_canonical(inv_sf[mx][my], rx, ry, swap)))
+
+    def distance(p: tuple[int, int], q: tuple[int, int]) -> int:
+        return max(abs(p[0] - q[0]), abs(p[1] - q[1]))
+
+    folded: list[tuple[int, int]] = []
+    exceptions: list[tuple[int, int, int]] = []
+    max_error = 0
+    for group in members:
+        in_domain = [value for m, value in group if m in domain]
+        candidates = in_domain or [value for _, value in group]
+        best = max(
+            candidates,
+            key=lambda c: sum(1 for value in candidates if distance(value, c) <= tolerance),
+        )
+        folded.append(best)
+        for (mx, my), value in group:
+            if (mx, my) not in domain:
+                continue
+            error = distance(value, best)
+            if error > tolerance:
+                exceptions.append(((mx << 8) | my, inv_sf[mx][my][0], inv_sf[mx][my][1]))
+            else:
+                max_error = max(max_error, error)
+    exceptions.sort()
+    return folded, exceptions, max_error
+
+
+def emit_folded_header(
+    folded: list[tuple[int, int]],
+    exceptions: list[tuple[int, int, int]],
+    octant: bool,
+    tolerance: int,
+    max_error: int,
+    input_path: Path,
+    output_path: Path,
+) -> None:
+    """折り畳んだ表の C++ ヘッダを生成する。"""
+    now = datetime.now(timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+    symmetry = "octant" if octant else "quadrant"
+
+    def array(f, ctype: str, name: str, values: list[int], rows: list[int]) -> None:
+        # 空の配列は書けないので、例外がなくても1要素は置く（数は kFoldedExceptionCount）
+        values = values or [0]
+        f.write("// clang-format off\n")
+        f.write(f"inline constexpr {ctype} {name}[{len(values)}] = {{\n")
+        start = 0
+        for length in rows or [len(values)]:
+            f.write(f"  {','.join(str(v) for v in values[start : start + length])},\n")
+            start += length
+        f.write("};\n")
+        f.write("// clang-format on\n")
+        f.write("\n")
+
+    # 八分円は a ごとの三角形の行（a+1 個）、象限は 128 個ずつで改行する
+    rows = [a + 1 for a in range(128)] if octant else [128] * 128
+    exception_rows = [32] * (len(exceptions) // 32) + (
+        [len(exceptions) % 32] if len(exceptions) % 32 else []
+    )
+
+    with open(output_path, "w") as f:
+        f.write("// Auto-generated by tools/generate_inverse_lut.py --format folded\n")
+        f.write(f"// Source: {input_path}\n")
+        f.write(f"// Generated: {now}\n")
+        f.write(
+            f"// Symmetry: {symmetry}, tolerance {tolerance} (max error {max_error}), "
+            f"cells {len(folded)}, exceptions {len(exceptions)}\n"
+        )
+        f.write("#pragma once\n")
+        f.write("#include <cstdint>\n")
+        f.write("\n")
+        f.write("namespace gcinput::domain::transform::correction {\n")
+        f.write("\n")
+        f.write(f"inline constexpr bool kFoldedLutOctant = {'true' if octant else 'false'};\n")
+        f.write(f"inline constexpr uint16_t kFoldedExceptionCount = {len(exceptions)};\n")
+        f.write("\n")
+        array(f, "uint8_t", "kFoldedLutX", [v[0] for v in folded], rows)
+        array(f, "uint8_t", "kFoldedLutY", [v[1] for v in folded], rows)
+        array(f, "uint16_t", "kFoldedExceptionCells", [e[0] for e in exceptions], exception_rows)
+        array(f, "uint8_t", "kFoldedExceptionX", [e[1] for e in exceptions], exception_rows)
+        array(f, "uint8_t", "kFoldedExceptionY", [e[2] for e in exceptions], exception_rows)
+        f.write("} // namespace gcinput::domain::transform::correction\n")
+
+
+def fold_or_exit(
+    inv_sf: list[list[tuple[int, int]]], symmetry: str, tolerance: int, max_exceptions: int
+) -> tuple[list[tuple[int, int]], list[tuple[int, int, int]], bool, int]:
+    """対称性を確かめ、成り立つ折り畳み方（auto なら八分円、だめなら象限）を返す。"""
+    domain = pipeline_domain()
+    choices = {"auto": [True, False], "octant": [True], "quadrant": [False]}[symmetry]
+    for octant in choices:
+        folded, exceptions, max_error = fold_inverse(inv_sf, domain, octant, tolerance)
+        name = "八分円" if octant else "象限"
+        print(
+            f"折り畳み（{name}）: {len(folded)} セル, 例外 {len(exceptions)} / {len(domain)} セル, "
+            f"最大誤差 {max_error}"
+        )
+        if len(exceptions) <= max_exceptions:
+            return folded, exceptions, octant, max_error
+    print(
+        f"エラー: 例外が {max_exceptions} を超える。表は対称ではない（--fold-tolerance を確かめる）",
+        file=sys.stderr,
+    )
+    sys.exit(1)
+
+
 def main() -> None:
     parser = argparse.ArgumentParser(
         description="readings.csv から S⁻¹⁺ の C++ LUT ヘッダを生成する"
@@ -201,7 +475,36 @@ def main() -> None:
         "--output",
         type=Path,
         required=True,
-        help="出力する C++ ヘッダのパス",
+        help="出力する C++ ヘッダ（--format profile/forward ならプロファイル）のパス",
+    )
+    parser.add_argument(
+        "--format",
+        choices=["header", "profile", "forward", "folded"],
+        default="header",
+        help="header: inverse_lut_data.hpp, profile: フラッシュのスロットへ書く逆変換テーブル, "
+        "forward: フラッシュのスロットへ書く順方向の写像, folded: inverse_lut_folded_data.hpp",
+    )
+    parser.add_argument(
+        "--fold-symmetry",
+        choices=["auto", "octant", "quadrant"],
+        default="auto",
+        help="--format folded の対称性（auto: 八分円、例外が多すぎれば象限）",
+    )
+    parser.add_argument(
+        "--fold-tolerance",
+        type=int,
+        default=0,
+        help="--format folded で折り畳んだ値を使ってよい誤差（各軸のカウント。超えたセルは例外）",
+    )
+    parser.add_argument(
+        "--fold-max-exceptions",
+        type=int,
+        default=2048,
+        help="--format folded で対称とみなす例外の数の上限",
+    )
+    parser.add_argument(
+        "--name",
+        help="プロファイルの名前（31バイトまで。省略時は入力のディレクトリ名）",
     )
     args = parser.parse_args()
 
@@ -230,9 +533,26 @@ def main() -> None:
     max_error, mean_error, count = compute_roundtrip_stats(s_data, inv_sf)
     print(f"往復誤差: max={max_error:.3f}, mean={mean_error:.3f} ({count} セル)")
 
-    # C++ ヘッダ出力
     args.output.parent.mkdir(parents=True, exist_ok=True)
-    emit_header(s_data, inv_sf, exact, args.input, args.output)
+    name = args.name or args.input.parent.name
+    if args.format == "profile":
+        emit_profile(
+            PROFILE_KIND_INVERSE_TABLE, inverse_table_data(inv_sf), args.input, args.output, name
+        )
+    elif args.format == "forward":
+        emit_profile(
+            PROFILE_KIND_FORWARD_MAP, forward_map_data(s_data), args.input, args.output, name
+        )
+    elif args.format == "folded":
+        folded, exceptions, octant, fold_error = fold_or_exit(
+            inv_sf, args.fold_symmetry, args.fold_tolerance, args.fold_max_exceptions
+        )
+        emit_folded_header(
+            folded, exceptions, octant, args.fold_tolerance, fold_error, args.input, args.output
+        )
+    else:
+        # C++ ヘッダ出力
+        emit_header(s_data, inv_sf, exact, args.input, args.output)
     print(f"出力: {args.output}")
 
 
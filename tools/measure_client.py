@@ -0,0 +1,221 @@
+"""計測ファームウェア (examples/measure) へスティックの値を直接送り、コンソールへ出たフレームを受け取る。
+
+ファームウェアは `V,seq,target,x,y,frames` を待ち行列に積み、1つずつ frames フレームだけコンソールへ見せる。
+値を送り始めると、そのフレーム番号（コンソールのStatus要求の数）を MeasureAck レコードで返す。
+OCRで読めなかった点だけをすぐ測り直すのに使う（全点走査をやり直さずに済む）。
+
+Usage:
+    # 1点ずつ指定
+    uv run tools/measure_client.py --port /dev/ttyUSB0 --value stick,128,255,10 --value stick,0,0,10
+
+    # 測り直す点のCSV（sx,sy列。frames列があればその値）
+    uv run tools/measure_client.py --port /dev/ttyUSB0 --points retry.csv --target stick \
+        --output live.csv
+"""
+
+import argparse
+import csv
+import os
+import select
+import sys
+import termios
+import time
+from dataclasses import dataclass
+from pathlib import Path
+
+from measurement_lib.telemetry import (
+    ACK_FULL,
+    ACK_LIVE,
+    ACK_REJECTED,
+    ACK_STATUS_NAMES,
+    FrameReader,
+    parse_measure_ack,
+    parse_text,
+)
+
+# ファームウェアの SweepTarget
+TARGETS = {"stick": 0, "cstick": 1, "trigger": 2}
+# ファームウェアの HostValueQueue::kCapacity / kMaxFrames
+QUEUE_CAPACITY = 64
+MAX_FRAMES = 600
+# 1フレームの長さの目安（最後の値を見せ終わるまで待つのに使う）
+FRAME_S = 1 / 60
+
+
+@dataclass
+class Value:
+    seq: int
+    target: int
+    x: int
+    y: int
+    frames: int
+
+    @property
+    def line(self) -> str:
+        return f"V,{self.seq},{self.target},{self.x},{self.y},{self.frames}"
+
+
+def parse_target(text: str) -> int:
+    if text in TARGETS:
+        return TARGETS[text]
+    target = int(text)
+    if target not in TARGETS.values():
+        raise ValueError(f"target は {'/'.join(TARGETS)} か 0..2: {text}")
+    return target
+
+
+def check_value(v: Value):
+    if not (0 <= v.x <= 255 and 0 <= v.y <= 255):
+        raise ValueError(f"値は 0..255: {v.x},{v.y}")
+    if not (1 <= v.frames <= MAX_FRAMES):
+        raise ValueError(f"frames は 1..{MAX_FRAMES}: {v.frames}")
+
+
+def values_from_args(args) -> list[Value]:
+    values: list[Value] = []
+    for text in args.value or []:
+        fields = text.split(",")
+        if len(fields) != 4:
+            raise ValueError(f"--value は target,x,y,frames: {text}")
+        target, x, y, frames = parse_target(fields[0]), *map(int, fields[1:])
+        values.append(Value(len(values) + 1, target, x, y, frames))
+    if args.points is not None:
+        target = parse_target(args.target)
+        with open(args.points, newline="") as f:
+            for row in csv.DictReader(f):
+                frames = int(row["frames"]) if row.get("frames") else args.frames
+                values.append(
+                    Value(len(values) + 1, target, int(row["sx"]), int(row["sy"]), frames)
+                )
+    for v in values:
+        check_value(v)
+    return values
+
+
+def open_port(port: str, baudrate: int) -> int:
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, f"B{baudrate}")
+    attrs[0] = 0  # iflag
+    attrs[1] = 0  # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0  # lflag
+    attrs[4] = speed
+    attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+class Client:
+    def __init__(self, fd: int, verbose: bool):
+        self.fd = fd
+        self.verbose = verbose
+        self.reader = FrameReader()
+
+    def send(self, line: str):
+        os.write(self.fd, (line + "\n").encode("ascii"))
+
+    def poll(self, timeout_s: float):
+        """届いた応答を返す。ログ行は --verbose のときだけ表示する。"""
+        ready, _, _ = select.select([self.fd], [], [], timeout_s)
+        if not ready:
+            return []
+        acks = []
+        for frame in self.reader.feed(os.read(self.fd, 4096)):
+            ack = parse_measure_ack(frame)
+            if ack is not None:
+                acks.append(ack)
+                continue
+            text = parse_text(frame)
+            if text is not None and self.verbose:
+                print(f"# {text.rstrip()}", file=sys.stderr)
+        return acks
+
+
+def run(client: Client, values: list[Value], window: int, timeout_s: float):
+    """待ち行列があふれないよう window 個ずつ送り、値ごとのフレーム番号を返す。"""
+    by_seq = {v.seq: v for v in values}
+    waiting = list(values)  # まだ送っていない（満杯で断られた分も戻す）
+    in_flight: set[int] = set()
+    live: dict[int, int] = {}
+    last_progress = time.monotonic()
+
+    while len(live) < len(values):
+        while waiting and len(in_flight) < window:
+            v = waiting.pop(0)
+            client.send(v.line)
+            in_flight.add(v.seq)
+        for ack in client.poll(0.05):
+            last_progress = time.monotonic()
+            if client.verbose:
+                name = ACK_STATUS_NAMES.get(ack.status, str(ack.status))
+                print(f"# ack {name} seq={ack.seq} frame={ack.console_frame}", file=sys.stderr)
+            if ack.status == ACK_LIVE and ack.seq in in_flight:
+                in_flight.discard(ack.seq)
+                live[ack.seq] = ack.console_frame
+                v = by_seq[ack.seq]
+                print(f"{v.seq},{v.target},{v.x},{v.y},{ack.console_frame}")
+            elif ack.status == ACK_FULL and ack.seq in in_flight:
+                # 前の値を見せ終わるまで待ってから送り直す
+                in_flight.discard(ack.seq)
+                waiting.insert(0, by_seq[ack.seq])
+                window = max(1, len(in_flight))
+            elif ack.status == ACK_REJECTED:
+                raise RuntimeError("ファームウェアが値の指示を読めなかった")
+        if time.monotonic() - last_progress > timeout_s:
+            raise TimeoutError(f"{timeout_s}秒応答がない（{len(live)}/{len(values)} 点）")
+    return live
+
+
+def main():
+    parser = argparse.ArgumentParser(description="計測ファームウェアへ値を直接送る")
+    parser.add_argument("--port", required=True, help="計測ファームウェアのシリアルポート")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument(
+        "--value", action="append", help="target,x,y,frames（targetは stick/cstick/trigger）"
+    )
+    parser.add_argument("--points", type=Path, help="測り直す点のCSV（sx,sy[,frames]）")
+    parser.add_argument("--target", default="stick", help="--points の点を入れる軸")
+    parser.add_argument("--frames", type=int, default=10, help="--points で frames 列がないとき")
+    parser.add_argument(
+        "--window", type=int, default=QUEUE_CAPACITY // 2, help="送ったまま待つ値の数"
+    )
+    parser.add_argument("--output", type=Path, help="値ごとのフレーム番号を書き出すCSV")
+    parser.add_argument("--keep", action="store_true", help="終わってもパターンへ戻さない")
+    parser.add_argument("--timeout", type=float, default=30.0, help="応答がないときに諦める秒数")
+    parser.add_argument("--verbose", action="store_true", help="応答とログも表示する")
+    args = parser.parse_args()
+
+    try:
+        values = values_from_args(args)
+    except (ValueError, KeyError) as e:
+        print(f"エラー: {e}", file=sys.stderr)
+        sys.exit(1)
+    if not values:
+        print("エラー: --value か --points を指定してください", file=sys.stderr)
+        sys.exit(1)
+
+    fd = open_port(args.port, args.baudrate)
+    client = Client(fd, args.verbose)
+    window = max(1, min(args.window, QUEUE_CAPACITY))
+    try:
+        print("seq,target,x,y,console_frame")
+        live = run(client, values, window, args.timeout)
+        if not args.keep:
+            # 最後の値を見せ終わってからパターンへ戻す
+            time.sleep(values[-1].frames * FRAME_S)
+            client.send("X")
+    finally:
+        os.close(fd)
+
+    if args.output is not None:
+        with open(args.output, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["seq", "target", "x", "y", "frames", "console_frame"])
+            for v in values:
+                writer.writerow([v.seq, v.target, v.x, v.y, v.frames, live[v.seq]])
+        print(f"書き出し: {args.output}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -13,6 +13,14 @@ from .ocr_templates import (
     load_templates,
 )
 from .roi_io import Roi, crop, ensure_roi_names, load_rois
+from .telemetry import (
+    FrameReader,
+    MeasureAck,
+    MeasureSample,
+    ProfileAck,
+    parse_measure_ack,
+    parse_profile_ack,
+)
 
 __all__ = [
     "AggregatedRow",
@@ -31,4 +39,10 @@ __all__ = [
     "crop",
     "ensure_roi_names",
     "load_rois",
+    "FrameReader",
+    "MeasureAck",
+    "MeasureSample",
+    "ProfileAck",
+    "parse_measure_ack",
+    "parse_profile_ack",
 ]
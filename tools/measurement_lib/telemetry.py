@@ -0,0 +1,187 @@
+"""ファームウェアのテレメトリフレーム (examples/common/telemetry/) をPythonで読む。
+
+フレームは COBS(type | timestamp_us(varint) | payload | CRC-8) 0x00。
+ホストのC++版 (host/telemetry/) と同じ形式だが、ここではツールが使うレコードだけを読む。
+"""
+
+from dataclasses import dataclass
+
+from .barcode import crc8_atm
+
+# examples/common/telemetry/records.hpp の RecordType
+TYPE_TEXT = 0x02
+TYPE_MEASURE_SAMPLE = 0x10
+TYPE_MEASURE_RUN = 0x15
+TYPE_MEASURE_ACK = 0x16
+TYPE_PROFILE_ACK = 0x18
+
+# MeasureAckStatus
+ACK_QUEUED = 0
+ACK_LIVE = 1
+ACK_FULL = 2
+ACK_REJECTED = 3
+ACK_RELEASED = 4
+
+ACK_STATUS_NAMES = {
+    ACK_QUEUED: "queued",
+    ACK_LIVE: "live",
+    ACK_FULL: "full",
+    ACK_REJECTED: "rejected",
+    ACK_RELEASED: "released",
+}
+
+
+# ProfileAckStatus
+PROFILE_READY = 0
+PROFILE_WRITTEN = 1
+PROFILE_ACTIVATED = 2
+PROFILE_REJECTED = 3
+PROFILE_FAILED = 4
+
+
+@dataclass(frozen=True)
+class Frame:
+    type: int
+    timestamp_us: int
+    payload: bytes
+
+
+@dataclass(frozen=True)
+class MeasureAck:
+    status: int
+    seq: int
+    console_frame: int
+    queued: int
+
+
+@dataclass(frozen=True)
+class ProfileAck:
+    status: int
+    slot: int
+    offset: int
+    crc: int
+
+
+@dataclass(frozen=True)
+class MeasureSample:
+    frame: int
+    first: int
+    second: int
+
+
+def cobs_encode(data: bytes) -> bytes:
+    """COBSでエンコードする（区切りの0x00は付けない）。"""
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte != 0:
+            out.append(byte)
+            code += 1
+        if byte == 0 or code == 0xFF:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes | None:
+    """区切りの0x00を除いたCOBSのバイト列を戻す。壊れていれば None。"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1 : i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def read_varint(data: bytes, pos: int) -> tuple[int, int] | None:
+    """符号なしLEB128を読み、(値, 次の位置) を返す。"""
+    value = 0
+    for i in range(5):
+        if pos + i >= len(data):
+            return None
+        byte = data[pos + i]
+        value |= (byte & 0x7F) << (7 * i)
+        if byte & 0x80 == 0:
+            return value, pos + i + 1
+    return None
+
+
+def parse_frame(encoded: bytes) -> Frame | None:
+    raw = cobs_decode(encoded)
+    if raw is None or len(raw) < 3 or crc8_atm(raw[:-1]) != raw[-1]:
+        return None
+    ts = read_varint(raw, 1)
+    if ts is None:
+        return None
+    timestamp_us, pos = ts
+    return Frame(type=raw[0], timestamp_us=timestamp_us, payload=raw[pos:-1])
+
+
+class FrameReader:
+    """受信したバイト列を区切りの0x00で切り、フレームを返す。"""
+
+    def __init__(self):
+        self._pending = bytearray()
+
+    def feed(self, data: bytes) -> list[Frame]:
+        frames: list[Frame] = []
+        self._pending += data
+        while True:
+            end = self._pending.find(0)
+            if end < 0:
+                return frames
+            encoded = bytes(self._pending[:end])
+            del self._pending[: end + 1]
+            frame = parse_frame(encoded) if encoded else None
+            if frame is not None:
+                frames.append(frame)
+
+
+def parse_measure_ack(frame: Frame) -> MeasureAck | None:
+    if frame.type != TYPE_MEASURE_ACK or len(frame.payload) < 4:
+        return None
+    p = frame.payload
+    seq = read_varint(p, 1)
+    if seq is None:
+        return None
+    console_frame = read_varint(p, seq[1])
+    if console_frame is None or console_frame[1] >= len(p):
+        return None
+    return MeasureAck(
+        status=p[0], seq=seq[0], console_frame=console_frame[0], queued=p[console_frame[1]]
+    )
+
+
+def parse_profile_ack(frame: Frame) -> ProfileAck | None:
+    if frame.type != TYPE_PROFILE_ACK or len(frame.payload) < 4:
+        return None
+    p = frame.payload
+    offset = read_varint(p, 2)
+    if offset is None:
+        return None
+    crc = read_varint(p, offset[1])
+    if crc is None:
+        return None
+    return ProfileAck(status=p[0], slot=p[1], offset=offset[0], crc=crc[0])
+
+
+def parse_measure_sample(frame: Frame) -> MeasureSample | None:
+    if frame.type != TYPE_MEASURE_SAMPLE or len(frame.payload) != 4:
+        return None
+    p = frame.payload
+    return MeasureSample(frame=p[0] | (p[1] << 8), first=p[2], second=p[3])
+
+
+def parse_text(frame: Frame) -> str | None:
+    if frame.type != TYPE_TEXT or not frame.payload:
+        return None
+    return frame.payload[1:].decode("utf-8", errors="replace")
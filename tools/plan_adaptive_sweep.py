@@ -0,0 +1,225 @@
+"""前回の計測結果 (readings.csv) から、適応走査で細かく測るマスの優先リストを作る。
+
+計測ファームウェア (examples/measure, kAdaptiveSweep) は粗い格子を先に測り、
+このリストのマスだけを指定の刻みで測る。
+マスごとに「格子から双線形補間した値」と前回の計測値のずれを見て、
+ずれが許容内に収まる最も粗い刻みを選ぶ。格子だけで足りるマスはリストに入れない。
+先頭ほどずれが大きいので、途中で止めても効くところから埋まる。
+
+Usage:
+    uv run tools/plan_adaptive_sweep.py \
+        --input resources/switch2/20260205/readings.csv \
+        --output plan.txt
+
+    # 計測ファームウェアのUARTへ直接送る
+    uv run tools/plan_adaptive_sweep.py \
+        --input resources/switch2/20260205/readings.csv \
+        --send /dev/ttyUSB0
+"""
+
+import argparse
+import csv
+import math
+import sys
+import time
+from dataclasses import dataclass
+from pathlib import Path
+
+N = 256
+# ファームウェアのAdaptivePlan::kMaxCells
+MAX_CELLS = 1024
+
+Reading = tuple[int, int]
+
+
+@dataclass(frozen=True)
+class Cell:
+    x0: int
+    y0: int
+    size: int
+    step: int
+    error: float  # 格子だけで補間したときのずれ（データがなければ inf）
+
+    @property
+    def line(self) -> str:
+        return f"C,{self.x0},{self.y0},{self.size},{self.step}"
+
+
+def read_readings(path: Path) -> dict[tuple[int, int], Reading]:
+    """readings.csv を読み込み (sx, sy) -> (gx, gy) を返す。"""
+    readings: dict[tuple[int, int], Reading] = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            sx = int(row["sx"])
+            sy = int(row["sy"])
+            if 0 <= sx < N and 0 <= sy < N:
+                readings[(sx, sy)] = (int(row["gx"]), int(row["gy"]))
+    print(f"読み込み: {len(readings)} 点 ({path})")
+    return readings
+
+
+def lattice(start: int, size: int, step: int) -> list[int]:
+    """マスの中で step 刻みに測る座標と、補間に使う向こう端。"""
+    points = list(range(start, start + size, step))
+    end = min(start + size, N - 1)
+    if points[-1] != end:
+        points.append(end)
+    return points
+
+
+def bracket(points: list[int], v: int) -> tuple[int, int]:
+    for a, b in zip(points, points[1:]):
+        if a <= v <= b:
+            return a, b
+    return points[-1], points[-1]
+
+
+def interpolation_error(
+    readings: dict[tuple[int, int], Reading], x0: int, y0: int, size: int, step: int
+) -> float | None:
+    """step 刻みの点だけから補間したときの最大のずれ。判定できる点がなければ None。"""
+    xs = lattice(x0, size, step)
+    ys = lattice(y0, size, step)
+    worst: float | None = None
+    for x in range(x0, min(x0 + size, N)):
+        xa, xb = bracket(xs, x)
+        tx = 0.0 if xa == xb else (x - xa) / (xb - xa)
+        for y in range(y0, min(y0 + size, N)):
+            actual = readings.get((x, y))
+            if actual is None:
+                continue
+            ya, yb = bracket(ys, y)
+            corners = [readings.get(p) for p in ((xa, ya), (xb, ya), (xa, yb), (xb, yb))]
+            if any(c is None for c in corners):
+                continue
+            ty = 0.0 if ya == yb else (y - ya) / (yb - ya)
+            c00, c10, c01, c11 = corners
+            error = 0.0
+            for axis in range(2):
+                top = c00[axis] * (1 - tx) + c10[axis] * tx
+                bottom = c01[axis] * (1 - tx) + c11[axis] * tx
+                estimate = top * (1 - ty) + bottom * ty
+                error = max(error, abs(estimate - actual[axis]))
+            worst = error if worst is None else max(worst, error)
+    return worst
+
+
+def plan_cells(
+    readings: dict[tuple[int, int], Reading],
+    coarse: int,
+    tolerance: float,
+    explore_unknown: bool,
+) -> list[Cell]:
+    """格子の各マスについて、ずれが tolerance 以下になる最も粗い刻みを選ぶ。"""
+    cells: list[Cell] = []
+    for x0 in range(0, N, coarse):
+        for y0 in range(0, N, coarse):
+            coarse_error = interpolation_error(readings, x0, y0, coarse, coarse)
+            if coarse_error is None:
+                # 前回のデータがないマスは1段だけ細かくして様子を見る
+                if explore_unknown and coarse > 1:
+                    cells.append(Cell(x0, y0, coarse, coarse // 2, float("inf")))
+                continue
+            if coarse_error <= tolerance:
+                continue
+            step = coarse // 2
+            while step > 1:
+                error = interpolation_error(readings, x0, y0, coarse, step)
+                if error is not None and error <= tolerance:
+                    break
+                step //= 2
+            cells.append(Cell(x0, y0, coarse, step, coarse_error))
+    # ずれの大きいマスから測る。データのないマスは最後
+    cells.sort(key=lambda c: (math.isinf(c.error), 0.0 if math.isinf(c.error) else -c.error))
+    return cells
+
+
+def count_points(cells: list[Cell], coarse: int) -> int:
+    """ファームウェアが細分の段で測る点の数（格子の点は除く）。"""
+
+    def on_grid(v: int) -> bool:
+        return v % coarse == 0 or v == N - 1
+
+    total = 0
+    for c in cells:
+        for x in range(c.x0, c.x0 + c.size, c.step):
+            for y in range(c.y0, c.y0 + c.size, c.step):
+                if not (on_grid(x) and on_grid(y)):
+                    total += 1
+    return total
+
+
+def plan_lines(cells: list[Cell]) -> list[str]:
+    return ["P", *(c.line for c in cells), f"E,{len(cells)}"]
+
+
+def send_lines(port: str, lines: list[str], baudrate: int, line_delay_s: float):
+    """UARTへ1行ずつ送る。受信側はmainループで読むので行の間を少し空ける。"""
+    import termios
+
+    with open(port, "r+b", buffering=0) as f:
+        attrs = termios.tcgetattr(f)
+        speed = getattr(termios, f"B{baudrate}")
+        attrs[0] = 0  # iflag
+        attrs[1] = 0  # oflag
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0  # lflag
+        attrs[4] = speed
+        attrs[5] = speed
+        termios.tcsetattr(f, termios.TCSANOW, attrs)
+        for line in lines:
+            f.write((line + "\n").encode("ascii"))
+            time.sleep(line_delay_s)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="適応走査の優先リストを作る")
+    parser.add_argument("--input", type=Path, required=True, help="前回の readings.csv")
+    parser.add_argument("--output", type=Path, help="優先リストを書き出すファイル")
+    parser.add_argument("--send", help="優先リストを送るシリアルポート")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--coarse", type=int, default=16, help="格子の間隔（ファームウェアと合わせる）")
+    parser.add_argument("--tolerance", type=float, default=1.0, help="許容するずれ（ゲーム側の値）")
+    parser.add_argument(
+        "--no-explore-unknown",
+        action="store_true",
+        help="前回のデータがないマスをリストに入れない",
+    )
+    parser.add_argument(
+        "--interval-ms", type=float, default=166.67, help="1点あたりの時間（所要時間の見積もり用）"
+    )
+    args = parser.parse_args()
+
+    if args.coarse < 2 or args.coarse > 128 or args.coarse & (args.coarse - 1):
+        print("エラー: --coarse は 2..128 の2の冪にしてください", file=sys.stderr)
+        sys.exit(1)
+    if args.output is None and args.send is None:
+        print("エラー: --output か --send を指定してください", file=sys.stderr)
+        sys.exit(1)
+
+    readings = read_readings(args.input)
+    cells = plan_cells(readings, args.coarse, args.tolerance, not args.no_explore_unknown)
+    if len(cells) > MAX_CELLS:
+        print(f"警告: マスが {len(cells)} 個あります。先頭の {MAX_CELLS} 個だけ使います", file=sys.stderr)
+        cells = cells[:MAX_CELLS]
+
+    grid_points = (N // args.coarse + 1) ** 2
+    refine_points = count_points(cells, args.coarse)
+    total = grid_points + refine_points
+    minutes = total * args.interval_ms / 60_000
+    print(
+        f"格子 {grid_points} 点 + 細分 {len(cells)} マス {refine_points} 点 = {total} 点 "
+        f"（全点の {total / (N * N):.1%}、約 {minutes:.0f} 分）"
+    )
+
+    lines = plan_lines(cells)
+    if args.output is not None:
+        args.output.write_text("\n".join(lines) + "\n")
+        print(f"書き出し: {args.output}")
+    if args.send is not None:
+        send_lines(args.send, lines, args.baudrate, line_delay_s=0.005)
+        print(f"送信: {args.send}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,217 @@
+"""補正プロファイルを bridge のフラッシュのスロットへシリアルで書き込み、書けたらそのプロファイルへ切り替える。
+
+プロファイルは tools/generate_inverse_lut.py --format profile（または forward）で作る。
+ファームウェアは選んでいるスロットを使ったままコンソールへ応答し続け、別のスロットへ書き込む。
+データを読み戻したCRCがヘッダと合えば、次の Status 応答から新しい表を使う（手順は
+examples/bridge/calibration/profile_upload.hpp）。順方向の写像は表を組み立て終えてから切り替わる。
+
+Usage:
+    uv run tools/generate_inverse_lut.py --format profile \\
+        --input resources/switch2/20260205/readings.csv --output build/profile.bin
+    uv run tools/upload_profile.py --port /dev/ttyUSB0 --slot 2 --profile build/profile.bin
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+from pathlib import Path
+
+from measurement_lib.barcode import crc8_atm
+from measurement_lib.telemetry import (
+    PROFILE_ACTIVATED,
+    PROFILE_FAILED,
+    PROFILE_READY,
+    PROFILE_REJECTED,
+    PROFILE_WRITTEN,
+    FrameReader,
+    cobs_encode,
+    parse_profile_ack,
+    parse_text,
+)
+
+# examples/bridge/calibration/profile_format.hpp / profile_store.hpp / profile_upload.hpp
+HEADER_SIZE = 64
+DATA_OFFSET = 4096
+DATA_SIZE_OFFSET = 12  # ProfileHeader::data_size
+DATA_CAPACITY = 256 * 256 // 8 + 2 * 256 * 256
+SLOT_COUNT = 4
+CHUNK_SIZE = 256
+WINDOW = 4
+
+
+def open_port(port: str, baudrate: int) -> int:
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, f"B{baudrate}")
+    attrs[0] = 0  # iflag
+    attrs[1] = 0  # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0  # lflag
+    attrs[4] = speed
+    attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def load_profile(path: Path) -> tuple[bytes, bytes]:
+    """プロファイルのファイルを (ヘッダ, データ) に分ける。"""
+    image = path.read_bytes()
+    if len(image) < DATA_OFFSET or image[:4] != b"GCPF":
+        raise ValueError("プロファイルのファイルではない（--format profile/forward で作る）")
+    (data_size,) = struct.unpack_from("<I", image, DATA_SIZE_OFFSET)
+    if data_size > DATA_CAPACITY or len(image) != DATA_OFFSET + data_size:
+        raise ValueError(f"大きさがヘッダと合わない: {len(image)} (data_size={data_size})")
+    return image[:HEADER_SIZE], image[DATA_OFFSET:]
+
+
+def chunk_frame(offset: int, data: bytes) -> bytes:
+    raw = struct.pack("<I", offset) + data
+    return cobs_encode(raw + bytes([crc8_atm(raw)])) + b"\0"
+
+
+class Uploader:
+    def __init__(self, fd: int, slot: int, verbose: bool):
+        self.fd = fd
+        self.slot = slot
+        self.verbose = verbose
+        self.reader = FrameReader()
+
+    def send(self, data: bytes):
+        view = memoryview(data)
+        while view:
+            select.select([], [self.fd], [], 1.0)
+            try:
+                written = os.write(self.fd, view)
+            except BlockingIOError:
+                continue
+            view = view[written:]
+
+    def poll(self, timeout_s: float):
+        """このスロットへの応答を返す。ログ行は --verbose のときだけ表示する。"""
+        ready, _, _ = select.select([self.fd], [], [], timeout_s)
+        if not ready:
+            return []
+        acks = []
+        for frame in self.reader.feed(os.read(self.fd, 4096)):
+            ack = parse_profile_ack(frame)
+            if ack is not None and ack.slot == self.slot:
+                acks.append(ack)
+                continue
+            text = parse_text(frame)
+            if text is not None and self.verbose:
+                print(f"# {text.rstrip()}", file=sys.stderr)
+        return acks
+
+    def wait_ready(self, timeout_s: float):
+        # 途中まで届いていた行を区切ってから指示を送る
+        self.send(f"\nU,{self.slot}\n".encode("ascii"))
+        deadline = time.monotonic() + timeout_s
+        while time.monotonic() < deadline:
+            for ack in self.poll(0.05):
+                if ack.status == PROFILE_READY:
+                    return
+                if ack.status == PROFILE_REJECTED:
+                    raise RuntimeError(
+                        f"スロット{self.slot}には書けない（選んでいる、範囲外、書き込み中）"
+                    )
+        raise TimeoutError(
+            "スロットを消し終えた応答がない"
+            "（空でないスロットはコンソールが止まっている間だけ消す。電源を切るかパッドを抜く）"
+        )
+
+    def stream(self, header: bytes, data: bytes, resend_s: float, timeout_s: float) -> int:
+        """データを送り、最後にヘッダを送る。切り替わったらデータのCRCを返す。"""
+        end = DATA_OFFSET + len(data)
+        acked = DATA_OFFSET
+        next_offset = acked
+        header_sent = False
+        resends = 0
+        last_progress = time.monotonic()
+        last_resend = last_progress
+        started = last_progress
+        while True:
+            while next_offset < end and next_offset - acked < WINDOW * CHUNK_SIZE:
+                chunk = data[next_offset - DATA_OFFSET : next_offset - DATA_OFFSET + CHUNK_SIZE]
+                self.send(chunk_frame(next_offset, chunk))
+                next_offset += len(chunk)
+            if acked == end and not header_sent:
+                self.send(chunk_frame(0, header))
+                header_sent = True
+
+            for ack in self.poll(0.05):
+                if ack.status == PROFILE_WRITTEN and ack.offset > acked:
+                    acked = ack.offset
+                    last_progress = time.monotonic()
+                    if self.verbose and (acked - DATA_OFFSET) % (32 * CHUNK_SIZE) == 0:
+                        print(f"# {acked - DATA_OFFSET}/{len(data)}", file=sys.stderr)
+                elif ack.status == PROFILE_ACTIVATED:
+                    elapsed = time.monotonic() - started
+                    print(f"送り直し {resends} 回、{elapsed:.1f} 秒", file=sys.stderr)
+                    return ack.crc
+                elif ack.status == PROFILE_FAILED:
+                    raise RuntimeError(
+                        f"書き込みに失敗した（offset={ack.offset}, crc={ack.crc:08x}）"
+                    )
+
+            now = time.monotonic()
+            if now - last_progress > timeout_s:
+                raise TimeoutError(f"{timeout_s}秒進まない（{acked - DATA_OFFSET}/{len(data)}）")
+            if now - max(last_progress, last_resend) > resend_s:
+                # 抜けたチャンクの後ろは捨てられているので、書き終えた位置から送り直す
+                next_offset = acked
+                header_sent = False
+                last_resend = now
+                resends += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="補正プロファイルを bridge のスロットへ書き込む")
+    parser.add_argument("--port", required=True, help="bridge のシリアルポート")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument(
+        "--slot", type=int, required=True, help=f"書き込むスロット（1..{SLOT_COUNT}）"
+    )
+    parser.add_argument(
+        "--profile", type=Path, required=True, help="--format profile/forward で作ったファイル"
+    )
+    parser.add_argument(
+        "--resend", type=float, default=0.5, help="応答が止まってから送り直すまでの秒数"
+    )
+    parser.add_argument("--timeout", type=float, default=10.0, help="進まないときに諦める秒数")
+    parser.add_argument(
+        "--ready-timeout",
+        type=float,
+        default=65.0,
+        help="スロットを消し終えるのを待つ秒数（コンソールが止まるまで消さない）",
+    )
+    parser.add_argument("--verbose", action="store_true", help="進み具合とログも表示する")
+    args = parser.parse_args()
+
+    if not 1 <= args.slot <= SLOT_COUNT:
+        print(f"エラー: --slot は 1..{SLOT_COUNT}", file=sys.stderr)
+        sys.exit(1)
+    try:
+        header, data = load_profile(args.profile)
+    except (OSError, ValueError) as e:
+        print(f"エラー: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    fd = open_port(args.port, args.baudrate)
+    uploader = Uploader(fd, args.slot, args.verbose)
+    try:
+        uploader.wait_ready(args.ready_timeout)
+        crc = uploader.stream(header, data, args.resend, args.timeout)
+    except (RuntimeError, TimeoutError) as e:
+        print(f"エラー: {e}", file=sys.stderr)
+        sys.exit(1)
+    finally:
+        os.close(fd)
+    print(f"スロット{args.slot}へ切り替えた（crc={crc:08x}）")
+
+
+if __name__ == "__main__":
+    main()
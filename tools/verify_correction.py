@@ -0,0 +1,246 @@
+"""補正の検証走査の結果から、補正後にゲームが受け取った値 S(P(s)) を目標 φ(C(s)) と比べる。
+
+計測ファームウェア (examples/measure) の kVerifyCorrection を有効にすると、
+注入した生の値 s に bridge と同じ補正 P(s) を掛けてコンソールへ送り、点ごとに
+`Q,frame,raw_x,raw_y,out_x,out_y` 行を出す（D行とバーコードの値は P(s)）。
+動画から作った readings.csv（frame,sx,sy,gx,gy）とフレーム番号でつなぎ、
+s の位置（八角形の内側からの距離と方向）ごとに誤差をまとめる。
+
+Usage:
+    build-host/telemetry/gc_telemetry_decode capture.bin > capture.csv
+    uv run tools/verify_correction.py \
+        --readings resources/switch2/verify/readings.csv \
+        --log capture.csv \
+        --out-csv verify_points.csv
+"""
+
+import argparse
+import csv
+import math
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+
+CENTER = 128
+# docs/transforms.md の C と φ
+GATE_RADIUS = 125
+SCALE = 0.8
+COS8 = math.cos(math.pi / 8)
+SIN8 = math.sin(math.pi / 8)
+APOTHEM = GATE_RADIUS * COS8
+
+# s の八角形比 t（1で Oct(125) の境界）で分ける帯。最後の帯は C でクランプされる点
+RINGS = [(0.0, 0.25), (0.25, 0.5), (0.5, 0.75), (0.75, 1.0), (1.0, math.inf)]
+SECTORS = ["E", "NE", "N", "NW", "W", "SW", "S", "SE"]
+
+
+@dataclass
+class Point:
+    frame: int
+    raw: tuple[int, int]  # s
+    out: tuple[int, int]  # P(s)（ファームウェアが送った値）
+    game: tuple[int, int]  # S(P(s)) = (gx + 128, gy + 128)
+    target: tuple[float, float]  # φ(C(s))
+    error: float
+    region: str
+
+
+@dataclass
+class Stats:
+    errors: list[float] = field(default_factory=list)
+
+    def add(self, error: float):
+        self.errors.append(error)
+
+    def row(self, tolerance: float) -> list[str]:
+        errors = sorted(self.errors)
+        n = len(errors)
+        p95 = errors[min(n - 1, math.ceil(n * 0.95) - 1)]
+        over = sum(1 for e in errors if e > tolerance)
+        return [
+            str(n),
+            f"{sum(errors) / n:.2f}",
+            f"{p95:.2f}",
+            f"{errors[-1]:.2f}",
+            f"{over} ({over / n:.0%})",
+        ]
+
+
+def octagon_ratio(px: float, py: float) -> float:
+    """中心基準の (px, py) が Oct(125) の何倍の位置か。"""
+    return (
+        max(
+            abs(COS8 * px + SIN8 * py),
+            abs(COS8 * px - SIN8 * py),
+            abs(SIN8 * px + COS8 * py),
+            abs(SIN8 * px - COS8 * py),
+        )
+        / APOTHEM
+    )
+
+
+def target_of(sx: int, sy: int) -> tuple[float, float]:
+    """φ(C(s))"""
+    px = sx - CENTER
+    py = sy - CENTER
+    t = octagon_ratio(px, py)
+    if t > 1:
+        px /= t
+        py /= t
+    return (SCALE * px + CENTER, SCALE * py + CENTER)
+
+
+def region_of(sx: int, sy: int) -> str:
+    px = sx - CENTER
+    py = sy - CENTER
+    t = octagon_ratio(px, py)
+    ring = next(i for i, (lo, hi) in enumerate(RINGS) if lo <= t < hi)
+    if px == 0 and py == 0:
+        return f"r{ring}"
+    angle = math.degrees(math.atan2(py, px)) % 360
+    return f"r{ring}/{SECTORS[int((angle + 22.5) // 45) % 8]}"
+
+
+def region_key(name: str) -> tuple[str, int]:
+    """帯の順、帯の中は方向の順に並べる。"""
+    ring, _, sector = name.partition("/")
+    return (ring, SECTORS.index(sector) if sector else -1)
+
+
+def ring_label(ring: int) -> str:
+    lo, hi = RINGS[ring]
+    if math.isinf(hi):
+        return f"r{ring} ({lo:g}<=t)"
+    return f"r{ring} ({lo:g}<=t<{hi:g})"
+
+
+def read_corrections(path: Path) -> dict[int, tuple[tuple[int, int], tuple[int, int]]]:
+    """gc_telemetry_decode のCSVから Q 行を読み、frame -> (s, P(s)) を返す。"""
+    corrections: dict[int, tuple[tuple[int, int], tuple[int, int]]] = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.rstrip("\n").split(",")
+            if fields[0] != "Q" or len(fields) != 6:
+                continue
+            frame, rx, ry, ox, oy = map(int, fields[1:])
+            corrections[frame] = ((rx, ry), (ox, oy))
+    print(f"Q行: {len(corrections)} 点 ({path})", file=sys.stderr)
+    return corrections
+
+
+def read_readings(path: Path) -> dict[int, tuple[tuple[int, int], tuple[int, int]]]:
+    """readings.csv を読み込み frame -> ((sx, sy), (gx, gy)) を返す。"""
+    readings: dict[int, tuple[tuple[int, int], tuple[int, int]]] = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            readings[int(row["frame"])] = (
+                (int(row["sx"]), int(row["sy"])),
+                (int(row["gx"]), int(row["gy"])),
+            )
+    print(f"読み込み: {len(readings)} 点 ({path})", file=sys.stderr)
+    return readings
+
+
+def join(corrections, readings) -> tuple[list[Point], int]:
+    points: list[Point] = []
+    mismatched = 0
+    for frame, ((rx, ry), out) in sorted(corrections.items()):
+        reading = readings.get(frame)
+        if reading is None:
+            continue
+        barcode, (gx, gy) = reading
+        # バーコードの値は P(s) のはず。違えば読み取りかフレームの対応がずれている
+        if barcode != out:
+            mismatched += 1
+            continue
+        game = (gx + CENTER, gy + CENTER)
+        target = target_of(rx, ry)
+        error = math.hypot(game[0] - target[0], game[1] - target[1])
+        points.append(Point(frame, (rx, ry), out, game, target, error, region_of(rx, ry)))
+    return points, mismatched
+
+
+def print_table(header: list[str], rows: list[list[str]]):
+    widths = [max(len(r[i]) for r in [header, *rows]) for i in range(len(header))]
+    for r in [header, *rows]:
+        print("  ".join(v.ljust(w) for v, w in zip(r, widths)).rstrip())
+
+
+def report(points: list[Point], tolerance: float, by_sector: bool):
+    total = Stats()
+    rings: dict[int, Stats] = {}
+    regions: dict[str, Stats] = {}
+    for p in points:
+        total.add(p.error)
+        ring = int(p.region.split("/")[0][1:])
+        rings.setdefault(ring, Stats()).add(p.error)
+        regions.setdefault(p.region, Stats()).add(p.error)
+
+    header = ["region", "points", "mean", "p95", "max", f">{tolerance:g}"]
+    rows = [[ring_label(i), *rings[i].row(tolerance)] for i in sorted(rings)]
+    rows.append(["all", *total.row(tolerance)])
+    print_table(header, rows)
+
+    if by_sector:
+        print()
+        rows = [[name, *regions[name].row(tolerance)] for name in sorted(regions, key=region_key)]
+        print_table(header, rows)
+
+    worst = sorted(points, key=lambda p: p.error, reverse=True)[:10]
+    print()
+    print("誤差の大きい点: s -> P(s) -> S(P(s)) / φ(C(s))")
+    for p in worst:
+        print(
+            f"  {p.raw} -> {p.out} -> {p.game} / "
+            f"({p.target[0]:.1f}, {p.target[1]:.1f})  error={p.error:.2f}  frame={p.frame}"
+        )
+
+
+def write_points(path: Path, points: list[Point]):
+    with open(path, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["frame", "sx", "sy", "px", "py", "mx", "my", "tx", "ty", "error", "region"])
+        for p in points:
+            writer.writerow(
+                [
+                    p.frame,
+                    *p.raw,
+                    *p.out,
+                    *p.game,
+                    f"{p.target[0]:.2f}",
+                    f"{p.target[1]:.2f}",
+                    f"{p.error:.3f}",
+                    p.region,
+                ]
+            )
+    print(f"書き出し: {path}", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="補正後の計測値を目標と比べる")
+    parser.add_argument("--readings", type=Path, required=True, help="検証走査の readings.csv")
+    parser.add_argument(
+        "--log", type=Path, required=True, help="Q行を含む gc_telemetry_decode のCSV"
+    )
+    parser.add_argument("--tolerance", type=float, default=1.5, help="外れとみなす誤差")
+    parser.add_argument("--by-sector", action="store_true", help="帯を方向ごとにも分ける")
+    parser.add_argument("--out-csv", type=Path, help="点ごとの結果を書き出すCSV")
+    args = parser.parse_args()
+
+    corrections = read_corrections(args.log)
+    readings = read_readings(args.readings)
+    points, mismatched = join(corrections, readings)
+    if mismatched:
+        print(f"警告: バーコードとQ行の値が合わない {mismatched} 点を除いた", file=sys.stderr)
+    if not points:
+        print("エラー: フレーム番号の合う点がない", file=sys.stderr)
+        sys.exit(1)
+    print(f"比較: {len(points)} 点（Q行 {len(corrections)} 点）", file=sys.stderr)
+
+    report(points, args.tolerance, args.by_sector)
+    if args.out_csv is not None:
+        write_points(args.out_csv, points)
+
+
+if __name__ == "__main__":
+    main()